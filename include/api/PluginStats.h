@@ -0,0 +1,186 @@
+/** @file
+
+  Time spent in plugin callbacks, by plugin and hook.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <string>
+#include <string_view>
+
+#include "ts/apidefs.h"
+#include "tscore/ink_hrtime.h"
+#include "tsutil/Metrics.h"
+
+/** Call count, time and a latency histogram of the callbacks of one plugin.
+
+    Enabled by proxy.config.plugin.time_stats. A plugin is identified by the file name of its shared
+    object, and is attached to every continuation it creates: the continuations created while the
+    plugin is loaded, or while one of its continuations or remap rules is running. The stats are
+    ts::Metrics, named proxy.process.plugin.<plugin>.<hook>.count and .time for each hook a plugin is
+    called on, and proxy.process.plugin.<plugin>.latency.<bound> for the histogram, so they are
+    available through the JSON-RPC records lookup like any other metric.
+
+    The time of a callback does not include the time spent in the transaction or session when the
+    plugin reenables it from the callback, see PluginStats::Pause.
+ */
+class PluginStats
+{
+  using self_type = PluginStats;
+  using Counter   = ts::Metrics::Counter::AtomicType;
+
+public:
+  /// Stats for callbacks that are not an HTTP hook, after the HTTP hook IDs.
+  static constexpr int REMAP_SLOT = TS_SSL_FIRST_HOOK;
+  static constexpr int OTHER_SLOT = REMAP_SLOT + 1;
+  static constexpr int N_SLOTS    = OTHER_SLOT + 1;
+
+  /// Histogram bucket upper bounds in microseconds, the last bucket counts anything slower.
+  static constexpr std::array<int64_t, 6> LATENCY_BOUNDS = {10, 100, 1000, 10000, 100000, 1000000};
+  static constexpr int                    N_BUCKETS      = LATENCY_BOUNDS.size() + 1;
+
+  /// Read the configuration, this must be done before any plugin is loaded.
+  static void init();
+
+  static bool
+  enabled()
+  {
+    return _enabled;
+  }
+
+  /** Get the stats of a plugin.
+
+      @param path Path of the plugin shared object.
+      @return The stats, or @c nullptr if the time stats are disabled.
+
+      The stats live until shutdown, so a reloaded remap plugin keeps its stats.
+   */
+  static self_type *get(std::string_view path);
+
+  /// The slot of a callback for @a event.
+  static int
+  slot_for(int event)
+  {
+    int id = event - TS_EVENT_HTTP_READ_REQUEST_HDR;
+
+    return (id >= 0 && id < TS_SSL_FIRST_HOOK) ? id : OTHER_SLOT;
+  }
+
+  /// Add a callback that took @a elapsed to the stats of @a slot.
+  void record(int slot, ink_hrtime elapsed);
+
+  /// The plugin whose code is running on this thread, to attach to new continuations.
+  static thread_local self_type *current;
+
+  /// Make @a stats the current plugin for a scope.
+  class Scope
+  {
+  public:
+    explicit Scope(self_type *stats) : _prev(current) { current = stats; }
+    ~Scope() { current = _prev; }
+
+  private:
+    self_type *_prev;
+  };
+
+  class Pause;
+
+  /// Time a plugin callback, and make the plugin current for it.
+  class Timer
+  {
+  public:
+    Timer(self_type *stats, int slot) : _stats(stats), _slot(slot), _scope(stats), _prev(_running)
+    {
+      if (_stats) {
+        _start   = ink_get_hrtime();
+        _running = this;
+      }
+    }
+
+    ~Timer()
+    {
+      if (_stats) {
+        _running = _prev;
+        _stats->record(_slot, ink_get_hrtime() - _start - _paused);
+      }
+    }
+
+  private:
+    friend class Pause;
+
+    self_type *_stats;
+    int        _slot;
+    Scope      _scope;
+    Timer     *_prev;
+    ink_hrtime _start  = 0;
+    ink_hrtime _paused = 0; ///< Time spent outside the plugin during the callback.
+  };
+
+  /** Exclude core processing from the callback that is running.
+
+      Used where the core handles a plugin call inline, such as a transaction reenabled from a
+      hook, so the time spent running the transaction is not charged to the plugin.
+   */
+  class Pause
+  {
+  public:
+    Pause() : _timer(_running), _scope(nullptr)
+    {
+      if (_timer) {
+        _start   = ink_get_hrtime();
+        _running = nullptr;
+      }
+    }
+
+    ~Pause()
+    {
+      if (_timer) {
+        _running         = _timer;
+        _timer->_paused += ink_get_hrtime() - _start;
+      }
+    }
+
+  private:
+    Timer     *_timer;
+    Scope      _scope;
+    ink_hrtime _start = 0;
+  };
+
+private:
+  explicit PluginStats(std::string_view name) : _name(name) {}
+
+  struct Slot {
+    std::atomic<Counter *> count{nullptr};
+    std::atomic<Counter *> time{nullptr};
+  };
+
+  /// Create the metrics of @a slot the first time the plugin is called for it.
+  Slot &slot(int slot);
+
+  std::string                      _name;
+  std::array<Slot, N_SLOTS>        _slots;
+  std::array<Counter *, N_BUCKETS> _latency;
+
+  static bool                _enabled;
+  static thread_local Timer *_running; ///< The innermost callback being timed on this thread.
+};
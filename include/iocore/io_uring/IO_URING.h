@@ -33,6 +33,11 @@ struct IOUringConfig {
   int attach_wq     = 0;
   int wq_bounded    = 0;
   int wq_unbounded  = 0;
+
+  // completion based network data path
+  int net_data_path        = 0;
+  int net_recv_buffers     = 256;
+  int net_recv_buffer_size = 16384;
 };
 
 class IOUringCompletionHandler
@@ -74,8 +79,13 @@ public:
 
   int register_eventfd();
 
+  // provided buffer ring, @a entries must be a power of 2. Returns nullptr if the kernel does not support it.
+  io_uring_buf_ring *setup_buf_ring(unsigned int entries, int bgid);
+  void               free_buf_ring(io_uring_buf_ring *br, unsigned int entries, int bgid);
+
   // assigns the global iouring config
-  static void            set_config(const IOUringConfig &);
+  static void                 set_config(const IOUringConfig &);
+  static const IOUringConfig &get_config();
   static IOUringContext *local_context();
   static void            set_main_queue(IOUringContext *);
   static int             get_main_queue_fd();
@@ -26,12 +26,14 @@
 #include "swoc/IntrusiveHashMap.h"
 
 #include <string_view>
+#include <array>
 #include <chrono>
 #include <atomic>
 #include <memory>
 #include <mutex>
 #include <sstream>
 #include <tuple>
+#include <unordered_map>
 #include "records/RecCore.h"
 #include "tscore/ink_platform.h"
 #include "tscore/ink_config.h"
@@ -277,12 +279,33 @@ protected:
     bool operator()(key_type &lhs, key_type &rhs) const;
   };
 
-  /// Internal implementation class instance.
+  /** Internal implementation class instance.
+   *
+   * The groups are split in shards by key hash, each with its own lock, so that threads working with different upstreams
+   * do not contend. A group is removed when its last connection closes and created again by the next one, which makes
+   * the updates too frequent for a reader / writer lock to pay off.
+   */
   struct TableSingleton {
     friend ConnectionTracker::Group;
-    std::unordered_map<Group::Key, std::shared_ptr<Group>, GroupMapHelper, GroupMapHelper>
-               _table; ///< Hash table of connection groups.
-    std::mutex _mutex; ///< Lock for insert, delete, and find.
+
+    static constexpr size_t N_SHARDS = 16;
+
+    /// Cache line aligned so that the locks of the shards do not share a line.
+    struct alignas(64) Shard {
+      std::unordered_map<Group::Key, std::shared_ptr<Group>, GroupMapHelper, GroupMapHelper>
+                 _table; ///< Hash table of connection groups.
+      std::mutex _mutex; ///< Lock for insert, delete, and find.
+    };
+
+    std::array<Shard, N_SHARDS> _shards;
+
+    /// The shard of the group for @a key.
+    Shard &shard(Group::Key const &key);
+
+    /** Get the group for @a key, creating it if there is none.
+     * The other arguments are passed to the @c Group constructor.
+     */
+    std::shared_ptr<Group> obtain(Group::DirectionType direction, Group::Key const &key, std::string_view fqdn, int min_keep_alive);
   };
   static TableSingleton _inbound_table;
   static TableSingleton _outbound_table;
@@ -375,6 +398,13 @@ ConnectionTracker::TxnState::blocked()
   ++_g->_blocked;
 }
 
+inline ConnectionTracker::TableSingleton::Shard &
+ConnectionTracker::TableSingleton::shard(Group::Key const &key)
+{
+  // Mix the bits, the IP address hashes are weak in the low ones.
+  return _shards[((static_cast<uint64_t>(Group::hash(key)) * 0x9E3779B97F4A7C15ULL) >> 32) % N_SHARDS];
+}
+
 /* === GroupMapHelper === */
 inline size_t
 ConnectionTracker::GroupMapHelper::operator()(key_type &key) const
@@ -60,6 +60,9 @@ extern int net_accept_period;
 extern int net_retry_delay;
 extern int net_throttle_delay;
 
+// Writes of at least this many bytes use MSG_ZEROCOPY, 0 for none
+extern int net_zerocopy_threshold;
+
 extern std::string_view net_ccp_in;
 extern std::string_view net_ccp_out;
 
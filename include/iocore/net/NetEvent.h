@@ -78,6 +78,12 @@ public:
   bool has_error() const;
   void set_error_from_socket();
 
+  // Read what the kernel queued on the error queue of the socket, such as write completions.
+  virtual void
+  process_error_queue()
+  {
+  }
+
   // get fd
   virtual int              get_fd()            = 0;
   virtual Ptr<ProxyMutex> &get_mutex()         = 0;
@@ -120,8 +126,18 @@ public:
   /** Whether the current timeout is a default inactivity timeout. */
   bool use_default_inactivity_timeout = false;
 
+  /** The slot of the NetHandler timeout wheel this is in, -1 for none. */
+  int timeout_slot = -1;
+
+  /** When the timeouts are checked next by the InactivityCop. */
+  ink_hrtime timeout_check_at = 0;
+
+  /** Whether this is in the timeout update list of its NetHandler. */
+  int in_timeout_update_list = 0;
+
   LINK(NetEvent, open_link);
-  LINK(NetEvent, cop_link);
+  LINK(NetEvent, timeout_link);
+  SLINK(NetEvent, timeout_update_link);
   LINKM(NetEvent, read, ready_link)
   SLINKM(NetEvent, read, enable_link)
   LINKM(NetEvent, write, ready_link)
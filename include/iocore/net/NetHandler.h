@@ -28,6 +28,7 @@
 #include "iocore/eventsystem/Continuation.h"
 #include "iocore/eventsystem/EThread.h"
 #include "iocore/net/NetEvent.h"
+#include "iocore/net/TimeoutWheel.h"
 
 //
 // NetHandler
@@ -101,9 +102,10 @@ public:
   QueM(NetEvent, NetState, read, ready_link) read_ready_list;
   QueM(NetEvent, NetState, write, ready_link) write_ready_list;
   Que(NetEvent, open_link) open_list;
-  DList(NetEvent, cop_link) cop_list;
+  TimeoutWheel<NetEvent, DList(NetEvent, timeout_link)> timeout_wheel;
   ASLLM(NetEvent, NetState, read, enable_link) read_enable_list;
   ASLLM(NetEvent, NetState, write, enable_link) write_enable_list;
+  ASLL(NetEvent, timeout_update_link) timeout_update_list;
   Que(NetEvent, keep_alive_queue_link) keep_alive_queue;
   uint32_t keep_alive_queue_size = 0;
   Que(NetEvent, active_queue_link) active_queue;
@@ -159,6 +161,7 @@ public:
   int        mainNetEvent(int event, Event *data);
   int        waitForActivity(ink_hrtime timeout) override;
   void       process_enabled_list();
+  void       process_timeout_updates();
   void       process_ready_list();
   void       manage_keep_alive_queue();
   bool       manage_active_queue(NetEvent *ne, bool ignore_queue_size);
@@ -198,16 +201,17 @@ public:
 
   /**
     Start to handle active timeout and inactivity timeout on a NetEvent.
-    Put the ne into open_list. All NetEvents in the open_list is checked for
-    timeout by InactivityCop. Only be called when holding the mutex of this
-    NetHandler and must call startIO(ne) first.
+    Put the ne into open_list and into the timeout wheel, the InactivityCop
+    checks the timeouts of the NetEvents as they come due in the wheel. Only
+    be called when holding the mutex of this NetHandler and must call
+    startIO(ne) first.
 
     @param ne NetEvent to be managed by InactivityCop
    */
   void startCop(NetEvent *ne);
   /**
     Stop to handle active timeout and inactivity on a NetEvent.
-    Remove the ne from open_list and cop_list.
+    Remove the ne from open_list and from the timeout wheel.
     Also remove the ne from keep_alive_queue and active_queue if its context is
     IN. Only be called when holding the mutex of this NetHandler.
 
@@ -215,6 +219,26 @@ public:
    */
   void stopCop(NetEvent *ne);
 
+  /**
+    The timeouts of a NetEvent were set, or it was closed or enabled, so it
+    may have to be checked earlier than the timeout wheel has it. The wheel
+    is updated right away on the thread of this NetHandler, and by the next
+    run of this NetHandler otherwise. A timeout pushed back by I/O does not
+    need this. Only be called when holding the mutex of the NetEvent.
+
+    @param ne NetEvent whose timeouts changed.
+   */
+  void update_timeout(NetEvent *ne);
+
+  /**
+    Put the ne in the timeout wheel at the time its timeouts should be
+    checked next, or take it out if there is nothing to check.
+
+    @param ne NetEvent in the open_list.
+    @param now The current time.
+   */
+  void schedule_timeout(NetEvent *ne, ink_hrtime now);
+
   // Signal the epoll_wait to terminate.
   void signalActivity() override;
 
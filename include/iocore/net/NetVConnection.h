@@ -319,6 +319,13 @@ public:
     return false;
   }
 
+  /// Whether the connection can be moved to another thread by @c UnixNetVConnection::migrateToCurrentThread.
+  virtual bool
+  can_migrate() const
+  {
+    return true;
+  }
+
   virtual int
   provided_cert() const
   {
@@ -49,6 +49,7 @@ public:
 
 private:
   const char  *_debug_tag() const override;
+  bool         _lazy_load() const override;
   virtual bool _setup_session_cache(SSL_CTX *ctx) override;
   virtual bool _set_cipher_suites_for_legacy_versions(SSL_CTX *ctx) override;
   virtual bool _set_info_callback(SSL_CTX *ctx) override;
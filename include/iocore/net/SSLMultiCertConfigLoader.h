@@ -51,13 +51,22 @@ public:
   SSLMultiCertConfigLoader(const SSLConfigParams *p) : _params(p) {}
   virtual ~SSLMultiCertConfigLoader(){};
 
-  swoc::Errata load(SSLCertLookup *lookup);
+  /** Load ssl_multicert.config into @a lookup.
+      The certificates that did not change since @a previous was loaded reuse its contexts, the others are read and built
+      on proxy.config.ssl.server.multicert.load_threads threads.
+   */
+  swoc::Errata load(SSLCertLookup *lookup, const SSLCertLookup *previous = nullptr);
 
   virtual SSL_CTX *default_server_ssl_ctx();
 
   virtual std::vector<SSLLoadingContext> init_server_ssl_ctx(CertLoadData const             &data,
                                                              const SSLMultiCertConfigParams *sslMultCertSettings);
 
+  /** Build the contexts of a certificate loaded on demand, see @c SSLLazyContext.
+      @return the contexts, none if any of them failed.
+   */
+  std::vector<SSLLoadingContext> init_lazy_ssl_ctx(CertLoadData const &data, const SSLMultiCertConfigParams *sslMultCertSettings);
+
   static bool load_certs(SSL_CTX *ctx, const std::vector<std::string> &cert_names_list,
                          const std::vector<std::string> &key_names_list, CertLoadData const &data, const SSLConfigParams *params,
                          const SSLMultiCertConfigParams *sslMultCertSettings);
@@ -80,12 +89,18 @@ protected:
   const SSLConfigParams *_params;
 
   bool _store_single_ssl_ctx(SSLCertLookup *lookup, const shared_SSLMultiCertConfigParams &sslMultCertSettings, shared_SSL_CTX ctx,
-                             SSLCertContextType ctx_type, std::set<std::string> &names);
+                             SSLCertContextType ctx_type, std::set<std::string> &names, bool reused = false);
 
 private:
   virtual const char   *_debug_tag() const;
   virtual const DbgCtl &_dbg_ctl() const;
   virtual bool          _store_ssl_ctx(SSLCertLookup *lookup, const shared_SSLMultiCertConfigParams &ssl_multi_cert_params);
+  virtual bool          _lazy_load() const;
+
+  struct LoadedCert;
+  void _build_cert(LoadedCert &cert, const SSLCertLookup *previous);
+  bool _insert_cert(SSLCertLookup *lookup, LoadedCert &cert);
+
   bool _prep_ssl_ctx(const shared_SSLMultiCertConfigParams &sslMultCertSettings, SSLMultiCertConfigLoader::CertLoadData &data,
                      std::set<std::string> &common_names, std::unordered_map<int, std::set<std::string>> &unique_names);
   virtual void _set_handshake_callbacks(SSL_CTX *ctx);
@@ -103,4 +118,7 @@ private:
   virtual bool _set_keylog_callback(SSL_CTX *ctx);
   virtual bool _enable_ktls(SSL_CTX *ctx);
   virtual bool _enable_early_data(SSL_CTX *ctx);
+
+  /// A digest of the SSL configuration the contexts are built with, for the reuse of contexts by a reload.
+  std::string _params_fingerprint;
 };
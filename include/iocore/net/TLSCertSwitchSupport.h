@@ -46,6 +46,13 @@ protected:
   virtual shared_SSL_CTX _lookupContextByName(const std::string &servername, SSLCertContextType ctxType) = 0;
   virtual shared_SSL_CTX _lookupContextByIP()                                                            = 0;
 
+  /// The handshake waits for the context found by @c _lookupContextByName to be built.
+  virtual bool
+  _isWaitingForContext() const
+  {
+    return false;
+  }
+
 private:
   static int _ex_data_index;
 };
@@ -0,0 +1,166 @@
+/** @file
+
+  A coarse timing wheel for connection timeouts
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include "tscore/List.h"
+#include "tscore/ink_hrtime.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+
+/**
+  TimeoutWheel - the times at which the timeouts of a set of T are checked
+
+  The wheel has a slot for each tick of the next @c SLOTS ticks, a T is put in the slot of the tick of its check time.
+  Advancing the wheel moves the T of the ticks that passed to the due list, the cost is that of the T that are due and
+  not that of all the T in the wheel. A T that is scheduled beyond the last slot goes around the wheel until its tick
+  comes.
+
+  The wheel is not notified when a timeout is pushed back by I/O. The T is checked at the old time, and put back in the
+  wheel at the new one by the caller, so that the I/O path does not touch the wheel.
+
+  T must have these members, for the use of the wheel:
+  ```
+  int        timeout_slot;     // -1 when not in the wheel
+  ink_hrtime timeout_check_at;
+  ```
+ */
+template <class T, class List = DLL<T>> class TimeoutWheel
+{
+public:
+  static constexpr int        SLOTS = 4096;
+  static constexpr ink_hrtime TICK  = HRTIME_SECOND;
+
+  explicit TimeoutWheel(ink_hrtime now = ink_get_hrtime()) : _tick(now / TICK) {}
+
+  TimeoutWheel(const TimeoutWheel &) = delete;
+
+  /// Check @a t at @a at, or at the next tick if @a at is not past the current one. @a t is moved if already in the wheel.
+  void schedule(T *t, ink_hrtime at);
+
+  /// Take @a t out of the wheel, or out of the due list.
+  void remove(T *t);
+
+  bool
+  in(const T *t) const
+  {
+    return t->timeout_slot >= 0;
+  }
+
+  /** Move the T whose check time is at or before the tick of @a now to the due list.
+
+      @return the number of T moved.
+   */
+  int advance(ink_hrtime now);
+
+  /// The next due T, taken out of the wheel. nullptr if none is due.
+  T *pop_due();
+
+  /// The number of T in the wheel, the due ones included.
+  size_t
+  size() const
+  {
+    return _size;
+  }
+
+private:
+  static constexpr int DUE = SLOTS;
+
+  List    _slots[SLOTS + 1]; // the last one is the due list
+  int64_t _tick = 0;         // the last tick advanced to
+  size_t  _size = 0;
+};
+
+template <class T, class List>
+inline void
+TimeoutWheel<T, List>::schedule(T *t, ink_hrtime at)
+{
+  int64_t tick = at / TICK;
+
+  if (in(t)) {
+    _slots[t->timeout_slot].remove(t);
+    --_size;
+  }
+  if (tick <= _tick) {
+    tick = _tick + 1;
+    at   = tick * TICK;
+  }
+  t->timeout_check_at = at;
+  t->timeout_slot     = static_cast<int>(tick % SLOTS);
+  _slots[t->timeout_slot].push(t);
+  ++_size;
+}
+
+template <class T, class List>
+inline void
+TimeoutWheel<T, List>::remove(T *t)
+{
+  if (in(t)) {
+    _slots[t->timeout_slot].remove(t);
+    t->timeout_slot = -1;
+    --_size;
+  }
+}
+
+template <class T, class List>
+inline int
+TimeoutWheel<T, List>::advance(ink_hrtime now)
+{
+  int64_t const target = now / TICK;
+  int           moved  = 0;
+
+  // After a long pause every slot is visited once, the check times sort out which T are due.
+  for (int64_t tick = _tick + 1, last = std::min(target, _tick + SLOTS); tick <= last; ++tick) {
+    List &slot = _slots[tick % SLOTS];
+    T    *next = nullptr;
+
+    for (T *t = slot.head; t != nullptr; t = next) {
+      next = List::next(t);
+      if (t->timeout_check_at / TICK <= target) {
+        slot.remove(t);
+        t->timeout_slot = DUE;
+        _slots[DUE].push(t);
+        ++moved;
+      }
+    }
+  }
+  if (target > _tick) {
+    _tick = target;
+  }
+  return moved;
+}
+
+template <class T, class List>
+inline T *
+TimeoutWheel<T, List>::pop_due()
+{
+  T *t = _slots[DUE].pop();
+
+  if (t != nullptr) {
+    t->timeout_slot = -1;
+    --_size;
+  }
+  return t;
+}
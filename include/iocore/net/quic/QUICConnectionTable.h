@@ -27,10 +27,19 @@
 #include "iocore/net/quic/QUICConnection.h"
 #include "iocore/net/quic/MTHashTable.h"
 
+#include <memory>
+#include <vector>
+
+/*
+ * The connections by connection ID, in shards.
+ *
+ * A connection ID is in the shard of its first byte, which for the connection IDs of the server is the UDP listener that
+ * owns the connection. The packets of a connection are steered to that listener, its thread looks up its own shard only.
+ */
 class QUICConnectionTable
 {
 public:
-  QUICConnectionTable(int hash_table_size = 65521) : _connections(hash_table_size) {}
+  QUICConnectionTable(int hash_table_size = 65521, int nshards = 1);
   ~QUICConnectionTable();
   /*
    * Insert an entry
@@ -53,6 +62,15 @@ public:
    */
   QUICConnection *lookup(QUICConnectionId cid);
 
+  /*
+   * The number of shards, at most 256
+   */
+  int shards() const;
+
 private:
-  MTHashTable<QUICConnectionId, QUICConnection *> _connections;
+  using Table = MTHashTable<QUICConnectionId, QUICConnection *>;
+
+  Table &_table(QUICConnectionId const &cid);
+
+  std::vector<std::unique_ptr<Table>> _shards;
 };
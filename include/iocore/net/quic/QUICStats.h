@@ -28,6 +28,7 @@
 using ts::Metrics;
 
 struct QuicStatsBlock {
+  Metrics::Counter::AtomicType *packets_cross_listener;
   Metrics::Counter::AtomicType *total_packets_sent;
 };
 
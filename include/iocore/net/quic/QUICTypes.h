@@ -271,6 +271,13 @@ public:
   bool    is_zero() const;
   void    randomize();
 
+  /** Randomize, but for the first byte which is @a shard.
+   *
+   * The connection IDs of the server carry the UDP listener that owns the connection, see QUICConnectionTable.
+   */
+  void    randomize(uint8_t shard);
+  uint8_t shard() const;
+
 private:
   uint64_t _hashcode() const;
   uint8_t  _id[MAX_LENGTH];
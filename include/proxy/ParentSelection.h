@@ -198,6 +198,7 @@ struct ParentResult {
   void
   reset()
   {
+    release_load();
     ink_zero(*this);
     line_number           = -1;
     result                = PARENT_UNDEFINED;
@@ -206,6 +207,17 @@ struct ParentResult {
     do_not_cache_response = false;
   }
 
+  // Give back the load taken on a bounded load consistent hash ring by the selected parent.
+  void
+  release_load()
+  {
+    if (load_node != nullptr) {
+      load_ring->release(load_node);
+      load_ring = nullptr;
+      load_node = nullptr;
+    }
+  }
+
   bool
   is_api_result() const
   {
@@ -316,12 +328,15 @@ private:
   bool          wrap_around;
   bool          mapWrapped[2];
   // state for consistent hash.
-  int                   last_lookup;
-  ATSConsistentHashIter chashIter[MAX_GROUP_RINGS];
+  int                    last_lookup;
+  ATSConsistentHashIter  chashIter[MAX_GROUP_RINGS];
+  ATSConsistentHash     *load_ring = nullptr;
+  ATSConsistentHashNode *load_node = nullptr;
 
   friend class NextHopSelectionStrategy;
   friend class NextHopRoundRobin;
   friend class NextHopConsistentHash;
+  friend class NextHopTableHash;
   friend class ParentConsistentHash;
   friend class ParentRoundRobin;
   friend class ParentConfigParams;
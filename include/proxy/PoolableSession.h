@@ -89,6 +89,8 @@ public:
 
   virtual void set_netvc(NetVConnection *newvc);
   virtual bool is_multiplexing() const;
+  /// Whether the session can be moved to the thread that steals it from the pool of its thread.
+  virtual bool can_migrate() const;
 
   // Keep track of connection limiting and a pointer to the
   // singleton that keeps track of the connection counts.
@@ -242,3 +244,11 @@ PoolableSession::is_multiplexing() const
 {
   return false;
 }
+
+// A multiplexed session carries the transactions of the thread that owns it.
+inline bool
+PoolableSession::can_migrate() const
+{
+  NetVConnection const *vc = get_netvc();
+  return !is_multiplexing() && (vc == nullptr || vc->can_migrate());
+}
@@ -205,8 +205,10 @@ protected:
 private:
   void handle_api_return(int event);
   int  state_api_callout(int event, void *edata);
+  void record_hook_time();
 
-  APIHook const *cur_hook = nullptr;
+  APIHook const *cur_hook   = nullptr;
+  ink_hrtime     hook_timer = 0; ///< When the current hook plugin was called, 0 once it resumed.
   HttpAPIHooks   api_hooks;
 
   // for DI. An active connection is one that a request has
@@ -275,6 +275,7 @@ struct HTTPHdrImpl : public HdrHeapObjImpl {
   // Marshaling Functions
   int    marshal(MarshalXlate *ptr_xlate, int num_ptr, MarshalXlate *str_xlate, int num_str);
   void   unmarshal(intptr_t offset);
+  void   relocate(intptr_t offset);
   void   move_strings(HdrStrHeap *new_heap);
   size_t strings_length();
 
@@ -729,7 +730,12 @@ HTTPHdr::copy(const HTTPHdr *hdr)
   if (valid()) {
     http_hdr_copy_onto(hdr->m_http, hdr->m_heap, m_http, m_heap, (m_heap != hdr->m_heap) ? true : false);
   } else {
-    m_heap = new_HdrHeap();
+    // Make room to take all the objects of an unmarshalled header at once.
+    int size = HdrHeap::DEFAULT_SIZE;
+    if (!hdr->m_heap->m_writeable) {
+      size = std::max(size, static_cast<int>(HDR_HEAP_HDR_SIZE + (hdr->m_heap->m_free_start - hdr->m_heap->m_data_start)));
+    }
+    m_heap = new_HdrHeap(size);
     m_http = http_hdr_clone(hdr->m_http, hdr->m_heap, m_heap);
     m_mime = m_http->m_fields_impl;
   }
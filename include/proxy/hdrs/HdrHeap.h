@@ -207,6 +207,11 @@ public:
   // One option - overload marshal_length to return this value if @a magic is HDR_BUF_MAGIC_MARSHALED.
 
   void inherit_string_heaps(const HdrHeap *inherit_from);
+  /// Copies all the objects of the read-only heap @a s_heap (an unmarshalled header) into this heap
+  /// with a single memcpy, relocates the pointers between them and inherits the string heaps.
+  /// Returns the copy of @a obj, or nullptr if the objects do not fit in the free space of one of
+  /// our chunks and the caller has to copy them one by one.
+  HdrHeapObjImpl *clone_objects(const HdrHeap *s_heap, const HdrHeapObjImpl *obj);
   int  attach_block(IOBufferBlock *b, const char *use_start);
   void set_ronly_str_heap_end(int slot, const char *end);
 
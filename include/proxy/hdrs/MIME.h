@@ -195,6 +195,7 @@ struct MIMEFieldBlockImpl : public HdrHeapObjImpl {
   // Marshaling Functions
   int    marshal(MarshalXlate *ptr_xlate, int num_ptr, MarshalXlate *str_xlate, int num_str);
   void   unmarshal(intptr_t offset);
+  void   relocate(intptr_t offset);
   void   move_strings(HdrStrHeap *new_heap);
   size_t strings_length();
   bool   contains(const MIMEField *field);
@@ -317,6 +318,7 @@ struct MIMEHdrImpl : public HdrHeapObjImpl {
   // Marshaling Functions
   int    marshal(MarshalXlate *ptr_xlate, int num_ptr, MarshalXlate *str_xlate, int num_str);
   void   unmarshal(intptr_t offset);
+  void   relocate(intptr_t offset);
   void   move_strings(HdrStrHeap *new_heap);
   size_t strings_length();
 
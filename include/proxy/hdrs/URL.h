@@ -119,7 +119,15 @@ public:
 private:
 };
 
-using URLHashContext = CryptoContext;
+/// Hash context for URL (cache key) hashes. The algorithm is chosen once, at cache initialization,
+/// and may differ from the global @c CryptoContext::Setting used for other hashes.
+class URLHashContext : public CryptoContext
+{
+public:
+  URLHashContext() : CryptoContext(Setting) {}
+
+  static HashType Setting;
+};
 
 extern const char *URL_SCHEME_FILE;
 extern const char *URL_SCHEME_FTP;
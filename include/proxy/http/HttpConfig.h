@@ -118,6 +118,8 @@ struct HttpStatsBlock {
   Metrics::Counter::AtomicType *extension_method_requests;
   Metrics::Counter::AtomicType *get_requests;
   Metrics::Counter::AtomicType *head_requests;
+  Metrics::Counter::AtomicType *hook_count[TS_SSL_FIRST_HOOK]; ///< Plugin invocations, by hook ID.
+  Metrics::Counter::AtomicType *hook_time[TS_SSL_FIRST_HOOK];  ///< Nanoseconds spent in plugins, by hook ID.
   Metrics::Counter::AtomicType *https_incoming_requests;
   Metrics::Counter::AtomicType *https_total_client_connections;
   Metrics::Counter::AtomicType *incoming_requests;
@@ -167,6 +169,10 @@ struct HttpStatsBlock {
   Metrics::Counter::AtomicType *parent_proxy_request_total_bytes;
   Metrics::Counter::AtomicType *parent_proxy_response_total_bytes;
   Metrics::Counter::AtomicType *parent_proxy_transaction_time;
+  Metrics::Counter::AtomicType *pool_steal_lock_contention;
+  Metrics::Counter::AtomicType *pool_steal_misses;
+  Metrics::Counter::AtomicType *pool_steal_origins_saved;
+  Metrics::Counter::AtomicType *pool_steals;
   Metrics::Gauge::AtomicType   *pooled_server_connections;
   Metrics::Counter::AtomicType *post_body_too_large;
   Metrics::Counter::AtomicType *post_requests;
@@ -492,6 +492,8 @@ private:
 
   /// Update the milestones to track time spent in the plugin API.
   void milestone_update_api_time();
+  /// Update the hook stats when the plugin called for the current hook resumes the transaction.
+  void record_hook_time();
 
   sockaddr *get_server_remote_addr() const;
   int       get_request_method_wksidx() const;
@@ -526,7 +528,9 @@ public:
   int                 server_transact_count = 0;
 
   TransactionMilestones milestones;
-  ink_hrtime            api_timer = 0;
+  ink_hrtime            api_timer     = 0;
+  ink_hrtime            hook_timer    = 0; ///< When the current hook plugin was called, 0 once it resumed.
+  TSHttpHookID          hook_timer_id = TS_HTTP_LAST_HOOK;
   // The next two enable plugins to tag the state machine for
   // the purposes of logging so the instances can be correlated
   // with the source plugin.
@@ -36,6 +36,8 @@
 #include "proxy/PoolableSession.h"
 #include "swoc/IntrusiveHashMap.h"
 
+#include <atomic>
+
 class ProxyTransaction;
 class HttpSM;
 
@@ -74,6 +76,12 @@ public:
   {
     return m_ip_pool.count();
   }
+  /// The number of sessions in the pool, can be read without the pool lock by a thread looking for a session to steal.
+  int
+  idle() const
+  {
+    return m_idle.load(std::memory_order_relaxed);
+  }
 
 private:
   using IPTable   = swoc::IntrusiveHashMap<PoolableSession::IPLinkage>;
@@ -90,10 +98,12 @@ public:
       The session is selected based on @a match_style equivalently to @a match. If found the session
       is removed from the pool.
 
+      If @a migrate is @c true the session is for another thread, and sessions that cannot migrate to it are passed over.
+
       @return A pointer to the session or @c NULL if not matching session was found.
   */
   HSMresult_t acquireSession(sockaddr const *addr, CryptoHash const &host_hash, TSServerSessionSharingMatchMask match_style,
-                             HttpSM *sm, PoolableSession *&server_session);
+                             HttpSM *sm, PoolableSession *&server_session, bool migrate = false);
   /** Release a session to the pool.
    */
   void releaseSession(PoolableSession *ss);
@@ -105,6 +115,9 @@ public:
   // Note that each server session is stored in both pools.
   IPTable   m_ip_pool;
   FQDNTable m_fqdn_pool;
+
+private:
+  std::atomic<int> m_idle{0};
 };
 
 class HttpSessionManager
@@ -134,6 +147,9 @@ private:
   ServerSessionPool             *m_g_pool = nullptr;
   HSMresult_t                    _acquire_session(sockaddr const *ip, CryptoHash const &hostname_hash, HttpSM *sm,
                                                   TSServerSessionSharingMatchMask match_style, TSServerSessionSharingPoolType pool_type);
+  HSMresult_t                    _steal_session(sockaddr const *ip, CryptoHash const &hostname_hash, HttpSM *sm,
+                                                 TSServerSessionSharingMatchMask match_style);
+  bool                           _migrate_session(PoolableSession *ssn, ServerSessionPool *pool, HttpSM *sm, EThread *ethread);
   TSServerSessionSharingPoolType m_pool_type = TS_SERVER_SESSION_SHARING_POOL_THREAD;
 };
 
@@ -897,6 +897,7 @@ public:
 
       ParentConfig::release(parent_params);
       parent_params = nullptr;
+      parent_result.release_load();
 
       hdr_info.client_request.destroy();
       hdr_info.client_response.destroy();
@@ -4,6 +4,7 @@
 
   v1: periodical pre-warming only
   v2: periodical pre-warming + event based pre-warming
+  v3: periodical pre-warming to the predicted demand + event based pre-warming
 
   @section license License
 
@@ -29,6 +30,7 @@
 #include "tscore/ink_assert.h"
 #include "tscore/ink_error.h"
 
+#include <cmath>
 #include <cstdint>
 #include <algorithm>
 
@@ -37,12 +39,15 @@ namespace PreWarm
 enum class Algorithm {
   V1 = 1,
   V2,
+  V3,
 };
 
 inline PreWarm::Algorithm
 algorithm_version(int i)
 {
   switch (i) {
+  case 3:
+    return PreWarm::Algorithm::V3;
   case 2:
     return PreWarm::Algorithm::V2;
   case 1:
@@ -119,4 +124,59 @@ prewarm_size_v2_on_event_interval(uint32_t hit, uint32_t miss, uint32_t current_
   return n;
 }
 
+/**
+   Demand prediction for algorithm v3
+
+   Exponentially weighted moving average of the requests per period.
+
+   @params average  : the prediction for the period that ended
+   @params requests : requests in the period that ended (hit + miss)
+   @params alpha    : weight of the period that ended, (0, 1]
+
+   @return the prediction for the next period
+ */
+inline double
+predict_demand(double average, uint32_t requests, double alpha)
+{
+  return alpha * requests + (1.0 - alpha) * average;
+}
+
+/**
+   Periodical pre-warming for algorithm v3
+
+   Expand the pool size to the predicted demand * @rate. The event based pre-warming handles the hit cases, as in v2.
+
+   @params min : min connections (configured)
+   @params max : max connections (configured), -1 : unlimited
+
+   @return how many connections needs to be pre-warmed for next period
+ */
+inline uint32_t
+prewarm_size_v3_on_event_interval(double predicted, uint32_t current_size, uint32_t min, int32_t max, double rate)
+{
+  return prewarm_size_v1_on_event_interval(static_cast<uint32_t>(std::lround(predicted * rate)), current_size, min, max);
+}
+
+/**
+   Bound @n new connections to what is left of the budget of pre-warmed connections
+
+   @params total_size : connections of all the pools
+   @params budget     : max connections of all the pools, 0 : unlimited
+
+   @return how many of the @n connections can be pre-warmed
+ */
+inline uint32_t
+prewarm_size_within_budget(uint32_t n, uint32_t total_size, uint32_t budget)
+{
+  if (budget == 0) {
+    return n;
+  }
+
+  if (total_size >= budget) {
+    return 0;
+  }
+
+  return std::min(n, budget - total_size);
+}
+
 } // namespace PreWarm
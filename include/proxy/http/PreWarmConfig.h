@@ -31,9 +31,12 @@ struct PreWarmConfigParams : public ConfigInfo {
   PreWarmConfigParams &operator=(const HttpConfigParams &) = delete;
 
   // Config Params
-  int8_t  enabled      = 0;
-  int8_t  algorithm    = 0;
-  int64_t event_period = 0;
+  int8_t  enabled            = 0;
+  int8_t  algorithm          = 0;
+  int64_t event_period       = 0;
+  int64_t max_connections    = 0;
+  float   demand_alpha       = 0;
+  int64_t discover_threshold = 0;
 };
 
 class PreWarmConfig
@@ -53,6 +53,7 @@ using ts::Metrics;
 #include <queue>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 // PreWarm::Dst and PreWarm::SPtrConstDst are defined in iocore.
 namespace PreWarm
@@ -112,12 +113,33 @@ struct Conf {
 using SPtrConstConf = std::shared_ptr<const Conf>;
 using ParsedSNIConf = std::unordered_map<SPtrConstDst, SPtrConstConf, DstHash, DstKeyEqual>;
 
+/**
+   Conf of a tunnel_route with captures or port placeholders. Its destinations are known from traffic only, the pools of
+   the busy ones are made on the fly by algorithm v3.
+ */
+struct DynamicRoute {
+  int32_t        port       = -1; ///< -1 : any port
+  SNIRoutingType type       = SNIRoutingType::NONE;
+  int            alpn_index = SessionProtocolNameRegistry::INVALID;
+  SPtrConstConf  conf;
+
+  bool
+  match(const SPtrConstDst &dst) const
+  {
+    return (port < 0 || port == dst->port) && type == dst->type && alpn_index == dst->alpn_index;
+  }
+};
+
+using DynamicRoutes = std::vector<DynamicRoute>;
+
 enum class CounterStat {
   HIT = 0,
   MISS,
   HANDSHAKE_TIME,
   HANDSHAKE_COUNT,
   RETRY,
+  PREDICTED,
+  HANDSHAKE_TIME_SAVED,
   LAST_ENTRY,
 };
 
@@ -185,7 +207,8 @@ public:
   IOBufferReader *server_buf_reader();
 
   // References
-  bool has_data_from_origin_server() const;
+  bool       has_data_from_origin_server() const;
+  ink_hrtime handshake_time() const;
 
   // NetTimeout
   // TODO: constify
@@ -270,9 +293,19 @@ private:
     PreWarm::SPtrConstConf     conf;
     PreWarm::SPtrConstStatsIds stats_ids;
     Stat                       stat;
+    double                     demand     = 0; ///< predicted requests per period
+    bool                       discovered = false;
+  };
+
+  /// A destination of a dynamic route that has no pool yet
+  struct Candidate {
+    PreWarm::SPtrConstConf conf;
+    uint32_t               requests = 0;
+    double                 demand   = 0;
   };
 
-  using Map = std::unordered_map<PreWarm::SPtrConstDst, Info, PreWarm::DstHash, PreWarm::DstKeyEqual>;
+  using Map          = std::unordered_map<PreWarm::SPtrConstDst, Info, PreWarm::DstHash, PreWarm::DstKeyEqual>;
+  using CandidateMap = std::unordered_map<PreWarm::SPtrConstDst, Candidate, PreWarm::DstHash, PreWarm::DstKeyEqual>;
 
   // construct/destruct PreWarmSM
   void _new_prewarm_sm(const PreWarm::SPtrConstDst &dst, const PreWarm::SPtrConstConf &conf,
@@ -282,6 +315,12 @@ private:
   void _reconfigure();
   void _make_queue_empty(Queue *q);
   void _delete_closed_sm(Queue *q);
+  void _delete_pool(Info &info);
+
+  // pools of the destinations of dynamic routes
+  void _discover(const PreWarm::SPtrConstDst &dst);
+  void _update_candidates();
+  void _drop_idle_discovered_pools();
 
   // hooks for pre-warming pool size algorithm
   void _prewarm_on_event_interval(const PreWarm::SPtrConstDst &dst, const Info &info);
@@ -292,6 +331,11 @@ private:
   //
   PreWarm::Algorithm _algorithm = PreWarm::Algorithm::V1;
 
+  uint32_t _size               = 0; ///< connections of all the pools of this thread
+  uint32_t _budget             = 0; ///< max of _size, 0 : unlimited
+  double   _demand_alpha       = 1.0;
+  uint32_t _discover_threshold = 0;
+
   Event     *_tick_event   = nullptr;
   ink_hrtime _event_period = HRTIME_SECONDS(1);
 
@@ -300,6 +344,9 @@ private:
   DLL<PreWarmSM>         _cop_list;
 
   Map _map;
+
+  PreWarm::DynamicRoutes _dynamic_routes;
+  CandidateMap           _candidates;
 };
 
 /**
@@ -331,10 +378,16 @@ public:
   // References
   const PreWarm::ParsedSNIConf &get_parsed_conf() const;
   const PreWarm::StatsIdMap    &get_stats_id_map() const;
+  const PreWarm::DynamicRoutes &get_dynamic_routes() const;
+
+  /// Stats of the pool of a destination found from traffic
+  PreWarm::SPtrConstStatsIds make_stats_ids(const PreWarm::SPtrConstDst &dst) const;
 
 private:
-  void _parse_sni_conf(PreWarm::ParsedSNIConf &parsed_conf, const SNIConfigParams *sni_conf) const;
+  void _parse_sni_conf(PreWarm::ParsedSNIConf &parsed_conf, PreWarm::DynamicRoutes &dynamic_routes,
+                       const SNIConfigParams *sni_conf) const;
   void _register_stats(const PreWarm::ParsedSNIConf &parsed_conf);
+  PreWarm::SPtrConstStatsIds _make_stats_ids(const PreWarm::SPtrConstDst &dst, int &stats_counter) const;
 
   ////
   // Variables
@@ -344,4 +397,5 @@ private:
 
   PreWarm::ParsedSNIConf _parsed_conf;
   PreWarm::StatsIdMap    _stats_id_map;
+  PreWarm::DynamicRoutes _dynamic_routes;
 };
@@ -43,11 +43,17 @@ class NextHopConsistentHash : public NextHopSelectionStrategy
 {
   std::vector<std::shared_ptr<ATSConsistentHash>> rings;
 
+protected:
   uint64_t getHashKey(uint64_t sm_id, const HttpRequestData &hrdata, ATSHash64 *h);
 
+  // finds the next host to try in a host group, on the hash ring of the group by default.
+  virtual std::shared_ptr<HostRecord> hostLookup(uint32_t cur_ring, ParentResult &result, HttpRequestData &request_info,
+                                                 bool *wrapped, uint64_t sm_id);
+
 public:
-  NHHashKeyType hash_key = NH_PATH_HASH_KEY;
-  NHHashUrlType hash_url = NH_HASH_URL_REQUEST;
+  NHHashKeyType hash_key    = NH_PATH_HASH_KEY;
+  NHHashUrlType hash_url    = NH_HASH_URL_REQUEST;
+  float         load_factor = 0; // > 0 enables consistent hashing with bounded loads
 
   NextHopConsistentHash() = delete;
   NextHopConsistentHash(const std::string_view name, const NHPolicyType &policy, ts::Yaml::Map &n);
@@ -61,11 +61,13 @@ struct NHHealthStatus {
 
 enum NHPolicyType {
   NH_UNDEFINED = 0,
-  NH_FIRST_LIVE,     // first available nexthop
-  NH_RR_STRICT,      // strict round robin
-  NH_RR_IP,          // round robin by client ip.
-  NH_RR_LATCHED,     // latched to available next hop.
-  NH_CONSISTENT_HASH // consistent hashing strategy.
+  NH_FIRST_LIVE,      // first available nexthop
+  NH_RR_STRICT,       // strict round robin
+  NH_RR_IP,           // round robin by client ip.
+  NH_RR_LATCHED,      // latched to available next hop.
+  NH_CONSISTENT_HASH, // consistent hashing strategy.
+  NH_MAGLEV_HASH,     // maglev lookup table strategy.
+  NH_JUMP_HASH        // jump consistent hash strategy.
 };
 
 enum NHSchemeType { NH_SCHEME_NONE = 0, NH_SCHEME_HTTP, NH_SCHEME_HTTPS };
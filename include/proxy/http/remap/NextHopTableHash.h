@@ -0,0 +1,47 @@
+/** @file
+
+  Implementation of the maglev and jump hash nexthop selection strategies.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include "tscore/TableHash.h"
+#include "proxy/http/remap/NextHopConsistentHash.h"
+
+// Selects hosts with a constant time ATSTableHash lookup per host group instead of a hash ring.
+// Hash keys, ring modes and health handling are those of the consistent_hash policy.
+class NextHopTableHash : public NextHopConsistentHash
+{
+  std::vector<std::unique_ptr<ATSTableHash>> tables;
+
+protected:
+  std::shared_ptr<HostRecord> hostLookup(uint32_t cur_ring, ParentResult &result, HttpRequestData &request_info, bool *wrapped,
+                                         uint64_t sm_id) override;
+
+public:
+  uint32_t table_size = ATSTableHash::DEFAULT_TABLE_SIZE; // maglev lookup table size, a prime.
+
+  NextHopTableHash() = delete;
+  NextHopTableHash(const std::string_view name, const NHPolicyType &policy, ts::Yaml::Map &n);
+  ~NextHopTableHash();
+};
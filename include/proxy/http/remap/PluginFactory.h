@@ -34,6 +34,8 @@
 #include "tscore/ink_uuid.h"
 #include "ts/apidefs.h"
 
+class PluginStats;
+
 /**
  * @brief Bundles plugin info + plugin instance data to be used always together.
  */
@@ -62,6 +64,7 @@ public:
   /* Plugin instance = the plugin info + the data returned by the init callback */
   RemapPluginInfo &_plugin;
   void            *_instance = nullptr;
+  PluginStats     *_stats    = nullptr; ///< Time stats of the plugin, if enabled.
 };
 
 /**
@@ -30,6 +30,8 @@
 #include "../../src/iocore/net/P_Net.h"
 #endif
 
+class PluginStats;
+
 enum INKContInternalMagic_t {
   INKCONT_INTERN_MAGIC_ALIVE = 0x00009631,
   INKCONT_INTERN_MAGIC_DEAD  = 0xDEAD9631,
@@ -52,13 +54,15 @@ protected:
   virtual void free();
 
 public:
-  void       *mdata;
-  TSEventFunc m_event_func;
-  int         m_event_count;
-  int         m_closed;
-  int         m_deletable;
-  int         m_deleted;
-  void       *m_context;
+  void        *mdata;
+  TSEventFunc  m_event_func;
+  int          m_event_count;
+  int          m_closed;
+  int          m_deletable;
+  int          m_deleted;
+  bool         m_sync_hook; ///< Resumes the HTTP hook with the handler return value, see TSContSyncHookSet().
+  void        *m_context;
+  PluginStats *m_plugin_stats; ///< Time stats of the plugin that created the continuation, if enabled.
   // INKqa07670: Nokia memory leak bug fix
   INKContInternalMagic_t m_free_magic;
 };
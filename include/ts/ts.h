@@ -1271,6 +1271,19 @@ void TSLifecycleHookAdd(TSLifecycleHookID id, TSCont contp);
    HTTP hooks */
 void TSHttpHookAdd(TSHttpHookID id, TSCont contp);
 
+/**
+    Make @a contp a synchronous HTTP hook. When called for a transaction or session hook, the
+    value returned from the event handler of a synchronous hook resumes the transaction or session
+    in place of TSHttpTxnReenable() or TSHttpSsnReenable(), which must not be called.
+    TS_EVENT_HTTP_ERROR is handled like a reenable with that event, any other value continues.
+
+    Consecutive synchronous hooks are dispatched in one pass without returning to the event loop.
+
+    @param contp The continuation.
+    @param sync @c true to make the hook synchronous, @c false for the default asynchronous hook.
+ */
+void TSContSyncHookSet(TSCont contp, bool sync);
+
 /* --------------------------------------------------------------------------
    HTTP sessions */
 void TSHttpSsnHookAdd(TSHttpSsn ssnp, TSHttpHookID id, TSCont contp);
@@ -1392,6 +1405,38 @@ char *TSHttpTxnEffectiveUrlStringGet(TSHttpTxn txnp, int *length /**< String len
 */
 TSReturnCode TSHttpHdrEffectiveUrlBufGet(TSMBuffer hdr_buf, TSMLoc hdr_loc, char *buf, int64_t size, int64_t *length);
 
+/** Allocate memory that lives as long as the transaction.
+    The memory comes from an arena of the transaction and is released all at once when the
+    transaction is destroyed, after the TS_HTTP_TXN_CLOSE_HOOK. It must not be freed with
+    @c TSfree, and must not be used after the transaction closes. This is much cheaper than
+    @c TSmalloc for the small, short lived allocations done while processing a transaction.
+
+    @param txnp The transaction.
+    @param size Number of bytes, the memory is aligned for any basic type.
+    @return The memory.
+*/
+void *TSHttpTxnArenaAlloc(TSHttpTxn txnp, size_t size);
+
+/** Copy a string to memory that lives as long as the transaction, see TSHttpTxnArenaAlloc().
+
+    @param txnp The transaction.
+    @param str The string to copy.
+    @param length Length of @a str, or -1 if @a str is null terminated.
+    @return The null terminated copy.
+*/
+char *TSHttpTxnArenaStrdup(TSHttpTxn txnp, const char *str, int64_t length);
+
+/** Get the string of a URL, like TSUrlStringGet(), in memory that lives as long as the
+    transaction, see TSHttpTxnArenaAlloc(). The string must not be freed.
+
+    @param txnp The transaction.
+    @param bufp marshal buffer containing the URL, may be @c nullptr.
+    @param offset location of the URL within bufp.
+    @param length Returns the length of the URL string.
+    @return The null terminated URL string.
+*/
+char *TSHttpTxnArenaUrlStringGet(TSHttpTxn txnp, TSMBuffer bufp, TSMLoc offset, int *length);
+
 void TSHttpTxnRespCacheableSet(TSHttpTxn txnp, int flag);
 void TSHttpTxnReqCacheableSet(TSHttpTxn txnp, int flag);
 
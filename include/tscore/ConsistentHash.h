@@ -23,9 +23,10 @@
 
 #include <atomic>
 #include "tscore/Hash.h"
+#include <cstddef>
 #include <cstdint>
 #include <iostream>
-#include <map>
+#include <vector>
 
 /*
   Helper class to be extended to make ring nodes.
@@ -34,16 +35,23 @@
 struct ATSConsistentHashNode {
   std::atomic<bool> available{true};
   char             *name{nullptr};
+  std::atomic<int>  load{0}; // live connections, only maintained by users of bounded load lookups
 };
 
 std::ostream &operator<<(std::ostream &os, ATSConsistentHashNode &thing);
 
-using ATSConsistentHashIter = std::map<uint64_t, ATSConsistentHashNode *>::iterator;
+// Position on the ring, an index into the sorted ring arrays. A plain integer, so it can be
+// zero initialized along with the structures that hold it.
+using ATSConsistentHashIter = size_t;
 
 /*
   TSConsistentHash requires a TSHash64 object
 
   Caller is responsible for freeing ring node memory.
+
+  The ring is kept as a sorted array of hash values, with a parallel array of nodes, so that a
+  lookup is a binary search over contiguous memory rather than a walk of a tree of pointers.
+  All nodes must be inserted before any lookups are done.
  */
 
 struct ATSConsistentHash {
@@ -54,10 +62,41 @@ struct ATSConsistentHash {
   ATSConsistentHashNode *lookup_available(const char *url = nullptr, ATSConsistentHashIter *i = nullptr, bool *w = nullptr,
                                           ATSHash64 *h = nullptr);
   ATSConsistentHashNode *lookup_by_hashval(uint64_t hashval, ATSConsistentHashIter *i = nullptr, bool *w = nullptr);
+
+  /*
+    Consistent hashing with bounded loads. Like lookup_by_hashval(), but nodes whose load is at
+    or above @a factor times the average load of the ring are passed over. If every node is
+    that loaded, the node lookup_by_hashval() would return is used.
+
+    acquire() and release() maintain the loads, each acquire() must be matched by a release().
+   */
+  ATSConsistentHashNode *lookup_bounded(uint64_t hashval, float factor, ATSConsistentHashIter *i = nullptr, bool *w = nullptr);
+  void                   acquire(ATSConsistentHashNode *node);
+  void                   release(ATSConsistentHashNode *node);
+
   ~ATSConsistentHash();
 
 private:
-  int                                         replicas;
-  ATSHash64                                  *hash;
-  std::map<uint64_t, ATSConsistentHashNode *> NodeMap;
+  size_t lower_bound(uint64_t hashval) const;
+
+  int                                  replicas;
+  ATSHash64                           *hash;
+  std::vector<uint64_t>                keys;  // sorted ring positions
+  std::vector<ATSConsistentHashNode *> nodes; // node at each ring position
+  size_t                               members = 0;
+  std::atomic<int64_t>                 total_load{0};
 };
+
+inline void
+ATSConsistentHash::acquire(ATSConsistentHashNode *node)
+{
+  ++node->load;
+  ++total_load;
+}
+
+inline void
+ATSConsistentHash::release(ATSConsistentHashNode *node)
+{
+  --node->load;
+  --total_load;
+}
@@ -149,7 +149,19 @@ public:
     EVP_MD_CTX *_ctx = nullptr;
   };
 
+  enum HashType {
+    UNSPECIFIED,
+#if TS_ENABLE_FIPS == 0
+    MD5,
+#endif
+    SHA256,
+    MURMUR3, ///< Fast, non-cryptographic. Only for keys that need not resist deliberate collisions.
+  }; ///< What type of hash we really are.
+  static HashType Setting;
+
   CryptoContext();
+  /// Use the hash @a type rather than the global @c Setting.
+  explicit CryptoContext(HashType type);
 
   /// Update the hash with @a data of @a length bytes.
   bool update(void const *data, int length);
@@ -162,15 +174,6 @@ public:
   /// Finalize and extract the @a hash.
   bool finalize(CryptoHash &hash);
 
-  enum HashType {
-    UNSPECIFIED,
-#if TS_ENABLE_FIPS == 0
-    MD5,
-#endif
-    SHA256,
-  }; ///< What type of hash we really are.
-  static HashType Setting;
-
   ~CryptoContext();
 
 private:
@@ -0,0 +1,54 @@
+/** @file
+
+  MurmurHash3 (x64, 128 bit) support class.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include "tscore/ink_defs.h"
+#include "tscore/CryptoHash.h"
+
+/**
+  Incremental MurmurHash3, the x64 128 bit variant, with a zero seed.
+
+  This is not a cryptographic hash, but it is an order of magnitude cheaper than MD5 or SHA256
+  and has good distribution, which makes it suitable for cache keys where the cost of hashing
+  every URL matters more than resistance to deliberately constructed collisions. Like MMH, the
+  output is only stable across machines of the same endianness.
+*/
+class MurmurHash3Context : public ts::CryptoContext::Hasher
+{
+public:
+  MurmurHash3Context() = default;
+  /// Update the hash with @a data of @a length bytes.
+  bool update(void const *data, int length) override;
+  /// Finalize and extract the @a hash.
+  bool finalize(CryptoHash &hash) override;
+
+private:
+  void block(uint8_t const *data);
+
+  uint64_t _h1          = 0;
+  uint64_t _h2          = 0;
+  uint64_t _length      = 0; ///< Total number of bytes hashed.
+  int      _buffer_size = 0; ///< Bytes of a partial block carried between updates.
+  uint8_t  _buffer[16];
+};
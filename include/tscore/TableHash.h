@@ -0,0 +1,87 @@
+/** @file
+
+  Maglev and jump consistent hash node selection.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include "tscore/ConsistentHash.h"
+#include <cstdint>
+#include <vector>
+
+/*
+  Selects a node for a hash value in constant time, as an alternative to the ring of
+  ATSConsistentHash.
+
+  MAGLEV fills a lookup table of a prime size from a per node permutation of its slots (Eisenbud et
+  al., "Maglev: A Fast and Reliable Software Network Load Balancer"), nodes get a share of the table
+  proportional to their weight. JUMP uses the jump consistent hash of Lamping and Veach, it needs no
+  table but ignores node weights, and a node can only be removed with minimal disruption from the
+  end of the node list.
+
+  A node that can not be used is not removed, so the choice for every other hash value is
+  unchanged. Instead each hash value has a fallback sequence: attempt 0 is the node chosen by the
+  algorithm, later attempts step through the other nodes from a start and stride chosen by the
+  hash value, so the hash values of an unusable node are spread evenly over the rest of the nodes,
+  and every node is visited once in the first size() attempts.
+
+  Caller is responsible for freeing node memory. All nodes must be inserted, and build() called,
+  before any lookups are done.
+ */
+
+struct ATSTableHash {
+  enum Algorithm { MAGLEV, JUMP };
+
+  static constexpr uint32_t DEFAULT_TABLE_SIZE = 65537;
+
+  // The MAGLEV @a table_size is rounded up to a prime.
+  ATSTableHash(Algorithm a = MAGLEV, uint32_t table_size = DEFAULT_TABLE_SIZE, ATSHash64 *h = nullptr);
+  void                   insert(ATSConsistentHashNode *node, float weight = 1.0, ATSHash64 *h = nullptr);
+  void                   build();
+  ATSConsistentHashNode *lookup_by_hashval(uint64_t hashval, uint32_t attempt = 0) const;
+
+  size_t
+  size() const
+  {
+    return nodes.size();
+  }
+
+  uint32_t
+  table_size() const
+  {
+    return algorithm == MAGLEV ? static_cast<uint32_t>(table.size()) : 0;
+  }
+
+  static int32_t  jump(uint64_t key, int32_t buckets);
+  static uint32_t next_prime(uint32_t n);
+
+  ~ATSTableHash();
+
+private:
+  Algorithm                            algorithm;
+  uint32_t                             slots;
+  ATSHash64                           *hash;
+  std::vector<ATSConsistentHashNode *> nodes;
+  std::vector<uint64_t>                node_hashes;
+  std::vector<float>                   weights;
+  std::vector<uint32_t>                table;   // MAGLEV slot to node index
+  std::vector<uint32_t>                strides; // fallback strides, coprime to the number of other nodes
+};
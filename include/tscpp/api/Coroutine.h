@@ -0,0 +1,403 @@
+/**
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+/**
+ * @file Coroutine.h
+ * @brief C++20 coroutines that wait for TS API events without blocking the event thread.
+ */
+
+// The C++ Plugin API is deprecated in ATS 10, and will be removed in ATS 11.
+
+#pragma once
+
+#include <coroutine>
+#include <string_view>
+#include <utility>
+
+#include <ts/ts.h>
+
+namespace atscppapi
+{
+class Awaiter;
+
+/**
+ * @brief The return type of a coroutine that runs on the event threads.
+ *
+ * The coroutine starts when it is called and runs until its first co_await, where it returns to
+ * its caller. It is resumed by the event it waits for, under the mutex of its continuation, on the
+ * thread that called it for all the operations that support thread affinity. Its frame is freed when
+ * it returns.
+ *
+ * Nothing is allocated for a co_await: the awaiters are in the frame of the coroutine, and a single
+ * continuation is created by the first co_await and reused by the following ones.
+ *
+ * If a parameter of the coroutine is a TSHttpTxn, the coroutine holds that transaction. The hook that
+ * called the coroutine must not reenable the transaction, the coroutine reenables it when it waits for
+ * another hook with Hook, when it awaits Reenable, or when it returns.
+ *
+ * @code
+ * atscppapi::Task
+ * handleRequest(TSHttpTxn txn)
+ * {
+ *   co_await atscppapi::Sleep(10);
+ *   co_await atscppapi::Hook(txn, TS_HTTP_SEND_RESPONSE_HDR_HOOK);
+ *   // Modify the response.
+ * }
+ * @endcode
+ *
+ * A coroutine can wait for one operation at a time, and the operation must send a single event to
+ * the continuation, except for the VIOs of VConnRead and VConnWrite, which are followed with NextEvent.
+ */
+class Task
+{
+public:
+  class promise_type
+  {
+  public:
+    promise_type() = default;
+
+    template <typename... Args> explicit promise_type(Args &...args) { (_bind(args), ...); }
+
+    ~promise_type();
+
+    // No copying.
+    promise_type(const promise_type &)            = delete;
+    promise_type &operator=(const promise_type &) = delete;
+
+    Task
+    get_return_object() noexcept
+    {
+      return {};
+    }
+
+    std::suspend_never
+    initial_suspend() noexcept
+    {
+      return {};
+    }
+
+    std::suspend_never
+    final_suspend() noexcept
+    {
+      return {};
+    }
+
+    void
+    return_void() noexcept
+    {
+    }
+
+    void unhandled_exception() noexcept;
+
+    // The continuation of the coroutine, created on first use.
+    //
+    TSCont cont();
+
+    // Hold @a txn, after reenabling the transaction held so far, which may be @a txn.
+    //
+    void hold(TSHttpTxn txn);
+
+    // Reenable the held transaction with @a event, if any.
+    //
+    void reenable(TSEvent event = TS_EVENT_HTTP_CONTINUE);
+
+  private:
+    friend class Awaiter;
+    friend class NextEvent;
+
+    void
+    _bind(TSHttpTxn txn)
+    {
+      if (_txn == nullptr) {
+        _txn = txn;
+      }
+    }
+
+    template <typename T>
+    void
+    _bind(T const &)
+    {
+    }
+
+    static int _handleEvent(TSCont cont, TSEvent event, void *edata);
+
+    TSCont    _cont     = nullptr;
+    TSHttpTxn _txn      = nullptr;
+    Awaiter  *_waiting  = nullptr; ///< The awaiter resumed by the next event.
+    bool      _starting = false;   ///< The awaiter is starting its operation, do not resume.
+
+    // An event sent while the coroutine was not waiting, e.g. by a VIO reenabled by the coroutine.
+    TSEvent _pending_event = TS_EVENT_NONE;
+    void   *_pending_edata = nullptr;
+  };
+};
+
+/**
+ * @brief Base of the awaiters that start an operation, and wait for the event it sends to the
+ * continuation of the coroutine.
+ */
+class Awaiter
+{
+public:
+  bool
+  await_ready() const noexcept
+  {
+    return false;
+  }
+
+  // Returns false, to continue without suspending, if the event was sent before the operation returned.
+  //
+  bool await_suspend(std::coroutine_handle<Task::promise_type> handle);
+
+protected:
+  ~Awaiter() = default;
+
+  // Start the operation, which sends an event to promise.cont().
+  //
+  virtual void _start(Task::promise_type &promise) = 0;
+
+  TSEvent _event = TS_EVENT_NONE;
+  void   *_edata = nullptr;
+
+private:
+  friend class Task::promise_type;
+};
+
+/**
+ * @brief Wait for @a timeout milliseconds, or for the next turn of the event loop if it is zero.
+ */
+class Sleep : public Awaiter
+{
+public:
+  explicit Sleep(TSHRTime timeout) : _timeout(timeout) {}
+
+  void
+  await_resume() const noexcept
+  {
+  }
+
+private:
+  void _start(Task::promise_type &promise) override;
+
+  TSHRTime _timeout;
+};
+
+/**
+ * @brief Wait for the hook @a id of the transaction @a txn. The transaction held by the coroutine is
+ * reenabled, and @a txn is held when the coroutine is resumed.
+ */
+class Hook : public Awaiter
+{
+public:
+  Hook(TSHttpTxn txn, TSHttpHookID id) : _txn(txn), _id(id) {}
+
+  TSEvent
+  await_resume() const noexcept
+  {
+    return _event;
+  }
+
+private:
+  void _start(Task::promise_type &promise) override;
+
+  TSHttpTxn    _txn;
+  TSHttpHookID _id;
+};
+
+/**
+ * @brief Reenable the transaction held by the coroutine with @a event, without suspending. The
+ * coroutine does not hold a transaction afterwards.
+ */
+class Reenable
+{
+public:
+  explicit Reenable(TSEvent event = TS_EVENT_HTTP_CONTINUE) : _event(event) {}
+
+  bool
+  await_ready() const noexcept
+  {
+    return false;
+  }
+
+  bool
+  await_suspend(std::coroutine_handle<Task::promise_type> handle)
+  {
+    handle.promise().reenable(_event);
+    return false;
+  }
+
+  void
+  await_resume() const noexcept
+  {
+  }
+
+private:
+  TSEvent _event;
+};
+
+/**
+ * @brief Connect to @a addr, the result is the connected TSVConn, or nullptr if the connection failed.
+ */
+class NetConnect : public Awaiter
+{
+public:
+  explicit NetConnect(sockaddr const *addr) : _addr(addr) {}
+
+  TSVConn
+  await_resume() const noexcept
+  {
+    return _event == TS_EVENT_NET_CONNECT ? static_cast<TSVConn>(_edata) : nullptr;
+  }
+
+private:
+  void _start(Task::promise_type &promise) override;
+
+  sockaddr const *_addr;
+};
+
+/**
+ * @brief Open the cache object of @a key for reading, the result is the cache TSVConn, or nullptr for
+ * a miss.
+ */
+class CacheRead : public Awaiter
+{
+public:
+  explicit CacheRead(TSCacheKey key) : _key(key) {}
+
+  TSVConn
+  await_resume() const noexcept
+  {
+    return _event == TS_EVENT_CACHE_OPEN_READ ? static_cast<TSVConn>(_edata) : nullptr;
+  }
+
+private:
+  void _start(Task::promise_type &promise) override;
+
+  TSCacheKey _key;
+};
+
+/**
+ * @brief Open the cache object of @a key for writing, the result is the cache TSVConn, or nullptr if
+ * it could not be opened.
+ */
+class CacheWrite : public Awaiter
+{
+public:
+  explicit CacheWrite(TSCacheKey key) : _key(key) {}
+
+  TSVConn
+  await_resume() const noexcept
+  {
+    return _event == TS_EVENT_CACHE_OPEN_WRITE ? static_cast<TSVConn>(_edata) : nullptr;
+  }
+
+private:
+  void _start(Task::promise_type &promise) override;
+
+  TSCacheKey _key;
+};
+
+/**
+ * @brief Start a read VIO of @a nbytes from @a vc into @a buffer, the result is its first event.
+ * Await NextEvent for the following events.
+ */
+class VConnRead : public Awaiter
+{
+public:
+  VConnRead(TSVConn vc, TSIOBuffer buffer, int64_t nbytes) : _vc(vc), _buffer(buffer), _nbytes(nbytes) {}
+
+  TSEvent
+  await_resume() const noexcept
+  {
+    return _event;
+  }
+
+private:
+  void _start(Task::promise_type &promise) override;
+
+  TSVConn    _vc;
+  TSIOBuffer _buffer;
+  int64_t    _nbytes;
+};
+
+/**
+ * @brief Start a write VIO of @a nbytes from @a reader to @a vc, the result is its first event.
+ * Await NextEvent for the following events.
+ */
+class VConnWrite : public Awaiter
+{
+public:
+  VConnWrite(TSVConn vc, TSIOBufferReader reader, int64_t nbytes) : _vc(vc), _reader(reader), _nbytes(nbytes) {}
+
+  TSEvent
+  await_resume() const noexcept
+  {
+    return _event;
+  }
+
+private:
+  void _start(Task::promise_type &promise) override;
+
+  TSVConn          _vc;
+  TSIOBufferReader _reader;
+  int64_t          _nbytes;
+};
+
+/**
+ * @brief Wait for the next event sent to the continuation of the coroutine by an operation already
+ * started, e.g. a VIO. The result is the event, and its data.
+ */
+class NextEvent : public Awaiter
+{
+public:
+  // Continue without suspending if an event was sent since the last co_await.
+  //
+  bool await_suspend(std::coroutine_handle<Task::promise_type> handle);
+
+  std::pair<TSEvent, void *>
+  await_resume() const noexcept
+  {
+    return {_event, _edata};
+  }
+
+private:
+  void
+  _start(Task::promise_type &) override
+  {
+  }
+};
+
+/**
+ * @brief Send the HTTP request @a request to @a addr with the fetch API. The result is the response,
+ * header and body, or empty if the fetch failed or timed out. It is valid until the next co_await.
+ */
+class FetchUrl : public Awaiter
+{
+public:
+  FetchUrl(std::string_view request, sockaddr const *addr) : _request(request), _addr(addr) {}
+
+  std::string_view await_resume() const noexcept;
+
+private:
+  void _start(Task::promise_type &promise) override;
+
+  std::string_view _request;
+  sockaddr const  *_addr;
+};
+
+} // end namespace atscppapi
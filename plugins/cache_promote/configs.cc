@@ -34,6 +34,7 @@ static const struct option longopt[] = {
   {const_cast<char *>("hits"),                 required_argument, nullptr, 'h' },
   {const_cast<char *>("bytes"),                required_argument, nullptr, 'B' },
   {const_cast<char *>("label"),                required_argument, nullptr, 'l' },
+  {const_cast<char *>("shards"),               required_argument, nullptr, 'S' },
   {const_cast<char *>("internal-enabled"),     no_argument,       nullptr, 'i' },
   // EOF
   {nullptr,                                    no_argument,       nullptr, '\0'},
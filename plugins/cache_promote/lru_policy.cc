@@ -17,12 +17,10 @@
 */
 #include <unistd.h>
 #include <cinttypes>
+#include <algorithm>
 
 #include "lru_policy.h"
 
-#define MINIMUM_BUCKET_SIZE 10
-static LRUEntry NULL_LRU_ENTRY; // Used to create an "empty" new LRUEntry
-
 // Initialize the LRU hash key from the TXN's URL
 bool
 LRUHash::initFromUrl(TSHttpTxn txnp)
@@ -42,19 +40,7 @@ LRUHash::initFromUrl(TSHttpTxn txnp)
       char *url     = TSUrlStringGet(reqp, c_url, &url_len);
 
       if (url && url_len > 0) {
-        // SHA1() is deprecated on OpenSSL 3, but it's faster than its replacement.
-#ifdef HAVE_SHA1
-#pragma GCC diagnostic push
-#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
-        SHA_CTX sha;
-
-        SHA1_Init(&sha);
-        SHA1_Update(&sha, url, url_len);
-        SHA1_Final(_hash, &sha);
-#pragma GCC diagnostic pop
-#else
-        EVP_Digest(url, url_len, _hash, nullptr, EVP_sha1(), nullptr);
-#endif
+        init(url, url_len);
         DBG("LRUHash::initFromUrl(%.*s%s)", url_len > 100 ? 100 : url_len, url, url_len > 100 ? "..." : "");
         TSfree(url);
         ret = true;
@@ -67,19 +53,26 @@ LRUHash::initFromUrl(TSHttpTxn txnp)
   return ret;
 }
 
-LRUPolicy::~LRUPolicy()
+// Find and lock the shard for a hash, counting how often the lock was already held
+LRUShard &
+LRUPolicy::lockShard(const LRUHash &hash)
 {
-  DBG("LRUPolicy DTOR");
-  TSMutexLock(_lock);
+  LRUShard &shard = _shards[hash.shard(_num_shards)];
+
+  if (TS_SUCCESS != TSMutexLockTry(shard.lock)) {
+    incrementStat(_lru_contention_id, 1);
+    TSMutexLock(shard.lock);
+  }
 
-  _map.clear();
-  _list.clear();
-  _list_size = 0;
-  _freelist.clear();
-  _freelist_size = 0;
+  return shard;
+}
 
-  TSMutexUnlock(_lock);
-  TSMutexDestroy(_lock);
+// Never more shards than buckets, so that every shard holds at least one
+void
+LRUPolicy::setShards(unsigned num_shards)
+{
+  _num_shards = std::min(num_shards, _buckets);
+  _shards     = std::make_unique<LRUShard[]>(_num_shards);
 }
 
 bool
@@ -93,6 +86,10 @@ LRUPolicy::parseOption(int opt, char *optarg)
       DBG("enforcing minimum bucket size of %d", MINIMUM_BUCKET_SIZE);
       _buckets = MINIMUM_BUCKET_SIZE;
     }
+    if (_num_shards > _buckets) {
+      TSError("%s: Enforcing at most one LRU shard per bucket", PLUGIN_NAME);
+      setShards(_buckets);
+    }
     break;
   case 'h':
     _hits = static_cast<unsigned>(strtol(optarg, nullptr, 10));
@@ -103,6 +100,19 @@ LRUPolicy::parseOption(int opt, char *optarg)
   case 'l':
     _label = optarg;
     break;
+  case 'S':
+  {
+    unsigned num_shards = static_cast<unsigned>(strtol(optarg, nullptr, 10));
+
+    if (num_shards < 1 || num_shards > MAXIMUM_SHARDS) {
+      TSError("%s: Enforcing LRU shards between 1 and %d", PLUGIN_NAME, MAXIMUM_SHARDS);
+      num_shards = std::clamp(num_shards, 1U, static_cast<unsigned>(MAXIMUM_SHARDS));
+    }
+    if (num_shards > _buckets) {
+      TSError("%s: Enforcing at most one LRU shard per bucket", PLUGIN_NAME);
+    }
+    setShards(num_shards);
+  } break;
   default:
     // All other options are unsupported for this policy
     return false;
@@ -126,12 +136,11 @@ LRUPolicy::doPromote(TSHttpTxn txnp)
     return false;
   }
 
-  // We have to hold the lock across all list and hash access / updates
-  TSMutexLock(_lock);
+  // We have to hold the shard lock across all list and hash access / updates
+  LRUShard &shard = lockShard(hash);
 
-  map_it = _map.find(&hash);
-  if (_map.end() != map_it) {
-    auto &[map_key, map_val]             = *map_it;
+  map_it = shard.map.find(&hash);
+  if (shard.map.end() != map_it) {
     auto &[val_key, val_hits, val_bytes] = *(map_it->second);
     bool      cacheable                  = false;
     TSMBuffer request;
@@ -160,16 +169,13 @@ LRUPolicy::doPromote(TSHttpTxn txnp)
     }
 
     // We have an entry in the LRU
-    TSAssert(_list_size > 0); // mismatch in the LRUs hash and list, shouldn't happen
+    TSAssert(shard.list_size > 0); // mismatch in the LRUs hash and list, shouldn't happen
     incrementStat(_lru_hit_id, 1);
     ++val_hits; // Increment hits, bytes are incremented elsewhere
     if (cacheable && (val_hits >= _hits || (_bytes > 0 && val_bytes > _bytes))) {
       // Promoted! Cleanup the LRU, and signal success. Save the promoted entry on the freelist.
       DBG("saving the LRUEntry to the freelist");
-      _freelist.splice(_freelist.begin(), _list, map_val);
-      ++_freelist_size;
-      --_list_size;
-      _map.erase(map_key);
+      shard.promote(map_it);
       incrementStat(_promoted_id, 1);
       incrementStat(_freelist_size_id, 1);
       decrementStat(_lru_size_id, 1);
@@ -177,35 +183,29 @@ LRUPolicy::doPromote(TSHttpTxn txnp)
     } else {
       // It's still not promoted, make sure it's moved to the front of the list
       DBG("still not promoted, got %d hits so far and %" PRId64 " bytes", val_hits, val_bytes);
-      _list.splice(_list.begin(), _list, map_val);
+      shard.touch(map_it);
     }
   } else {
     // New LRU entry for the URL, try to repurpose the list entry as much as possible
     incrementStat(_lru_miss_id, 1);
-    if (_list_size >= _buckets) {
-      DBG("repurposing last LRUHash entry");
-      _list.splice(_list.begin(), _list, --_list.end());
-      _map.erase(&(std::get<0>(*_list.begin()))); // Get the hash from the first list element
+    switch (shard.insert(hash, shardBuckets(_buckets, _num_shards, &shard - _shards.get()))) {
+    case LRUShard::Slot::VACATED:
+      DBG("repurposed last LRUHash entry");
       incrementStat(_lru_vacated_id, 1);
-    } else if (_freelist_size > 0) {
-      DBG("reusing LRUEntry from freelist");
-      _list.splice(_list.begin(), _freelist, _freelist.begin());
-      --_freelist_size;
-      ++_list_size;
+      break;
+    case LRUShard::Slot::REUSED:
+      DBG("reused LRUEntry from freelist");
       incrementStat(_lru_size_id, 1);
       decrementStat(_freelist_size_id, 1);
-    } else {
-      DBG("creating new LRUEntry");
-      _list.push_front(NULL_LRU_ENTRY);
-      ++_list_size;
+      break;
+    case LRUShard::Slot::CREATED:
+      DBG("created new LRUEntry");
       incrementStat(_lru_size_id, 1);
+      break;
     }
-    // Update the "new" LRUEntry and add it to the hash
-    *_list.begin()                       = {hash, 1, 0};
-    _map[&(std::get<0>(*_list.begin()))] = _list.begin();
   }
 
-  TSMutexUnlock(_lock);
+  TSMutexUnlock(shard.lock);
 
   // If we didn't promote, and we want to count bytes, save away the calculated hash for later use
   if (false == ret && countBytes()) {
@@ -225,10 +225,11 @@ LRUPolicy::addBytes(TSHttpTxn txnp)
   if (hash) {
     LRUMap::iterator map_it;
 
-    // We have to hold the lock across all list and hash access / updates
-    TSMutexLock(_lock);
-    map_it = _map.find(hash);
-    if (_map.end() != map_it) {
+    // We have to hold the shard lock across all list and hash access / updates
+    LRUShard &shard = lockShard(*hash);
+
+    map_it = shard.map.find(hash);
+    if (shard.map.end() != map_it) {
       TSMBuffer resp;
       TSMLoc    resp_hdr;
 
@@ -249,7 +250,7 @@ LRUPolicy::addBytes(TSHttpTxn txnp)
         TSHandleMLocRelease(resp, TS_NULL_MLOC, resp_hdr);
       }
     }
-    TSMutexUnlock(_lock);
+    TSMutexUnlock(shard.lock);
   }
 }
 
@@ -259,14 +260,15 @@ LRUPolicy::stats_add(const char *remap_id)
 {
   std::string_view                          remap_identifier = remap_id;
   const std::tuple<std::string_view, int *> stats[]          = {
-    {"cache_hits",     &_cache_hits_id    },
-    {"freelist_size",  &_freelist_size_id },
-    {"lru_size",       &_lru_size_id      },
-    {"lru_hit",        &_lru_hit_id       },
-    {"lru_miss",       &_lru_miss_id      },
-    {"lru_vacated",    &_lru_vacated_id   },
-    {"promoted",       &_promoted_id      },
-    {"total_requests", &_total_requests_id},
+    {"cache_hits",          &_cache_hits_id    },
+    {"freelist_size",       &_freelist_size_id },
+    {"lru_size",            &_lru_size_id      },
+    {"lru_hit",             &_lru_hit_id       },
+    {"lru_miss",            &_lru_miss_id      },
+    {"lru_vacated",         &_lru_vacated_id   },
+    {"lru_lock_contention", &_lru_contention_id},
+    {"promoted",            &_promoted_id      },
+    {"total_requests",      &_total_requests_id},
   };
 
   if (nullptr == remap_id) {
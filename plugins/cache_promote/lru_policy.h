@@ -23,7 +23,9 @@
 #ifndef HAVE_SHA1
 #include <openssl/evp.h>
 #endif
+#include <algorithm>
 #include <cstring>
+#include <memory>
 #include <unordered_map>
 #include <list>
 #include <tuple>
@@ -31,6 +33,7 @@
 #include "policy.h"
 
 #define MINIMUM_BUCKET_SIZE 10
+#define MAXIMUM_SHARDS      256
 
 //////////////////////////////////////////////////////////////////////////////////////////////
 // The LRU based policy keeps track of <bucket> number of URLs, with a counter for each slot.
@@ -38,6 +41,13 @@
 // optional <chance> parameter can be used to sample hits, this can reduce contention and
 // churning in the LRU as well.
 //
+// The LRU can optionally be split into <shards> independent LRUs, each with its own lock. A URL
+// always maps to the same shard, so the promotion criteria per URL are unchanged, but requests
+// for unrelated URLs no longer serialize on a single mutex. The <bucket> count is divided
+// across the shards, the first <bucket> % <shards> of them getting one extra, so the shards
+// together hold exactly the configured number of buckets. There are never more shards than
+// buckets.
+//
 class LRUHash
 {
   friend struct LRUHashHasher;
@@ -65,6 +75,35 @@ public:
   // Initialize the hash key from the TXN's URL
   bool initFromUrl(TSHttpTxn txnp);
 
+  // Initialize the hash key from a URL string
+  void
+  init(const char *url, int url_len)
+  {
+    // SHA1() is deprecated on OpenSSL 3, but it's faster than its replacement.
+#ifdef HAVE_SHA1
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wdeprecated-declarations"
+    SHA_CTX sha;
+
+    SHA1_Init(&sha);
+    SHA1_Update(&sha, url, url_len);
+    SHA1_Final(_hash, &sha);
+#pragma GCC diagnostic pop
+#else
+    EVP_Digest(url, url_len, _hash, nullptr, EVP_sha1(), nullptr);
+#endif
+  }
+
+  // Pick a shard, using hash bytes that are not part of the LRUHashHasher value
+  unsigned
+  shard(unsigned num_shards) const
+  {
+    uint32_t val;
+
+    memcpy(&val, _hash + SHA_DIGEST_LENGTH - sizeof(val), sizeof(val));
+    return val % num_shards;
+  }
+
 private:
   u_char _hash[SHA_DIGEST_LENGTH];
 };
@@ -87,11 +126,87 @@ using LRUEntry = std::tuple<LRUHash, unsigned, int64_t>;
 using LRUList  = std::list<LRUEntry>;
 using LRUMap   = std::unordered_map<const LRUHash *, LRUList::iterator, LRUHashHasher, LRUHashHasher>;
 
+// One independently locked LRU. Note that we keep track of the List sizes, because some versions
+// fo STL have broken implementations of size(), making them obsessively slow on calling ::size().
+// The caller holds the lock around all of the methods below.
+struct LRUShard {
+  // How insert() found the list entry for a new URL
+  enum class Slot { VACATED, REUSED, CREATED };
+
+  LRUShard() : lock(TSMutexCreate()) {}
+  ~LRUShard()
+  {
+    TSMutexLock(lock);
+
+    map.clear();
+    list.clear();
+    list_size = 0;
+    freelist.clear();
+    freelist_size = 0;
+
+    TSMutexUnlock(lock);
+    TSMutexDestroy(lock);
+  }
+
+  LRUShard(const LRUShard &)            = delete;
+  LRUShard &operator=(const LRUShard &) = delete;
+
+  // Add a URL at the head with one hit. When the shard already holds max_size entries the tail
+  // entry is vacated for it, otherwise a freelist entry is reused or a new one created.
+  Slot
+  insert(const LRUHash &hash, size_t max_size)
+  {
+    Slot slot;
+
+    if (list_size >= max_size) {
+      list.splice(list.begin(), list, --list.end());
+      map.erase(&(std::get<0>(*list.begin()))); // Get the hash from the first list element
+      slot = Slot::VACATED;
+    } else if (freelist_size > 0) {
+      list.splice(list.begin(), freelist, freelist.begin());
+      --freelist_size;
+      ++list_size;
+      slot = Slot::REUSED;
+    } else {
+      list.emplace_front();
+      ++list_size;
+      slot = Slot::CREATED;
+    }
+    // Update the "new" LRUEntry and add it to the hash
+    *list.begin()                      = {hash, 1, 0};
+    map[&(std::get<0>(*list.begin()))] = list.begin();
+
+    return slot;
+  }
+
+  // Move an entry to the head of the LRU
+  void
+  touch(LRUMap::iterator map_it)
+  {
+    list.splice(list.begin(), list, map_it->second);
+  }
+
+  // Remove a promoted entry from the LRU, saving it on the freelist
+  void
+  promote(LRUMap::iterator map_it)
+  {
+    freelist.splice(freelist.begin(), list, map_it->second);
+    ++freelist_size;
+    --list_size;
+    map.erase(map_it);
+  }
+
+  TSMutex lock;
+  LRUMap  map;
+  LRUList list, freelist;
+  size_t  list_size = 0, freelist_size = 0;
+};
+
 class LRUPolicy : public PromotionPolicy
 {
 public:
-  LRUPolicy() : PromotionPolicy(), _lock(TSMutexCreate()) {}
-  ~LRUPolicy() override;
+  LRUPolicy() : PromotionPolicy(), _shards(std::make_unique<LRUShard[]>(_num_shards)) {}
+  ~LRUPolicy() override = default;
 
   bool parseOption(int opt, char *optarg) override;
   bool doPromote(TSHttpTxn txnp) override;
@@ -107,8 +222,8 @@ public:
   void
   usage() const override
   {
-    TSError("[%s] Usage: @plugin=%s.so @pparam=--policy=lru @pparam=--buckets=<m> --hits=<n> --bytes=<o> --sample=<p>", PLUGIN_NAME,
-            PLUGIN_NAME);
+    TSError("[%s] Usage: @plugin=%s.so @pparam=--policy=lru @pparam=--buckets=<m> --hits=<n> --bytes=<o> --sample=<p> --shards=<q>",
+            PLUGIN_NAME, PLUGIN_NAME);
   }
 
   const char *
@@ -121,7 +236,14 @@ public:
   id() const override
   {
     return _label + ";LRU=b:" + std::to_string(_buckets) + ",h:" + std::to_string(_hits) + ",B:" + std::to_string(_bytes) +
-           ",i:" + std::to_string(_internal_enabled);
+           ",s:" + std::to_string(_num_shards) + ",i:" + std::to_string(_internal_enabled);
+  }
+
+  // The number of buckets of shard <shard> out of <num_shards>, which add up to <buckets>
+  static unsigned
+  shardBuckets(unsigned buckets, unsigned num_shards, unsigned shard)
+  {
+    return buckets / num_shards + (shard < buckets % num_shards ? 1 : 0);
   }
 
   void
@@ -137,23 +259,24 @@ public:
   }
 
 private:
-  unsigned    _buckets = 1000;
-  unsigned    _hits    = 10;
-  int64_t     _bytes   = 0;
-  std::string _label   = "";
-
-  // For the LRU. Note that we keep track of the List sizes, because some versions fo STL have broken
-  // implementations of size(), making them obsessively slow on calling ::size().
-  TSMutex _lock;
-  LRUMap  _map;
-  LRUList _list, _freelist;
-  size_t  _list_size = 0, _freelist_size = 0;
+  LRUShard &lockShard(const LRUHash &hash);
+  void      setShards(unsigned num_shards);
+
+  unsigned    _buckets    = 1000;
+  unsigned    _hits       = 10;
+  int64_t     _bytes      = 0;
+  unsigned    _num_shards = 1;
+  std::string _label      = "";
+
+  // The LRU(s), a URL always hashes to the same shard
+  std::unique_ptr<LRUShard[]> _shards;
 
   // internal stats ids
-  int _freelist_size_id = -1;
-  int _lru_size_id      = -1;
-  int _lru_hit_id       = -1;
-  int _lru_miss_id      = -1;
-  int _lru_vacated_id   = -1;
-  int _promoted_id      = -1;
+  int _freelist_size_id  = -1;
+  int _lru_size_id       = -1;
+  int _lru_hit_id        = -1;
+  int _lru_miss_id       = -1;
+  int _lru_vacated_id    = -1;
+  int _lru_contention_id = -1;
+  int _promoted_id       = -1;
 };
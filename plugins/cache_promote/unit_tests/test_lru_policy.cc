@@ -0,0 +1,171 @@
+/** @file
+
+  Unit tests for the sharded LRU of the cache_promote LRU policy.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include <mutex>
+#include <string>
+
+#define CATCH_CONFIG_MAIN /* include main function */
+#include "catch.hpp"      /* catch unit-test framework */
+#include "../lru_policy.h"
+
+const char *PLUGIN_NAME = "TEST_cache_promote";
+DbgCtl      cache_promote_dbg_ctl{PLUGIN_NAME};
+
+// The LRU shards only need their lock from the plugin API.
+TSMutex
+TSMutexCreate()
+{
+  return reinterpret_cast<TSMutex>(new std::mutex);
+}
+
+void
+TSMutexDestroy(TSMutex mutexp)
+{
+  delete reinterpret_cast<std::mutex *>(mutexp);
+}
+
+void
+TSMutexLock(TSMutex mutexp)
+{
+  reinterpret_cast<std::mutex *>(mutexp)->lock();
+}
+
+void
+TSMutexUnlock(TSMutex mutexp)
+{
+  reinterpret_cast<std::mutex *>(mutexp)->unlock();
+}
+
+namespace
+{
+LRUHash
+hash_of(const std::string &url)
+{
+  LRUHash hash;
+
+  hash.init(url.data(), url.size());
+  return hash;
+}
+
+bool
+contains(LRUShard &shard, const std::string &url)
+{
+  LRUHash hash = hash_of(url);
+
+  return shard.map.find(&hash) != shard.map.end();
+}
+} // namespace
+
+TEST_CASE("LRU shard sizes add up to the configured buckets", "[cache_promote][lru]")
+{
+  for (unsigned buckets : {10U, 11U, 1000U, 1001U, 1023U}) {
+    for (unsigned shards : {1U, 3U, 7U, 10U, 16U}) {
+      if (shards > buckets) {
+        continue;
+      }
+
+      unsigned total = 0;
+      unsigned least = buckets;
+      unsigned most  = 0;
+
+      for (unsigned i = 0; i < shards; ++i) {
+        unsigned size  = LRUPolicy::shardBuckets(buckets, shards, i);
+        total         += size;
+        least          = std::min(least, size);
+        most           = std::max(most, size);
+      }
+      INFO("buckets " << buckets << " shards " << shards);
+      CHECK(total == buckets);
+      CHECK(least >= 1);
+      CHECK(most - least <= 1);
+    }
+  }
+
+  // One shard per bucket, and the remainder going to the first shards.
+  CHECK(LRUPolicy::shardBuckets(10, 10, 9) == 1);
+  CHECK(LRUPolicy::shardBuckets(1000, 3, 0) == 334);
+  CHECK(LRUPolicy::shardBuckets(1000, 3, 2) == 333);
+}
+
+TEST_CASE("LRU hashes map to a stable shard", "[cache_promote][lru]")
+{
+  LRUHash a = hash_of("http://example.com/a");
+  LRUHash b = hash_of("http://example.com/a");
+
+  for (unsigned shards : {1U, 2U, 16U, 256U}) {
+    CHECK(a.shard(shards) == b.shard(shards));
+    CHECK(a.shard(shards) < shards);
+  }
+}
+
+TEST_CASE("LRU shard evicts the least recently used entry", "[cache_promote][lru]")
+{
+  LRUShard shard;
+
+  CHECK(shard.insert(hash_of("a"), 3) == LRUShard::Slot::CREATED);
+  CHECK(shard.insert(hash_of("b"), 3) == LRUShard::Slot::CREATED);
+  CHECK(shard.insert(hash_of("c"), 3) == LRUShard::Slot::CREATED);
+  CHECK(shard.list_size == 3);
+
+  // A hit on "a" moves it to the head, so "b" is now the tail.
+  LRUHash a = hash_of("a");
+  shard.touch(shard.map.find(&a));
+
+  CHECK(shard.insert(hash_of("d"), 3) == LRUShard::Slot::VACATED);
+  CHECK(shard.list_size == 3);
+  CHECK(shard.map.size() == 3);
+  CHECK(contains(shard, "a"));
+  CHECK_FALSE(contains(shard, "b"));
+  CHECK(contains(shard, "c"));
+  CHECK(contains(shard, "d"));
+
+  auto &[key, hits, bytes] = *shard.map.find(&a)->second;
+  (void)key;
+  CHECK(hits == 1);
+  CHECK(bytes == 0);
+}
+
+TEST_CASE("LRU shard reuses promoted entries", "[cache_promote][lru]")
+{
+  LRUShard shard;
+  LRUHash  a = hash_of("a");
+
+  shard.insert(a, 2);
+  shard.insert(hash_of("b"), 2);
+  shard.promote(shard.map.find(&a));
+
+  CHECK(shard.list_size == 1);
+  CHECK(shard.freelist_size == 1);
+  CHECK_FALSE(contains(shard, "a"));
+
+  CHECK(shard.insert(hash_of("c"), 2) == LRUShard::Slot::REUSED);
+  CHECK(shard.list_size == 2);
+  CHECK(shard.freelist_size == 0);
+  CHECK(contains(shard, "b"));
+  CHECK(contains(shard, "c"));
+
+  // Full again, the oldest entry is vacated rather than growing the shard.
+  CHECK(shard.insert(hash_of("d"), 2) == LRUShard::Slot::VACATED);
+  CHECK(shard.list_size == 2);
+  CHECK_FALSE(contains(shard, "b"));
+}
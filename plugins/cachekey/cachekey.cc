@@ -174,14 +174,14 @@ classifyUserAgent(const Classifier &c, TSMBuffer buf, TSMLoc hdrs, String &class
 }
 
 static String
-getUri(TSMBuffer buf, TSMLoc url)
+getUri(TSHttpTxn txn, TSMBuffer buf, TSMLoc url)
 {
-  String      uri;
-  int         uriLen;
-  const char *uriPtr = TSUrlStringGet(buf, url, &uriLen);
+  String uri;
+  int    uriLen;
+  /* The URI string is in the transaction arena, no need to free it. */
+  const char *uriPtr = TSHttpTxnArenaUrlStringGet(txn, buf, url, &uriLen);
   if (nullptr != uriPtr && 0 != uriLen) {
     uri.assign(uriPtr, uriLen);
-    TSfree((void *)uriPtr);
   } else {
     CacheKeyError("failed to get URI");
   }
@@ -259,11 +259,11 @@ CacheKey::CacheKey(TSHttpTxn txn, String separator, CacheKeyUriType uriType, Cac
         CacheKeyError("failed to get pristine URI handle");
         return;
       }
-      CacheKeyDebug("using pristine uri '%s'", getUri(_buf, _url).c_str());
+      CacheKeyDebug("using pristine uri '%s'", getUri(_txn, _buf, _url).c_str());
     } else {
       _buf = rri->requestBufp;
       _url = rri->requestUrl;
-      CacheKeyDebug("using remap uri '%s'", getUri(_buf, _url).c_str());
+      CacheKeyDebug("using remap uri '%s'", getUri(_txn, _buf, _url).c_str());
     }
     _hdrs = rri->requestHdrp;
   } else {
@@ -279,14 +279,14 @@ CacheKey::CacheKey(TSHttpTxn txn, String separator, CacheKeyUriType uriType, Cac
         CacheKeyError("failed to get pristine URI handle");
         return;
       }
-      CacheKeyDebug("using pristine uri '%s'", getUri(_buf, _url).c_str());
+      CacheKeyDebug("using pristine uri '%s'", getUri(_txn, _buf, _url).c_str());
     } else {
       if (TS_SUCCESS != TSHttpHdrUrlGet(_buf, _hdrs, &_url)) {
         TSHandleMLocRelease(_buf, TS_NULL_MLOC, _hdrs);
         CacheKeyError("failed to get URI handle");
         return;
       }
-      CacheKeyDebug("using post-remap uri '%s','", getUri(_buf, _url).c_str());
+      CacheKeyDebug("using post-remap uri '%s','", getUri(_txn, _buf, _url).c_str());
     }
   }
   _valid = true; /* success, we got all necessary elements - URI, headers, etc. */
@@ -407,7 +407,7 @@ CacheKey::appendPrefix(const String &prefix, Pattern &prefixCapture, Pattern &pr
   if (!prefixCaptureUri.empty()) {
     customPrefix = true;
 
-    String uri = getUri(_buf, _url);
+    String uri = getUri(_txn, _buf, _url);
     if (!uri.empty()) {
       StringVector captures;
       if (prefixCaptureUri.process(uri, captures)) {
@@ -450,7 +450,7 @@ CacheKey::appendPath(Pattern &pathCapture, Pattern &pathCaptureUri)
   if (!pathCaptureUri.empty()) {
     customPath = true;
 
-    String uri = getUri(_buf, _url);
+    String uri = getUri(_txn, _buf, _url);
     if (!uri.empty()) {
       StringVector captures;
       if (pathCaptureUri.process(uri, captures)) {
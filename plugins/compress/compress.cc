@@ -1,6 +1,6 @@
 /** @file
 
-  Transforms content using gzip, deflate or brotli
+  Transforms content using gzip, deflate, brotli or zstd
 
   @section license License
 
@@ -22,6 +22,12 @@
  */
 
 #include <cstring>
+#include <ctime>
+#include <iterator>
+#include <mutex>
+#include <set>
+#include <string>
+#include <string_view>
 #include <zlib.h>
 
 #include "ts/apidefs.h"
@@ -33,6 +39,10 @@
 #include <brotli/encode.h>
 #endif
 
+#if HAVE_ZSTD_H
+#include <zstd.h>
+#endif
+
 #include "ts/ts.h"
 #include "tscore/ink_defs.h"
 
@@ -71,6 +81,10 @@ const int BROTLI_COMPRESSION_LEVEL = 6;
 const int BROTLI_LGW               = 16;
 #endif
 
+#if HAVE_ZSTD_H
+const int ZSTD_COMPRESSION_LEVEL = 6;
+#endif
+
 static const char *global_hidden_header_name = nullptr;
 
 static TSMutex compress_config_mutex = nullptr;
@@ -81,6 +95,253 @@ Configuration *prev_config = nullptr;
 
 namespace
 {
+// Per encoding stats, so the cost and benefit of each algorithm can be compared.
+enum CompressStat { STAT_RESPONSES, STAT_BYTES_IN, STAT_BYTES_OUT, STAT_CPU_TIME, STAT_PREFILLS, STAT_COUNT };
+
+// Indexed by the bit position of the encoding's ALGORITHM_ flag.
+const char *const stat_encodings[] = {"deflate", "gzip", "br", "zstd"};
+const char *const stat_suffixes[]  = {"responses", "bytes_in", "bytes_out", "cpu_time_us", "prefills"};
+
+int stat_ids[std::size(stat_encodings)][STAT_COUNT];
+
+void
+init_stats()
+{
+  for (size_t e = 0; e < std::size(stat_encodings); ++e) {
+    for (int s = 0; s < STAT_COUNT; ++s) {
+      char name[64];
+      snprintf(name, sizeof(name), "plugin.%s.%s.%s", TAG, stat_encodings[e], stat_suffixes[s]);
+      if (TSStatFindName(name, &stat_ids[e][s]) == TS_ERROR) {
+        stat_ids[e][s] = TSStatCreate(name, TS_RECORDDATATYPE_INT, TS_STAT_NON_PERSISTENT, TS_STAT_SYNC_SUM);
+      }
+    }
+  }
+}
+
+// Index in to stat_encodings of the encoding a transform produces, this follows content_encoding_header().
+int
+encoding_index(int type, int algo)
+{
+  if ((type & COMPRESSION_TYPE_BROTLI) && (algo & ALGORITHM_BROTLI)) {
+    return 2;
+  } else if ((type & COMPRESSION_TYPE_ZSTD) && (algo & ALGORITHM_ZSTD)) {
+    return 3;
+  } else if ((type & COMPRESSION_TYPE_GZIP) && (algo & ALGORITHM_GZIP)) {
+    return 1;
+  }
+  return 0;
+}
+
+int
+stat_encoding(const Data *data)
+{
+  return encoding_index(data->compression_type, data->compression_algorithms);
+}
+
+int64_t
+thread_cpu_time()
+{
+  timespec ts;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+}
+
+// Background fill of the configured encodings that the first fill of an object did not produce. Each one is an
+// internal GET of the same URL that accepts only that encoding, so its miss compresses and caches that encoding as
+// its own alternate, and later clients asking for it hit cache without a transform. Like the background_fetch
+// plugin, the response is read and discarded.
+std::mutex            prefill_mutex;
+std::set<std::string> prefill_active; // URL and encoding of the fills in flight
+
+// Request headers that would turn a fill in to a partial or conditional response.
+const std::string_view prefill_remove_headers[] = {
+  {TS_MIME_FIELD_RANGE, static_cast<size_t>(TS_MIME_LEN_RANGE)},
+  {TS_MIME_FIELD_IF_MATCH, static_cast<size_t>(TS_MIME_LEN_IF_MATCH)},
+  {TS_MIME_FIELD_IF_MODIFIED_SINCE, static_cast<size_t>(TS_MIME_LEN_IF_MODIFIED_SINCE)},
+  {TS_MIME_FIELD_IF_NONE_MATCH, static_cast<size_t>(TS_MIME_LEN_IF_NONE_MATCH)},
+  {TS_MIME_FIELD_IF_RANGE, static_cast<size_t>(TS_MIME_LEN_IF_RANGE)},
+  {TS_MIME_FIELD_IF_UNMODIFIED_SINCE, static_cast<size_t>(TS_MIME_LEN_IF_UNMODIFIED_SINCE)},
+};
+
+struct Prefill {
+  explicit Prefill(std::string k) : key(std::move(k)) {}
+
+  ~Prefill()
+  {
+    if (vc) {
+      TSVConnClose(vc);
+    }
+    TSIOBufferReaderFree(req_reader);
+    TSIOBufferDestroy(req_buf);
+    TSIOBufferReaderFree(resp_reader);
+    TSIOBufferDestroy(resp_buf);
+    TSHandleMLocRelease(mbuf, TS_NULL_MLOC, hdr_loc);
+    TSMBufferDestroy(mbuf);
+    if (cont) {
+      TSContDestroy(cont);
+    }
+
+    std::lock_guard<std::mutex> lock(prefill_mutex);
+    prefill_active.erase(key);
+  }
+
+  std::string      key;
+  sockaddr_storage client_ip{};
+  TSMBuffer        mbuf        = TSMBufferCreate();
+  TSMLoc           hdr_loc     = TS_NULL_MLOC;
+  TSCont           cont        = nullptr;
+  TSVConn          vc          = nullptr;
+  TSVIO            r_vio       = nullptr;
+  TSIOBuffer       req_buf     = TSIOBufferCreate();
+  TSIOBufferReader req_reader  = TSIOBufferReaderAlloc(req_buf);
+  TSIOBuffer       resp_buf    = TSIOBufferCreate();
+  TSIOBufferReader resp_reader = TSIOBufferReaderAlloc(resp_buf);
+};
+
+int
+prefill_event(TSCont contp, TSEvent event, void * /* edata ATS_UNUSED */)
+{
+  Prefill *p = static_cast<Prefill *>(TSContDataGet(contp));
+  int64_t  avail;
+
+  switch (event) {
+  case TS_EVENT_IMMEDIATE:
+    if ((p->vc = TSHttpConnectWithPluginId(reinterpret_cast<sockaddr *>(&p->client_ip), TAG, 0)) == nullptr) {
+      error("failed to connect the prefill of %s", p->key.c_str());
+      delete p;
+      break;
+    }
+    TSHttpHdrPrint(p->mbuf, p->hdr_loc, p->req_buf);
+    TSIOBufferWrite(p->req_buf, "\r\n", 2);
+
+    p->r_vio = TSVConnRead(p->vc, contp, p->resp_buf, INT64_MAX);
+    TSVConnWrite(p->vc, contp, p->req_reader, TSIOBufferReaderAvail(p->req_reader));
+    break;
+
+  case TS_EVENT_VCONN_WRITE_COMPLETE:
+    break;
+
+  case TS_EVENT_VCONN_READ_READY:
+    avail = TSIOBufferReaderAvail(p->resp_reader);
+    TSIOBufferReaderConsume(p->resp_reader, avail);
+    TSVIONDoneSet(p->r_vio, TSVIONDoneGet(p->r_vio) + avail);
+    TSVIOReenable(p->r_vio);
+    break;
+
+  case TS_EVENT_VCONN_INACTIVITY_TIMEOUT:
+    TSVConnAbort(p->vc, TS_VC_CLOSE_ABORT);
+    p->vc = nullptr;
+    [[fallthrough]];
+  case TS_EVENT_VCONN_READ_COMPLETE:
+  case TS_EVENT_VCONN_EOS:
+  case TS_EVENT_ERROR:
+    info("prefill of %s done, event %s", p->key.c_str(), TSHttpEventNameLookup(event));
+    delete p;
+    break;
+
+  default:
+    debug("unhandled prefill event %s (%d)", TSHttpEventNameLookup(event), event);
+    break;
+  }
+
+  return 0;
+}
+
+void
+prefill_set_header(TSMBuffer bufp, TSMLoc hdr_loc, const char *name, int name_len, const char *value)
+{
+  TSMLoc field = TSMimeHdrFieldFind(bufp, hdr_loc, name, name_len);
+
+  while (field) {
+    TSMLoc next = TSMimeHdrFieldNextDup(bufp, hdr_loc, field);
+    TSMimeHdrFieldDestroy(bufp, hdr_loc, field);
+    TSHandleMLocRelease(bufp, hdr_loc, field);
+    field = next;
+  }
+  if (value != nullptr && TSMimeHdrFieldCreateNamed(bufp, hdr_loc, name, name_len, &field) == TS_SUCCESS) {
+    TSMimeHdrFieldValueStringSet(bufp, hdr_loc, field, -1, value, -1);
+    TSMimeHdrFieldAppend(bufp, hdr_loc, field);
+    TSHandleMLocRelease(bufp, hdr_loc, field);
+  }
+}
+
+// Issue one background fill per encoding in @a encodings, a mask of ALGORITHM_ flags, for the URL of @a txnp.
+void
+prefill_issue(TSHttpTxn txnp, int encodings)
+{
+  sockaddr const *ip = TSHttpTxnClientAddrGet(txnp);
+  TSMBuffer       req_buf;
+  TSMLoc          req_loc;
+  TSMBuffer       url_buf;
+  TSMLoc          url_loc;
+  int             url_len;
+
+  if (ip == nullptr || (ip->sa_family != AF_INET && ip->sa_family != AF_INET6)) {
+    return;
+  }
+  if (TSHttpTxnClientReqGet(txnp, &req_buf, &req_loc) != TS_SUCCESS) {
+    return;
+  }
+  ts::PostScript req_defer([&]() -> void { TSHandleMLocRelease(req_buf, TS_NULL_MLOC, req_loc); });
+  if (TSHttpTxnPristineUrlGet(txnp, &url_buf, &url_loc) != TS_SUCCESS) {
+    return;
+  }
+  ts::PostScript url_defer([&]() -> void { TSHandleMLocRelease(url_buf, TS_NULL_MLOC, url_loc); });
+
+  char          *url = TSUrlStringGet(url_buf, url_loc, &url_len);
+  ts::PostScript url_str_defer([&]() -> void { TSfree(url); });
+  if (url == nullptr) {
+    return;
+  }
+
+  for (size_t e = 0; e < std::size(stat_encodings); ++e) {
+    if (!(encodings & (1 << e))) {
+      continue;
+    }
+
+    std::string key{url, static_cast<size_t>(url_len)};
+    key.append(" ").append(stat_encodings[e]);
+    {
+      std::lock_guard<std::mutex> lock(prefill_mutex);
+      if (!prefill_active.insert(key).second) {
+        continue;
+      }
+    }
+
+    Prefill *p = new Prefill(std::move(key));
+    TSMLoc   p_url;
+    int      host_len;
+
+    memcpy(&p->client_ip, ip, ip->sa_family == AF_INET ? sizeof(sockaddr_in) : sizeof(sockaddr_in6));
+    p->hdr_loc = TSHttpHdrCreate(p->mbuf);
+    if (TSHttpHdrCopy(p->mbuf, p->hdr_loc, req_buf, req_loc) != TS_SUCCESS ||
+        TSUrlClone(p->mbuf, url_buf, url_loc, &p_url) != TS_SUCCESS) {
+      delete p;
+      continue;
+    }
+    TSHttpHdrUrlSet(p->mbuf, p->hdr_loc, p_url);
+
+    // The pristine URL is remapped again by the internal transaction, so its Host must match it.
+    const char *host = TSUrlHostGet(p->mbuf, p_url, &host_len);
+    if (host != nullptr && host_len > 0) {
+      std::string h{host, static_cast<size_t>(host_len)};
+      prefill_set_header(p->mbuf, p->hdr_loc, TS_MIME_FIELD_HOST, TS_MIME_LEN_HOST, h.c_str());
+    }
+    TSHandleMLocRelease(p->mbuf, TS_NULL_MLOC, p_url);
+
+    for (auto const &name : prefill_remove_headers) {
+      prefill_set_header(p->mbuf, p->hdr_loc, name.data(), name.size(), nullptr);
+    }
+    prefill_set_header(p->mbuf, p->hdr_loc, TS_MIME_FIELD_ACCEPT_ENCODING, TS_MIME_LEN_ACCEPT_ENCODING, stat_encodings[e]);
+
+    p->cont = TSContCreate(prefill_event, TSMutexCreate());
+    TSContDataSet(p->cont, p);
+    TSStatIntIncrement(stat_ids[e][STAT_PREFILLS], 1);
+    info("prefilling %s", p->key.c_str());
+    TSContScheduleOnPool(p->cont, 0, TS_THREAD_POOL_NET);
+  }
+}
+
 /**
   If client request has both of Range and Accept-Encoding header, follow range-request config.
  */
@@ -146,6 +407,8 @@ data_alloc(int compression_type, int compression_algorithms)
   data->state                  = transform_state_initialized;
   data->compression_type       = compression_type;
   data->compression_algorithms = compression_algorithms;
+  data->upstream_length        = 0;
+  data->cpu_time               = 0;
   data->zstrm.next_in          = Z_NULL;
   data->zstrm.avail_in         = 0;
   data->zstrm.total_in         = 0;
@@ -191,6 +454,19 @@ data_alloc(int compression_type, int compression_algorithms)
     data->bstrm.avail_out = 0;
     data->bstrm.total_out = 0;
   }
+#endif
+#if HAVE_ZSTD_H
+  data->zstrm_zstd.cctx = nullptr;
+  if (compression_type & COMPRESSION_TYPE_ZSTD) {
+    debug("zstd compression. Create zstd compression context.");
+    data->zstrm_zstd.cctx = ZSTD_createCCtx();
+    if (!data->zstrm_zstd.cctx) {
+      fatal("zstd compression context creation failed");
+    }
+    ZSTD_CCtx_setParameter(data->zstrm_zstd.cctx, ZSTD_c_compressionLevel, ZSTD_COMPRESSION_LEVEL);
+    data->zstrm_zstd.total_in  = 0;
+    data->zstrm_zstd.total_out = 0;
+  }
 #endif
   return data;
 }
@@ -212,6 +488,9 @@ data_destroy(Data *data)
 #if HAVE_BROTLI_ENCODE_H
   BrotliEncoderDestroyInstance(data->bstrm.br);
 #endif
+#if HAVE_ZSTD_H
+  ZSTD_freeCCtx(data->zstrm_zstd.cctx);
+#endif
 
   TSfree(data);
 }
@@ -227,6 +506,9 @@ content_encoding_header(TSMBuffer bufp, TSMLoc hdr_loc, const int compression_ty
   if (compression_type & COMPRESSION_TYPE_BROTLI && (algorithm & ALGORITHM_BROTLI)) {
     value     = TS_HTTP_VALUE_BROTLI;
     value_len = TS_HTTP_LEN_BROTLI;
+  } else if (compression_type & COMPRESSION_TYPE_ZSTD && (algorithm & ALGORITHM_ZSTD)) {
+    value     = "zstd";
+    value_len = sizeof("zstd") - 1;
   } else if (compression_type & COMPRESSION_TYPE_GZIP && (algorithm & ALGORITHM_GZIP)) {
     value     = TS_HTTP_VALUE_GZIP;
     value_len = TS_HTTP_LEN_GZIP;
@@ -462,11 +744,76 @@ brotli_transform_one(Data *data, const char *upstream_buffer, int64_t upstream_l
 }
 #endif
 
+#if HAVE_ZSTD_H
+static bool
+zstd_compress_operation(Data *data, const char *upstream_buffer, int64_t upstream_length, ZSTD_EndDirective op)
+{
+  TSIOBufferBlock downstream_blkp;
+  int64_t         downstream_length;
+  ZSTD_inBuffer   input = {upstream_buffer, static_cast<size_t>(upstream_length), 0};
+
+  for (;;) {
+    downstream_blkp         = TSIOBufferStart(data->downstream_buffer);
+    char *downstream_buffer = TSIOBufferBlockWriteStart(downstream_blkp, &downstream_length);
+
+    ZSTD_outBuffer output    = {downstream_buffer, static_cast<size_t>(downstream_length), 0};
+    size_t         remaining = ZSTD_compressStream2(data->zstrm_zstd.cctx, &output, &input, op);
+
+    if (ZSTD_isError(remaining)) {
+      error("ZSTD_compressStream2(%d) call failed: %s", op, ZSTD_getErrorName(remaining));
+      return false;
+    }
+
+    TSIOBufferProduce(data->downstream_buffer, output.pos);
+    data->downstream_length    += output.pos;
+    data->zstrm_zstd.total_out += output.pos;
+
+    // Done once all input is consumed and, for a flush or end, the frame is fully written out.
+    if (input.pos == input.size && (op == ZSTD_e_continue || remaining == 0)) {
+      break;
+    }
+  }
+
+  data->zstrm_zstd.total_in += input.size;
+  return true;
+}
+
+static void
+zstd_transform_one(Data *data, const char *upstream_buffer, int64_t upstream_length)
+{
+  zstd_compress_operation(data, upstream_buffer, upstream_length, data->hc->flush() ? ZSTD_e_flush : ZSTD_e_continue);
+}
+
+static void
+zstd_transform_finish(Data *data)
+{
+  if (data->state != transform_state_output) {
+    return;
+  }
+
+  data->state = transform_state_finished;
+
+  if (!zstd_compress_operation(data, nullptr, 0, ZSTD_e_end)) {
+    return;
+  }
+
+  if (data->downstream_length != static_cast<int64_t>(data->zstrm_zstd.total_out)) {
+    error("zstd-transform: output lengths don't match (%d, %zu)", data->downstream_length, data->zstrm_zstd.total_out);
+  }
+
+  debug("zstd-transform: Finished zstd");
+  log_compression_ratio(data->zstrm_zstd.total_in, data->downstream_length);
+}
+#endif
+
 static void
 compress_transform_one(Data *data, TSIOBufferReader upstream_reader, int amount)
 {
   TSIOBufferBlock downstream_blkp;
   int64_t         upstream_length;
+  int64_t         start = thread_cpu_time();
+
+  data->upstream_length += amount;
   while (amount > 0) {
     downstream_blkp = TSIOBufferReaderStart(upstream_reader);
     if (!downstream_blkp) {
@@ -488,6 +835,11 @@ compress_transform_one(Data *data, TSIOBufferReader upstream_reader, int amount)
     if (data->compression_type & COMPRESSION_TYPE_BROTLI && (data->compression_algorithms & ALGORITHM_BROTLI)) {
       brotli_transform_one(data, upstream_buffer, upstream_length);
     } else
+#endif
+#if HAVE_ZSTD_H
+      if (data->compression_type & COMPRESSION_TYPE_ZSTD && (data->compression_algorithms & ALGORITHM_ZSTD)) {
+      zstd_transform_one(data, upstream_buffer, upstream_length);
+    } else
 #endif
       if ((data->compression_type & (COMPRESSION_TYPE_GZIP | COMPRESSION_TYPE_DEFLATE)) &&
           (data->compression_algorithms & (ALGORITHM_GZIP | ALGORITHM_DEFLATE))) {
@@ -499,6 +851,7 @@ compress_transform_one(Data *data, TSIOBufferReader upstream_reader, int amount)
     TSIOBufferReaderConsume(upstream_reader, upstream_length);
     amount -= upstream_length;
   }
+  data->cpu_time += thread_cpu_time() - start;
 }
 
 static void
@@ -571,11 +924,22 @@ brotli_transform_finish(Data *data)
 static void
 compress_transform_finish(Data *data)
 {
+  if (data->state != transform_state_output) {
+    return;
+  }
+
+  int64_t start = thread_cpu_time();
 #if HAVE_BROTLI_ENCODE_H
   if (data->compression_type & COMPRESSION_TYPE_BROTLI && data->compression_algorithms & ALGORITHM_BROTLI) {
     brotli_transform_finish(data);
     debug("compress_transform_finish: brotli compression finish");
   } else
+#endif
+#if HAVE_ZSTD_H
+    if (data->compression_type & COMPRESSION_TYPE_ZSTD && data->compression_algorithms & ALGORITHM_ZSTD) {
+    zstd_transform_finish(data);
+    debug("compress_transform_finish: zstd compression finish");
+  } else
 #endif
     if ((data->compression_type & (COMPRESSION_TYPE_GZIP | COMPRESSION_TYPE_DEFLATE)) &&
         (data->compression_algorithms & (ALGORITHM_GZIP | ALGORITHM_DEFLATE))) {
@@ -583,7 +947,15 @@ compress_transform_finish(Data *data)
     debug("compress_transform_finish: gzip compression finish");
   } else {
     error("No Compression matched, shouldn't come here");
+    return;
   }
+  data->cpu_time += thread_cpu_time() - start;
+
+  const int *ids = stat_ids[stat_encoding(data)];
+  TSStatIntIncrement(ids[STAT_RESPONSES], 1);
+  TSStatIntIncrement(ids[STAT_BYTES_IN], data->upstream_length);
+  TSStatIntIncrement(ids[STAT_BYTES_OUT], data->downstream_length);
+  TSStatIntIncrement(ids[STAT_CPU_TIME], data->cpu_time / 1000);
 }
 
 static void
@@ -761,6 +1133,11 @@ transformable(TSHttpTxn txnp, bool server, HostConfiguration *host_configuration
           compression_acceptable = 1;
         }
         *compress_type |= COMPRESSION_TYPE_BROTLI;
+      } else if (strncasecmp(value, "zstd", sizeof("zstd") - 1) == 0) {
+        if (*algorithms & ALGORITHM_ZSTD) {
+          compression_acceptable = 1;
+        }
+        *compress_type |= COMPRESSION_TYPE_ZSTD;
       } else if (strncasecmp(value, "deflate", sizeof("deflate") - 1) == 0) {
         if (*algorithms & ALGORITHM_DEFLATE) {
           compression_acceptable = 1;
@@ -884,13 +1261,20 @@ find_host_configuration(TSHttpTxn /* txnp ATS_UNUSED */, TSMBuffer bufp, TSMLoc
   return host_configuration;
 }
 
+// Per transaction data of transform_plugin.
+struct TxnData {
+  HostConfiguration *hc;
+  int                prefill = 0; ///< ALGORITHM_ flags of the encodings to fill in the background at close
+};
+
 static int
 transform_plugin(TSCont contp, TSEvent event, void *edata)
 {
   TSHttpTxn          txnp          = static_cast<TSHttpTxn>(edata);
   int                compress_type = COMPRESSION_TYPE_DEFAULT;
   int                algorithms    = ALGORITHM_DEFAULT;
-  HostConfiguration *hc            = static_cast<HostConfiguration *>(TSContDataGet(contp));
+  TxnData           *txn_data      = static_cast<TxnData *>(TSContDataGet(contp));
+  HostConfiguration *hc            = txn_data->hc;
 
   switch (event) {
   case TS_EVENT_HTTP_READ_RESPONSE_HDR:
@@ -910,6 +1294,11 @@ transform_plugin(TSCont contp, TSEvent event, void *edata)
 
       if (transformable(txnp, true, hc, &compress_type, &algorithms)) {
         compress_transform_add(txnp, hc, compress_type, algorithms);
+
+        // This fills the cache with one encoding, the others are filled once it is written.
+        if (hc->cache() && hc->prefill() && !TSHttpTxnIsInternal(txnp) && TSHttpTxnIsCacheable(txnp, nullptr, nullptr)) {
+          txn_data->prefill = algorithms & ~(1 << encoding_index(compress_type, algorithms));
+        }
       }
     }
     break;
@@ -948,7 +1337,11 @@ transform_plugin(TSCont contp, TSEvent event, void *edata)
   } break;
 
   case TS_EVENT_HTTP_TXN_CLOSE:
+    if (txn_data->prefill) {
+      prefill_issue(txnp, txn_data->prefill);
+    }
     // Release the ocnif lease, and destroy this continuation
+    delete txn_data;
     TSContDestroy(contp);
     break;
 
@@ -999,7 +1392,7 @@ handle_request(TSHttpTxn txnp, Configuration *config)
     if (allowed) {
       TSCont transform_contp = TSContCreate(transform_plugin, nullptr);
 
-      TSContDataSet(transform_contp, (void *)hc);
+      TSContDataSet(transform_contp, new TxnData{hc});
 
       info("Kicking off compress plugin for request");
       normalize_accept_encoding(txnp, req_buf, req_loc);
@@ -1075,6 +1468,7 @@ TSPluginInit(int argc, const char *argv[])
   if (!register_plugin()) {
     fatal("the compress plugin failed to register");
   }
+  init_stats();
 
   info("TSPluginInit %s", argv[0]);
 
@@ -1103,6 +1497,7 @@ TSReturnCode
 TSRemapInit(TSRemapInterface *api_info, char *errbuf, int errbuf_size)
 {
   CHECK_REMAP_API_COMPATIBILITY(api_info, errbuf, errbuf_size);
+  init_stats();
   info("The compress plugin is successfully initialized");
   return TS_SUCCESS;
 }
@@ -1,6 +1,6 @@
 /** @file
 
-  Transforms content using gzip, deflate or brotli
+  Transforms content using gzip, deflate, brotli or zstd
 
   @section license License
 
@@ -107,6 +107,7 @@ enum ParserState {
   kParseCache,
   kParseRangeRequest,
   kParseFlush,
+  kParsePrefill,
   kParseAllow,
   kParseMinimumContentLength
 };
@@ -234,13 +235,19 @@ HostConfiguration::add_compression_algorithms(string &line)
       compression_algorithms_ |= ALGORITHM_BROTLI;
 #else
       error("supported-algorithms: brotli support not compiled in.");
+#endif
+    } else if (token == "zstd") {
+#ifdef HAVE_ZSTD_H
+      compression_algorithms_ |= ALGORITHM_ZSTD;
+#else
+      error("supported-algorithms: zstd support not compiled in.");
 #endif
     } else if (token == "gzip") {
       compression_algorithms_ |= ALGORITHM_GZIP;
     } else if (token == "deflate") {
       compression_algorithms_ |= ALGORITHM_DEFLATE;
     } else {
-      error("Unknown compression type. Supported compression-algorithms <br,gzip,deflate>.");
+      error("Unknown compression type. Supported compression-algorithms <br,zstd,gzip,deflate>.");
     }
   }
 }
@@ -365,6 +372,8 @@ Configuration::Parse(const char *path)
           state = kParseRangeRequest;
         } else if (token == "flush") {
           state = kParseFlush;
+        } else if (token == "prefill") {
+          state = kParsePrefill;
         } else if (token == "supported-algorithms") {
           current_host_configuration->add_compression_algorithms(line);
           state = kParseStart;
@@ -403,6 +412,10 @@ Configuration::Parse(const char *path)
         current_host_configuration->set_flush(token == "true");
         state = kParseStart;
         break;
+      case kParsePrefill:
+        current_host_configuration->set_prefill(token == "true");
+        state = kParseStart;
+        break;
       case kParseAllow:
         current_host_configuration->add_allow(token);
         state = kParseStart;
@@ -38,7 +38,8 @@ enum CompressionAlgorithm {
   ALGORITHM_DEFAULT = 0,
   ALGORITHM_DEFLATE = 1,
   ALGORITHM_GZIP    = 2,
-  ALGORITHM_BROTLI  = 4 // For bit manipulations
+  ALGORITHM_BROTLI  = 4, // For bit manipulations
+  ALGORITHM_ZSTD    = 8
 };
 
 enum class RangeRequestCtrl : int {
@@ -56,6 +57,7 @@ public:
       cache_(true),
       remove_accept_encoding_(false),
       flush_(false),
+      prefill_(false),
       compression_algorithms_(ALGORITHM_GZIP),
       minimum_content_length_(1024)
   {
@@ -97,6 +99,16 @@ public:
     flush_ = x;
   }
   bool
+  prefill()
+  {
+    return prefill_;
+  }
+  void
+  set_prefill(bool x)
+  {
+    prefill_ = x;
+  }
+  bool
   remove_accept_encoding()
   {
     return remove_accept_encoding_;
@@ -145,6 +157,7 @@ private:
   bool         cache_;
   bool         remove_accept_encoding_;
   bool         flush_;
+  bool         prefill_;
   int          compression_algorithms_;
   unsigned int minimum_content_length_;
 
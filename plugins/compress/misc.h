@@ -1,6 +1,6 @@
 /** @file
 
-  Transforms content using gzip, deflate or brotli
+  Transforms content using gzip, deflate, brotli or zstd
 
   @section license License
 
@@ -32,6 +32,10 @@
 #include <brotli/encode.h>
 #endif
 
+#if HAVE_ZSTD_H
+#include <zstd.h>
+#endif
+
 #include "configuration.h"
 
 // zlib stuff, see [deflateInit2] at http://www.zlib.net/manual.html
@@ -44,7 +48,8 @@ enum CompressionType {
   COMPRESSION_TYPE_DEFAULT = 0,
   COMPRESSION_TYPE_DEFLATE = 1,
   COMPRESSION_TYPE_GZIP    = 2,
-  COMPRESSION_TYPE_BROTLI  = 4
+  COMPRESSION_TYPE_BROTLI  = 4,
+  COMPRESSION_TYPE_ZSTD    = 8
 };
 
 // this one is used to rename the accept encoding header
@@ -70,6 +75,14 @@ using b_stream = struct {
 };
 #endif
 
+#if HAVE_ZSTD_H
+using zstd_stream = struct {
+  ZSTD_CCtx *cctx;
+  size_t     total_in;
+  size_t     total_out;
+};
+#endif
+
 using Data = struct {
   TSHttpTxn                txn;
   Gzip::HostConfiguration *hc;
@@ -81,9 +94,14 @@ using Data = struct {
   enum transform_state     state;
   int                      compression_type;
   int                      compression_algorithms;
+  int64_t                  upstream_length; // bytes handed to the compressor
+  int64_t                  cpu_time;        // thread CPU time spent compressing, in nanoseconds
 #if HAVE_BROTLI_ENCODE_H
   b_stream bstrm;
 #endif
+#if HAVE_ZSTD_H
+  zstd_stream zstrm_zstd;
+#endif
 };
 
 voidpf      gzip_alloc(voidpf opaque, uInt items, uInt size);
@@ -359,6 +359,23 @@ Context::initialize(TSCont cont)
   scheduler_cont_ = cont;
 }
 
+void
+Context::reset(TSHttpTxn txnp)
+{
+  txnp_                  = txnp;
+  reenable_txn_          = false;
+  local_reply_           = false;
+  in_vm_context_created_ = false;
+  destroyed_             = false;
+  stream_failed_         = false;
+
+  local_reply_headers_.clear();
+  local_reply_details_.clear();
+  buffer_.clear();
+  resetHttpCallResult();
+  clearTransformResult();
+}
+
 TSHttpTxn
 Context::txnp()
 {
@@ -207,6 +207,9 @@ public:
   void initialize(TSHttpTxn txnp);
   void initialize(TSCont cont);
 
+  // clear the transaction state, so that a pooled context can be used for another transaction
+  void reset(TSHttpTxn txnp);
+
   TSHttpTxn txnp();
   TSCont    scheduler_cont();
 
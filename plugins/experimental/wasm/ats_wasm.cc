@@ -67,6 +67,11 @@ Wasm::Wasm(std::unique_ptr<WasmVm> wasm_vm, std::string_view vm_id, std::string_
   mutex_ = TSMutexCreate();
 }
 
+Wasm::~Wasm()
+{
+  clearContextPool();
+}
+
 // function to retrieve mutex
 TSMutex
 Wasm::mutex() const
@@ -142,6 +147,50 @@ Wasm::readyDelete()
   return (root_contexts_.empty() && pending_done_.empty() && pending_delete_.empty());
 }
 
+// functions to manage the pool of transaction contexts, all of them are called with the VM mutex held
+void
+Wasm::setContextPoolSize(size_t size)
+{
+  context_pool_size_ = size;
+}
+
+Context *
+Wasm::takeContext(const std::shared_ptr<PluginBase> &plugin)
+{
+  while (!context_pool_.empty()) {
+    Context *c = context_pool_.back();
+    context_pool_.pop_back();
+    if (c->plugin_ == plugin) {
+      return c;
+    }
+    delete c;
+  }
+  return nullptr;
+}
+
+bool
+Wasm::poolContext(Context *context)
+{
+  if (context_pool_.size() >= context_pool_size_) {
+    return false;
+  }
+  context_pool_.push_back(context);
+  return true;
+}
+
+// the pooled contexts are not root contexts, the pool has to be cleared before the VM can shutdown
+size_t
+Wasm::clearContextPool()
+{
+  size_t n = context_pool_.size();
+
+  for (auto *c : context_pool_) {
+    delete c;
+  }
+  context_pool_.clear();
+  return n;
+}
+
 // functions to manage timer
 bool
 Wasm::existsTimerPeriod(uint32_t root_context_id)
@@ -23,6 +23,8 @@
 
 #include "ts/ts.h"
 
+#include <vector>
+
 namespace ats_wasm
 {
 using proxy_wasm::ContextBase;
@@ -60,6 +62,7 @@ public:
   Wasm(std::unique_ptr<WasmVm> wasm_vm, std::string_view vm_id, std::string_view vm_configuration, std::string_view vm_key,
        std::unordered_map<std::string, std::string> envs, AllowedCapabilitiesMap allowed_capabilities);
   Wasm(const std::shared_ptr<WasmHandleBase> &base_wasm_handle, const WasmVmFactory &factory);
+  ~Wasm() override;
 
   // start a new VM
   Context *start(const std::shared_ptr<PluginBase> &plugin, TSCont cont);
@@ -71,6 +74,12 @@ public:
   bool readyShutdown();
   bool readyDelete();
 
+  // functions to manage the pool of transaction contexts
+  void     setContextPoolSize(size_t size);
+  Context *takeContext(const std::shared_ptr<PluginBase> &plugin);
+  bool     poolContext(Context *context);
+  size_t   clearContextPool();
+
   // functions for creating contexts from the VM
   ContextBase *createVmContext() override;
   ContextBase *createRootContext(const std::shared_ptr<PluginBase> &plugin) override;
@@ -89,6 +98,10 @@ protected:
 
 private:
   TSMutex mutex_{nullptr};
+
+  // contexts of finished transactions, ready to be reset for the next ones
+  std::vector<Context *> context_pool_;
+  size_t                 context_pool_size_ = 0;
 };
 
 } // namespace ats_wasm
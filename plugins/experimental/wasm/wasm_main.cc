@@ -37,7 +37,12 @@
 #include <unistd.h>
 #include <fcntl.h>
 
+#include <map>
 #include <string>
+#include <unordered_map>
+
+// default number of transaction contexts kept for reuse by each VM
+static constexpr size_t DEFAULT_CONTEXT_POOL_SIZE = 64;
 
 // struct for storing plugin configuration
 struct WasmInstanceConfig {
@@ -46,10 +51,34 @@ struct WasmInstanceConfig {
   std::list<std::pair<std::shared_ptr<ats_wasm::Wasm>, std::shared_ptr<proxy_wasm::PluginBase>>> configs = {};
 
   std::list<std::pair<std::shared_ptr<ats_wasm::Wasm>, std::shared_ptr<proxy_wasm::PluginBase>>> deleted_configs = {};
+
+  // loaded modules by the hash of their code and VM settings, the VMs are cloned from them
+  std::unordered_map<std::string, std::shared_ptr<proxy_wasm::WasmHandleBase>> modules = {};
 };
 
 static std::unique_ptr<WasmInstanceConfig> wasm_config = nullptr;
 
+// plugin metrics
+enum WasmStat {
+  WASM_STAT_VM_INSTANTIATIONS = 0,
+  WASM_STAT_VM_INSTANTIATION_TIME,
+  WASM_STAT_MODULE_CACHE_HITS,
+  WASM_STAT_MODULE_CACHE_MISSES,
+  WASM_STAT_CONTEXT_CREATED,
+  WASM_STAT_CONTEXT_REUSED,
+  WASM_STAT_CONTEXT_POOLED,
+  WASM_STAT_CONTEXT_SETUP_TIME,
+  WASM_STAT_COUNT
+};
+
+static const char *wasm_stat_names[WASM_STAT_COUNT] = {
+  "plugin.wasm.vm.instantiations",   "plugin.wasm.vm.instantiation_time_ns", "plugin.wasm.module_cache.hits",
+  "plugin.wasm.module_cache.misses", "plugin.wasm.context.created",          "plugin.wasm.context.reused",
+  "plugin.wasm.context.pooled",      "plugin.wasm.context.setup_time_ns",
+};
+
+static int wasm_stats[WASM_STAT_COUNT];
+
 // handler for transform event
 static int
 transform_handler(TSCont contp, ats_wasm::TransformInfo *ti)
@@ -458,7 +487,16 @@ http_event_handler(TSCont contp, TSEvent event, void *data)
 
     if (found) {
       Dbg(ats_wasm::dbg_ctl, "[%s] config wasm has not changed", __FUNCTION__);
+      if (old_wasm->poolContext(context)) {
+        TSStatIntIncrement(wasm_stats[WASM_STAT_CONTEXT_POOLED], 1);
+      } else {
+        delete context;
+      }
     } else {
+      // the context and the pooled ones keep the VM from shutting down
+      delete context;
+      TSStatIntDecrement(wasm_stats[WASM_STAT_CONTEXT_POOLED], old_wasm->clearContextPool());
+
       if (old_wasm->readyShutdown()) {
         Dbg(ats_wasm::dbg_ctl, "[%s] starting WasmBase Shutdown", __FUNCTION__);
         old_wasm->startShutdown();
@@ -486,7 +524,8 @@ http_event_handler(TSCont contp, TSEvent event, void *data)
       Dbg(ats_wasm::dbg_ctl, "[%s] config wasm has changed", __FUNCTION__);
     }
 
-    delete context;
+    // the context is deleted or back in the pool, the transaction is reenabled below
+    context = nullptr;
 
     TSContDestroy(contp);
     result = 0;
@@ -536,15 +575,25 @@ global_hook_handler(TSCont /*contp*/, TSEvent /*event*/, void *data)
 {
   auto *txnp = static_cast<TSHttpTxn>(data);
   for (auto it = wasm_config->configs.begin(); it != wasm_config->configs.end(); it++) {
-    std::shared_ptr<ats_wasm::Wasm>         wbp  = it->first;
-    std::shared_ptr<proxy_wasm::PluginBase> plg  = it->second;
-    auto                                   *wasm = wbp.get();
+    std::shared_ptr<ats_wasm::Wasm>         wbp   = it->first;
+    std::shared_ptr<proxy_wasm::PluginBase> plg   = it->second;
+    auto                                   *wasm  = wbp.get();
+    TSHRTime                                start = TShrtime();
     TSMutexLock(wasm->mutex());
-    auto *rootContext = wasm->getRootContext(plg, false);
-    auto *context     = new ats_wasm::Context(wasm, rootContext->id(), plg);
-    context->initialize(txnp);
+    auto *context = wasm->takeContext(plg);
+    if (context != nullptr) {
+      TSStatIntDecrement(wasm_stats[WASM_STAT_CONTEXT_POOLED], 1);
+      TSStatIntIncrement(wasm_stats[WASM_STAT_CONTEXT_REUSED], 1);
+      context->reset(txnp);
+    } else {
+      auto *rootContext = wasm->getRootContext(plg, false);
+      context           = new ats_wasm::Context(wasm, rootContext->id(), plg);
+      context->initialize(txnp);
+      TSStatIntIncrement(wasm_stats[WASM_STAT_CONTEXT_CREATED], 1);
+    }
     context->onCreate();
     TSMutexUnlock(wasm->mutex());
+    TSStatIntIncrement(wasm_stats[WASM_STAT_CONTEXT_SETUP_TIME], TShrtime() - start);
 
     // create continuation for transaction
     TSCont txn_contp = TSContCreate(http_event_handler, nullptr);
@@ -614,13 +663,15 @@ static bool
 read_configuration()
 {
   std::list<std::pair<std::shared_ptr<ats_wasm::Wasm>, std::shared_ptr<proxy_wasm::PluginBase>>> new_configs = {};
+  std::unordered_map<std::string, std::shared_ptr<proxy_wasm::WasmHandleBase>>                   new_modules = {};
 
   for (auto const &cfn : wasm_config->config_filenames) {
     // PluginBase parameters
-    std::string name          = "";
-    std::string root_id       = "";
-    std::string configuration = "";
-    bool        fail_open     = true;
+    std::string name              = "";
+    std::string root_id           = "";
+    std::string configuration     = "";
+    bool        fail_open         = true;
+    size_t      context_pool_size = DEFAULT_CONTEXT_POOL_SIZE;
 
     // WasmBase parameters
     std::string runtime           = "";
@@ -668,6 +719,9 @@ read_configuration()
                 fail_open = false;
               }
             }
+            if (key == "context_pool_size") {
+              context_pool_size = second.as<size_t>();
+            }
           }
           if (second.IsMap() && (key == "capability_restriction_config")) {
             if (second["allowed_capabilities"]) {
@@ -750,42 +804,24 @@ read_configuration()
       return false;
     }
 
-    std::shared_ptr<ats_wasm::Wasm> wasm;
+    proxy_wasm::WasmVmFactory factory;
     if (runtime == "ats.wasm.runtime.wasmedge") {
 #ifdef WASMEDGE
-      wasm = std::make_shared<ats_wasm::Wasm>(proxy_wasm::createWasmEdgeVm(), // VM
-                                              vm_id,                          // vm_id
-                                              vm_configuration,               // vm_configuration
-                                              "",                             // vm_key,
-                                              envs,                           // envs
-                                              cap_maps                        // allowed capabilities
-      );
+      factory = proxy_wasm::createWasmEdgeVm;
 #else
       TSError("[wasm][%s] wasm unable to use WasmEdge runtime", __FUNCTION__);
       return false;
 #endif
     } else if (runtime == "ats.wasm.runtime.wamr") {
 #ifdef WAMR
-      wasm = std::make_shared<ats_wasm::Wasm>(proxy_wasm::createWamrVm(), // VM
-                                              vm_id,                      // vm_id
-                                              vm_configuration,           // vm_configuration
-                                              "",                         // vm_key,
-                                              envs,                       // envs
-                                              cap_maps                    // allowed capabilities
-      );
+      factory = proxy_wasm::createWamrVm;
 #else
       TSError("[wasm][%s] wasm unable to use WAMR runtime", __FUNCTION__);
       return false;
 #endif
     } else if (runtime == "ats.wasm.runtime.wasmtime") {
 #ifdef WASMTIME
-      wasm = std::make_shared<ats_wasm::Wasm>(proxy_wasm::createWasmtimeVm(), // VM
-                                              vm_id,                          // vm_id
-                                              vm_configuration,               // vm_configuration
-                                              "",                             // vm_key,
-                                              envs,                           // envs
-                                              cap_maps                        // allowed capabilities
-      );
+      factory = proxy_wasm::createWasmtimeVm;
 #else
       TSError("[wasm][%s] wasm unable to use Wasmtime runtime", __FUNCTION__);
       return false;
@@ -794,7 +830,6 @@ read_configuration()
       TSError("[wasm][%s] wasm unable to use %s runtime", __FUNCTION__, runtime.c_str());
       return false;
     }
-    wasm->wasm_vm()->integration() = std::make_unique<ats_wasm::ATSWasmVmIntegration>();
 
     auto plugin = std::make_shared<proxy_wasm::PluginBase>(name,          // name
                                                            root_id,       // root_id
@@ -819,18 +854,77 @@ read_configuration()
       return false;
     }
 
-    if (!wasm) {
-      TSError("[wasm][%s] wasm wasm wasm unable to create vm", __FUNCTION__);
-      return false;
+    // the module is keyed with everything a cloned VM takes from it
+    std::string settings = runtime + (allow_precompiled ? "||precompiled||" : "||") + vm_configuration;
+    for (auto const &env : std::map<std::string, std::string>(envs.begin(), envs.end())) {
+      settings += "||" + env.first + "=" + env.second;
+    }
+    for (auto const &cap : std::map<std::string, proxy_wasm::SanitizationConfig>(cap_maps.begin(), cap_maps.end())) {
+      settings += "||" + cap.first;
     }
-    if (!wasm->load(code, allow_precompiled)) {
-      TSError("[wasm][%s] Failed to load Wasm code", __FUNCTION__);
+    std::string module_key = proxy_wasm::makeVmKey(vm_id, settings, code);
+
+    TSHRTime start = TShrtime();
+
+    std::shared_ptr<ats_wasm::Wasm>             wasm;
+    std::shared_ptr<proxy_wasm::WasmHandleBase> module;
+    if (auto it = new_modules.find(module_key); it != new_modules.end()) {
+      module = it->second;
+    } else if (auto it = wasm_config->modules.find(module_key); it != wasm_config->modules.end()) {
+      module = it->second;
+    }
+
+    if (module != nullptr) {
+      Dbg(ats_wasm::dbg_ctl, "[%s] cloning vm from loaded wasm module '%s'", __FUNCTION__, wasm_filename.c_str());
+      TSStatIntIncrement(wasm_stats[WASM_STAT_MODULE_CACHE_HITS], 1);
+      wasm = std::make_shared<ats_wasm::Wasm>(module, factory);
+    } else {
+      TSStatIntIncrement(wasm_stats[WASM_STAT_MODULE_CACHE_MISSES], 1);
+
+      auto vm        = factory();
+      bool cloneable = vm != nullptr && vm->cloneable() != proxy_wasm::Cloneable::NotCloneable;
+      auto base      = std::make_shared<ats_wasm::Wasm>(std::move(vm),    // VM
+                                                        vm_id,            // vm_id
+                                                        vm_configuration, // vm_configuration
+                                                        "",               // vm_key,
+                                                        envs,             // envs
+                                                        cap_maps          // allowed capabilities
+      );
+      if (base->wasm_vm() == nullptr) {
+        TSError("[wasm][%s] wasm unable to create vm", __FUNCTION__);
+        return false;
+      }
+      base->wasm_vm()->integration() = std::make_unique<ats_wasm::ATSWasmVmIntegration>();
+
+      if (!base->load(code, allow_precompiled)) {
+        TSError("[wasm][%s] Failed to load Wasm code", __FUNCTION__);
+        return false;
+      }
+
+      if (cloneable) {
+        // the VM with the compiled module is never started, the VMs of this and later configurations
+        // using the same module are cloned from it
+        module = std::make_shared<proxy_wasm::WasmHandleBase>(base);
+        wasm   = std::make_shared<ats_wasm::Wasm>(module, factory);
+      } else {
+        wasm = base;
+      }
+    }
+    if (module != nullptr) {
+      new_modules[module_key] = module;
+    }
+
+    if (wasm->wasm_vm() == nullptr) {
+      TSError("[wasm][%s] wasm unable to create vm", __FUNCTION__);
       return false;
     }
+    wasm->wasm_vm()->integration() = std::make_unique<ats_wasm::ATSWasmVmIntegration>();
+
     if (!wasm->initialize()) {
       TSError("[wasm][%s] Failed to initialize Wasm code", __FUNCTION__);
       return false;
     }
+    wasm->setContextPoolSize(context_pool_size);
 
     TSCont contp       = TSContCreate(schedule_handler, TSMutexCreate());
     auto  *rootContext = wasm->start(plugin, contp);
@@ -839,6 +933,8 @@ read_configuration()
       TSError("[wasm][%s] Failed to configure Wasm", __FUNCTION__);
       return false;
     }
+    TSStatIntIncrement(wasm_stats[WASM_STAT_VM_INSTANTIATIONS], 1);
+    TSStatIntIncrement(wasm_stats[WASM_STAT_VM_INSTANTIATION_TIME], TShrtime() - start);
 
     auto new_config = std::make_pair(wasm, plugin);
     new_configs.push_front(new_config);
@@ -847,6 +943,7 @@ read_configuration()
   auto old_configs = wasm_config->configs;
 
   wasm_config->configs = new_configs;
+  wasm_config->modules = new_modules;
 
   for (auto it = old_configs.begin(); it != old_configs.end(); it++) {
     std::shared_ptr<ats_wasm::Wasm>         old_wasm   = it->first;
@@ -855,6 +952,7 @@ read_configuration()
     if (old_wasm != nullptr) {
       Dbg(ats_wasm::dbg_ctl, "[%s] previous WasmBase exists", __FUNCTION__);
       TSMutexLock(old_wasm->mutex());
+      TSStatIntDecrement(wasm_stats[WASM_STAT_CONTEXT_POOLED], old_wasm->clearContextPool());
       if (old_wasm->readyShutdown()) {
         Dbg(ats_wasm::dbg_ctl, "[%s] starting WasmBase Shutdown", __FUNCTION__);
         old_wasm->startShutdown();
@@ -904,6 +1002,10 @@ TSPluginInit(int argc, const char *argv[])
 
   wasm_config = std::make_unique<WasmInstanceConfig>();
 
+  for (int i = 0; i < WASM_STAT_COUNT; i++) {
+    wasm_stats[i] = TSStatCreate(wasm_stat_names[i], TS_RECORDDATATYPE_INT, TS_STAT_NON_PERSISTENT, TS_STAT_SYNC_SUM);
+  }
+
   for (int i = 1; i < argc; i++) {
     std::string filename = std::string(argv[i]);
     if (*filename.begin() != '/') {
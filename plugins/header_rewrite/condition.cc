@@ -98,4 +98,9 @@ Condition::initialize(Parser &p)
   }
 
   _cond_op = parse_matcher_op(p.get_arg());
+
+  // The modifiers other than NOCASE are applied to the result by the ruleset.
+  if (cacheable()) {
+    _cse_key = p.get_op() + '\x1f' + p.get_arg() + ((_mods & COND_NOCASE) ? "\x1fNOCASE" : "");
+  }
 }
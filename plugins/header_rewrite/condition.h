@@ -76,6 +76,30 @@ public:
     return false; // Shouldn't happen.
   }
 
+  // Evaluate the condition without its modifiers, for the compiled group of a ruleset. The result
+  // of identical conditions is computed once, until an operator runs.
+  bool
+  test(const Resources &res)
+  {
+    if (_cse_id < 0) {
+      return eval(res);
+    }
+    if (res.cse_known(_cse_id)) {
+      return res.cse_value(_cse_id);
+    }
+
+    bool rt = eval(res);
+
+    res.cse_set(_cse_id, rt);
+    return rt;
+  }
+
+  Condition *
+  next() const
+  {
+    return static_cast<Condition *>(_next);
+  }
+
   bool
   last() const
   {
@@ -115,6 +139,19 @@ public:
     return _qualifier;
   }
 
+  // The condition and its match, for the conditions that can share their result, or empty.
+  const std::string &
+  cse_key() const
+  {
+    return _cse_key;
+  }
+
+  void
+  set_cse_id(int id)
+  {
+    _cse_id = id;
+  }
+
   // Virtual methods, has to be implemented by each conditional;
   void         initialize(Parser &p) override;
   virtual void append_value(std::string &s, const Resources &res) = 0;
@@ -123,6 +160,13 @@ protected:
   // Evaluate the condition
   virtual bool eval(const Resources &res) = 0;
 
+  // Whether the result only depends on the transaction, and can be shared by identical conditions.
+  virtual bool
+  cacheable() const
+  {
+    return false;
+  }
+
   std::string _qualifier;
   const char *_qualifier_wks = nullptr;
   MatcherOps  _cond_op       = MATCH_EQUAL;
@@ -130,4 +174,6 @@ protected:
 
 private:
   CondModifiers _mods = COND_NONE;
+  std::string   _cse_key;
+  int           _cse_id = -1;
 };
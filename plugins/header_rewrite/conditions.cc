@@ -343,11 +343,10 @@ ConditionUrl::append_value(std::string &s, const Resources &res)
     break;
   case URL_QUAL_URL:
   case URL_QUAL_NONE: {
-    // TSUrlStringGet returns an allocated char * we must free
-    char *non_const_q_str = TSUrlStringGet(bufp, url, &i);
-    s.append(non_const_q_str, i);
-    Dbg(pi_dbg_ctl, "   URL to match is: %.*s", i, non_const_q_str);
-    TSfree(non_const_q_str);
+    // The URL string is in the transaction arena, it is released with the transaction
+    q_str = TSHttpTxnArenaUrlStringGet(res.txnp, bufp, url, &i);
+    s.append(q_str, i);
+    Dbg(pi_dbg_ctl, "   URL to match is: %.*s", i, q_str);
     break;
   }
   }
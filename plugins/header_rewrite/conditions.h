@@ -124,6 +124,12 @@ public:
 
 protected:
   bool eval(const Resources &res) override;
+
+  bool
+  cacheable() const override
+  {
+    return true;
+  }
 };
 
 // Random 0 to (N-1)
@@ -188,6 +194,12 @@ public:
 protected:
   bool eval(const Resources &res) override;
 
+  bool
+  cacheable() const override
+  {
+    return true;
+  }
+
 private:
   // Nginx-style cookie parsing:
   //   nginx/src/http/ngx_http_parse.c:ngx_http_parse_multi_header_lines()
@@ -260,6 +272,12 @@ public:
 protected:
   bool eval(const Resources &res) override;
 
+  bool
+  cacheable() const override
+  {
+    return true;
+  }
+
 private:
   bool _client;
 };
@@ -285,6 +303,12 @@ public:
 protected:
   bool eval(const Resources &res) override;
 
+  bool
+  cacheable() const override
+  {
+    return true;
+  }
+
 private:
   UrlQualifiers _url_qual = URL_QUAL_NONE;
   UrlType       _type;
@@ -362,6 +386,12 @@ public:
 protected:
   bool eval(const Resources &res) override;
 
+  bool
+  cacheable() const override
+  {
+    return true;
+  }
+
 private:
   IpQualifiers _ip_qual = IP_QUAL_CLIENT;
 };
@@ -441,7 +471,14 @@ private:
   virtual std::string get_geo_string(const sockaddr *addr) const;
 
 protected:
-  bool          eval(const Resources &res) override;
+  bool eval(const Resources &res) override;
+
+  bool
+  cacheable() const override
+  {
+    return true;
+  }
+
   GeoQualifiers _geo_qual = GEO_QUAL_COUNTRY;
   bool          _int_type = false;
 };
@@ -490,6 +527,12 @@ public:
 protected:
   bool eval(const Resources &res) override;
 
+  bool
+  cacheable() const override
+  {
+    return true;
+  }
+
 private:
   void           _create_masks();
   int            _v4_cidr = 24;
@@ -679,6 +722,13 @@ public:
     return _end;
   }
 
+  // First condition of the group (linked list).
+  Condition *
+  conditions() const
+  {
+    return _cond;
+  }
+
   void
   append_value(std::string & /* s ATS_UNUSED */, const Resources & /* res ATS_UNUSED */) override
   {
@@ -21,6 +21,7 @@
 #include <string>
 #include <stack>
 #include <stdexcept>
+#include <unordered_map>
 #include <getopt.h>
 
 #include "ts/ts.h"
@@ -306,6 +307,15 @@ RulesConfig::parse_config(const std::string &fname, TSHttpHookID default_hook, c
     }
   }
 
+  // Compile the conditions of all the rules, including the remap rules.
+  std::unordered_map<std::string, int> cse_ids;
+
+  for (int i = TS_HTTP_READ_REQUEST_HDR_HOOK; i <= TS_HTTP_LAST_HOOK; ++i) { // lgtm[cpp/constant-comparison]
+    for (RuleSet *rule = _rules[i]; rule; rule = rule->next) {
+      rule->compile(cse_ids);
+    }
+  }
+
   return true;
 }
 
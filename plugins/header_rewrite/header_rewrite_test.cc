@@ -24,8 +24,11 @@
 #include <cstdarg>
 #include <iostream>
 #include <ostream>
+#include <vector>
 
 #include "parser.h"
+#include "program.h"
+#include "regex_helper.h"
 
 namespace header_rewrite_ns
 {
@@ -93,6 +96,24 @@ public:
   bool res;
 };
 
+class ResultTest
+{
+public:
+  ResultTest(const std::string &name) : res(true) { std::cout << "Finished test: " << name << std::endl; }
+
+  template <typename T, typename U>
+  void
+  do_parser_check(T x, U y, int line = 0)
+  {
+    if (x != y) {
+      std::cerr << "CHECK FAILED on line " << line << ": |" << x << "| != |" << y << "|" << std::endl;
+      res = false;
+    }
+  }
+
+  bool res;
+};
+
 #define CHECK_EQ(x, y)                     \
   do {                                     \
     p.do_parser_check((x), (y), __LINE__); \
@@ -538,10 +559,213 @@ test_tokenizer()
   return errors;
 }
 
+// A condition of a group for the reference evaluator, the same modifiers as a Condition.
+struct TestCondition {
+  int                        leaf = -1; // Bit of the leaf values, or -1 for a nested group
+  std::vector<TestCondition> group;
+  bool                       negate = false;
+  bool                       is_or  = false;
+  bool                       last   = false; // [L] only ends the rules after this one, it is not part of the decision
+};
+
+// This is Condition::do_eval(), and ConditionGroup::eval() for the nested groups.
+static bool
+reference_eval(const std::vector<TestCondition> &conds, size_t i, unsigned values)
+{
+  if (conds.empty()) {
+    return true;
+  }
+
+  const TestCondition &cond = conds[i];
+  bool                 rt   = cond.leaf >= 0 ? (values >> cond.leaf) & 1 : reference_eval(cond.group, 0, values);
+
+  if (cond.negate) {
+    rt = !rt;
+  }
+  if (i + 1 < conds.size()) {
+    if (cond.is_or) {
+      return rt || reference_eval(conds, i + 1, values);
+    }
+    return rt ? reference_eval(conds, i + 1, values) : false;
+  }
+  return rt;
+}
+
+struct TestLeaf {
+  int bit;
+};
+
+static std::vector<BranchProgram<TestLeaf>::Node>
+to_nodes(const std::vector<TestCondition> &conds, std::vector<TestLeaf> &leaves)
+{
+  std::vector<BranchProgram<TestLeaf>::Node> nodes;
+
+  for (const auto &cond : conds) {
+    auto &node = nodes.emplace_back();
+
+    node.negate = cond.negate;
+    node.is_or  = cond.is_or;
+    if (cond.leaf >= 0) {
+      node.leaf = &leaves[cond.leaf];
+    } else {
+      node.group = to_nodes(cond.group, leaves);
+    }
+  }
+  return nodes;
+}
+
+// A group of up to 4 conditions with random modifiers, each of them nested up to @a depth.
+static std::vector<TestCondition>
+random_group(unsigned &seed, int depth, int &nleaves)
+{
+  std::vector<TestCondition> conds;
+  auto                       next = [&seed]() { return (seed = seed * 1103515245 + 12345) >> 16; };
+  int                        n    = next() % 4 + (depth == 2 ? 1 : 0);
+
+  for (int i = 0; i < n; ++i) {
+    auto    &cond = conds.emplace_back();
+    unsigned r    = next();
+
+    cond.negate = r & 1;
+    cond.is_or  = r & 2;
+    cond.last   = r & 4;
+    if (depth > 0 && (r & 24) == 0) {
+      cond.group = random_group(seed, depth - 1, nleaves);
+    } else {
+      cond.leaf = nleaves++ % 8;
+    }
+  }
+  return conds;
+}
+
+int
+test_branch_program()
+{
+  int        errors = 0;
+  ResultTest p("BranchProgram");
+
+  // Hand written rules, a [AND] b [OR] NOT c, which is a AND (b OR NOT c), and NOT (a [OR] b) [AND] c [L].
+  {
+    std::vector<TestCondition> conds(3);
+
+    conds[0].leaf   = 0;
+    conds[1].leaf   = 1;
+    conds[1].is_or  = true;
+    conds[2].leaf   = 2;
+    conds[2].negate = true;
+
+    std::vector<TestLeaf>   leaves = {{0}, {1}, {2}};
+    BranchProgram<TestLeaf> program;
+
+    program.compile(to_nodes(conds, leaves));
+    CHECK_EQ(program.size(), 3UL);
+    for (unsigned values = 0; values < 8; ++values) {
+      CHECK_EQ(program.run([values](TestLeaf &l) { return bool((values >> l.bit) & 1); }), reference_eval(conds, 0, values));
+    }
+  }
+
+  {
+    std::vector<TestCondition> conds(2);
+
+    conds[0].group.resize(2);
+    conds[0].group[0].leaf  = 0;
+    conds[0].group[0].is_or = true;
+    conds[0].group[1].leaf  = 1;
+    conds[0].negate         = true;
+    conds[1].leaf           = 2;
+    conds[1].last           = true;
+
+    std::vector<TestLeaf>   leaves = {{0}, {1}, {2}};
+    BranchProgram<TestLeaf> program;
+
+    program.compile(to_nodes(conds, leaves));
+    CHECK_EQ(program.size(), 3UL);
+    for (unsigned values = 0; values < 8; ++values) {
+      bool expect = !((values & 1) || (values & 2)) && (values & 4);
+
+      CHECK_EQ(reference_eval(conds, 0, values), expect);
+      CHECK_EQ(program.run([values](TestLeaf &l) { return bool((values >> l.bit) & 1); }), expect);
+    }
+  }
+
+  // An empty group is true, as is a rule without conditions.
+  {
+    BranchProgram<TestLeaf> program;
+
+    program.compile({});
+    CHECK_EQ(program.run([](TestLeaf &) { return false; }), true);
+  }
+
+  // Every combination of [AND], [OR], [NOT] and [L] in random nested groups, against all leaf values.
+  unsigned              seed   = 42;
+  std::vector<TestLeaf> leaves = {{0}, {1}, {2}, {3}, {4}, {5}, {6}, {7}};
+
+  for (int rule = 0; rule < 2000; ++rule) {
+    int                        nleaves = 0;
+    std::vector<TestCondition> conds   = random_group(seed, 2, nleaves);
+    BranchProgram<TestLeaf>    program;
+
+    program.compile(to_nodes(conds, leaves));
+    CHECK_EQ(program.size(), static_cast<size_t>(nleaves));
+    for (unsigned values = 0; values < 256; ++values) {
+      CHECK_EQ(program.run([values](TestLeaf &l) { return bool((values >> l.bit) & 1); }), reference_eval(conds, 0, values));
+    }
+  }
+
+  END_TEST();
+
+  return errors;
+}
+
+int
+test_literal_prefix()
+{
+  int        errors = 0;
+  ResultTest p("literal_prefix");
+
+  // Anchors
+  CHECK_EQ(literal_prefix("^/api/v[0-9]+/"), "/api/v");
+  CHECK_EQ(literal_prefix("/api/v1"), "");
+  CHECK_EQ(literal_prefix("^"), "");
+  CHECK_EQ(literal_prefix(""), "");
+  CHECK_EQ(literal_prefix("^/index.html$"), "/index");
+  CHECK_EQ(literal_prefix("^/exact$"), "/exact");
+  CHECK_EQ(literal_prefix("^^/x"), "");
+
+  // Escapes
+  CHECK_EQ(literal_prefix(R"(^/a\.html)"), "/a.html");
+  CHECK_EQ(literal_prefix(R"(^\/foo\/bar)"), "/foo/bar");
+  CHECK_EQ(literal_prefix(R"(^/a\d+)"), "/a");
+  CHECK_EQ(literal_prefix(R"(^/a\b)"), "/a");
+  CHECK_EQ(literal_prefix(R"(^/a\)"), "/a");
+  CHECK_EQ(literal_prefix(R"(^/a\.?b)"), "/a");
+  CHECK_EQ(literal_prefix(R"(^/a\++)"), "/a+");
+
+  // Alternation, anywhere in the regex
+  CHECK_EQ(literal_prefix("^/a|^/b"), "");
+  CHECK_EQ(literal_prefix("^/(a|b)"), "");
+  CHECK_EQ(literal_prefix(R"(^/a\|b)"), "");
+
+  // Character classes, groups and quantifiers
+  CHECK_EQ(literal_prefix("^[/]abc"), "");
+  CHECK_EQ(literal_prefix("^/ab[cd]"), "/ab");
+  CHECK_EQ(literal_prefix("^/a.c"), "/a");
+  CHECK_EQ(literal_prefix("^/ab*"), "/a");
+  CHECK_EQ(literal_prefix("^/ab?"), "/a");
+  CHECK_EQ(literal_prefix("^/ab{2}"), "/a");
+  CHECK_EQ(literal_prefix("^/ab+c"), "/ab");
+  CHECK_EQ(literal_prefix("^/a(b)"), "/a");
+  CHECK_EQ(literal_prefix("^(?i)/a"), "");
+
+  END_TEST();
+
+  return errors;
+}
+
 int
 main()
 {
-  if (test_parsing() || test_processing() || test_tokenizer()) {
+  if (test_parsing() || test_processing() || test_tokenizer() || test_branch_program() || test_literal_prefix()) {
     return 1;
   }
 
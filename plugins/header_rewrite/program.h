@@ -0,0 +1,118 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+//////////////////////////////////////////////////////////////////////////////////////////////
+//
+// A condition group compiled to a flat program of tests and jumps.
+//
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// The conditions of a group are a linked list, evaluated from left to right with the
+// [AND] / [OR] of each condition applying to the result of all the conditions after it,
+// and nested groups. The program is the same decision, without the recursion: every test
+// jumps to the next test to run, or to the result, depending on its outcome. The [NOT]
+// of a condition or a group only swaps its jumps.
+//
+template <class Leaf> class BranchProgram
+{
+public:
+  static constexpr int ACCEPT = -1;
+  static constexpr int REJECT = -2;
+
+  // One condition of a group, or a nested group, as input to compile().
+  struct Node {
+    Leaf             *leaf = nullptr; // nullptr for a nested group
+    std::vector<Node> group;
+    bool              negate = false;
+    bool              is_or  = false;
+  };
+
+  struct Test {
+    Leaf *leaf;
+    int   on_true;
+    int   on_false;
+  };
+
+  void
+  compile(const std::vector<Node> &group)
+  {
+    _tests.clear();
+    _entry = compile_group(group, ACCEPT, REJECT);
+  }
+
+  // Run the tests, @a test evaluates one leaf without its modifiers.
+  template <typename F>
+  bool
+  run(F &&test) const
+  {
+    int pc = _entry;
+
+    while (pc >= 0) {
+      const Test &t = _tests[pc];
+
+      pc = test(*t.leaf) ? t.on_true : t.on_false;
+    }
+    return pc == ACCEPT;
+  }
+
+  size_t
+  size() const
+  {
+    return _tests.size();
+  }
+
+private:
+  // Returns the first test of the group, the tests are added from the last one, so that
+  // the jumps of each test are known when it is added.
+  int
+  compile_group(const std::vector<Node> &group, int on_true, int on_false)
+  {
+    int next = on_true; // An empty group is true
+
+    for (auto node = group.rbegin(); node != group.rend(); ++node) {
+      int t = on_true;
+      int f = on_false;
+
+      if (node != group.rbegin()) {
+        if (node->is_or) {
+          f = next;
+        } else {
+          t = next;
+        }
+      }
+      if (node->negate) {
+        std::swap(t, f);
+      }
+
+      if (node->leaf) {
+        _tests.push_back({node->leaf, t, f});
+        next = static_cast<int>(_tests.size()) - 1;
+      } else {
+        next = compile_group(node->group, t, f);
+      }
+    }
+    return next;
+  }
+
+  std::vector<Test> _tests;
+  int               _entry = ACCEPT;
+};
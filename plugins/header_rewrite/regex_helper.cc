@@ -15,8 +15,55 @@
   See the License for the specific language governing permissions and
   limitations under the License.
 */
+#include <cctype>
+#include <cstring>
+#include <strings.h>
+
 #include "regex_helper.h"
 
+// The literal prefix of the matches of a regex anchored with ^, e.g. "/api/v" for ^/api/v[0-9]+/.
+// This is conservative, any construct that is not a plain literal ends the prefix, and a regex with
+// alternatives has none.
+std::string
+literal_prefix(const std::string &s)
+{
+  std::string prefix;
+
+  if (s.size() < 2 || s[0] != '^' || s.find('|') != std::string::npos) {
+    return prefix;
+  }
+
+  for (size_t i = 1; i < s.size();) {
+    char   c   = s[i];
+    size_t len = 1;
+
+    if (c == '\\') {
+      // An escaped punctuation character is a literal, the alphanumeric escapes are classes or assertions.
+      if (i + 1 == s.size() || !std::ispunct(static_cast<unsigned char>(s[i + 1]))) {
+        break;
+      }
+      c   = s[i + 1];
+      len = 2;
+    } else if (std::strchr("^$.[]()*+?{}", c) != nullptr) {
+      break;
+    }
+
+    // A quantifier makes the character optional, but + still requires it once.
+    char quantifier = i + len < s.size() ? s[i + len] : '\0';
+
+    if (quantifier == '*' || quantifier == '?' || quantifier == '{') {
+      break;
+    }
+    prefix += c;
+    if (quantifier == '+') {
+      break;
+    }
+    i += len;
+  }
+
+  return prefix;
+}
+
 bool
 regexHelper::setRegexMatch(const std::string &s, bool nocase)
 {
@@ -25,6 +72,8 @@ regexHelper::setRegexMatch(const std::string &s, bool nocase)
   int         erroffset;
 
   regexString = s;
+  regexPrefix = literal_prefix(s);
+  regexNocase = nocase;
   regex       = pcre_compile(regexString.c_str(), nocase ? PCRE_CASELESS : 0, &errorComp, &erroffset, nullptr);
 
   if (regex == nullptr) {
@@ -43,6 +92,16 @@ regexHelper::setRegexMatch(const std::string &s, bool nocase)
 int
 regexHelper::regexMatch(const char *str, int len, int ovector[]) const
 {
+  // Most of the regexes of a large ruleset do not match, which the prefix usually tells without running the regex.
+  if (!regexPrefix.empty()) {
+    size_t plen = regexPrefix.size();
+
+    if (static_cast<size_t>(len) < plen ||
+        (regexNocase ? strncasecmp(str, regexPrefix.data(), plen) : memcmp(str, regexPrefix.data(), plen)) != 0) {
+      return PCRE_ERROR_NOMATCH;
+    }
+  }
+
   return pcre_exec(regex,      // the compiled pattern
                    regexExtra, // Extra data from study (maybe)
                    str,        // the subject std::string
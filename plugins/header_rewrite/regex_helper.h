@@ -29,6 +29,9 @@
 
 const int OVECCOUNT = 30; // We support $1 - $9 only, and this needs to be 3x that
 
+// The literal prefix of every match of the regex @a s, or empty if there is none.
+std::string literal_prefix(const std::string &s);
+
 class regexHelper
 {
 public:
@@ -43,7 +46,9 @@ public:
 
 private:
   std::string regexString;
+  std::string regexPrefix; // Literal prefix of every match, checked before running the regex
   pcre       *regex       = nullptr;
   pcre_extra *regexExtra  = nullptr;
   int         regexCcount = 0;
+  bool        regexNocase = false;
 };
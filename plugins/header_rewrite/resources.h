@@ -21,6 +21,7 @@
 //
 #pragma once
 
+#include <bitset>
 #include <string>
 
 #include "ts/ts.h"
@@ -66,6 +67,35 @@ public:
     return _ready;
   }
 
+  // Results of the conditions shared by identical conditions, see Condition::test().
+  static constexpr int MAX_CSE_IDS = 256;
+
+  bool
+  cse_known(int id) const
+  {
+    return _cse_known.test(id);
+  }
+
+  bool
+  cse_value(int id) const
+  {
+    return _cse_value.test(id);
+  }
+
+  void
+  cse_set(int id, bool value) const
+  {
+    _cse_known.set(id);
+    _cse_value.set(id, value);
+  }
+
+  // Operators can change what the conditions evaluate.
+  void
+  cse_clear() const
+  {
+    _cse_known.reset();
+  }
+
   TSHttpTxn           txnp;
   TSCont              contp          = nullptr;
   TSRemapRequestInfo *_rri           = nullptr;
@@ -79,5 +109,7 @@ public:
 private:
   void destroy();
 
-  bool _ready = false;
+  bool                             _ready = false;
+  mutable std::bitset<MAX_CSE_IDS> _cse_known;
+  mutable std::bitset<MAX_CSE_IDS> _cse_value;
 };
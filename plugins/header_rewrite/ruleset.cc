@@ -108,6 +108,45 @@ RuleSet::add_operator(Parser &p, const char *filename, int lineno)
   return false;
 }
 
+// Flatten the conditions of a group for BranchProgram, the [NOT] of each condition and group is in its node.
+static std::vector<BranchProgram<Condition>::Node>
+flatten_group(const ConditionGroup *group, std::unordered_map<std::string, int> &cse_ids)
+{
+  std::vector<BranchProgram<Condition>::Node> nodes;
+
+  for (Condition *cond = group->conditions(); cond; cond = cond->next()) {
+    auto &node = nodes.emplace_back();
+
+    node.negate = cond->mods() & COND_NOT;
+    node.is_or  = cond->mods() & COND_OR;
+    if (auto *nested = dynamic_cast<const ConditionGroup *>(cond); nested) {
+      node.group = flatten_group(nested, cse_ids);
+    } else {
+      node.leaf = cond;
+      // Identical conditions share the id of their result.
+      if (!cond->cse_key().empty()) {
+        auto [spot, added] = cse_ids.try_emplace(cond->cse_key(), static_cast<int>(cse_ids.size()));
+
+        if (spot->second < Resources::MAX_CSE_IDS) {
+          cond->set_cse_id(spot->second);
+        }
+      }
+    }
+  }
+
+  return nodes;
+}
+
+// Compile the conditions of this rule, once the rule is complete. The ids of the conditions that
+// share their result are unique within @a cse_ids.
+void
+RuleSet::compile(std::unordered_map<std::string, int> &cse_ids)
+{
+  _program.compile(flatten_group(&_group, cse_ids));
+  _compiled = true;
+  Dbg(pi_dbg_ctl, "    Compiled rule for hook=%s to %zu tests", TSHttpHookNameLookup(_hook), _program.size());
+}
+
 ResourceIDs
 RuleSet::get_all_resource_ids() const
 {
@@ -22,6 +22,7 @@
 #pragma once
 
 #include <string>
+#include <unordered_map>
 
 #include <tscore/ink_assert.h>
 
@@ -30,6 +31,7 @@
 #include "resources.h"
 #include "parser.h"
 #include "conditions.h"
+#include "program.h"
 
 ///////////////////////////////////////////////////////////////////////////////
 // Class holding one ruleset. A ruleset is one (or more) pre-conditions, and
@@ -68,6 +70,7 @@ public:
   Condition  *make_condition(Parser &p, const char *filename, int lineno);
   bool        add_operator(Parser &p, const char *filename, int lineno);
   ResourceIDs get_all_resource_ids() const;
+  void        compile(std::unordered_map<std::string, int> &cse_ids);
 
   bool
   has_operator() const
@@ -120,6 +123,7 @@ public:
 
     auto no_reenable_count{ops.oper->do_exec(res)};
 
+    res.cse_clear();
     ink_assert(no_reenable_count < 2);
     if (no_reenable_count) {
       return static_cast<OperModifiers>(ops.oper_mods | OPER_NO_REENABLE);
@@ -131,7 +135,9 @@ public:
   const OperatorPair &
   eval(const Resources &res)
   {
-    if (_group.eval(res)) {
+    bool matched = _compiled ? _program.run([&res](Condition &cond) { return cond.test(res); }) : _group.eval(res);
+
+    if (matched) {
       return _operators[0]; // IF conditions
     } else {
       return _operators[1]; // ELSE conditions
@@ -141,8 +147,10 @@ public:
   RuleSet *next = nullptr; // Linked list
 
 private:
-  ConditionGroup _group;        // All conditions are now wrapped in a group
-  OperatorPair   _operators[2]; // Holds both the IF and the ELSE set of operators
+  ConditionGroup           _group;        // All conditions are now wrapped in a group
+  OperatorPair             _operators[2]; // Holds both the IF and the ELSE set of operators
+  BranchProgram<Condition> _program;      // The conditions of the group, see compile()
+  bool                     _compiled = false;
 
   // State values (updated when conds / operators are added)
   TSHttpHookID _hook    = TS_HTTP_READ_RESPONSE_HDR_HOOK; // Which hook is this rule for
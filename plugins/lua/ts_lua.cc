@@ -34,10 +34,12 @@ extern "C" {
 #define TS_LUA_STATS_TIMEOUT     5000 // 5s -- convert to configurable
 #define TS_LUA_STATS_BUFFER_SIZE 10   // stats buffer
 
-#define TS_LUA_IND_STATE    0
-#define TS_LUA_IND_GC_BYTES 1
-#define TS_LUA_IND_THREADS  2
-#define TS_LUA_IND_SIZE     3
+#define TS_LUA_IND_STATE     0
+#define TS_LUA_IND_GC_BYTES  1
+#define TS_LUA_IND_THREADS   2
+#define TS_LUA_IND_GC_STEPS  3
+#define TS_LUA_IND_GC_CYCLES 4
+#define TS_LUA_IND_SIZE      5
 
 static uint64_t ts_lua_http_next_id   = 0;
 static uint64_t ts_lua_g_http_next_id = 0;
@@ -64,20 +66,26 @@ static char const *const ts_lua_stat_strs[] = {
   "plugin.lua.remap.states",
   "plugin.lua.remap.gc_bytes",
   "plugin.lua.remap.threads",
+  "plugin.lua.remap.gc_steps",
+  "plugin.lua.remap.gc_cycles",
   nullptr,
 };
 static char const *const ts_lua_g_stat_strs[] = {
   "plugin.lua.global.states",
   "plugin.lua.global.gc_bytes",
   "plugin.lua.global.threads",
+  "plugin.lua.global.gc_steps",
+  "plugin.lua.global.gc_cycles",
   nullptr,
 };
 
 typedef struct {
   ts_lua_main_ctx *main_ctx_array;
 
-  TSMgmtInt gc_kb;   // last collected gc in kb
-  TSMgmtInt threads; // last collected number active threads
+  TSMgmtInt gc_kb;     // last collected gc in kb
+  TSMgmtInt threads;   // last collected number active threads
+  TSMgmtInt gc_steps;  // incremental gc steps after the hooks
+  TSMgmtInt gc_cycles; // gc cycles finished by these steps
 
   int stat_inds[TS_LUA_IND_SIZE]; // stats indices
 
@@ -175,8 +183,10 @@ create_lua_vms()
 static void
 collectStats(ts_lua_plugin_stats *const plugin_stats)
 {
-  TSMgmtInt gc_kb_total   = 0;
-  TSMgmtInt threads_total = 0;
+  TSMgmtInt gc_kb_total     = 0;
+  TSMgmtInt threads_total   = 0;
+  TSMgmtInt gc_steps_total  = 0;
+  TSMgmtInt gc_cycles_total = 0;
 
   ts_lua_main_ctx *const main_ctx_array = plugin_stats->main_ctx_array;
 
@@ -187,15 +197,19 @@ collectStats(ts_lua_plugin_stats *const plugin_stats)
       ts_lua_ctx_stats *const stats = main_ctx->stats;
 
       TSMutexLock(stats->mutexp);
-      gc_kb_total   += stats->gc_kb;
-      threads_total += stats->threads;
+      gc_kb_total     += stats->gc_kb;
+      threads_total   += stats->threads;
+      gc_steps_total  += stats->gc_steps;
+      gc_cycles_total += stats->gc_cycles;
       TSMutexUnlock(stats->mutexp);
     }
   }
 
   // set the stats sample slot
-  plugin_stats->gc_kb   = gc_kb_total;
-  plugin_stats->threads = threads_total;
+  plugin_stats->gc_kb     = gc_kb_total;
+  plugin_stats->threads   = threads_total;
+  plugin_stats->gc_steps  = gc_steps_total;
+  plugin_stats->gc_cycles = gc_cycles_total;
 }
 
 static void
@@ -204,6 +218,8 @@ publishStats(ts_lua_plugin_stats *const plugin_stats)
   TSMgmtInt const gc_bytes = plugin_stats->gc_kb * 1024;
   TSStatIntSet(plugin_stats->stat_inds[TS_LUA_IND_GC_BYTES], gc_bytes);
   TSStatIntSet(plugin_stats->stat_inds[TS_LUA_IND_THREADS], plugin_stats->threads);
+  TSStatIntSet(plugin_stats->stat_inds[TS_LUA_IND_GC_STEPS], plugin_stats->gc_steps);
+  TSStatIntSet(plugin_stats->stat_inds[TS_LUA_IND_GC_CYCLES], plugin_stats->gc_cycles);
 }
 
 // dump exhaustive per state summary stats
@@ -290,8 +306,11 @@ lifecycleHandler(TSCont contp, TSEvent /* event ATS_UNUSED */, void *edata)
 
         case Print:
         default:
-          fprintf(stderr, "[%s] %s (%s) id: %3d gc_kb: %6d gc_kb_max: %6d threads: %4d threads_max: %4d\n", timebuf,
-                  TS_LUA_DEBUG_TAG, labelstr, index, stats->gc_kb, stats->gc_kb_max, stats->threads, stats->threads_max);
+          fprintf(stderr,
+                  "[%s] %s (%s) id: %3d gc_kb: %6d gc_kb_max: %6d threads: %4d threads_max: %4d gc_steps: %" PRId64
+                  " gc_cycles: %" PRId64 "\n",
+                  timebuf, TS_LUA_DEBUG_TAG, labelstr, index, stats->gc_kb, stats->gc_kb_max, stats->threads, stats->threads_max,
+                  stats->gc_steps, stats->gc_cycles);
           break;
         }
 
@@ -347,13 +366,15 @@ TSRemapNewInstance(int argc, char *argv[], void **ih, char *errbuf, int errbuf_s
   int                        fn                                     = 0;
   int                        states                                 = ts_lua_max_state_count;
   int                        ljgc                                   = 0;
+  int                        gc_step                                = 0;
   int                        jit                                    = 1;
   static const struct option longopt[]                              = {
-    {"states", required_argument, 0, 's'},
-    {"jit",    required_argument, 0, 'j'},
-    {"inline", required_argument, 0, 'i'},
-    {"ljgc",   required_argument, 0, 'g'},
-    {0,        0,                 0, 0  },
+    {"states",  required_argument, 0, 's'},
+    {"jit",     required_argument, 0, 'j'},
+    {"inline",  required_argument, 0, 'i'},
+    {"ljgc",    required_argument, 0, 'g'},
+    {"gc-step", required_argument, 0, 'c'},
+    {0,         0,                 0, 0  },
   };
 
   argc--;
@@ -388,6 +409,10 @@ TSRemapNewInstance(int argc, char *argv[], void **ih, char *errbuf, int errbuf_s
     case 'g':
       ljgc = atoi(optarg);
       break;
+    case 'c':
+      gc_step = atoi(optarg);
+      Dbg(dbg_ctl, "[%s] setting gc step after each hook [%d KB]", __FUNCTION__, gc_step);
+      break;
     }
 
     if (opt == -1) {
@@ -450,6 +475,7 @@ TSRemapNewInstance(int argc, char *argv[], void **ih, char *errbuf, int errbuf_s
     conf->init_func = 0;
     conf->ref_count = 1;
     conf->ljgc      = ljgc;
+    conf->gc_step   = gc_step;
 
     Dbg(dbg_ctl, "Reference Count = %d , creating new instance...", conf->ref_count);
 
@@ -574,6 +600,8 @@ ts_lua_remap_plugin_init(void *ih, TSHttpTxn rh, TSRemapRequestInfo *rri)
     ts_lua_destroy_http_ctx(http_ctx);
   }
 
+  ts_lua_update_gc_stats(main_ctx, instance_conf);
+
   TSMutexUnlock(main_ctx->mutexp);
 
   return TSRemapStatus(ret);
@@ -816,6 +844,8 @@ globalHookHandler(TSCont contp, TSEvent event ATS_UNUSED, void *edata)
     ts_lua_destroy_http_ctx(http_ctx);
   }
 
+  ts_lua_update_gc_stats(main_ctx, conf);
+
   TSMutexUnlock(main_ctx->mutexp);
 
   if (ret) {
@@ -865,10 +895,12 @@ TSPluginInit(int argc, const char *argv[])
 
   int                        jit       = 1;
   int                        reload    = 0;
+  int                        gc_step   = 0;
   static const struct option longopt[] = {
     {"states",        required_argument, 0, 's'},
     {"jit",           required_argument, 0, 'j'},
     {"enable-reload", no_argument,       0, 'r'},
+    {"gc-step",       required_argument, 0, 'c'},
     {0,               0,                 0, 0  },
   };
 
@@ -898,6 +930,10 @@ TSPluginInit(int argc, const char *argv[])
       reload = 1;
       Dbg(dbg_ctl, "[%s] enable global plugin reload [%d]", __FUNCTION__, reload);
       break;
+    case 'c':
+      gc_step = atoi(optarg);
+      Dbg(dbg_ctl, "[%s] setting gc step after each hook [%d KB]", __FUNCTION__, gc_step);
+      break;
     }
 
     if (opt == -1) {
@@ -926,8 +962,9 @@ TSPluginInit(int argc, const char *argv[])
     return;
   }
   memset(conf, 0, sizeof(ts_lua_instance_conf));
-  conf->remap  = 0;
-  conf->states = states;
+  conf->remap   = 0;
+  conf->states  = states;
+  conf->gc_step = gc_step;
 
   if (argv[optind][0] == '/') {
     snprintf(conf->script, TS_LUA_MAX_SCRIPT_FNAME_LENGTH, "%s", argv[optind]);
@@ -19,6 +19,7 @@
 #include <netinet/in.h>
 #include <arpa/inet.h>
 #include "ts_lua_util.h"
+#include "ts_lua_header_view.h"
 
 static void ts_lua_inject_client_request_client_addr_api(lua_State *L);
 static void ts_lua_inject_client_request_server_addr_api(lua_State *L);
@@ -84,6 +85,7 @@ ts_lua_inject_client_request_api(lua_State *L)
   ts_lua_inject_client_request_socket_api(L);
   ts_lua_inject_client_request_header_api(L);
   ts_lua_inject_client_request_header_table_api(L);
+  ts_lua_inject_header_view_func(L, TS_LUA_HEADER_CLIENT_REQUEST);
   ts_lua_inject_client_request_headers_api(L);
   ts_lua_inject_client_request_url_api(L);
   ts_lua_inject_client_request_uri_api(L);
@@ -17,6 +17,7 @@
 */
 
 #include "ts_lua_util.h"
+#include "ts_lua_header_view.h"
 
 #define TS_LUA_CHECK_CLIENT_RESPONSE_HDR(http_ctx)                                                                    \
   do {                                                                                                                \
@@ -56,6 +57,7 @@ ts_lua_inject_client_response_api(lua_State *L)
 
   ts_lua_inject_client_response_header_api(L);
   ts_lua_inject_client_response_header_table_api(L);
+  ts_lua_inject_header_view_func(L, TS_LUA_HEADER_CLIENT_RESPONSE);
   ts_lua_inject_client_response_headers_api(L);
   ts_lua_inject_client_response_misc_api(L);
 
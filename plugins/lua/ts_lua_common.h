@@ -101,6 +101,7 @@ typedef struct {
   int remap;
   int states;
   int ljgc;
+  int gc_step; // kbytes of incremental gc run after each hook, 0 to only rely on the automatic gc
   int ref_count;
 
   int init_func;
@@ -38,6 +38,8 @@ typedef struct {
   int     gc_kb_max;   // maximum recorded gc kbytes
   int     threads;     // associated coroutines
   int     threads_max; // max coroutines
+  int64_t gc_steps;    // incremental gc steps run after the hooks
+  int64_t gc_cycles;   // gc cycles finished by these steps
 } ts_lua_ctx_stats;
 
 /* main context*/
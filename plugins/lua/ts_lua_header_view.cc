@@ -0,0 +1,409 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <strings.h>
+#include "ts_lua_util.h"
+#include "ts_lua_header_view.h"
+
+#define TS_LUA_HEADER_VIEW_MT "ts_lua_header_view"
+
+/*
+ * A header view is a field name bound to one of the headers of the transaction. It is created
+ * once, usually when the script is loaded, and reads the field in place in the header of the
+ * transaction that runs the hook, so comparing or searching a value does not create a lua string.
+ * The name is the well known string of the core if there is one, which the header lookup finds
+ * without hashing the name.
+ */
+typedef struct {
+  TSLuaHeaderKind kind;
+  const char     *name; // a well known string, or the copy after the view
+  int             name_len;
+} ts_lua_header_view;
+
+static const char **ts_lua_mime_field_names[] = {
+  &TS_MIME_FIELD_ACCEPT,
+  &TS_MIME_FIELD_ACCEPT_CHARSET,
+  &TS_MIME_FIELD_ACCEPT_ENCODING,
+  &TS_MIME_FIELD_ACCEPT_LANGUAGE,
+  &TS_MIME_FIELD_ACCEPT_RANGES,
+  &TS_MIME_FIELD_AGE,
+  &TS_MIME_FIELD_ALLOW,
+  &TS_MIME_FIELD_AUTHORIZATION,
+  &TS_MIME_FIELD_CACHE_CONTROL,
+  &TS_MIME_FIELD_CLIENT_IP,
+  &TS_MIME_FIELD_CONNECTION,
+  &TS_MIME_FIELD_CONTENT_ENCODING,
+  &TS_MIME_FIELD_CONTENT_LANGUAGE,
+  &TS_MIME_FIELD_CONTENT_LENGTH,
+  &TS_MIME_FIELD_CONTENT_LOCATION,
+  &TS_MIME_FIELD_CONTENT_MD5,
+  &TS_MIME_FIELD_CONTENT_RANGE,
+  &TS_MIME_FIELD_CONTENT_TYPE,
+  &TS_MIME_FIELD_COOKIE,
+  &TS_MIME_FIELD_DATE,
+  &TS_MIME_FIELD_ETAG,
+  &TS_MIME_FIELD_EXPECT,
+  &TS_MIME_FIELD_EXPIRES,
+  &TS_MIME_FIELD_FORWARDED,
+  &TS_MIME_FIELD_FROM,
+  &TS_MIME_FIELD_HOST,
+  &TS_MIME_FIELD_IF_MATCH,
+  &TS_MIME_FIELD_IF_MODIFIED_SINCE,
+  &TS_MIME_FIELD_IF_NONE_MATCH,
+  &TS_MIME_FIELD_IF_RANGE,
+  &TS_MIME_FIELD_IF_UNMODIFIED_SINCE,
+  &TS_MIME_FIELD_KEEP_ALIVE,
+  &TS_MIME_FIELD_LAST_MODIFIED,
+  &TS_MIME_FIELD_LOCATION,
+  &TS_MIME_FIELD_MAX_FORWARDS,
+  &TS_MIME_FIELD_PRAGMA,
+  &TS_MIME_FIELD_PROXY_AUTHENTICATE,
+  &TS_MIME_FIELD_PROXY_AUTHORIZATION,
+  &TS_MIME_FIELD_PROXY_CONNECTION,
+  &TS_MIME_FIELD_RANGE,
+  &TS_MIME_FIELD_REFERER,
+  &TS_MIME_FIELD_RETRY_AFTER,
+  &TS_MIME_FIELD_SERVER,
+  &TS_MIME_FIELD_SET_COOKIE,
+  &TS_MIME_FIELD_STRICT_TRANSPORT_SECURITY,
+  &TS_MIME_FIELD_TE,
+  &TS_MIME_FIELD_TRANSFER_ENCODING,
+  &TS_MIME_FIELD_UPGRADE,
+  &TS_MIME_FIELD_USER_AGENT,
+  &TS_MIME_FIELD_VARY,
+  &TS_MIME_FIELD_VIA,
+  &TS_MIME_FIELD_WARNING,
+  &TS_MIME_FIELD_WWW_AUTHENTICATE,
+  &TS_MIME_FIELD_X_FORWARDED_FOR,
+};
+
+static int ts_lua_header_view_create(lua_State *L);
+static int ts_lua_header_view_get(lua_State *L);
+static int ts_lua_header_view_exists(lua_State *L);
+static int ts_lua_header_view_len(lua_State *L);
+static int ts_lua_header_view_equals(lua_State *L);
+static int ts_lua_header_view_equals_nocase(lua_State *L);
+static int ts_lua_header_view_starts_with(lua_State *L);
+static int ts_lua_header_view_find(lua_State *L);
+
+void
+ts_lua_inject_header_view_api(lua_State *L)
+{
+  luaL_newmetatable(L, TS_LUA_HEADER_VIEW_MT);
+
+  lua_newtable(L); /* methods */
+
+  lua_pushcfunction(L, ts_lua_header_view_get);
+  lua_setfield(L, -2, "get");
+
+  lua_pushcfunction(L, ts_lua_header_view_exists);
+  lua_setfield(L, -2, "exists");
+
+  lua_pushcfunction(L, ts_lua_header_view_len);
+  lua_setfield(L, -2, "len");
+
+  lua_pushcfunction(L, ts_lua_header_view_equals);
+  lua_setfield(L, -2, "equals");
+
+  lua_pushcfunction(L, ts_lua_header_view_equals_nocase);
+  lua_setfield(L, -2, "equals_nocase");
+
+  lua_pushcfunction(L, ts_lua_header_view_starts_with);
+  lua_setfield(L, -2, "starts_with");
+
+  lua_pushcfunction(L, ts_lua_header_view_find);
+  lua_setfield(L, -2, "find");
+
+  lua_setfield(L, -2, "__index");
+
+  lua_pop(L, 1);
+}
+
+void
+ts_lua_inject_header_view_func(lua_State *L, TSLuaHeaderKind kind)
+{
+  lua_pushinteger(L, kind);
+  lua_pushcclosure(L, ts_lua_header_view_create, 1);
+  lua_setfield(L, -2, "header_view");
+}
+
+static const char *
+ts_lua_header_view_intern(const char *name, size_t name_len)
+{
+  for (auto const wks : ts_lua_mime_field_names) {
+    if (*wks && strlen(*wks) == name_len && strncasecmp(*wks, name, name_len) == 0) {
+      return *wks;
+    }
+  }
+
+  return nullptr;
+}
+
+static int
+ts_lua_header_view_create(lua_State *L)
+{
+  const char         *name;
+  const char         *wks;
+  size_t              name_len;
+  ts_lua_header_view *view;
+
+  name = luaL_checklstring(L, 1, &name_len);
+  luaL_argcheck(L, name_len > 0, 1, "empty header name");
+
+  wks  = ts_lua_header_view_intern(name, name_len);
+  view = static_cast<ts_lua_header_view *>(lua_newuserdata(L, sizeof(ts_lua_header_view) + (wks ? 0 : name_len)));
+
+  view->kind     = static_cast<TSLuaHeaderKind>(lua_tointeger(L, lua_upvalueindex(1)));
+  view->name_len = name_len;
+  if (wks) {
+    view->name = wks;
+  } else {
+    memcpy(view + 1, name, name_len);
+    view->name = reinterpret_cast<const char *>(view + 1);
+  }
+
+  luaL_getmetatable(L, TS_LUA_HEADER_VIEW_MT);
+  lua_setmetatable(L, -2);
+
+  return 1;
+}
+
+/* the header of the view in the current transaction */
+static bool
+ts_lua_header_view_hdr(ts_lua_http_ctx *http_ctx, TSLuaHeaderKind kind, TSMBuffer *bufp, TSMLoc *hdrp)
+{
+  switch (kind) {
+  case TS_LUA_HEADER_CLIENT_REQUEST:
+    *bufp = http_ctx->client_request_bufp;
+    *hdrp = http_ctx->client_request_hdrp;
+    return *hdrp != nullptr;
+
+  case TS_LUA_HEADER_SERVER_REQUEST:
+    if (!http_ctx->server_request_hdrp &&
+        TSHttpTxnServerReqGet(http_ctx->txnp, &http_ctx->server_request_bufp, &http_ctx->server_request_hdrp) != TS_SUCCESS) {
+      return false;
+    }
+    *bufp = http_ctx->server_request_bufp;
+    *hdrp = http_ctx->server_request_hdrp;
+    return true;
+
+  case TS_LUA_HEADER_SERVER_RESPONSE:
+    if (!http_ctx->server_response_hdrp &&
+        TSHttpTxnServerRespGet(http_ctx->txnp, &http_ctx->server_response_bufp, &http_ctx->server_response_hdrp) != TS_SUCCESS) {
+      return false;
+    }
+    *bufp = http_ctx->server_response_bufp;
+    *hdrp = http_ctx->server_response_hdrp;
+    return true;
+
+  case TS_LUA_HEADER_CLIENT_RESPONSE:
+    if (!http_ctx->client_response_hdrp &&
+        TSHttpTxnClientRespGet(http_ctx->txnp, &http_ctx->client_response_bufp, &http_ctx->client_response_hdrp) != TS_SUCCESS) {
+      return false;
+    }
+    *bufp = http_ctx->client_response_bufp;
+    *hdrp = http_ctx->client_response_hdrp;
+    return true;
+  }
+
+  return false;
+}
+
+/* the value of the first field of the view, in the header storage, or nullptr if there is no such field */
+static const char *
+ts_lua_header_view_value(ts_lua_http_ctx *http_ctx, ts_lua_header_view *view, int *val_len)
+{
+  const char *val = nullptr;
+  TSMBuffer   bufp;
+  TSMLoc      hdrp, field_loc;
+
+  if (!ts_lua_header_view_hdr(http_ctx, view->kind, &bufp, &hdrp)) {
+    return nullptr;
+  }
+
+  field_loc = TSMimeHdrFieldFind(bufp, hdrp, view->name, view->name_len);
+  if (field_loc != TS_NULL_MLOC) {
+    val = TSMimeHdrFieldValueStringGet(bufp, hdrp, field_loc, -1, val_len);
+    TSHandleMLocRelease(bufp, hdrp, field_loc);
+  }
+
+  return val;
+}
+
+static int
+ts_lua_header_view_get(lua_State *L)
+{
+  const char         *val;
+  int                 val_len;
+  int                 count;
+  TSMBuffer           bufp;
+  TSMLoc              hdrp, field_loc, next_field_loc;
+  ts_lua_header_view *view;
+  ts_lua_http_ctx    *http_ctx;
+
+  GET_HTTP_CONTEXT(http_ctx, L);
+
+  view = static_cast<ts_lua_header_view *>(luaL_checkudata(L, 1, TS_LUA_HEADER_VIEW_MT));
+
+  if (!ts_lua_header_view_hdr(http_ctx, view->kind, &bufp, &hdrp)) {
+    lua_pushnil(L);
+    return 1;
+  }
+
+  field_loc = TSMimeHdrFieldFind(bufp, hdrp, view->name, view->name_len);
+  if (field_loc == TS_NULL_MLOC) {
+    lua_pushnil(L);
+    return 1;
+  }
+
+  // same value as the header table, the duplicate fields are joined with a comma
+  count = 0;
+  while (field_loc != TS_NULL_MLOC) {
+    val            = TSMimeHdrFieldValueStringGet(bufp, hdrp, field_loc, -1, &val_len);
+    next_field_loc = TSMimeHdrFieldNextDup(bufp, hdrp, field_loc);
+    lua_pushlstring(L, val, val_len);
+    count++;
+    if (next_field_loc != TS_NULL_MLOC) {
+      lua_pushlstring(L, ",", 1);
+      count++;
+    }
+    TSHandleMLocRelease(bufp, hdrp, field_loc);
+    field_loc = next_field_loc;
+  }
+  lua_concat(L, count);
+
+  return 1;
+}
+
+static int
+ts_lua_header_view_exists(lua_State *L)
+{
+  int                 val_len;
+  ts_lua_header_view *view;
+  ts_lua_http_ctx    *http_ctx;
+
+  GET_HTTP_CONTEXT(http_ctx, L);
+
+  view = static_cast<ts_lua_header_view *>(luaL_checkudata(L, 1, TS_LUA_HEADER_VIEW_MT));
+
+  lua_pushboolean(L, ts_lua_header_view_value(http_ctx, view, &val_len) != nullptr);
+  return 1;
+}
+
+static int
+ts_lua_header_view_len(lua_State *L)
+{
+  const char         *val;
+  int                 val_len;
+  ts_lua_header_view *view;
+  ts_lua_http_ctx    *http_ctx;
+
+  GET_HTTP_CONTEXT(http_ctx, L);
+
+  view = static_cast<ts_lua_header_view *>(luaL_checkudata(L, 1, TS_LUA_HEADER_VIEW_MT));
+  val  = ts_lua_header_view_value(http_ctx, view, &val_len);
+
+  if (val) {
+    lua_pushinteger(L, val_len);
+  } else {
+    lua_pushnil(L);
+  }
+  return 1;
+}
+
+static int
+ts_lua_header_view_equals(lua_State *L)
+{
+  const char         *val, *str;
+  int                 val_len;
+  size_t              str_len;
+  ts_lua_header_view *view;
+  ts_lua_http_ctx    *http_ctx;
+
+  GET_HTTP_CONTEXT(http_ctx, L);
+
+  view = static_cast<ts_lua_header_view *>(luaL_checkudata(L, 1, TS_LUA_HEADER_VIEW_MT));
+  str  = luaL_checklstring(L, 2, &str_len);
+  val  = ts_lua_header_view_value(http_ctx, view, &val_len);
+
+  lua_pushboolean(L, val && static_cast<size_t>(val_len) == str_len && memcmp(val, str, str_len) == 0);
+  return 1;
+}
+
+static int
+ts_lua_header_view_equals_nocase(lua_State *L)
+{
+  const char         *val, *str;
+  int                 val_len;
+  size_t              str_len;
+  ts_lua_header_view *view;
+  ts_lua_http_ctx    *http_ctx;
+
+  GET_HTTP_CONTEXT(http_ctx, L);
+
+  view = static_cast<ts_lua_header_view *>(luaL_checkudata(L, 1, TS_LUA_HEADER_VIEW_MT));
+  str  = luaL_checklstring(L, 2, &str_len);
+  val  = ts_lua_header_view_value(http_ctx, view, &val_len);
+
+  lua_pushboolean(L, val && static_cast<size_t>(val_len) == str_len && strncasecmp(val, str, str_len) == 0);
+  return 1;
+}
+
+static int
+ts_lua_header_view_starts_with(lua_State *L)
+{
+  const char         *val, *str;
+  int                 val_len;
+  size_t              str_len;
+  ts_lua_header_view *view;
+  ts_lua_http_ctx    *http_ctx;
+
+  GET_HTTP_CONTEXT(http_ctx, L);
+
+  view = static_cast<ts_lua_header_view *>(luaL_checkudata(L, 1, TS_LUA_HEADER_VIEW_MT));
+  str  = luaL_checklstring(L, 2, &str_len);
+  val  = ts_lua_header_view_value(http_ctx, view, &val_len);
+
+  lua_pushboolean(L, val && static_cast<size_t>(val_len) >= str_len && memcmp(val, str, str_len) == 0);
+  return 1;
+}
+
+static int
+ts_lua_header_view_find(lua_State *L)
+{
+  const char         *val, *str, *pos;
+  int                 val_len;
+  size_t              str_len;
+  ts_lua_header_view *view;
+  ts_lua_http_ctx    *http_ctx;
+
+  GET_HTTP_CONTEXT(http_ctx, L);
+
+  view = static_cast<ts_lua_header_view *>(luaL_checkudata(L, 1, TS_LUA_HEADER_VIEW_MT));
+  str  = luaL_checklstring(L, 2, &str_len);
+  val  = ts_lua_header_view_value(http_ctx, view, &val_len);
+  pos  = val ? static_cast<const char *>(memmem(val, val_len, str, str_len)) : nullptr;
+
+  /* plain find, the 1-based position as string.find */
+  if (pos) {
+    lua_pushinteger(L, pos - val + 1);
+  } else {
+    lua_pushnil(L);
+  }
+  return 1;
+}
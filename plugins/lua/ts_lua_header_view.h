@@ -0,0 +1,33 @@
+/*
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+  http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#pragma once
+
+#include "ts_lua_common.h"
+
+typedef enum {
+  TS_LUA_HEADER_CLIENT_REQUEST = 0,
+  TS_LUA_HEADER_SERVER_REQUEST,
+  TS_LUA_HEADER_SERVER_RESPONSE,
+  TS_LUA_HEADER_CLIENT_RESPONSE,
+} TSLuaHeaderKind;
+
+void ts_lua_inject_header_view_api(lua_State *L);
+
+/* set the header_view function of the table on top of the stack */
+void ts_lua_inject_header_view_func(lua_State *L, TSLuaHeaderKind kind);
@@ -20,6 +20,7 @@
 #include <arpa/inet.h>
 #include <sys/socket.h>
 #include "ts_lua_util.h"
+#include "ts_lua_header_view.h"
 
 #define TS_LUA_CHECK_SERVER_REQUEST_HDR(http_ctx)                                                                                \
   do {                                                                                                                           \
@@ -92,6 +93,7 @@ ts_lua_inject_server_request_api(lua_State *L)
   ts_lua_inject_server_request_socket_api(L);
   ts_lua_inject_server_request_header_api(L);
   ts_lua_inject_server_request_header_table_api(L);
+  ts_lua_inject_header_view_func(L, TS_LUA_HEADER_SERVER_REQUEST);
   ts_lua_inject_server_request_headers_api(L);
   ts_lua_inject_server_request_get_header_size_api(L);
   ts_lua_inject_server_request_get_body_size_api(L);
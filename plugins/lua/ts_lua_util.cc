@@ -23,6 +23,7 @@
 #include "ts_lua_server_request.h"
 #include "ts_lua_server_response.h"
 #include "ts_lua_client_response.h"
+#include "ts_lua_header_view.h"
 #include "ts_lua_cached_response.h"
 #include "ts_lua_context.h"
 #include "ts_lua_hook.h"
@@ -536,6 +537,7 @@ ts_lua_inject_ts_api(lua_State *L)
 
   ts_lua_inject_remap_api(L);
   ts_lua_inject_constant_api(L);
+  ts_lua_inject_header_view_api(L);
 
   ts_lua_inject_client_request_api(L);
   ts_lua_inject_server_request_api(L);
@@ -1045,21 +1047,23 @@ ts_lua_destroy_http_transform_ctx(ts_lua_http_transform_ctx *transform_ctx)
 int
 ts_lua_http_cont_handler(TSCont contp, TSEvent ev, void *edata)
 {
-  TSHttpTxn         txnp;
-  TSMBuffer         bufp;
-  TSMLoc            hdr_loc;
-  TSMLoc            url_loc;
-  int               event, ret, rc, n, t;
-  lua_State        *L;
-  ts_lua_http_ctx  *http_ctx;
-  ts_lua_main_ctx  *main_ctx;
-  ts_lua_cont_info *ci;
-  ts_lua_coroutine *crt;
+  TSHttpTxn             txnp;
+  TSMBuffer             bufp;
+  TSMLoc                hdr_loc;
+  TSMLoc                url_loc;
+  int                   event, ret, rc, n, t;
+  lua_State            *L;
+  ts_lua_http_ctx      *http_ctx;
+  ts_lua_main_ctx      *main_ctx;
+  ts_lua_cont_info     *ci;
+  ts_lua_coroutine     *crt;
+  ts_lua_instance_conf *conf;
 
   event    = (int)ev;
   http_ctx = (ts_lua_http_ctx *)TSContDataGet(contp);
   ci       = &http_ctx->cinfo;
   crt      = &ci->routine;
+  conf     = http_ctx->instance_conf; // http_ctx is destroyed by TXN_CLOSE
 
   main_ctx = crt->mctx;
   L        = crt->lua;
@@ -1248,23 +1252,10 @@ ts_lua_http_cont_handler(TSCont contp, TSEvent ev, void *edata)
     break;
   }
 
-  // current memory in use by this state
-  int const gc_kb = lua_getgccount(L);
+  ts_lua_update_gc_stats(main_ctx, conf);
 
   TSMutexUnlock(main_ctx->mutexp);
 
-  // collect state memory stats
-  ts_lua_ctx_stats *const stats = main_ctx->stats;
-
-  TSMutexLock(stats->mutexp);
-  if (gc_kb != stats->gc_kb) {
-    stats->gc_kb = gc_kb;
-    if (stats->gc_kb_max < stats->gc_kb) {
-      stats->gc_kb_max = stats->gc_kb;
-    }
-  }
-  TSMutexUnlock(stats->mutexp);
-
   if (rc == 0) {
     TSHttpTxnReenable(txnp, TS_EVENT_HTTP_CONTINUE);
 
@@ -1278,6 +1269,39 @@ ts_lua_http_cont_handler(TSCont contp, TSEvent ev, void *edata)
   return 0;
 }
 
+// Collect the memory stats of the state, held by the caller, after a step of the incremental gc if the
+// instance is configured with one. The step runs once the script is done with the hook, rather than
+// in the middle of a script when an allocation triggers the automatic gc. It runs on the main thread
+// of the state, the coroutine of the hook may have been released.
+void
+ts_lua_update_gc_stats(ts_lua_main_ctx *main_ctx, ts_lua_instance_conf *conf)
+{
+  lua_State *const L        = main_ctx->lua;
+  int              gc_cycle = -1;
+
+  if (conf->gc_step > 0) {
+    gc_cycle = lua_gc(L, LUA_GCSTEP, conf->gc_step);
+  }
+
+  // current memory in use by this state
+  int const gc_kb = lua_getgccount(L);
+
+  ts_lua_ctx_stats *const stats = main_ctx->stats;
+
+  TSMutexLock(stats->mutexp);
+  if (gc_kb != stats->gc_kb) {
+    stats->gc_kb = gc_kb;
+    if (stats->gc_kb_max < stats->gc_kb) {
+      stats->gc_kb_max = stats->gc_kb;
+    }
+  }
+  if (gc_cycle >= 0) {
+    ++stats->gc_steps;
+    stats->gc_cycles += gc_cycle;
+  }
+  TSMutexUnlock(stats->mutexp);
+}
+
 namespace ts_lua_ns
 {
 DbgCtl dbg_ctl{TS_LUA_DEBUG_TAG};
@@ -46,6 +46,8 @@ void             ts_lua_destroy_async_ctx(ts_lua_http_ctx *http_ctx);
 void             ts_lua_set_http_ctx(lua_State *L, ts_lua_http_ctx *ctx);
 ts_lua_http_ctx *ts_lua_get_http_ctx(lua_State *L);
 
+void ts_lua_update_gc_stats(ts_lua_main_ctx *main_ctx, ts_lua_instance_conf *conf);
+
 #define GET_HTTP_CONTEXT(ctx, list)                   \
   ctx = ts_lua_get_http_ctx(list);                    \
   if (ctx == NULL) {                                  \
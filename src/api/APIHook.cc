@@ -22,6 +22,7 @@
  */
 
 #include "api/APIHook.h"
+#include "api/PluginStats.h"
 
 #include "ts/apidefs.h"
 
@@ -57,6 +58,7 @@ APIHook::invoke(int event, void *edata) const
     // If we cannot get the lock, the caller needs to restructure to handle rescheduling
     ink_release_assert(0);
   }
+  PluginStats::Timer timer(m_cont->m_plugin_stats, PluginStats::slot_for(event));
   return m_cont->handleEvent(event, edata);
   return 0;
 }
@@ -72,5 +74,6 @@ APIHook::blocking_invoke(int event, void *edata) const
 
   WEAK_SCOPED_MUTEX_LOCK(lock, m_cont->mutex, this_ethread());
 
+  PluginStats::Timer timer(m_cont->m_plugin_stats, PluginStats::slot_for(event));
   return m_cont->handleEvent(event, edata);
 }
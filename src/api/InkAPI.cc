@@ -40,6 +40,7 @@
 
 #include "api/InkAPIInternal.h"
 #include "api/HttpAPIHooks.h"
+#include "api/PluginStats.h"
 #include "proxy/logging/Log.h"
 #include "proxy/hdrs/URL.h"
 #include "proxy/hdrs/MIME.h"
@@ -3372,6 +3373,16 @@ TSContDataGet(TSCont contp)
   return i->mdata;
 }
 
+void
+TSContSyncHookSet(TSCont contp, bool sync)
+{
+  sdk_assert(sdk_sanity_check_continuation(contp) == TS_SUCCESS);
+
+  INKContInternal *i = reinterpret_cast<INKContInternal *>(contp);
+
+  i->m_sync_hook = sync;
+}
+
 TSAction
 TSContScheduleOnPool(TSCont contp, TSHRTime timeout, TSThreadPool tp)
 {
@@ -3838,6 +3849,7 @@ TSHttpSsnReenable(TSHttpSsn ssnp, TSEvent event)
         eventProcessor.schedule_imm(new TSHttpSsnCallback(cs, cs->mutex, event), ET_NET);
       }
     } else {
+      PluginStats::Pause pause; // The session runs in the plugin callback.
       cs->handleEvent(static_cast<int>(event), nullptr);
     }
   }
@@ -3982,6 +3994,51 @@ TSHttpHdrEffectiveUrlBufGet(TSMBuffer hdr_buf, TSMLoc hdr_loc, char *buf, int64_
   return TS_SUCCESS;
 }
 
+void *
+TSHttpTxnArenaAlloc(TSHttpTxn txnp, size_t size)
+{
+  sdk_assert(sdk_sanity_check_txn(txnp) == TS_SUCCESS);
+
+  HttpSM *sm = reinterpret_cast<HttpSM *>(txnp);
+
+  return sm->t_state.arena.alloc(size, alignof(std::max_align_t));
+}
+
+char *
+TSHttpTxnArenaStrdup(TSHttpTxn txnp, const char *str, int64_t length)
+{
+  sdk_assert(sdk_sanity_check_txn(txnp) == TS_SUCCESS);
+  sdk_assert(sdk_sanity_check_null_ptr((void *)str) == TS_SUCCESS);
+
+  HttpSM *sm = reinterpret_cast<HttpSM *>(txnp);
+
+  if (length < 0) {
+    length = strlen(str);
+  }
+
+  char *copy = static_cast<char *>(sm->t_state.arena.alloc(length + 1, 1));
+
+  memcpy(copy, str, length);
+  copy[length] = '\0';
+  return copy;
+}
+
+char *
+TSHttpTxnArenaUrlStringGet(TSHttpTxn txnp, TSMBuffer bufp, TSMLoc obj, int *length)
+{
+  sdk_assert(sdk_sanity_check_txn(txnp) == TS_SUCCESS);
+  if (bufp) {
+    sdk_assert(sdk_sanity_check_mbuffer(bufp) == TS_SUCCESS);
+  }
+  sdk_assert(sdk_sanity_check_url_handle(obj) == TS_SUCCESS);
+  sdk_assert(sdk_sanity_check_null_ptr((void *)length) == TS_SUCCESS);
+
+  HttpSM  *sm       = reinterpret_cast<HttpSM *>(txnp);
+  URLImpl *url_impl = reinterpret_cast<URLImpl *>(obj);
+
+  return url_string_get(url_impl, &sm->t_state.arena, length, nullptr);
+}
+
 TSReturnCode
 TSHttpTxnClientRespGet(TSHttpTxn txnp, TSMBuffer *bufp, TSMLoc *obj)
 {
@@ -5042,6 +5099,7 @@ TSHttpTxnReenable(TSHttpTxn txnp, TSEvent event)
     MUTEX_TRY_LOCK(trylock, sm->mutex, eth);
     if (trylock.is_locked()) {
       ink_assert(eth->is_event_type(ET_NET));
+      PluginStats::Pause pause; // The transaction runs in the plugin callback.
       sm->state_api_callback(static_cast<int>(event), nullptr);
       return;
     }
@@ -24,6 +24,8 @@
 #include "ts/apidefs.h"
 #include "ts/InkAPIPrivateIOCore.h"
 
+#include "api/PluginStats.h"
+
 #include "tscore/Allocator.h"
 #include "tscore/Diags.h"
 #include "tscore/ink_assert.h"
@@ -57,6 +59,7 @@ INKContInternal::INKContInternal()
     m_closed(1),
     m_deletable(0),
     m_deleted(0),
+    m_sync_hook(false),
     m_context(0),
     m_free_magic(INKCONT_INTERN_MAGIC_ALIVE)
 {
@@ -70,6 +73,7 @@ INKContInternal::INKContInternal(TSEventFunc funcp, TSMutex mutexp)
     m_closed(1),
     m_deletable(0),
     m_deleted(0),
+    m_sync_hook(false),
     m_context(0),
     m_free_magic(INKCONT_INTERN_MAGIC_ALIVE)
 {
@@ -81,9 +85,11 @@ INKContInternal::init(TSEventFunc funcp, TSMutex mutexp, void *context)
 {
   SET_HANDLER(&INKContInternal::handle_event);
 
-  mutex        = (ProxyMutex *)mutexp;
-  m_event_func = funcp;
-  m_context    = context;
+  mutex          = (ProxyMutex *)mutexp;
+  m_event_func   = funcp;
+  m_sync_hook    = false;
+  m_context      = context;
+  m_plugin_stats = PluginStats::current;
 }
 
 void
@@ -155,10 +161,11 @@ INKContInternal::handle_event(int event, void *edata)
     }
   } else {
     /* set the plugin context */
-    auto *previousContext = pluginThreadContext;
-    pluginThreadContext   = reinterpret_cast<PluginThreadContext *>(m_context);
-    int retval            = m_event_func((TSCont)this, (TSEvent)event, edata);
-    pluginThreadContext   = previousContext;
+    PluginStats::Scope scope(m_plugin_stats);
+    auto              *previousContext = pluginThreadContext;
+    pluginThreadContext                = reinterpret_cast<PluginThreadContext *>(m_context);
+    int retval                         = m_event_func((TSCont)this, (TSEvent)event, edata);
+    pluginThreadContext                = previousContext;
     if (edata && event == EVENT_INTERVAL) {
       Event *e = reinterpret_cast<Event *>(edata);
       if (e->period != 0) {
@@ -0,0 +1,144 @@
+/** @file
+
+  Time spent in plugin callbacks, by plugin and hook.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include "api/PluginStats.h"
+#include "proxy/http/HttpDebugNames.h"
+#include "records/RecCore.h"
+
+using ts::Metrics;
+
+bool                             PluginStats::_enabled = false;
+thread_local PluginStats        *PluginStats::current  = nullptr;
+thread_local PluginStats::Timer *PluginStats::_running = nullptr;
+
+namespace
+{
+DbgCtl dbg_ctl_plugin{"plugin"};
+
+std::mutex                                                       registry_mutex;
+std::map<std::string, std::unique_ptr<PluginStats>, std::less<>> registry;
+
+// e.g. read_request_hdr for TS_HTTP_READ_REQUEST_HDR_HOOK.
+std::string
+slot_name(int slot)
+{
+  static constexpr std::string_view HOOK_PREFIX{"TS_HTTP_"};
+  static constexpr std::string_view HOOK_SUFFIX{"_HOOK"};
+
+  if (slot == PluginStats::REMAP_SLOT) {
+    return "remap";
+  } else if (slot == PluginStats::OTHER_SLOT) {
+    return "other";
+  }
+
+  std::string_view hook{HttpDebugNames::get_api_hook_name(static_cast<TSHttpHookID>(slot))};
+  std::string      name;
+
+  if (hook.starts_with(HOOK_PREFIX) && hook.ends_with(HOOK_SUFFIX)) {
+    hook.remove_prefix(HOOK_PREFIX.size());
+    hook.remove_suffix(HOOK_SUFFIX.size());
+  }
+  std::transform(hook.begin(), hook.end(), std::back_inserter(name), ::tolower);
+  return name;
+}
+} // end anonymous namespace
+
+void
+PluginStats::init()
+{
+  int enabled = 0;
+
+  REC_ReadConfigInteger(enabled, "proxy.config.plugin.time_stats");
+  _enabled = enabled != 0;
+  Dbg(dbg_ctl_plugin, "plugin time stats are %s", _enabled ? "enabled" : "disabled");
+}
+
+PluginStats *
+PluginStats::get(std::string_view path)
+{
+  if (!_enabled) {
+    return nullptr;
+  }
+
+  // The plugin file name without the extension, e.g. header_rewrite for /opt/ts/libexec/header_rewrite.so.
+  std::string_view name = path.substr(path.find_last_of('/') + 1);
+  name                  = name.substr(0, name.find('.'));
+
+  std::lock_guard lock(registry_mutex);
+  auto            spot = registry.find(name);
+
+  if (spot == registry.end()) {
+    std::unique_ptr<PluginStats> stats{new PluginStats(name)};
+    std::string                  stem = "proxy.process.plugin." + stats->_name + ".latency.";
+
+    for (int i = 0; i < N_BUCKETS; ++i) {
+      int64_t     bound = i < N_BUCKETS - 1 ? LATENCY_BOUNDS[i] : 0;
+      std::string label;
+
+      if (bound == 0) {
+        label = "inf";
+      } else if (bound < 1000) {
+        label = std::to_string(bound) + "us";
+      } else if (bound < 1000000) {
+        label = std::to_string(bound / 1000) + "ms";
+      } else {
+        label = std::to_string(bound / 1000000) + "s";
+      }
+      stats->_latency[i] = Metrics::Counter::createPtr(stem + label);
+    }
+    spot = registry.emplace(stats->_name, std::move(stats)).first;
+  }
+  return spot->second.get();
+}
+
+PluginStats::Slot &
+PluginStats::slot(int slot)
+{
+  Slot &s = _slots[slot];
+
+  // Racing threads create the same metrics, the names are unique.
+  if (s.time.load(std::memory_order_acquire) == nullptr) {
+    std::string stem = "proxy.process.plugin." + _name + "." + slot_name(slot);
+
+    s.count.store(Metrics::Counter::createPtr(stem + ".count"), std::memory_order_relaxed);
+    s.time.store(Metrics::Counter::createPtr(stem + ".time"), std::memory_order_release);
+  }
+  return s;
+}
+
+void
+PluginStats::record(int slot, ink_hrtime elapsed)
+{
+  Slot   &s      = this->slot(slot);
+  int64_t usec   = ink_hrtime_to_usec(elapsed);
+  auto    bucket = std::upper_bound(LATENCY_BOUNDS.begin(), LATENCY_BOUNDS.end(), usec) - LATENCY_BOUNDS.begin();
+
+  Metrics::Counter::increment(s.count.load(std::memory_order_relaxed));
+  Metrics::Counter::increment(s.time.load(std::memory_order_relaxed), std::max<ink_hrtime>(elapsed, 0));
+  Metrics::Counter::increment(_latency[bucket]);
+}
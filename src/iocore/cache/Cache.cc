@@ -82,6 +82,9 @@ int     cache_config_mutex_retry_delay             = 2;
 int     cache_read_while_writer_retry_delay        = 50;
 int     cache_config_read_while_writer_max_retries = 10;
 int     cache_config_persist_bad_disks             = false;
+int     cache_config_read_ahead_fragments          = 0;
+int     cache_config_read_ahead_max_in_flight      = 16;
+int     cache_config_key_hash                      = 0;
 
 // Globals
 
@@ -344,6 +347,9 @@ Cache::open_read(Continuation *cont, const CacheKey *key, CacheFragType type, co
   CacheVC      *c     = nullptr;
   {
     CACHE_TRY_LOCK(lock, stripe->mutex, mutex->thread_holding);
+    if (!lock.is_locked() && dir_probe_absent(key, stripe)) {
+      goto Lmiss;
+    }
     if (!lock.is_locked() || (od = stripe->open_read(key)) || dir_probe(key, stripe, &result, &last_collision)) {
       c = new_CacheVC(cont);
       SET_CONTINUATION_HANDLER(c, &CacheVC::openReadStartHead);
@@ -360,6 +366,7 @@ Cache::open_read(Continuation *cont, const CacheKey *key, CacheFragType type, co
       goto Lmiss;
     }
     if (!lock.is_locked()) {
+      c->f.stripe_lock_retried = 1;
       CONT_SCHED_LOCK_RETRY(c);
       return &c->_action;
     }
@@ -548,6 +555,9 @@ Cache::open_read(Continuation *cont, const CacheKey *key, CacheHTTPHdr *request,
 
   {
     CACHE_TRY_LOCK(lock, stripe->mutex, mutex->thread_holding);
+    if (!lock.is_locked() && dir_probe_absent(key, stripe)) {
+      goto Lmiss;
+    }
     if (!lock.is_locked() || (od = stripe->open_read(key)) || dir_probe(key, stripe, &result, &last_collision)) {
       c            = new_CacheVC(cont);
       c->first_key = c->key = c->earliest_key = *key;
@@ -563,6 +573,7 @@ Cache::open_read(Continuation *cont, const CacheKey *key, CacheHTTPHdr *request,
     }
     if (!lock.is_locked()) {
       SET_CONTINUATION_HANDLER(c, &CacheVC::openReadStartHead);
+      c->f.stripe_lock_retried = 1;
       CONT_SCHED_LOCK_RETRY(c);
       return &c->_action;
     }
@@ -848,6 +859,12 @@ ink_cache_init(ts::ModuleVersion v)
   REC_EstablishStaticConfigInt32(cache_read_while_writer_retry_delay, "proxy.config.cache.read_while_writer_retry.delay");
   Dbg(dbg_ctl_cache_init, "proxy.config.cache.read_while_writer_retry.delay = %dms", cache_read_while_writer_retry_delay);
 
+  REC_EstablishStaticConfigInt32(cache_config_read_ahead_fragments, "proxy.config.cache.read_ahead.fragments");
+  Dbg(dbg_ctl_cache_init, "proxy.config.cache.read_ahead.fragments = %d", cache_config_read_ahead_fragments);
+
+  REC_EstablishStaticConfigInt32(cache_config_read_ahead_max_in_flight, "proxy.config.cache.read_ahead.max_in_flight");
+  Dbg(dbg_ctl_cache_init, "proxy.config.cache.read_ahead.max_in_flight = %d", cache_config_read_ahead_max_in_flight);
+
   REC_EstablishStaticConfigInt32(cache_config_hit_evacuate_percent, "proxy.config.cache.hit_evacuate_percent");
   Dbg(dbg_ctl_cache_init, "proxy.config.cache.hit_evacuate_percent = %d", cache_config_hit_evacuate_percent);
 
@@ -856,6 +873,12 @@ ink_cache_init(ts::ModuleVersion v)
 
   REC_EstablishStaticConfigInt32(cache_config_force_sector_size, "proxy.config.cache.force_sector_size");
 
+  // The key hash has to be settled before any URL is hashed. Stripes written with a different
+  // key hash are cleared when their directory is read, see StripeSM::handle_dir_read.
+  REC_ReadConfigInt32(cache_config_key_hash, "proxy.config.cache.key_hash");
+  URLHashContext::Setting = cache_config_key_hash == 1 ? CryptoContext::MURMUR3 : CryptoContext::UNSPECIFIED;
+  Dbg(dbg_ctl_cache_init, "proxy.config.cache.key_hash = %d", cache_config_key_hash);
+
   ink_assert(REC_RegisterConfigUpdateFunc("proxy.config.cache.target_fragment_size", FragmentSizeUpdateCb, nullptr) !=
              REC_ERR_FAIL);
   REC_ReadConfigInt32(cache_config_target_fragment_size, "proxy.config.cache.target_fragment_size");
@@ -107,6 +107,7 @@ OpenDir::open_write(CacheVC *cont, int allow_if_writers, int max_writers)
   cont->od           = od;
   cont->write_vector = &od->vector;
   bucket[b].push(od);
+  bucket_entries[b].fetch_add(1, std::memory_order_release);
   return 1;
 }
 
@@ -146,6 +147,7 @@ OpenDir::close_write(CacheVC *cont)
     unsigned int h = cont->first_key.slice32(0);
     int          b = h % OPEN_DIR_BUCKETS;
     bucket[b].remove(cont->od);
+    bucket_entries[b].fetch_sub(1, std::memory_order_release);
     delayed_readers.append(cont->od->readers);
     signal_readers(0, nullptr);
     cont->od->vector.clear();
@@ -168,6 +170,16 @@ OpenDir::open_read(const CryptoHash *key) const
   return nullptr;
 }
 
+/*
+   May be called without the stripe lock. Returns true if there might be an
+   open writer for @a key, i.e. any writer in the same bucket.
+   */
+bool
+OpenDir::maybe_open(const CryptoHash *key) const
+{
+  return bucket_entries[key->slice32(0) % OPEN_DIR_BUCKETS].load(std::memory_order_acquire) != 0;
+}
+
 int
 OpenDirEntry::wait(CacheVC *cont, int msec)
 {
@@ -219,6 +231,7 @@ dir_bucket_loop_check(Dir *start_dir, Dir *seg)
 void
 dir_init_segment(int s, Stripe *stripe)
 {
+  DirSegmentWriteGuard guard(stripe->directory, s);
   stripe->directory.header->freelist[s] = 0;
   Dir *seg                              = stripe->directory.get_segment(s);
   int  l, b;
@@ -385,7 +398,8 @@ dir_clean_bucket(Dir *b, int s, Stripe *stripe)
 void
 dir_clean_segment(int s, Stripe *stripe)
 {
-  Dir *seg = stripe->directory.get_segment(s);
+  DirSegmentWriteGuard guard(stripe->directory, s);
+  Dir                 *seg = stripe->directory.get_segment(s);
   for (int64_t i = 0; i < stripe->directory.buckets; i++) {
     dir_clean_bucket(dir_bucket(i, seg), s, stripe);
     ink_assert(!dir_next(dir_bucket(i, seg)) || dir_offset(dir_bucket(i, seg)));
@@ -409,6 +423,7 @@ dir_clear_range(off_t start, off_t end, Stripe *stripe)
     if (dir_offset(e) >= static_cast<int64_t>(start) && dir_offset(e) < static_cast<int64_t>(end)) {
       ts::Metrics::Gauge::decrement(cache_rsb.direntries_used);
       ts::Metrics::Gauge::decrement(stripe->cache_vol->vol_rsb.direntries_used);
+      DirSegmentWriteGuard guard(stripe->directory, i / (stripe->directory.buckets * DIR_DEPTH));
       dir_set_offset(e, 0); // delete
     }
   }
@@ -436,8 +451,9 @@ freelist_clean(int s, StripeSM *stripe)
     return;
   }
   Warning("cache directory overflow on '%s' segment %d, purging...", stripe->disk->path, s);
-  int  n   = 0;
-  Dir *seg = stripe->directory.get_segment(s);
+  DirSegmentWriteGuard guard(stripe->directory, s);
+  int                  n   = 0;
+  Dir                 *seg = stripe->directory.get_segment(s);
   for (int bi = 0; bi < stripe->directory.buckets; bi++) {
     Dir *b = dir_bucket(bi, seg);
     for (int l = 0; l < DIR_DEPTH; l++) {
@@ -533,6 +549,7 @@ Lagain:
         } else { // delete the invalid entry
           ts::Metrics::Gauge::decrement(cache_rsb.direntries_used);
           ts::Metrics::Gauge::decrement(stripe->cache_vol->vol_rsb.direntries_used);
+          DirSegmentWriteGuard guard(stripe->directory, s);
           e = dir_delete_entry(e, p, s, stripe);
           continue;
         }
@@ -556,6 +573,63 @@ Lagain:
   return 0;
 }
 
+/*
+   Check, without the stripe lock, whether @a key is certainly not in the
+   directory. This is a seqlock read of the key's segment: the bucket chain is
+   walked optimistically and the result is only trusted if the segment
+   sequence was even and unchanged across the walk, and no writer had the
+   document open. Entry validity is not checked, any tag match is treated as
+   a possible hit. A false return means "don't know", take the lock and
+   dir_probe() as usual.
+   */
+bool
+dir_probe_absent(const CacheKey *key, StripeSM *stripe)
+{
+  Directory &directory = stripe->directory;
+  int        s         = key->slice32(0) % directory.segments;
+  int        b         = key->slice32(1) % directory.buckets;
+  bool       absent    = false;
+
+  uint32_t seq = directory.seqs[s].load(std::memory_order_acquire);
+  if (!(seq & 1) && !stripe->open_dir.maybe_open(key)) {
+    Dir    *seg   = directory.get_segment(s);
+    Dir    *e     = dir_bucket(b, seg);
+    int64_t limit = directory.buckets * DIR_DEPTH;
+    int     depth = 0;
+
+    // The entries may change under us, so bound the walk and check each link
+    // before following it rather than trusting the chain. Long chains are
+    // rare enough to just give up on.
+    absent = true;
+    if (dir_offset(e)) {
+      while (e) {
+        if (dir_compare_tag(e, key) || ++depth > 8 * DIR_DEPTH) {
+          absent = false;
+          break;
+        }
+        int64_t next = dir_next(e);
+        if (next >= limit) {
+          absent = false;
+          break;
+        }
+        e = dir_from_offset(next, seg);
+      }
+    }
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (directory.seqs[s].load(std::memory_order_relaxed) != seq || stripe->open_dir.maybe_open(key)) {
+      absent = false;
+    }
+  }
+  if (absent) {
+    ts::Metrics::Counter::increment(cache_rsb.dir_lock_free_miss);
+    ts::Metrics::Counter::increment(stripe->cache_vol->vol_rsb.dir_lock_free_miss);
+  } else {
+    ts::Metrics::Counter::increment(cache_rsb.dir_lock_free_fallback);
+    ts::Metrics::Counter::increment(stripe->cache_vol->vol_rsb.dir_lock_free_fallback);
+  }
+  return absent;
+}
+
 int
 dir_insert(const CacheKey *key, StripeSM *stripe, Dir *to_part)
 {
@@ -563,9 +637,10 @@ dir_insert(const CacheKey *key, StripeSM *stripe, Dir *to_part)
   int s  = key->slice32(0) % stripe->directory.segments, l;
   int bi = key->slice32(1) % stripe->directory.buckets;
   ink_assert(dir_approx_size(to_part) <= MAX_FRAG_SIZE + sizeof(Doc));
-  Dir *seg = stripe->directory.get_segment(s);
-  Dir *e   = nullptr;
-  Dir *b   = dir_bucket(bi, seg);
+  Dir                 *seg = stripe->directory.get_segment(s);
+  Dir                 *e   = nullptr;
+  Dir                 *b   = dir_bucket(bi, seg);
+  DirSegmentWriteGuard guard(stripe->directory, s);
 #if defined(DEBUG) && defined(DO_CHECK_DIR_FAST)
   unsigned int t   = DIR_MASK_TAG(key->slice32(2));
   Dir         *col = b;
@@ -639,6 +714,7 @@ dir_overwrite(const CacheKey *key, StripeSM *stripe, Dir *dir, Dir *overwrite, b
   int  loop_count    = 0;
   bool loop_possible = true;
 #endif
+  DirSegmentWriteGuard guard(stripe->directory, s);
   CHECK_DIR(d);
 
   ink_assert((unsigned int)dir_approx_size(dir) <= (unsigned int)(MAX_FRAG_SIZE + sizeof(Doc))); // XXX - size should be unsigned
@@ -737,6 +813,7 @@ dir_delete(const CacheKey *key, StripeSM *stripe, Dir *del)
       if (dir_compare_tag(e, key) && dir_offset(e) == dir_offset(del)) {
         ts::Metrics::Gauge::decrement(cache_rsb.direntries_used);
         ts::Metrics::Gauge::decrement(stripe->cache_vol->vol_rsb.direntries_used);
+        DirSegmentWriteGuard guard(stripe->directory, s);
         dir_delete_entry(e, p, s, stripe);
         CHECK_DIR(d);
         return 1;
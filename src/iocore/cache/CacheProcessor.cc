@@ -1130,39 +1130,51 @@ register_cache_stats(CacheStatsBlock *rsb, const std::string &prefix)
   rsb->fragment_document_count[1] = ts::Metrics::Counter::createPtr(prefix + ".frags_per_doc.2");
   rsb->fragment_document_count[2] = ts::Metrics::Counter::createPtr(prefix + ".frags_per_doc.3+");
 
+  // The stripe lock wait histogram, one bucket per bound plus everything longer
+  for (int i = 0; i < CACHE_STRIPE_LOCK_WAIT_BUCKETS - 1; ++i) {
+    rsb->stripe_lock_wait[i] =
+      ts::Metrics::Counter::createPtr(prefix + ".stripe_lock_wait." + std::to_string(cache_stripe_lock_wait_bounds[i]) + "ms");
+  }
+  rsb->stripe_lock_wait[CACHE_STRIPE_LOCK_WAIT_BUCKETS - 1] = ts::Metrics::Counter::createPtr(prefix + ".stripe_lock_wait.inf");
+
   // And then everything else
-  rsb->bytes_used            = ts::Metrics::Gauge::createPtr(prefix + ".bytes_used");
-  rsb->bytes_total           = ts::Metrics::Gauge::createPtr(prefix + ".bytes_total");
-  rsb->stripes               = ts::Metrics::Gauge::createPtr(prefix + ".stripes");
-  rsb->ram_cache_bytes_total = ts::Metrics::Gauge::createPtr(prefix + ".ram_cache.total_bytes");
-  rsb->ram_cache_bytes       = ts::Metrics::Gauge::createPtr(prefix + ".ram_cache.bytes_used");
-  rsb->ram_cache_hits        = ts::Metrics::Counter::createPtr(prefix + ".ram_cache.hits");
-  rsb->ram_cache_misses      = ts::Metrics::Counter::createPtr(prefix + ".ram_cache.misses");
-  rsb->pread_count           = ts::Metrics::Counter::createPtr(prefix + ".pread_count");
-  rsb->percent_full          = ts::Metrics::Gauge::createPtr(prefix + ".percent_full");
-  rsb->read_seek_fail        = ts::Metrics::Counter::createPtr(prefix + ".read.seek.failure");
-  rsb->read_invalid          = ts::Metrics::Counter::createPtr(prefix + ".read.invalid");
-  rsb->write_backlog_failure = ts::Metrics::Counter::createPtr(prefix + ".write.backlog.failure");
-  rsb->direntries_total      = ts::Metrics::Gauge::createPtr(prefix + ".direntries.total");
-  rsb->direntries_used       = ts::Metrics::Gauge::createPtr(prefix + ".direntries.used");
-  rsb->directory_collision   = ts::Metrics::Counter::createPtr(prefix + ".directory_collision");
-  rsb->read_busy_success     = ts::Metrics::Counter::createPtr(prefix + ".read_busy.success");
-  rsb->read_busy_failure     = ts::Metrics::Counter::createPtr(prefix + ".read_busy.failure");
-  rsb->write_bytes           = ts::Metrics::Counter::createPtr(prefix + ".write_bytes_stat");
-  rsb->hdr_vector_marshal    = ts::Metrics::Counter::createPtr(prefix + ".vector_marshals");
-  rsb->hdr_marshal           = ts::Metrics::Counter::createPtr(prefix + ".hdr_marshals");
-  rsb->hdr_marshal_bytes     = ts::Metrics::Counter::createPtr(prefix + ".hdr_marshal_bytes");
-  rsb->gc_bytes_evacuated    = ts::Metrics::Counter::createPtr(prefix + ".gc_bytes_evacuated");
-  rsb->gc_frags_evacuated    = ts::Metrics::Counter::createPtr(prefix + ".gc_frags_evacuated");
-  rsb->directory_wrap        = ts::Metrics::Counter::createPtr(prefix + ".wrap_count");
-  rsb->directory_sync_count  = ts::Metrics::Counter::createPtr(prefix + ".sync.count");
-  rsb->directory_sync_bytes  = ts::Metrics::Counter::createPtr(prefix + ".sync.bytes");
-  rsb->directory_sync_time   = ts::Metrics::Counter::createPtr(prefix + ".sync.time");
-  rsb->span_errors_read      = ts::Metrics::Counter::createPtr(prefix + ".span.errors.read");
-  rsb->span_errors_write     = ts::Metrics::Counter::createPtr(prefix + ".span.errors.write");
-  rsb->span_failing          = ts::Metrics::Gauge::createPtr(prefix + ".span.failing");
-  rsb->span_offline          = ts::Metrics::Gauge::createPtr(prefix + ".span.offline");
-  rsb->span_online           = ts::Metrics::Gauge::createPtr(prefix + ".span.online");
+  rsb->bytes_used              = ts::Metrics::Gauge::createPtr(prefix + ".bytes_used");
+  rsb->bytes_total             = ts::Metrics::Gauge::createPtr(prefix + ".bytes_total");
+  rsb->stripes                 = ts::Metrics::Gauge::createPtr(prefix + ".stripes");
+  rsb->ram_cache_bytes_total   = ts::Metrics::Gauge::createPtr(prefix + ".ram_cache.total_bytes");
+  rsb->ram_cache_bytes         = ts::Metrics::Gauge::createPtr(prefix + ".ram_cache.bytes_used");
+  rsb->ram_cache_hits          = ts::Metrics::Counter::createPtr(prefix + ".ram_cache.hits");
+  rsb->ram_cache_misses        = ts::Metrics::Counter::createPtr(prefix + ".ram_cache.misses");
+  rsb->pread_count             = ts::Metrics::Counter::createPtr(prefix + ".pread_count");
+  rsb->percent_full            = ts::Metrics::Gauge::createPtr(prefix + ".percent_full");
+  rsb->read_seek_fail          = ts::Metrics::Counter::createPtr(prefix + ".read.seek.failure");
+  rsb->read_invalid            = ts::Metrics::Counter::createPtr(prefix + ".read.invalid");
+  rsb->write_backlog_failure   = ts::Metrics::Counter::createPtr(prefix + ".write.backlog.failure");
+  rsb->direntries_total        = ts::Metrics::Gauge::createPtr(prefix + ".direntries.total");
+  rsb->direntries_used         = ts::Metrics::Gauge::createPtr(prefix + ".direntries.used");
+  rsb->directory_collision     = ts::Metrics::Counter::createPtr(prefix + ".directory_collision");
+  rsb->read_busy_success       = ts::Metrics::Counter::createPtr(prefix + ".read_busy.success");
+  rsb->read_busy_failure       = ts::Metrics::Counter::createPtr(prefix + ".read_busy.failure");
+  rsb->write_bytes             = ts::Metrics::Counter::createPtr(prefix + ".write_bytes_stat");
+  rsb->hdr_vector_marshal      = ts::Metrics::Counter::createPtr(prefix + ".vector_marshals");
+  rsb->hdr_marshal             = ts::Metrics::Counter::createPtr(prefix + ".hdr_marshals");
+  rsb->hdr_marshal_bytes       = ts::Metrics::Counter::createPtr(prefix + ".hdr_marshal_bytes");
+  rsb->gc_bytes_evacuated      = ts::Metrics::Counter::createPtr(prefix + ".gc_bytes_evacuated");
+  rsb->gc_frags_evacuated      = ts::Metrics::Counter::createPtr(prefix + ".gc_frags_evacuated");
+  rsb->directory_wrap          = ts::Metrics::Counter::createPtr(prefix + ".wrap_count");
+  rsb->directory_sync_count    = ts::Metrics::Counter::createPtr(prefix + ".sync.count");
+  rsb->directory_sync_bytes    = ts::Metrics::Counter::createPtr(prefix + ".sync.bytes");
+  rsb->directory_sync_time     = ts::Metrics::Counter::createPtr(prefix + ".sync.time");
+  rsb->dir_lock_free_miss      = ts::Metrics::Counter::createPtr(prefix + ".directory.lock_free.miss");
+  rsb->dir_lock_free_fallback  = ts::Metrics::Counter::createPtr(prefix + ".directory.lock_free.fallback");
+  rsb->read_ahead_issued       = ts::Metrics::Counter::createPtr(prefix + ".read_ahead.issued");
+  rsb->read_ahead_hits         = ts::Metrics::Counter::createPtr(prefix + ".read_ahead.hits");
+  rsb->read_ahead_wasted_bytes = ts::Metrics::Counter::createPtr(prefix + ".read_ahead.wasted_bytes");
+  rsb->span_errors_read        = ts::Metrics::Counter::createPtr(prefix + ".span.errors.read");
+  rsb->span_errors_write       = ts::Metrics::Counter::createPtr(prefix + ".span.errors.write");
+  rsb->span_failing            = ts::Metrics::Gauge::createPtr(prefix + ".span.failing");
+  rsb->span_offline            = ts::Metrics::Gauge::createPtr(prefix + ".span.offline");
+  rsb->span_online             = ts::Metrics::Gauge::createPtr(prefix + ".span.online");
 }
 
 void
@@ -45,6 +45,17 @@ DbgCtl dbg_ctl_cache_hit_evac{"cache_hit_evac"};
 
 #endif
 
+void
+stripe_lock_wait_update(StripeSM *stripe, ink_hrtime wait)
+{
+  int i = 0;
+  while (i < CACHE_STRIPE_LOCK_WAIT_BUCKETS - 1 && wait > HRTIME_MSECONDS(cache_stripe_lock_wait_bounds[i])) {
+    ++i;
+  }
+  ts::Metrics::Counter::increment(cache_rsb.stripe_lock_wait[i]);
+  ts::Metrics::Counter::increment(stripe->cache_vol->vol_rsb.stripe_lock_wait[i]);
+}
+
 } // end anonymous namespace
 
 uint32_t
@@ -703,6 +714,7 @@ Lread: {
     VC_SCHED_LOCK_RETRY();
   }
   if (dir_probe(&key, stripe, &dir, &last_collision)) {
+    read_ahead_issue();
     SET_HANDLER(&CacheVC::openReadReadDone);
     int ret = do_read_call(&key);
     if (ret == EVENT_RETURN) {
@@ -742,6 +754,23 @@ Lcallreturn:
   return handleEvent(AIO_EVENT_DONE, nullptr);
 }
 
+void
+CacheVC::read_ahead_issue()
+{
+  if (!cache_config_read_ahead_fragments || frag_type != CACHE_FRAG_TYPE_HTTP || !alternate.valid()) {
+    return;
+  }
+  // Single fragment documents have no fragment table, and nothing to read ahead.
+  if (!alternate.get_frag_table()) {
+    return;
+  }
+  if (!read_ahead) {
+    read_ahead = new CacheReadAhead;
+  }
+  // key is the next fragment, fragment is the index of the one we have
+  read_ahead->issue(this, key, fragment + 1, static_cast<int>(alternate.get_frag_offset_count()) + 1);
+}
+
 /*
   This code follows CacheVC::openReadStartHead closely,
   if you change this you might have to change that.
@@ -966,8 +995,17 @@ CacheVC::openReadStartHead(int event, Event *e)
   {
     CACHE_TRY_LOCK(lock, stripe->mutex, mutex->thread_holding);
     if (!lock.is_locked()) {
+      // Nothing read yet, a definite miss doesn't need to wait for the lock.
+      if (!buf && !f.read_from_writer_called && dir_probe_absent(&key, stripe)) {
+        goto Ldone;
+      }
+      f.stripe_lock_retried = 1;
       VC_SCHED_LOCK_RETRY();
     }
+    if (f.stripe_lock_retried) {
+      f.stripe_lock_retried = 0;
+      stripe_lock_wait_update(stripe, ink_get_hrtime() - start_time);
+    }
     if (!buf) {
       goto Lread;
     }
@@ -0,0 +1,227 @@
+/** @file
+
+  Sequential fragment read ahead for large cached objects.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "CacheReadAhead.h"
+#include "P_CacheInternal.h"
+
+#include <algorithm>
+
+namespace
+{
+DbgCtl dbg_ctl_cache_read_ahead{"cache_read_ahead"};
+
+void
+count_wasted(StripeSM *stripe, int64_t bytes)
+{
+  ts::Metrics::Counter::increment(cache_rsb.read_ahead_wasted_bytes, bytes);
+  ts::Metrics::Counter::increment(stripe->cache_vol->vol_rsb.read_ahead_wasted_bytes, bytes);
+}
+
+void
+count_hit(StripeSM *stripe)
+{
+  ts::Metrics::Counter::increment(cache_rsb.read_ahead_hits);
+  ts::Metrics::Counter::increment(stripe->cache_vol->vol_rsb.read_ahead_hits);
+}
+
+int
+max_depth()
+{
+  return std::clamp(cache_config_read_ahead_fragments, 0, CACHE_READ_AHEAD_MAX_FRAGMENTS);
+}
+} // end anonymous namespace
+
+CacheReadAheadIO::CacheReadAheadIO(Ptr<ProxyMutex> &m) : Continuation(m)
+{
+  SET_HANDLER(&CacheReadAheadIO::handle_read_done);
+}
+
+int
+CacheReadAheadIO::handle_read_done(int /* event ATS_UNUSED */, void * /* data ATS_UNUSED */)
+{
+  done = true;
+  --stripe->read_ahead_in_flight;
+  if (owner == nullptr) {
+    // The reader went away while we were on the disk.
+    count_wasted(stripe, io.aiocb.aio_nbytes);
+    delete this;
+  } else if (waiter) {
+    owner->complete(this);
+  }
+  return EVENT_DONE;
+}
+
+CacheReadAhead::~CacheReadAhead()
+{
+  for (int i = 0; i < CACHE_READ_AHEAD_MAX_FRAGMENTS; ++i) {
+    if (_slots[i]) {
+      discard(i);
+    }
+  }
+}
+
+void
+CacheReadAhead::discard(int slot)
+{
+  CacheReadAheadIO *ra = _slots[slot];
+
+  ink_assert(ra->waiter == nullptr);
+  _slots[slot] = nullptr;
+  --_count;
+  if (ra->done) {
+    count_wasted(ra->stripe, ra->io.aiocb.aio_nbytes);
+    delete ra;
+  } else {
+    ra->owner = nullptr;
+  }
+}
+
+void
+CacheReadAhead::issue(CacheVC *vc, const CacheKey &key, int frag_index, int nfrags)
+{
+  StripeSM *stripe = vc->stripe;
+  int       limit  = max_depth();
+  CacheKey  window[CACHE_READ_AHEAD_MAX_FRAGMENTS + 1];
+
+  ink_assert(stripe->mutex->thread_holding == this_ethread());
+
+  window[0] = key;
+  for (int i = 1; i <= limit; ++i) {
+    next_CacheKey(&window[i], &window[i - 1]);
+  }
+
+  // Drop anything that is no longer ahead of the reader, e.g. after a seek.
+  for (int i = 0; i < CACHE_READ_AHEAD_MAX_FRAGMENTS; ++i) {
+    if (_slots[i] && std::find(window, window + limit + 1, _slots[i]->key) == window + limit + 1) {
+      if (_slots[i]->done) {
+        _depth = std::max(1, _depth / 2);
+      }
+      discard(i);
+    }
+  }
+
+  // Don't get further ahead of a client that isn't draining what it already has.
+  if (vc->vio.get_writer()->high_water()) {
+    return;
+  }
+
+  int depth = std::min(_depth, limit);
+  for (int i = 1; i <= depth && frag_index + i < nfrags; ++i) {
+    if (std::any_of(_slots.begin(), _slots.end(), [&](CacheReadAheadIO *ra) { return ra && ra->key == window[i]; })) {
+      continue;
+    }
+    if (stripe->read_ahead_in_flight >= cache_config_read_ahead_max_in_flight) {
+      break;
+    }
+    auto slot = std::find(_slots.begin(), _slots.end(), nullptr);
+    if (slot == _slots.end()) {
+      break;
+    }
+
+    Dir  dir;
+    Dir *last_collision = nullptr;
+    if (!dir_probe(&window[i], stripe, &dir, &last_collision)) {
+      break; // not written yet
+    }
+    if (stripe->dir_agg_buf_valid(&dir)) {
+      break; // still in memory, no point in reading it
+    }
+
+    CacheReadAheadIO *ra = new CacheReadAheadIO(vc->mutex);
+    ra->key              = window[i];
+    ra->dir              = dir;
+    ra->stripe           = stripe;
+    ra->owner            = this;
+
+    ra->io.aiocb.aio_fildes = stripe->fd;
+    ra->io.aiocb.aio_offset = stripe->vol_offset(&dir);
+    ra->io.aiocb.aio_nbytes = dir_approx_size(&dir);
+    if (static_cast<off_t>(ra->io.aiocb.aio_offset + ra->io.aiocb.aio_nbytes) > static_cast<off_t>(stripe->skip + stripe->len)) {
+      ra->io.aiocb.aio_nbytes = stripe->skip + stripe->len - ra->io.aiocb.aio_offset;
+    }
+    ra->buf              = new_IOBufferData(iobuffer_size_to_index(ra->io.aiocb.aio_nbytes, MAX_BUFFER_SIZE_INDEX), MEMALIGNED);
+    ra->io.aiocb.aio_buf = ra->buf->data();
+    ra->io.action        = ra;
+    ra->io.thread        = vc->mutex->thread_holding->tt == DEDICATED ? AIO_CALLBACK_THREAD_ANY : vc->mutex->thread_holding;
+
+    *slot = ra;
+    ++_count;
+    ++stripe->read_ahead_in_flight;
+    if (ink_aio_read(&ra->io) < 0) {
+      // Nothing is on the disk for this slot, the reader reads the fragment itself.
+      Dbg(dbg_ctl_cache_read_ahead, "%p: failed to read ahead frag %d of %d", vc, frag_index + i, nfrags);
+      *slot = nullptr;
+      --_count;
+      --stripe->read_ahead_in_flight;
+      ra->buf = nullptr;
+      delete ra;
+      break;
+    }
+    ts::Metrics::Counter::increment(cache_rsb.read_ahead_issued);
+    ts::Metrics::Counter::increment(stripe->cache_vol->vol_rsb.read_ahead_issued);
+    Dbg(dbg_ctl_cache_read_ahead, "%p: read ahead frag %d of %d, depth %d", vc, frag_index + i, nfrags, depth);
+  }
+}
+
+CacheReadAhead::Claim
+CacheReadAhead::claim(CacheVC *vc)
+{
+  for (auto &slot : _slots) {
+    CacheReadAheadIO *ra = slot;
+    if (!ra || !(ra->key == *vc->read_key) || dir_offset(&ra->dir) != dir_offset(&vc->dir)) {
+      continue;
+    }
+    vc->io.aiocb.aio_offset = ra->io.aiocb.aio_offset;
+    vc->io.aiocb.aio_nbytes = ra->io.aiocb.aio_nbytes;
+    if (ra->done) {
+      vc->buf           = ra->buf;
+      vc->io.aio_result = ra->io.aio_result;
+      slot              = nullptr;
+      --_count;
+      count_hit(ra->stripe);
+      delete ra;
+      return Claim::READY;
+    }
+    // The reader caught up with the disk, so look further ahead next time.
+    _depth                  = std::min(_depth * 2, max_depth());
+    ra->waiter              = vc;
+    vc->io.aiocb.aio_fildes = ra->io.aiocb.aio_fildes;
+    return Claim::WAITING;
+  }
+  return Claim::NONE;
+}
+
+void
+CacheReadAhead::complete(CacheReadAheadIO *ra)
+{
+  CacheVC *vc = ra->waiter;
+
+  *std::find(_slots.begin(), _slots.end(), ra) = nullptr;
+  --_count;
+  vc->buf           = ra->buf;
+  vc->io.aio_result = ra->io.aio_result;
+  count_hit(ra->stripe);
+  delete ra;
+  // This may free the VC, and this window along with it.
+  vc->handleEvent(AIO_EVENT_DONE, nullptr);
+}
@@ -0,0 +1,119 @@
+/** @file
+
+  Sequential fragment read ahead for large cached objects.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include "P_CacheDir.h"
+
+#include "iocore/aio/AIO.h"
+#include "iocore/eventsystem/Continuation.h"
+#include "iocore/eventsystem/IOBuffer.h"
+
+#include "tscore/CryptoHash.h"
+#include "tscore/Ptr.h"
+
+#include <array>
+
+class CacheReadAhead;
+class StripeSM;
+struct CacheVC;
+
+// Upper bound for proxy.config.cache.read_ahead.fragments.
+#define CACHE_READ_AHEAD_MAX_FRAGMENTS 16
+
+/**
+ * A single outstanding (or completed) read of a fragment that the reading
+ * CacheVC has not asked for yet.
+ *
+ * The read shares the mutex of the CacheVC that issued it so the AIO
+ * completion is serialized with the VC. If the VC goes away while the read
+ * is in flight the read is orphaned and cleans up after itself.
+ */
+struct CacheReadAheadIO : public Continuation {
+  explicit CacheReadAheadIO(Ptr<ProxyMutex> &m);
+
+  int handle_read_done(int event, void *data);
+
+  CacheKey          key;
+  Dir               dir;
+  Ptr<IOBufferData> buf;
+  AIOCallback       io;
+  StripeSM         *stripe = nullptr;
+  CacheReadAhead   *owner  = nullptr; ///< nullptr once orphaned.
+  CacheVC          *waiter = nullptr; ///< VC blocked on this read, resumed when it completes.
+  bool              done   = false;
+};
+
+/**
+ * Per CacheVC read ahead window.
+ *
+ * Only created for HTTP reads of multi-fragment objects when
+ * proxy.config.cache.read_ahead.fragments is non-zero. The window starts at
+ * one fragment and doubles each time the reader has to wait on the disk,
+ * up to the configured limit. Reads are also bounded per stripe by
+ * proxy.config.cache.read_ahead.max_in_flight so that a few large
+ * downloads cannot starve the other readers of a disk.
+ */
+class CacheReadAhead
+{
+public:
+  enum class Claim { NONE, READY, WAITING };
+
+  CacheReadAhead() = default;
+  ~CacheReadAhead();
+
+  CacheReadAhead(const CacheReadAhead &)            = delete;
+  CacheReadAhead &operator=(const CacheReadAhead &) = delete;
+
+  /** Start reads for the fragments that follow @a key.
+
+      @a key is the fragment @a vc is about to read, and is index @a frag_index
+      in the fragment table. Must be called with the stripe lock held.
+   */
+  void issue(CacheVC *vc, const CacheKey &key, int frag_index, int nfrags);
+
+  /** Satisfy the read @a vc is about to start from the window.
+
+      @return READY if the fragment is already in @a vc->buf, WAITING if the
+      fragment is in flight and @a vc will be called back with AIO_EVENT_DONE,
+      or NONE if the fragment must be read normally.
+   */
+  Claim claim(CacheVC *vc);
+
+  /// Hand a completed read to the VC waiting on it.
+  void complete(CacheReadAheadIO *ra);
+
+  /// Reads in the window, completed or not.
+  int
+  size() const
+  {
+    return _count;
+  }
+
+private:
+  void discard(int slot);
+
+  std::array<CacheReadAheadIO *, CACHE_READ_AHEAD_MAX_FRAGMENTS> _slots{};
+  int                                                            _count = 0;
+  int                                                            _depth = 1;
+};
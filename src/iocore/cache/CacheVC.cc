@@ -465,6 +465,18 @@ CacheVC::handleRead(int /* event ATS_UNUSED */, Event * /* e ATS_UNUSED */)
     io.aio_result = io.aiocb.aio_nbytes;
     SET_HANDLER(&CacheVC::handleReadDone);
     return EVENT_RETURN;
+  } else if (read_ahead) {
+    switch (read_ahead->claim(this)) {
+    case CacheReadAhead::Claim::READY:
+      SET_HANDLER(&CacheVC::handleReadDone);
+      return EVENT_RETURN;
+    case CacheReadAhead::Claim::WAITING:
+      // The read ahead calls us back with AIO_EVENT_DONE, just like the AIO would.
+      SET_HANDLER(&CacheVC::handleReadDone);
+      return EVENT_CONT;
+    case CacheReadAhead::Claim::NONE:
+      break;
+    }
   }
 
   io.aiocb.aio_fildes = stripe->fd;
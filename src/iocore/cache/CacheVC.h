@@ -41,6 +41,7 @@
 
 class Stripe;
 class HttpConfigAccessor;
+class CacheReadAhead;
 
 struct CacheVC : public CacheVConnection {
   CacheVC();
@@ -135,6 +136,7 @@ struct CacheVC : public CacheVConnection {
   bool load_from_ram_cache();
   bool load_from_last_open_read_call();
   bool load_from_aggregation_buffer();
+  void read_ahead_issue();
   int  do_read_call(CacheKey *akey);
   int  handleWrite(int event, Event *e);
   int  handleWriteLock(int event, Event *e);
@@ -236,9 +238,10 @@ struct CacheVC : public CacheVConnection {
   Ptr<IOBufferBlock>  blocks; // data available to write
   Ptr<IOBufferBlock>  writer_buf;
 
-  OpenDirEntry *od = nullptr;
-  AIOCallback   io;
-  int           alternate_index = CACHE_ALT_INDEX_DEFAULT; // preferred position in vector
+  OpenDirEntry   *od = nullptr;
+  AIOCallback     io;
+  CacheReadAhead *read_ahead      = nullptr;                 // fragments read before they are needed
+  int             alternate_index = CACHE_ALT_INDEX_DEFAULT; // preferred position in vector
   LINK(CacheVC, opendir_link);
   // end Region B
 
@@ -310,6 +313,7 @@ struct CacheVC : public CacheVConnection {
       unsigned int hit_evacuate            : 1;
       unsigned int compressed_in_ram       : 1; // compressed state in ram cache
       unsigned int allow_empty_doc         : 1; // used for cache empty http document
+      unsigned int stripe_lock_retried     : 1; // a read had to wait for the stripe lock
     } f;
   };
   // BTF optimization used to skip reading stuff in cache partition that doesn't contain any
@@ -29,6 +29,7 @@
 #include "iocore/aio/AIO.h"
 #include "tscore/Version.h"
 
+#include <atomic>
 #include <cstdint>
 #include <ctime>
 
@@ -230,10 +231,12 @@ struct OpenDirEntry {
 struct OpenDir : public Continuation {
   Queue<CacheVC, Link_CacheVC_opendir_link> delayed_readers;
   DLL<OpenDirEntry>                         bucket[OPEN_DIR_BUCKETS];
+  std::atomic<uint16_t>                     bucket_entries[OPEN_DIR_BUCKETS] = {}; // readable without the stripe lock
 
   int           open_write(CacheVC *c, int allow_if_writers, int max_writers);
   int           close_write(CacheVC *c);
   OpenDirEntry *open_read(const CryptoHash *key) const;
+  bool          maybe_open(const CryptoHash *key) const;
   int           signal_readers(int event, Event *e);
 
   OpenDir();
@@ -268,17 +271,18 @@ struct StripteHeaderFooter {
   uint32_t          write_serial;
   uint32_t          dirty;
   uint32_t          sector_size;
-  uint32_t          unused; // pad out to 8 byte boundary
+  uint32_t          key_hash; // cache key hash algorithm (proxy.config.cache.key_hash), pads to 8 bytes
   uint16_t          freelist[1];
 };
 
 struct Directory {
-  char                *raw_dir{nullptr};
-  Dir                 *dir{};
-  StripteHeaderFooter *header{};
-  StripteHeaderFooter *footer{};
-  int                  segments{};
-  off_t                buckets{};
+  char                  *raw_dir{nullptr};
+  Dir                   *dir{};
+  StripteHeaderFooter   *header{};
+  StripteHeaderFooter   *footer{};
+  int                    segments{};
+  off_t                  buckets{};
+  std::atomic<uint32_t> *seqs{nullptr}; // per segment write sequence, odd while the segment is being modified
 
   /* Total number of dir entries.
    */
@@ -301,9 +305,43 @@ Directory::get_segment(int s) const
   return reinterpret_cast<Dir *>((reinterpret_cast<char *>(this->dir)) + (s * this->buckets) * DIR_DEPTH * SIZEOF_DIR);
 }
 
+/* Marks segment @a s of a directory as being modified for the lifetime of
+   the guard, so that lock free readers (see dir_probe_absent) can detect a
+   concurrent change and fall back to taking the stripe lock. Writers are
+   already serialized by the stripe lock so guards for the same segment may
+   nest, only the outermost one bumps the sequence.
+ */
+class DirSegmentWriteGuard
+{
+public:
+  DirSegmentWriteGuard(Directory &directory, int s)
+    : _seq(directory.seqs ? &directory.seqs[s] : nullptr), _owner(_seq && !(_seq->load(std::memory_order_relaxed) & 1))
+  {
+    if (_owner) {
+      _seq->fetch_add(1, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_release);
+    }
+  }
+
+  ~DirSegmentWriteGuard()
+  {
+    if (_owner) {
+      _seq->fetch_add(1, std::memory_order_release);
+    }
+  }
+
+  DirSegmentWriteGuard(const DirSegmentWriteGuard &)            = delete;
+  DirSegmentWriteGuard &operator=(const DirSegmentWriteGuard &) = delete;
+
+private:
+  std::atomic<uint32_t> *_seq;
+  bool                   _owner;
+};
+
 // Global Functions
 
 int      dir_probe(const CacheKey *, StripeSM *, Dir *, Dir **);
+bool     dir_probe_absent(const CacheKey *key, StripeSM *stripe);
 int      dir_insert(const CacheKey *key, StripeSM *stripe, Dir *to_part);
 int      dir_overwrite(const CacheKey *key, StripeSM *stripe, Dir *to_part, Dir *overwrite, bool must_overwrite = true);
 int      dir_delete(const CacheKey *key, StripeSM *stripe, Dir *del);
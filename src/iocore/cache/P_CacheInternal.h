@@ -30,6 +30,7 @@
 
 #include "CacheVC.h"
 #include "CacheEvacuateDocVC.h"
+#include "CacheReadAhead.h"
 
 struct EvacuationBlock;
 
@@ -117,6 +118,9 @@ extern int cache_config_target_fragment_size;
 extern int cache_config_mutex_retry_delay;
 extern int cache_read_while_writer_retry_delay;
 extern int cache_config_read_while_writer_max_retries;
+extern int cache_config_read_ahead_fragments;
+extern int cache_config_read_ahead_max_in_flight;
+extern int cache_config_key_hash;
 
 #define PUSH_HANDLER(_x)                                          \
   do {                                                            \
@@ -193,7 +197,9 @@ free_CacheVCCommon(CacheVC *cont)
   }
   ink_assert(!cont->is_io_in_progress());
   ink_assert(!cont->od);
-  cont->io.action = nullptr;
+  delete cont->read_ahead;
+  cont->read_ahead = nullptr;
+  cont->io.action  = nullptr;
   cont->io.mutex.clear();
   cont->io.aio_result       = 0;
   cont->io.aiocb.aio_nbytes = 0;
@@ -25,9 +25,16 @@
 
 #include "tsutil/Metrics.h"
 
+#include <iterator>
+
 // cache stats definitions, for both global cache metrics, as well as per volume metrics.
 enum class CacheOpType { Lookup = 0, Read, Write, Update, Remove, Evacuate, Scan, Last };
 
+// Upper bounds, in milliseconds, of the stripe lock wait histogram buckets. There is one more
+// bucket for longer waits.
+inline constexpr int cache_stripe_lock_wait_bounds[] = {1, 2, 5, 10, 20, 50, 100};
+inline constexpr int CACHE_STRIPE_LOCK_WAIT_BUCKETS  = std::size(cache_stripe_lock_wait_bounds) + 1;
+
 struct CacheStatsBlock {
   struct {
     ts::Metrics::Gauge::AtomicType   *active  = nullptr;
@@ -37,36 +44,44 @@ struct CacheStatsBlock {
 
   ts::Metrics::Counter::AtomicType *fragment_document_count[3] = {nullptr, nullptr, nullptr}; // For 1, 2 and 3+ fragments
 
-  ts::Metrics::Gauge::AtomicType   *bytes_used            = nullptr;
-  ts::Metrics::Gauge::AtomicType   *bytes_total           = nullptr;
-  ts::Metrics::Gauge::AtomicType   *stripes               = nullptr;
-  ts::Metrics::Gauge::AtomicType   *ram_cache_bytes       = nullptr;
-  ts::Metrics::Gauge::AtomicType   *ram_cache_bytes_total = nullptr;
-  ts::Metrics::Gauge::AtomicType   *direntries_total      = nullptr;
-  ts::Metrics::Gauge::AtomicType   *direntries_used       = nullptr;
-  ts::Metrics::Counter::AtomicType *ram_cache_hits        = nullptr;
-  ts::Metrics::Counter::AtomicType *ram_cache_misses      = nullptr;
-  ts::Metrics::Counter::AtomicType *pread_count           = nullptr;
-  ts::Metrics::Gauge::AtomicType   *percent_full          = nullptr;
-  ts::Metrics::Counter::AtomicType *read_seek_fail        = nullptr;
-  ts::Metrics::Counter::AtomicType *read_invalid          = nullptr;
-  ts::Metrics::Counter::AtomicType *write_backlog_failure = nullptr;
-  ts::Metrics::Counter::AtomicType *directory_collision   = nullptr;
-  ts::Metrics::Counter::AtomicType *read_busy_success     = nullptr;
-  ts::Metrics::Counter::AtomicType *read_busy_failure     = nullptr;
-  ts::Metrics::Counter::AtomicType *gc_bytes_evacuated    = nullptr;
-  ts::Metrics::Counter::AtomicType *gc_frags_evacuated    = nullptr;
-  ts::Metrics::Counter::AtomicType *write_bytes           = nullptr;
-  ts::Metrics::Counter::AtomicType *hdr_vector_marshal    = nullptr;
-  ts::Metrics::Counter::AtomicType *hdr_marshal           = nullptr;
-  ts::Metrics::Counter::AtomicType *hdr_marshal_bytes     = nullptr;
-  ts::Metrics::Counter::AtomicType *directory_wrap        = nullptr;
-  ts::Metrics::Counter::AtomicType *directory_sync_count  = nullptr;
-  ts::Metrics::Counter::AtomicType *directory_sync_time   = nullptr;
-  ts::Metrics::Counter::AtomicType *directory_sync_bytes  = nullptr;
-  ts::Metrics::Counter::AtomicType *span_errors_read      = nullptr;
-  ts::Metrics::Counter::AtomicType *span_errors_write     = nullptr;
-  ts::Metrics::Gauge::AtomicType   *span_offline          = nullptr;
-  ts::Metrics::Gauge::AtomicType   *span_online           = nullptr;
-  ts::Metrics::Gauge::AtomicType   *span_failing          = nullptr;
+  // Time reads spent waiting for the stripe lock, see cache_stripe_lock_wait_bounds
+  ts::Metrics::Counter::AtomicType *stripe_lock_wait[CACHE_STRIPE_LOCK_WAIT_BUCKETS] = {};
+
+  ts::Metrics::Gauge::AtomicType   *bytes_used              = nullptr;
+  ts::Metrics::Gauge::AtomicType   *bytes_total             = nullptr;
+  ts::Metrics::Gauge::AtomicType   *stripes                 = nullptr;
+  ts::Metrics::Gauge::AtomicType   *ram_cache_bytes         = nullptr;
+  ts::Metrics::Gauge::AtomicType   *ram_cache_bytes_total   = nullptr;
+  ts::Metrics::Gauge::AtomicType   *direntries_total        = nullptr;
+  ts::Metrics::Gauge::AtomicType   *direntries_used         = nullptr;
+  ts::Metrics::Counter::AtomicType *ram_cache_hits          = nullptr;
+  ts::Metrics::Counter::AtomicType *ram_cache_misses        = nullptr;
+  ts::Metrics::Counter::AtomicType *pread_count             = nullptr;
+  ts::Metrics::Gauge::AtomicType   *percent_full            = nullptr;
+  ts::Metrics::Counter::AtomicType *read_seek_fail          = nullptr;
+  ts::Metrics::Counter::AtomicType *read_invalid            = nullptr;
+  ts::Metrics::Counter::AtomicType *write_backlog_failure   = nullptr;
+  ts::Metrics::Counter::AtomicType *directory_collision     = nullptr;
+  ts::Metrics::Counter::AtomicType *read_busy_success       = nullptr;
+  ts::Metrics::Counter::AtomicType *read_busy_failure       = nullptr;
+  ts::Metrics::Counter::AtomicType *gc_bytes_evacuated      = nullptr;
+  ts::Metrics::Counter::AtomicType *gc_frags_evacuated      = nullptr;
+  ts::Metrics::Counter::AtomicType *write_bytes             = nullptr;
+  ts::Metrics::Counter::AtomicType *hdr_vector_marshal      = nullptr;
+  ts::Metrics::Counter::AtomicType *hdr_marshal             = nullptr;
+  ts::Metrics::Counter::AtomicType *hdr_marshal_bytes       = nullptr;
+  ts::Metrics::Counter::AtomicType *directory_wrap          = nullptr;
+  ts::Metrics::Counter::AtomicType *directory_sync_count    = nullptr;
+  ts::Metrics::Counter::AtomicType *directory_sync_time     = nullptr;
+  ts::Metrics::Counter::AtomicType *directory_sync_bytes    = nullptr;
+  ts::Metrics::Counter::AtomicType *dir_lock_free_miss      = nullptr;
+  ts::Metrics::Counter::AtomicType *dir_lock_free_fallback  = nullptr;
+  ts::Metrics::Counter::AtomicType *read_ahead_issued       = nullptr;
+  ts::Metrics::Counter::AtomicType *read_ahead_hits         = nullptr;
+  ts::Metrics::Counter::AtomicType *read_ahead_wasted_bytes = nullptr;
+  ts::Metrics::Counter::AtomicType *span_errors_read        = nullptr;
+  ts::Metrics::Counter::AtomicType *span_errors_write       = nullptr;
+  ts::Metrics::Gauge::AtomicType   *span_offline            = nullptr;
+  ts::Metrics::Gauge::AtomicType   *span_online             = nullptr;
+  ts::Metrics::Gauge::AtomicType   *span_failing            = nullptr;
 };
@@ -162,6 +162,7 @@ Stripe::_init_directory(std::size_t directory_size, int header_size, int footer_
   this->directory.header = reinterpret_cast<StripteHeaderFooter *>(this->directory.raw_dir);
   std::size_t const footer_offset{directory_size - static_cast<std::size_t>(footer_size)};
   this->directory.footer = reinterpret_cast<StripteHeaderFooter *>(this->directory.raw_dir + footer_offset);
+  this->directory.seqs   = new std::atomic<uint32_t>[this->directory.segments]();
 }
 
 int
@@ -329,6 +330,7 @@ Stripe::_clear_init(std::uint32_t hw_sector_size)
   this->directory.header->magic          = STRIPE_MAGIC;
   this->directory.header->version._major = CACHE_DB_MAJOR_VERSION;
   this->directory.header->version._minor = CACHE_DB_MINOR_VERSION;
+  this->directory.header->key_hash       = cache_config_key_hash;
   this->scan_pos = this->directory.header->agg_pos = this->directory.header->write_pos = this->start;
   this->directory.header->last_write_pos                                               = this->directory.header->write_pos;
   this->directory.header->phase                                                        = 0;
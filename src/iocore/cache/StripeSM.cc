@@ -260,6 +260,13 @@ StripeSM::handle_dir_read(int event, void *data)
     clear_dir_aio();
     return EVENT_DONE;
   }
+  if (directory.header->key_hash != static_cast<uint32_t>(cache_config_key_hash)) {
+    // The objects are keyed with another hash algorithm, none of them could ever be found.
+    Warning("cache directory for '%s' uses key hash %u, but proxy.config.cache.key_hash is %d, clearing", hash_text.get(),
+            directory.header->key_hash, cache_config_key_hash);
+    clear_dir_aio();
+    return EVENT_DONE;
+  }
   CHECK_DIR(this);
 
   sector_size = directory.header->sector_size;
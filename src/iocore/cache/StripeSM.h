@@ -100,6 +100,9 @@ public:
   int64_t           first_fragment_offset = 0;
   Ptr<IOBufferData> first_fragment_data;
 
+  // Fragment reads issued ahead of their readers, see CacheReadAhead.
+  std::atomic<int> read_ahead_in_flight{0};
+
   void cancel_trigger();
 
   int recover_data();
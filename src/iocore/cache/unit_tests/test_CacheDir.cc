@@ -238,6 +238,20 @@ public:
     }
     stripe->clear_dir();
 
+    // test lock free miss check
+    rand_CacheKey(&key);
+    CHECK(dir_probe_absent(&key, stripe));
+    dir_insert(&key, stripe, &dir);
+    CHECK(!dir_probe_absent(&key, stripe));
+    CHECK(dir_delete(&key, stripe, &dir));
+    {
+      // a segment being modified is never reported as a miss
+      DirSegmentWriteGuard guard(stripe->directory, key.slice32(0) % stripe->directory.segments);
+      CHECK(!dir_probe_absent(&key, stripe));
+    }
+    CHECK(dir_probe_absent(&key, stripe));
+    stripe->clear_dir();
+
     // Teardown
     test_done();
     delete this;
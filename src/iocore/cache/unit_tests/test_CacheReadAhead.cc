@@ -0,0 +1,77 @@
+/** @file
+
+  Unit test for fragment read ahead of large objects
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#define LARGE_FILE 10 * 1024 * 1024
+
+#include "main.h"
+#include "../P_CacheInternal.h"
+
+int  cache_vols           = 1;
+bool reuse_existing_cache = false;
+
+// Runs after the large object was read back, checks the read ahead was used.
+class ReadAheadCheck : public TestContChain
+{
+public:
+  ReadAheadCheck() { SET_HANDLER(&ReadAheadCheck::check_event); }
+
+  int
+  check_event(int /* event ATS_UNUSED */, void * /* e ATS_UNUSED */)
+  {
+    CHECK(cache_rsb.read_ahead_issued->load() > 0);
+    CHECK(cache_rsb.read_ahead_hits->load() > 0);
+    CHECK(cache_rsb.read_ahead_hits->load() <= cache_rsb.read_ahead_issued->load());
+    delete this;
+    return 0;
+  }
+};
+
+class CacheReadAheadInit : public CacheInit
+{
+public:
+  CacheReadAheadInit() {}
+  int
+  cache_init_success_callback(int /* event ATS_UNUSED */, void * /* e ATS_UNUSED */) override
+  {
+    CacheTestHandler *h  = new CacheTestHandler(LARGE_FILE, "http://www.scw55.com/");
+    ReadAheadCheck   *ck = new ReadAheadCheck;
+    TerminalTest     *tt = new TerminalTest;
+    h->add(ck);
+    h->add(tt);
+    this_ethread()->schedule_imm(h);
+    delete this;
+    return 0;
+  }
+};
+
+TEST_CASE("cache read ahead", "cache")
+{
+  init_cache(256 * 1024 * 1024);
+  cache_config_target_fragment_size     = 256 * 1024;
+  cache_config_read_ahead_fragments     = 4;
+  cache_config_read_ahead_max_in_flight = 8;
+  CacheReadAheadInit *init              = new CacheReadAheadInit;
+
+  this_ethread()->schedule_imm(init);
+  this_thread()->execute();
+}
@@ -61,6 +61,12 @@ IOUringContext::set_config(const IOUringConfig &cfg)
   config = cfg;
 }
 
+const IOUringConfig &
+IOUringContext::get_config()
+{
+  return config;
+}
+
 static io_uring_probe probe_unsupported             = {};
 constexpr int         MAX_SUPPORTED_OP_BEFORE_PROBE = 20;
 
@@ -209,6 +215,24 @@ IOUringContext::register_eventfd()
   return evfd;
 }
 
+io_uring_buf_ring *
+IOUringContext::setup_buf_ring(unsigned int entries, int bgid)
+{
+  int                ret = 0;
+  io_uring_buf_ring *br  = io_uring_setup_buf_ring(&ring, entries, bgid, 0, &ret);
+
+  if (br == nullptr) {
+    Dbg(dbg_ctl_io_uring, "io_uring_setup_buf_ring failed: (%d) %s", -ret, strerror(-ret));
+  }
+  return br;
+}
+
+void
+IOUringContext::free_buf_ring(io_uring_buf_ring *br, unsigned int entries, int bgid)
+{
+  io_uring_free_buf_ring(&ring, br, entries, bgid);
+}
+
 IOUringContext *
 IOUringContext::local_context()
 {
@@ -29,11 +29,13 @@
 
 #include "iocore/io_uring/IO_URING.h"
 
+#include <cstring>
 #include <functional>
 
 #include <sys/socket.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
+#include <unistd.h>
 #include "tscore/ink_hrtime.h"
 
 #include "tsutil/Metrics.h"
@@ -278,3 +280,70 @@ TEST_CASE("net_io", "[io_uring]")
   REQUIRE(server.clients == 1);
   REQUIRE(connected.load());
 }
+
+class RecvHandler : public IOUringCompletionHandler
+{
+public:
+  void
+  handle_complete(io_uring_cqe *c) override
+  {
+    res   = c->res;
+    flags = c->flags;
+    ++completions;
+  }
+
+  int      res         = 0;
+  unsigned flags       = 0;
+  int      completions = 0;
+};
+
+TEST_CASE("provided_buffers", "[io_uring]")
+{
+  IOUringConfig cfg = {
+    .queue_entries = 32,
+  };
+  IOUringContext::set_config(cfg);
+  IOUringContext ctx;
+
+  constexpr unsigned int ENTRIES     = 4;
+  constexpr int          BUFFER_SIZE = 64;
+  constexpr int          GROUP_ID    = 1;
+
+  io_uring_buf_ring *br = ctx.setup_buf_ring(ENTRIES, GROUP_ID);
+  if (br == nullptr) {
+    WARN("provided buffer rings are not supported by this kernel");
+    return;
+  }
+
+  char buffers[ENTRIES][BUFFER_SIZE];
+  for (unsigned int bid = 0; bid < ENTRIES; ++bid) {
+    io_uring_buf_ring_add(br, buffers[bid], BUFFER_SIZE, bid, io_uring_buf_ring_mask(ENTRIES), bid);
+  }
+  io_uring_buf_ring_advance(br, ENTRIES);
+
+  int sv[2];
+  REQUIRE(socketpair(AF_UNIX, SOCK_STREAM, 0, sv) == 0);
+
+  RecvHandler   handler;
+  io_uring_sqe *s = ctx.next_sqe(&handler);
+
+  io_uring_prep_recv(s, sv[1], nullptr, 0, 0);
+  s->flags     |= IOSQE_BUFFER_SELECT;
+  s->buf_group  = GROUP_ID;
+
+  REQUIRE(write(sv[0], "hello", 5) == 5);
+  while (handler.completions == 0) {
+    ctx.submit_and_wait(1 * HRTIME_SECOND);
+  }
+
+  REQUIRE(handler.res == 5);
+  REQUIRE((handler.flags & IORING_CQE_F_BUFFER) != 0);
+
+  unsigned int bid = handler.flags >> IORING_CQE_BUFFER_SHIFT;
+  REQUIRE(bid < ENTRIES);
+  REQUIRE(memcmp(buffers[bid], "hello", 5) == 0);
+
+  ctx.free_buf_ring(br, ENTRIES, GROUP_ID);
+  close(sv[0]);
+  close(sv[1]);
+}
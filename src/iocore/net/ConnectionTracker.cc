@@ -167,20 +167,10 @@ ConnectionTracker::config_init(GlobalConfig *global, TxnConfig *txn, RecConfigUp
 ConnectionTracker::TxnState
 ConnectionTracker::obtain_inbound(IpEndpoint const &addr)
 {
-  TxnState                    zret;
-  CryptoHash                  hash;
-  Group::Key                  key{addr, hash, MatchType::MATCH_IP};
-  std::lock_guard<std::mutex> lock(_inbound_table._mutex); // Table lock
-  auto                        loc = _inbound_table._table.find(key);
-  if (loc != _inbound_table._table.end()) {
-    zret._g = loc->second;
-  } else {
-    zret._g = std::make_shared<Group>(Group::DirectionType::INBOUND, key, "", 0);
-    // Note that we must use zret._g's key, not the above key, because Key's
-    // members are references to the Group's members. Thus the above key's
-    // members are invalid after this function.
-    _inbound_table._table.insert(std::make_pair(zret._g->_key, zret._g));
-  }
+  TxnState   zret;
+  CryptoHash hash;
+  Group::Key key{addr, hash, MatchType::MATCH_IP};
+  zret._g = _inbound_table.obtain(Group::DirectionType::INBOUND, key, "", 0);
   return zret;
 }
 
@@ -190,21 +180,29 @@ ConnectionTracker::obtain_outbound(TxnConfig const &txn_cnf, std::string_view fq
   TxnState   zret;
   CryptoHash hash;
   CryptoContext().hash_immediate(hash, fqdn.data(), fqdn.size());
-  Group::Key                  key{addr, hash, txn_cnf.server_match};
-  std::lock_guard<std::mutex> lock(_outbound_table._mutex); // Table lock
-  auto                        loc = _outbound_table._table.find(key);
-  if (loc != _outbound_table._table.end()) {
-    zret._g = loc->second;
-  } else {
-    zret._g = std::make_shared<Group>(Group::DirectionType::OUTBOUND, key, fqdn, txn_cnf.server_min);
-    // Note that we must use zret._g's key, not the above key, because Key's
-    // members are references to the Group's members. Thus the above key's
-    // members are invalid after this function.
-    _outbound_table._table.insert(std::make_pair(zret._g->_key, zret._g));
-  }
+  Group::Key key{addr, hash, txn_cnf.server_match};
+  zret._g = _outbound_table.obtain(Group::DirectionType::OUTBOUND, key, fqdn, txn_cnf.server_min);
   return zret;
 }
 
+std::shared_ptr<ConnectionTracker::Group>
+ConnectionTracker::TableSingleton::obtain(Group::DirectionType direction, Group::Key const &key, std::string_view fqdn,
+                                          int min_keep_alive)
+{
+  Shard                      &shard = this->shard(key);
+  std::lock_guard<std::mutex> lock(shard._mutex); // Shard lock
+
+  if (auto loc = shard._table.find(key); loc != shard._table.end()) {
+    return loc->second;
+  }
+  auto g = std::make_shared<Group>(direction, key, fqdn, min_keep_alive);
+  // Note that we must use g's key, not the above key, because Key's
+  // members are references to the Group's members. Thus the above key's
+  // members are invalid after this function.
+  shard._table.insert(std::make_pair(g->_key, g));
+  return g;
+}
+
 ConnectionTracker::Group::Group(DirectionType direction, Key const &key, std::string_view fqdn, int min_keep_alive)
   : _direction{direction},
     _hash(key._hash),
@@ -287,13 +285,14 @@ ConnectionTracker::Group::release()
   if (_count > 0) {
     if (--_count == 0) {
       TableSingleton             &table = _direction == DirectionType::INBOUND ? _inbound_table : _outbound_table;
-      std::lock_guard<std::mutex> lock(table._mutex); // Table lock
+      TableSingleton::Shard      &shard = table.shard(_key);
+      std::lock_guard<std::mutex> lock(shard._mutex); // Shard lock
       if (_count > 0) {
         // Someone else grabbed the Group between our last check and taking the
         // lock.
         return;
       }
-      table._table.erase(_key);
+      shard._table.erase(_key);
     }
   } else {
     // A bit dubious, as there's no guarantee it's still negative, but even that would be interesting to know.
@@ -310,11 +309,13 @@ ConnectionTracker::Group::get_last_alert_epoch_time() const
 void
 ConnectionTracker::get_outbound_groups(std::vector<std::shared_ptr<Group const>> &groups)
 {
-  std::lock_guard<std::mutex> lock(_outbound_table._mutex); // TABLE LOCK
   groups.resize(0);
-  groups.reserve(_outbound_table._table.size());
-  for (auto &&[key, group] : _outbound_table._table) {
-    groups.push_back(group);
+  for (auto &shard : _outbound_table._shards) {
+    std::lock_guard<std::mutex> lock(shard._mutex); // Shard lock
+    groups.reserve(groups.size() + shard._table.size());
+    for (auto &&[key, group] : shard._table) {
+      groups.push_back(group);
+    }
   }
 }
 
@@ -0,0 +1,600 @@
+/** @file
+
+  Completion based network data path with io_uring
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "P_IOUringNet.h"
+#include "P_NetAccept.h"
+#include "P_UnixNet.h"
+#include "P_UnixNetVConnection.h"
+
+#include "tsutil/Metrics.h"
+
+#include <algorithm>
+
+#include <unistd.h>
+
+using ts::Metrics;
+
+namespace
+{
+DbgCtl dbg_ctl_io_uring_net{"io_uring_net"};
+
+// The received data a connection can hold before the recv is cancelled, in receive buffers.
+constexpr int64_t MAX_PENDING_BUFFERS = 16;
+
+// How long a recv that ran out of receive buffers waits to be armed again. The buffers are provided again as the
+// completions of the thread are handled, so this only has to outlast the current batch.
+constexpr long RECV_NOBUFS_DELAY_NS = 1000000;
+
+struct IOUringNetStatsBlock {
+  Metrics::Counter::AtomicType *recv;
+  Metrics::Counter::AtomicType *recv_nobufs;
+  Metrics::Counter::AtomicType *recv_delayed;
+  Metrics::Counter::AtomicType *send;
+  Metrics::Counter::AtomicType *accept;
+};
+
+IOUringNetStatsBlock io_uring_net_rsb = []() {
+  return IOUringNetStatsBlock{Metrics::Counter::createPtr("proxy.process.io_uring.net.recv"),
+                              Metrics::Counter::createPtr("proxy.process.io_uring.net.recv_nobufs"),
+                              Metrics::Counter::createPtr("proxy.process.io_uring.net.recv_delayed"),
+                              Metrics::Counter::createPtr("proxy.process.io_uring.net.send"),
+                              Metrics::Counter::createPtr("proxy.process.io_uring.net.accept")};
+}();
+
+// The completion of a cancel, nothing to do as the cancelled operation gets its own completion.
+struct IgnoreCompletion : public IOUringCompletionHandler {
+  void
+  handle_complete(io_uring_cqe * /* cqe ATS_UNUSED */) override
+  {
+  }
+};
+
+IgnoreCompletion ignore_completion;
+
+void
+cancel(IOUringContext *ctx, IOUringCompletionHandler *op)
+{
+  io_uring_sqe *sqe = ctx->next_sqe(&ignore_completion);
+
+  if (sqe != nullptr) {
+    io_uring_prep_cancel(sqe, op, 0);
+  }
+}
+
+} // end anonymous namespace
+
+//
+// IOUringRecvBuffers
+//
+
+IOUringRecvBuffers::IOUringRecvBuffers(IOUringContext *ctx) : _ctx(ctx)
+{
+  const IOUringConfig &cfg = IOUringContext::get_config();
+
+  _entries = 1;
+  while (_entries < static_cast<unsigned int>(cfg.net_recv_buffers)) {
+    _entries <<= 1;
+  }
+  _size_index = iobuffer_size_to_index(cfg.net_recv_buffer_size, MAX_BUFFER_SIZE_INDEX);
+
+  if (_ctx->valid()) {
+    _ring = _ctx->setup_buf_ring(_entries, GROUP_ID);
+  }
+  if (_ring == nullptr) {
+    return;
+  }
+
+  _buffers.resize(_entries);
+  for (unsigned int bid = 0; bid < _entries; ++bid) {
+    _provide(bid);
+  }
+  Dbg(dbg_ctl_io_uring_net, "%u receive buffers of %" PRId64 " bytes", _entries, index_to_buffer_size(_size_index));
+}
+
+IOUringRecvBuffers::~IOUringRecvBuffers()
+{
+  if (_ring != nullptr) {
+    _ctx->free_buf_ring(_ring, _entries, GROUP_ID);
+  }
+}
+
+IOUringRecvBuffers *
+IOUringRecvBuffers::local()
+{
+  // The context is constructed first so that it outlives the buffer ring registered with it.
+  IOUringContext                 *ctx = IOUringContext::local_context();
+  thread_local IOUringRecvBuffers buffers(ctx);
+
+  return buffers._ring != nullptr ? &buffers : nullptr;
+}
+
+void
+IOUringRecvBuffers::_provide(unsigned int bid)
+{
+  _buffers[bid] = new_IOBufferData(_size_index);
+  io_uring_buf_ring_add(_ring, _buffers[bid]->data(), index_to_buffer_size(_size_index), bid, io_uring_buf_ring_mask(_entries),
+                        0);
+  io_uring_buf_ring_advance(_ring, 1);
+}
+
+Ptr<IOBufferData>
+IOUringRecvBuffers::take(unsigned int bid)
+{
+  ink_release_assert(bid < _entries);
+
+  Ptr<IOBufferData> data = _buffers[bid];
+
+  _provide(bid);
+  return data;
+}
+
+//
+// IOUringNetIO
+//
+
+IOUringNetIO::IOUringNetIO(UnixNetVConnection *vc)
+  : _vc(vc), _ctx(IOUringContext::local_context()), _buffers(IOUringRecvBuffers::local())
+{
+  _recv.io  = this;
+  _send.io  = this;
+  _delay.io = this;
+}
+
+bool
+IOUringNetIO::enabled()
+{
+  thread_local int state = -1;
+
+  if (state < 0) {
+    IOUringContext *ctx = IOUringContext::local_context();
+
+    // Multishot recv and provided buffer rings are both from Linux 6.0, which is also the release that added
+    // IORING_OP_SEND_ZC, the opcode the probe can tell apart.
+    state = IOUringContext::get_config().net_data_path && ctx->valid() && ctx->supports_op(IORING_OP_SEND_ZC) &&
+            IOUringRecvBuffers::local() != nullptr;
+    Dbg(dbg_ctl_io_uring_net, "io_uring network data path %s", state ? "enabled" : "disabled");
+  }
+  return state;
+}
+
+bool
+IOUringNetIO::_want_recv() const
+{
+  return _vc != nullptr && !_recv_armed && !_recv_delayed && !_eos && _error == 0 &&
+         _pending_bytes < MAX_PENDING_BUFFERS * IOUringContext::get_config().net_recv_buffer_size;
+}
+
+void
+IOUringNetIO::_arm_recv()
+{
+  io_uring_sqe *sqe = _ctx->next_sqe(&_recv);
+
+  // Without a submission queue entry, the next read tries again.
+  if (sqe == nullptr) {
+    return;
+  }
+  io_uring_prep_recv_multishot(sqe, _vc->con.sock.get_fd(), nullptr, 0, 0);
+  sqe->flags     |= IOSQE_BUFFER_SELECT;
+  sqe->buf_group  = IOUringRecvBuffers::GROUP_ID;
+  _recv_armed     = true;
+  _recv_cancel    = false;
+}
+
+void
+IOUringNetIO::_delay_recv()
+{
+  io_uring_sqe *sqe = _ctx->next_sqe(&_delay);
+
+  // Without a submission queue entry, the next read arms the recv.
+  if (sqe == nullptr) {
+    return;
+  }
+  _recv_delay.tv_sec  = 0;
+  _recv_delay.tv_nsec = RECV_NOBUFS_DELAY_NS;
+  io_uring_prep_timeout(sqe, &_recv_delay, 0, 0);
+  _recv_delayed = true;
+  Metrics::Counter::increment(io_uring_net_rsb.recv_delayed);
+}
+
+void
+IOUringNetIO::_cancel_recv()
+{
+  if (_recv_armed && !_recv_cancel) {
+    cancel(_ctx, &_recv);
+    _recv_cancel = true;
+  }
+}
+
+int64_t
+IOUringNetIO::read(MIOBuffer *buf, int64_t toread)
+{
+  if (_pending_bytes == 0) {
+    if (_error != 0) {
+      return -_error;
+    }
+    if (_eos) {
+      return 0;
+    }
+    if (_want_recv()) {
+      _arm_recv();
+    }
+    return -EAGAIN;
+  }
+
+  // Hand over the received blocks, the last one is split if it does not fit.
+  int64_t moved = 0;
+
+  while (_pending && moved < toread) {
+    IOBufferBlock *b     = _pending.get();
+    int64_t        avail = b->read_avail();
+
+    if (avail <= toread - moved) {
+      Ptr<IOBufferBlock> next = b->next;
+
+      b->next = nullptr;
+      buf->append_block(b);
+      _pending  = next;
+      moved    += avail;
+    } else {
+      IOBufferBlock *part = b->clone();
+
+      part->_end     = part->_start + (toread - moved);
+      part->_buf_end = part->_end;
+      buf->append_block(part);
+      b->consume(toread - moved);
+      moved = toread;
+    }
+  }
+  if (!_pending) {
+    _pending_tail = nullptr;
+  }
+  _pending_bytes -= moved;
+
+  if (_want_recv()) {
+    _arm_recv();
+  }
+  return moved;
+}
+
+void
+IOUringNetIO::RecvOp::handle_complete(io_uring_cqe *cqe)
+{
+  io->_recv_complete(cqe);
+}
+
+void
+IOUringNetIO::_recv_complete(io_uring_cqe *cqe)
+{
+  int res = cqe->res;
+
+  if (!(cqe->flags & IORING_CQE_F_MORE)) {
+    _recv_armed  = false;
+    _recv_cancel = false;
+  }
+
+  if (res > 0 && (cqe->flags & IORING_CQE_F_BUFFER)) {
+    Ptr<IOBufferData> data = _buffers->take(cqe->flags >> IORING_CQE_BUFFER_SHIFT);
+
+    Metrics::Counter::increment(io_uring_net_rsb.recv);
+    if (_vc != nullptr) {
+      IOBufferBlock *b = new_IOBufferBlock(data, res, 0);
+
+      if (_pending_tail != nullptr) {
+        _pending_tail->next = b;
+      } else {
+        _pending = b;
+      }
+      _pending_tail   = b;
+      _pending_bytes += res;
+
+      // Stop receiving while the connection does not read, the recv is armed again by the next read.
+      if (_pending_bytes >= MAX_PENDING_BUFFERS * IOUringContext::get_config().net_recv_buffer_size) {
+        _cancel_recv();
+      }
+    }
+  } else if (res == 0) {
+    _eos = true;
+  } else if (res == -ENOBUFS) {
+    // All the buffers of the thread are taken, a recv armed right away would fail the same way.
+    Metrics::Counter::increment(io_uring_net_rsb.recv_nobufs);
+    if (!_recv_armed && _vc != nullptr) {
+      _delay_recv();
+    }
+  } else if (res < 0 && res != -ECANCELED) {
+    _error = -res;
+  }
+
+  if (_release_if_idle() || _vc == nullptr) {
+    return;
+  }
+  // A recv cancelled for holding too much data is armed again when the connection has read it.
+  if (res == -ECANCELED) {
+    if (_want_recv()) {
+      _arm_recv();
+    }
+    return;
+  }
+  // Nothing was received, the recv is armed again after the delay.
+  if (res == -ENOBUFS && _recv_delayed) {
+    return;
+  }
+  _vc->read.triggered = 1;
+  _vc->readReschedule(_vc->nh);
+}
+
+void
+IOUringNetIO::DelayOp::handle_complete(io_uring_cqe * /* cqe ATS_UNUSED */)
+{
+  io->_delay_complete();
+}
+
+void
+IOUringNetIO::_delay_complete()
+{
+  _recv_delayed = false;
+  if (_release_if_idle() || _vc == nullptr) {
+    return;
+  }
+  if (_want_recv()) {
+    _arm_recv();
+  }
+}
+
+int64_t
+IOUringNetIO::write(int64_t towrite, MIOBufferAccessor &buf, int64_t &total_written)
+{
+  int64_t r = -EAGAIN;
+
+  if (_send_done) {
+    r          = _send_result;
+    _send_done = false;
+    // The write VIO may have been changed while the send was in flight, then the bytes it sent are gone with the old
+    // buffer.
+    if (r > 0 && _send_reader == buf.reader()) {
+      buf.reader()->consume(r);
+      total_written += r;
+    }
+    _send_reader = nullptr;
+    _send_blocks = nullptr;
+  }
+  if (_send_in_flight || (r < 0 && r != -EAGAIN) || towrite - total_written <= 0) {
+    return r;
+  }
+
+  // Send the rest with the next iteration of the NetHandler, along with the sends of the other connections.
+  IOBufferReader *tmp_reader = buf.reader()->clone();
+  unsigned        niov       = 0;
+  int64_t         try_write  = 0;
+
+  _send_blocks = tmp_reader->block;
+  while (niov < MAX_SEND_IOV && try_write < towrite - total_written) {
+    int64_t len = std::min(tmp_reader->block_read_avail(), towrite - total_written - try_write);
+
+    if (len <= 0) {
+      break;
+    }
+    _iov[niov].iov_base  = tmp_reader->start();
+    _iov[niov].iov_len   = len;
+    try_write           += len;
+    niov++;
+    tmp_reader->consume(len);
+  }
+  tmp_reader->dealloc();
+
+  io_uring_sqe *sqe = _ctx->next_sqe(&_send);
+
+  if (niov == 0 || sqe == nullptr) {
+    _send_blocks = nullptr;
+    return r;
+  }
+  ink_zero(_msg);
+  _msg.msg_iov    = _iov;
+  _msg.msg_iovlen = niov;
+  io_uring_prep_sendmsg(sqe, _vc->con.sock.get_fd(), &_msg, 0);
+  _send_reader    = buf.reader();
+  _send_in_flight = true;
+
+  return r;
+}
+
+void
+IOUringNetIO::SendOp::handle_complete(io_uring_cqe *cqe)
+{
+  io->_send_complete(cqe);
+}
+
+void
+IOUringNetIO::_send_complete(io_uring_cqe *cqe)
+{
+  _send_in_flight = false;
+  Metrics::Counter::increment(io_uring_net_rsb.send);
+
+  if (_release_if_idle() || _vc == nullptr) {
+    return;
+  }
+  _send_result         = cqe->res != 0 ? cqe->res : -EAGAIN;
+  _send_done           = true;
+  _vc->write.triggered = 1;
+  _vc->writeReschedule(_vc->nh);
+}
+
+void
+IOUringNetIO::detach()
+{
+  _vc            = nullptr;
+  _pending       = nullptr;
+  _pending_tail  = nullptr;
+  _pending_bytes = 0;
+
+  _cancel_recv();
+  if (_send_in_flight) {
+    cancel(_ctx, &_send);
+  }
+  if (_recv_delayed) {
+    cancel(_ctx, &_delay);
+  }
+  _release_if_idle();
+}
+
+bool
+IOUringNetIO::_release_if_idle()
+{
+  if (_vc == nullptr && !_recv_armed && !_send_in_flight && !_recv_delayed) {
+    delete this;
+    return true;
+  }
+  return false;
+}
+
+//
+// IOUringNetAccept
+//
+
+IOUringNetAccept::IOUringNetAccept(NetAccept *na) : _na(na), _ctx(IOUringContext::local_context()) {}
+
+bool
+IOUringNetAccept::start()
+{
+  if (!IOUringNetIO::enabled()) {
+    return false;
+  }
+
+  io_uring_sqe *sqe = _ctx->next_sqe(this);
+
+  if (sqe == nullptr) {
+    return false;
+  }
+  io_uring_prep_multishot_accept(sqe, _na->server.sock.get_fd(), nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+  _armed = true;
+  return true;
+}
+
+int
+IOUringNetAccept::next(sockaddr *addr, socklen_t *addrlen)
+{
+  if (_fds.empty()) {
+    if (_error != 0) {
+      int error = _error;
+
+      _error = 0;
+      return -error;
+    }
+    if (!_armed && !_delayed) {
+      start();
+    }
+    return -EAGAIN;
+  }
+
+  int fd = _fds.front();
+
+  _fds.pop_front();
+  if (getpeername(fd, addr, addrlen) < 0) {
+    int error = errno;
+
+    ::close(fd);
+    return -error;
+  }
+  return fd;
+}
+
+void
+IOUringNetAccept::stop()
+{
+  _stopped = true;
+  for (int fd : _fds) {
+    ::close(fd);
+  }
+  _fds.clear();
+
+  // Only one of the accept and the delay before arming it again is in flight.
+  if (_armed || _delayed) {
+    cancel(_ctx, this);
+  } else {
+    delete this;
+  }
+}
+
+// The multishot accept ended with the result @a res while the listener is still open.
+void
+IOUringNetAccept::_rearm(int res)
+{
+  if (res == -EMFILE || res == -ENFILE || res == -ENOBUFS || res == -ENOMEM) {
+    // Arming it now would fail the same way, wait as the epoll accept does.
+    io_uring_sqe *sqe = _ctx->next_sqe(this);
+
+    if (sqe != nullptr) {
+      _delay.tv_sec  = net_throttle_delay / 1000;
+      _delay.tv_nsec = (net_throttle_delay % 1000) * 1000000L;
+      io_uring_prep_timeout(sqe, &_delay, 0, 0);
+      _delayed = true;
+    }
+  } else if (res >= 0 || res == -ECANCELED || accept_error_seriousness(res) >= 0) {
+    start();
+  }
+  // Otherwise the NetAccept closes the listener on this error.
+}
+
+void
+IOUringNetAccept::handle_complete(io_uring_cqe *cqe)
+{
+  bool idle = _fds.empty() && _error == 0;
+
+  if (_delayed) {
+    // The delay is over, or was cancelled by stop().
+    _delayed = false;
+    if (_stopped) {
+      delete this;
+    } else {
+      start();
+    }
+    return;
+  }
+
+  if (!(cqe->flags & IORING_CQE_F_MORE)) {
+    _armed = false;
+  }
+
+  if (_stopped) {
+    if (cqe->res >= 0) {
+      ::close(cqe->res);
+    }
+    if (!_armed) {
+      delete this;
+    }
+    return;
+  }
+
+  if (cqe->res >= 0) {
+    Metrics::Counter::increment(io_uring_net_rsb.accept);
+    _fds.push_back(cqe->res);
+  } else if (cqe->res != -ECANCELED) {
+    _error = -cqe->res;
+  }
+  if (!_armed) {
+    _rearm(cqe->res);
+  }
+
+  if (idle && (!_fds.empty() || _error != 0)) {
+    this_ethread()->schedule_imm(_na);
+  }
+}
@@ -39,6 +39,8 @@ int net_accept_period  = 10;
 int net_retry_delay    = 10;
 int net_throttle_delay = 50; /* milliseconds */
 
+int net_zerocopy_threshold = 0;
+
 // For the in/out congestion control: ToDo: this probably would be better as ports: specifications
 std::string_view net_ccp_in;
 std::string_view net_ccp_out;
@@ -55,6 +57,7 @@ configure_net()
   // These are not reloadable
   REC_ReadConfigInteger(net_event_period, "proxy.config.net.event_period");
   REC_ReadConfigInteger(net_accept_period, "proxy.config.net.accept_period");
+  REC_ReadConfigInteger(net_zerocopy_threshold, "proxy.config.net.zerocopy_threshold");
 
   // This is kinda fugly, but better than it was before (on every connection in and out)
   // Note that these would need to be ats_free()'d if we ever want to clean that up, but
@@ -79,7 +82,9 @@ configure_net()
 static inline void
 register_net_stats()
 {
+  net_rsb.accepts_cross_cpu          = Metrics::Counter::createPtr("proxy.process.net.accepts_cross_cpu");
   net_rsb.accepts_currently_open     = Metrics::Gauge::createPtr("proxy.process.net.accepts_currently_open");
+  net_rsb.accepts_same_cpu           = Metrics::Counter::createPtr("proxy.process.net.accepts_same_cpu");
   net_rsb.calls_to_read              = Metrics::Counter::createPtr("proxy.process.net.calls_to_read");
   net_rsb.calls_to_read_nodata       = Metrics::Counter::createPtr("proxy.process.net.calls_to_read_nodata");
   net_rsb.calls_to_readfromnet       = Metrics::Counter::createPtr("proxy.process.net.calls_to_readfromnet");
@@ -124,6 +129,9 @@ register_net_stats()
   net_rsb.handler_run                        = Metrics::Counter::createPtr("proxy.process.net.net_handler_run");
   net_rsb.inactivity_cop_lock_acquire_failure =
     Metrics::Counter::createPtr("proxy.process.net.inactivity_cop_lock_acquire_failure");
+  net_rsb.inactivity_cop_runs              = Metrics::Counter::createPtr("proxy.process.net.inactivity_cop_runs");
+  net_rsb.inactivity_cop_checked           = Metrics::Counter::createPtr("proxy.process.net.inactivity_cop_checked");
+  net_rsb.inactivity_cop_sweep_time        = Metrics::Counter::createPtr("proxy.process.net.inactivity_cop_sweep_time");
   net_rsb.keep_alive_queue_timeout_count   = Metrics::Counter::createPtr("proxy.process.net.dynamic_keep_alive_timeout_in_count");
   net_rsb.keep_alive_queue_timeout_total   = Metrics::Counter::createPtr("proxy.process.net.dynamic_keep_alive_timeout_in_total");
   net_rsb.read_bytes                       = Metrics::Counter::createPtr("proxy.process.net.read_bytes");
@@ -135,6 +143,11 @@ register_net_stats()
   net_rsb.tcp_accept                       = Metrics::Counter::createPtr("proxy.process.tcp.total_accepts");
   net_rsb.write_bytes                      = Metrics::Counter::createPtr("proxy.process.net.write_bytes");
   net_rsb.write_bytes_count                = Metrics::Counter::createPtr("proxy.process.net.write_bytes_count");
+  net_rsb.zerocopy_writes                  = Metrics::Counter::createPtr("proxy.process.net.zerocopy.writes");
+  net_rsb.zerocopy_bytes                   = Metrics::Counter::createPtr("proxy.process.net.zerocopy.bytes");
+  net_rsb.zerocopy_copied_bytes            = Metrics::Counter::createPtr("proxy.process.net.zerocopy.copied_bytes");
+  net_rsb.zerocopy_fallbacks               = Metrics::Counter::createPtr("proxy.process.net.zerocopy.fallbacks");
+  net_rsb.zerocopy_deferred_bytes          = Metrics::Gauge::createPtr("proxy.process.net.zerocopy.deferred_bytes");
   net_rsb.connection_tracker_table_size    = Metrics::Gauge::createPtr("proxy.process.net.connection_tracker_table_size");
 }
 
@@ -25,6 +25,7 @@
 #include "P_UnixNet.h"
 #include "iocore/net/NetHandler.h"
 #include "iocore/net/PollCont.h"
+#include "tscore/ink_atomic.h"
 #if TS_USE_LINUX_IO_URING
 #include "iocore/io_uring/IO_URING.h"
 #endif
@@ -38,6 +39,30 @@ namespace
 DbgCtl dbg_ctl_net_queue{"net_queue"};
 DbgCtl dbg_ctl_v_net_queue{"v_net_queue"};
 
+// When the timeouts of @a ne should be checked next, 0 if there is nothing to check.
+ink_hrtime
+timeout_check_at(NetEvent *ne, ink_hrtime now)
+{
+  // The next check frees a closed NetEvent, or sets its default inactivity timeout.
+  if (ne->closed || ne->default_inactivity_timeout_in == -1) {
+    return now;
+  }
+
+  ink_hrtime at = ne->next_inactivity_timeout_at;
+
+  if (ne->next_activity_timeout_at && (at == 0 || ne->next_activity_timeout_at < at)) {
+    at = ne->next_activity_timeout_at;
+  }
+  if (at) {
+    return at;
+  }
+  // Without a timeout, the default inactivity timeout is applied once I/O is enabled.
+  if (ne->default_inactivity_timeout_in > 0 && (ne->read.enabled || ne->write.enabled)) {
+    return now;
+  }
+  return 0;
+}
+
 } // end anonymous namespace
 
 std::atomic<int32_t>  NetHandler::additional_accepts{0};
@@ -103,6 +128,7 @@ NetHandler::startCop(NetEvent *ne)
   ink_assert(!open_list.in(ne));
 
   open_list.enqueue(ne);
+  schedule_timeout(ne, ink_get_hrtime());
 }
 
 void
@@ -111,11 +137,61 @@ NetHandler::stopCop(NetEvent *ne)
   ink_release_assert(ne->nh == this);
 
   open_list.remove(ne);
-  cop_list.remove(ne);
+  timeout_wheel.remove(ne);
+  if (ne->in_timeout_update_list) {
+    timeout_update_list.remove(ne);
+    ne->in_timeout_update_list = 0;
+  }
   remove_from_keep_alive_queue(ne);
   remove_from_active_queue(ne);
 }
 
+void
+NetHandler::schedule_timeout(NetEvent *ne, ink_hrtime now)
+{
+  if (ink_hrtime at = timeout_check_at(ne, now); at) {
+    timeout_wheel.schedule(ne, at);
+  } else {
+    timeout_wheel.remove(ne);
+  }
+}
+
+void
+NetHandler::update_timeout(NetEvent *ne)
+{
+  // Only the thread of this NetHandler touches the timeout wheel.
+  if (this->thread != this_ethread()) {
+    if (!ink_atomic_swap(&ne->in_timeout_update_list, 1)) {
+      timeout_update_list.push(ne);
+    }
+    return;
+  }
+  // startCop puts it in the wheel.
+  if (!open_list.in(ne)) {
+    return;
+  }
+
+  ink_hrtime at = timeout_check_at(ne, ink_get_hrtime());
+
+  // A later check time is left as it is, the check puts the NetEvent back in the wheel at the right time.
+  if (at == 0 || (timeout_wheel.in(ne) && ne->timeout_check_at <= at)) {
+    return;
+  }
+  timeout_wheel.schedule(ne, at);
+}
+
+void
+NetHandler::process_timeout_updates()
+{
+  NetEvent *ne = nullptr;
+
+  SList(NetEvent, timeout_update_link) q(timeout_update_list.popall());
+  while ((ne = q.pop())) {
+    ne->in_timeout_update_list = 0;
+    update_timeout(ne);
+  }
+}
+
 int
 NetHandler::update_nethandler_config(const char *str, RecDataT, RecData data, void *)
 {
@@ -349,6 +425,7 @@ NetHandler::waitForActivity(ink_hrtime timeout)
   SCOPED_MUTEX_LOCK(lock, mutex, this->thread);
 
   process_enabled_list();
+  process_timeout_updates();
 
 #if TS_USE_LINUX_IO_URING
   ur->submit();
@@ -519,6 +596,7 @@ NetHandler::_close_ne(NetEvent *ne, ink_hrtime now, int &handle_event, int &clos
     ++closed;
   } else {
     ne->next_inactivity_timeout_at = now;
+    timeout_wheel.schedule(ne, now);
     // create a dummy event
     Event event;
     event.ethread = this_ethread();
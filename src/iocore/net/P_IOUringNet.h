@@ -0,0 +1,218 @@
+/** @file
+
+  Completion based network data path with io_uring
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include "tscore/ink_config.h"
+
+#if TS_USE_LINUX_IO_URING
+#include "iocore/eventsystem/IOBuffer.h"
+#include "iocore/io_uring/IO_URING.h"
+#include "iocore/net/Net.h"
+#include "tscore/ink_memory.h"
+
+#include <sys/socket.h>
+#include <sys/uio.h>
+
+#include <deque>
+#include <vector>
+
+class UnixNetVConnection;
+struct NetAccept;
+
+/** Receive buffers provided to the kernel, one ring per thread.
+
+    The buffers are IOBufferData. A completed receive takes its buffer out of the ring and a new one is provided in its
+    place, so that the received data is handed to the connection in an IOBufferBlock, without a copy.
+ */
+class IOUringRecvBuffers
+{
+public:
+  static constexpr int GROUP_ID = 0;
+
+  explicit IOUringRecvBuffers(IOUringContext *ctx);
+  ~IOUringRecvBuffers();
+
+  IOUringRecvBuffers(const IOUringRecvBuffers &) = delete;
+
+  /// The buffers of this thread, nullptr if the kernel does not support provided buffer rings.
+  static IOUringRecvBuffers *local();
+
+  /// Take the buffer @a bid filled by the kernel, and provide a new one in its place.
+  Ptr<IOBufferData> take(unsigned int bid);
+
+private:
+  void _provide(unsigned int bid);
+
+  IOUringContext                *_ctx;
+  io_uring_buf_ring             *_ring       = nullptr;
+  unsigned int                   _entries    = 0;
+  int64_t                        _size_index = 0;
+  std::vector<Ptr<IOBufferData>> _buffers;
+};
+
+/** The io_uring operations of a UnixNetVConnection.
+
+    A multishot recv is kept armed, and the received blocks wait here until the connection reads them. There is one
+    sendmsg in flight at most, and its result is picked up by the next write of the connection. A recv that ran out of
+    receive buffers is armed again after a short timeout rather than right away. When the connection is closed with
+    operations in flight, this lives on until the kernel is done with them.
+ */
+class IOUringNetIO
+{
+public:
+  explicit IOUringNetIO(UnixNetVConnection *vc);
+
+  /// Whether the connections of this thread can use io_uring.
+  static bool enabled();
+
+  /** Move received data to @a buf.
+
+      @return the bytes moved, at most @a toread, 0 at the end of stream, -EAGAIN if no data was received yet, or the
+      negated errno of the receive.
+   */
+  int64_t read(MIOBuffer *buf, int64_t toread);
+
+  /** Write from @a buf.
+
+      @return the result of the previous send, after consuming what it sent from @a buf and adding it to
+      @a total_written, or -EAGAIN if a send was submitted or is still in flight.
+   */
+  int64_t write(int64_t towrite, MIOBufferAccessor &buf, int64_t &total_written);
+
+  /// The connection is going away, cancel what is in flight.
+  void detach();
+
+private:
+  struct RecvOp : public IOUringCompletionHandler {
+    IOUringNetIO *io = nullptr;
+    void          handle_complete(io_uring_cqe *cqe) override;
+  };
+
+  struct SendOp : public IOUringCompletionHandler {
+    IOUringNetIO *io = nullptr;
+    void          handle_complete(io_uring_cqe *cqe) override;
+  };
+
+  struct DelayOp : public IOUringCompletionHandler {
+    IOUringNetIO *io = nullptr;
+    void          handle_complete(io_uring_cqe *cqe) override;
+  };
+
+  // NET_MAX_IOV is too many to keep with each connection, a send of more blocks is partial.
+  static constexpr unsigned int MAX_SEND_IOV = 32;
+
+  ~IOUringNetIO() = default;
+
+  bool _want_recv() const;
+  void _arm_recv();
+  void _cancel_recv();
+  void _delay_recv();
+  void _recv_complete(io_uring_cqe *cqe);
+  void _delay_complete();
+  void _send_complete(io_uring_cqe *cqe);
+  bool _release_if_idle();
+
+  UnixNetVConnection *_vc;
+  IOUringContext     *_ctx;
+  IOUringRecvBuffers *_buffers;
+  RecvOp              _recv;
+  SendOp              _send;
+  DelayOp             _delay;
+
+  // received data not read by the connection yet
+  Ptr<IOBufferBlock> _pending;
+  IOBufferBlock     *_pending_tail  = nullptr;
+  int64_t            _pending_bytes = 0;
+  bool               _recv_armed    = false;
+  bool               _recv_cancel   = false;
+  bool               _eos           = false;
+  int                _error         = 0;
+
+  // the timeout before the recv is armed again, after it ran out of receive buffers
+  __kernel_timespec _recv_delay   = {};
+  bool              _recv_delayed = false;
+
+  // the send in flight, the blocks are held until it completes
+  msghdr             _msg = {};
+  IOVec              _iov[MAX_SEND_IOV];
+  Ptr<IOBufferBlock> _send_blocks;
+  IOBufferReader    *_send_reader    = nullptr;
+  int64_t            _send_result    = 0;
+  bool               _send_in_flight = false;
+  bool               _send_done      = false;
+};
+
+/** Multishot accept on a listening socket, for the per thread NetAccept.
+
+    The accepted sockets are queued until the NetAccept, scheduled on the first one, takes them.
+    When the kernel ends the multishot accept, on a failed accept or otherwise, it is armed again
+    while the listener is open, after proxy.config.net.throttle_delay if the accept ran out of
+    file descriptors or memory.
+ */
+class IOUringNetAccept final : public IOUringCompletionHandler
+{
+public:
+  explicit IOUringNetAccept(NetAccept *na);
+
+  /// Arm the multishot accept, false if it cannot be used for this listener.
+  bool start();
+
+  /** The next accepted socket, its peer address is set in @a addr.
+
+      @return the socket, -EAGAIN if there is none, or the negated errno of a failed accept.
+   */
+  int next(sockaddr *addr, socklen_t *addrlen);
+
+  /// The NetAccept is going away, cancel the accept. This is deleted when its last completion arrives.
+  void stop();
+
+  void handle_complete(io_uring_cqe *cqe) override;
+
+  /// The multishot accept is in the kernel.
+  bool
+  armed() const
+  {
+    return _armed;
+  }
+
+  /// The multishot accept ended on a failed accept, it is armed again when the delay is over.
+  bool
+  delayed() const
+  {
+    return _delayed;
+  }
+
+private:
+  void _rearm(int res);
+
+  NetAccept        *_na;
+  IOUringContext   *_ctx;
+  std::deque<int>   _fds;
+  __kernel_timespec _delay   = {};
+  int               _error   = 0;
+  bool              _armed   = false;
+  bool              _delayed = false;
+  bool              _stopped = false;
+};
+#endif
@@ -35,7 +35,9 @@
 using ts::Metrics;
 
 struct NetStatsBlock {
+  Metrics::Counter::AtomicType *accepts_cross_cpu;
   Metrics::Gauge::AtomicType   *accepts_currently_open;
+  Metrics::Counter::AtomicType *accepts_same_cpu;
   Metrics::Counter::AtomicType *calls_to_read_nodata;
   Metrics::Counter::AtomicType *calls_to_read;
   Metrics::Counter::AtomicType *calls_to_readfromnet;
@@ -53,6 +55,9 @@ struct NetStatsBlock {
   Metrics::Counter::AtomicType *handler_run;
   Metrics::Counter::AtomicType *handler_run_count;
   Metrics::Counter::AtomicType *inactivity_cop_lock_acquire_failure;
+  Metrics::Counter::AtomicType *inactivity_cop_runs;
+  Metrics::Counter::AtomicType *inactivity_cop_checked;
+  Metrics::Counter::AtomicType *inactivity_cop_sweep_time;
   Metrics::Counter::AtomicType *keep_alive_queue_timeout_count;
   Metrics::Counter::AtomicType *keep_alive_queue_timeout_total;
   Metrics::Counter::AtomicType *read_bytes;
@@ -78,6 +83,11 @@ struct NetStatsBlock {
   Metrics::Counter::AtomicType *tcp_accept;
   Metrics::Counter::AtomicType *write_bytes;
   Metrics::Counter::AtomicType *write_bytes_count;
+  Metrics::Counter::AtomicType *zerocopy_writes;
+  Metrics::Counter::AtomicType *zerocopy_bytes;
+  Metrics::Counter::AtomicType *zerocopy_copied_bytes;
+  Metrics::Counter::AtomicType *zerocopy_fallbacks;
+  Metrics::Gauge::AtomicType   *zerocopy_deferred_bytes;
   Metrics::Gauge::AtomicType   *connection_tracker_table_size;
 };
 
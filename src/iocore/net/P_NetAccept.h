@@ -47,6 +47,9 @@
 
 struct NetAccept;
 struct HttpProxyPort;
+#if TS_USE_LINUX_IO_URING
+class IOUringNetAccept;
+#endif
 class Event;
 class SSLNextProtocolAccept;
 //
@@ -97,10 +100,18 @@ struct NetAccept : public Continuation {
   Ptr<NetAcceptAction>   action_;
   SSLNextProtocolAccept *snpa = nullptr;
   NetAcceptEventIO       ep;
+#if TS_USE_LINUX_IO_URING
+  // multishot accept, for a listener of its own thread
+  IOUringNetAccept *uring_accept = nullptr;
+#endif
 
   HttpProxyPort *proxyPort = nullptr;
   AcceptOptions  opt;
 
+  // With the connections steered by CPU, the place of the listener in its reuseport group, and the listener to start next.
+  int        steer_index = -1;
+  NetAccept *steer_next  = nullptr;
+
   virtual NetProcessor *getNetProcessor() const;
 
   virtual void       init_accept(EThread *t = nullptr);
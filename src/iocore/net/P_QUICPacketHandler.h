@@ -71,7 +71,12 @@ private:
   QUICConnectionTable &_ctable;
   quiche_config       &_quiche_config;
 
+  // The place of the listener in its reuseport group, and the listener to bind next.
+  int                  _index = 0;
+  QUICPacketHandlerIn *_next  = nullptr;
+
   void _recv_packet(int event, UDPPacket *udpPacket) override;
+  int  _shard() const;
 };
 
 class QUICPacketHandlerOut : public Continuation, public QUICPacketHandler
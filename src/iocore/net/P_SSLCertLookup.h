@@ -29,12 +29,15 @@
 
 #include <set>
 #include <openssl/ssl.h>
+#include <memory>
 #include <mutex>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 struct SSLConfigParams;
 struct SSLContextStorage;
+class SSLLazyContext;
 
 /** Special things to do instead of use a context.
     In general an option will be associated with a @c nullptr context because
@@ -115,6 +118,12 @@ public:
   {
   }
 
+  /// A context built when a handshake needs it, see @c SSLLazyContext.
+  SSLCertContext(std::shared_ptr<SSLLazyContext> l, SSLCertContextType ctx_type, const shared_SSLMultiCertConfigParams &u)
+    : ctx_mutex(), ctx(nullptr), ctx_type(ctx_type), opt(u->opt), userconfig(u), keyblock(nullptr), lazy(std::move(l))
+  {
+  }
+
   SSLCertContext(SSLCertContext const &other);
   SSLCertContext &operator=(SSLCertContext const &other);
   ~SSLCertContext() {}
@@ -128,6 +137,13 @@ public:
   SSLCertContextOption            opt        = SSLCertContextOption::OPT_NONE; ///< Special handling option.
   shared_SSLMultiCertConfigParams userconfig = nullptr;                        ///< User provided settings
   shared_ssl_ticket_key_block     keyblock   = nullptr;                        ///< session keys associated with this address
+  std::shared_ptr<SSLLazyContext> lazy       = nullptr;                        ///< Builds the context on demand.
+};
+
+/// The contexts built for a certificate of ssl_multicert.config, or the context that builds them on demand.
+struct SSLCertContexts {
+  std::vector<std::pair<shared_SSL_CTX, SSLCertContextType>> ctxs;
+  std::shared_ptr<SSLLazyContext>                            lazy = nullptr;
 };
 
 struct SSLCertLookup : public ConfigInfo {
@@ -166,6 +182,9 @@ struct SSLCertLookup : public ConfigInfo {
   void register_cert_secrets(std::vector<std::string> const &cert_secrets, std::set<std::string> &lookup_names);
   void getPolicies(const std::string &secret_name, std::set<shared_SSLMultiCertConfigParams> &policies) const;
 
+  /// The contexts of the certificates by their fingerprint, the next reload reuses those of the unchanged certificates.
+  std::unordered_map<std::string, SSLCertContexts> built;
+
   SSLCertLookup();
   ~SSLCertLookup() override;
 
@@ -72,6 +72,8 @@ struct SSLConfigParams : public ConfigInfo {
   char *cipherSuite;
   char *client_cipherSuite;
   int   configExitOnLoadError;
+  int   configLazyLoad;
+  int   configLoadThreads;
   int   clientCertLevel;
   int   verify_depth;
   int   ssl_origin_session_cache;
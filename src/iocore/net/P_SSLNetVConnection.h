@@ -79,6 +79,7 @@ constexpr int64_t  SSL_DEF_TLS_RECORD_BYTE_THRESHOLD = 1000000;
 constexpr int      SSL_DEF_TLS_RECORD_MSEC_THRESHOLD = 1000;
 
 struct SSLCertLookup;
+class SSLLazyContext;
 
 enum class SslVConnOp {
   SSL_HOOK_OP_DEFAULT,  ///< Null / initialization value. Do normal processing.
@@ -317,6 +318,7 @@ protected:
   bool           _isTryingRenegotiation() const override;
   shared_SSL_CTX _lookupContextByName(const std::string &servername, SSLCertContextType ctxType) override;
   shared_SSL_CTX _lookupContextByIP() override;
+  bool           _isWaitingForContext() const override;
 
   // TLSEventSupport
   bool
@@ -358,6 +360,11 @@ private:
 
   ReadWriteEventIO async_ep{};
 
+  // The context of the server name is being built, the handshake goes on when it is done.
+  class LazyContextWait;
+  std::shared_ptr<SSLLazyContext> _lazy_ctx;
+  LazyContextWait                *_lazy_ctx_wait = nullptr;
+
   // early data related stuff
 #if TS_HAS_TLS_EARLY_DATA
   bool            _early_data_finish = false;
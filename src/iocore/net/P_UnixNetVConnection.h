@@ -47,6 +47,10 @@
 class UnixNetVConnection;
 class NetHandler;
 struct PollDescriptor;
+class ZeroCopyWrites;
+#if TS_USE_LINUX_IO_URING
+class IOUringNetIO;
+#endif
 
 // WARNING:  many or most of the member functions of UnixNetVConnection should only be used when it is instantiated
 // directly.  They should not be used when UnixNetVConnection is a base class.
@@ -151,6 +155,7 @@ public:
   virtual void net_read_io(NetHandler *nh) override;
   virtual void net_write_io(NetHandler *nh) override;
   virtual void free_thread(EThread *t) override;
+  void         process_error_queue() override;
   virtual int
   close() override
   {
@@ -200,6 +205,8 @@ public:
    * current NetVC and mark the current NetVC to be closed.
    */
   UnixNetVConnection *migrateToCurrentThread(Continuation *c, EThread *t);
+  /// A connection on io_uring stays with its thread.
+  bool can_migrate() const override;
 
   Action action_;
 
@@ -259,6 +266,16 @@ private:
   /** The shared group across all connections for this IP to track incoming
    * connections for connection limiting. */
   std::shared_ptr<ConnectionTracker::Group> conn_track_group;
+
+  // The MSG_ZEROCOPY writes of this connection, created with the first write over the threshold.
+  ZeroCopyWrites *_zerocopy = nullptr;
+
+#if TS_USE_LINUX_IO_URING
+  // The io_uring operations of this connection, nullptr if it stays with readiness based I/O.
+  IOUringNetIO *_io_uring();
+
+  IOUringNetIO *_uring = nullptr;
+#endif
 };
 
 extern ClassAllocator<UnixNetVConnection> netVCAllocator;
@@ -291,6 +308,16 @@ UnixNetVConnection::set_local_addr()
   ATS_UNUSED_RETURN(safe_getsockname(get_fd(), &local_addr.sa, &local_sa_size));
 }
 
+inline bool
+UnixNetVConnection::can_migrate() const
+{
+#if TS_USE_LINUX_IO_URING
+  return _uring == nullptr;
+#else
+  return true;
+#endif
+}
+
 // Update the internal VC state variable for MPTCP
 inline void
 UnixNetVConnection::set_mptcp_state()
@@ -326,14 +353,6 @@ UnixNetVConnection::get_inactivity_timeout()
   return inactivity_timeout_in;
 }
 
-inline void
-UnixNetVConnection::set_active_timeout(ink_hrtime timeout_in)
-{
-  Dbg(_dbg_ctl_socket, "Set active timeout=%" PRId64 ", NetVC=%p", timeout_in, this);
-  active_timeout_in        = timeout_in;
-  next_activity_timeout_at = (active_timeout_in > 0) ? ink_get_hrtime() + timeout_in : 0;
-}
-
 inline void
 UnixNetVConnection::cancel_inactivity_timeout()
 {
@@ -0,0 +1,91 @@
+/** @file
+
+  Socket writes with MSG_ZEROCOPY
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include "iocore/eventsystem/IOBuffer.h"
+#include "tscore/ink_hrtime.h"
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+/** The zero copy writes of a socket.
+
+    The kernel sends a MSG_ZEROCOPY write from the pages of the caller, so the IOBufferData of the write are held until
+    the completion of the write is read from the error queue of the socket. When the kernel reports that it copied the
+    data anyway, the socket goes back to regular writes.
+ */
+class ZeroCopyWrites
+{
+public:
+  ZeroCopyWrites() = default;
+  ~ZeroCopyWrites();
+
+  ZeroCopyWrites(const ZeroCopyWrites &) = delete;
+
+  /// Whether a write of @a len bytes on @a fd should use MSG_ZEROCOPY, SO_ZEROCOPY is set with the first one.
+  bool use(int fd, int64_t len);
+
+  /// A MSG_ZEROCOPY write sent @a bytes from @a blocks, hold their data until it completes.
+  void sent(int64_t bytes, IOBufferBlock *const *blocks, unsigned int nblocks);
+
+  /// Read the completions from the error queue of @a fd, and release the data of the completed writes.
+  void complete(int fd);
+
+  bool
+  pending() const
+  {
+    return !_sends.empty();
+  }
+
+  /** Close @a fd once its zero copy writes complete.
+
+      The socket is shut down for writing right away, it is closed and @a zc deleted by @c reap.
+   */
+  static void linger(int fd, ZeroCopyWrites *zc);
+
+  /** Close the sockets of this thread whose zero copy writes completed, or that waited too long.
+
+      A socket that waited too long is reset rather than closed, so that the kernel does not send from the released data.
+   */
+  static void reap(ink_hrtime now);
+
+private:
+  friend struct ZeroCopyWritesTest;
+
+  struct Send {
+    uint32_t                       seq   = 0;
+    int64_t                        bytes = 0;
+    int64_t                        held  = 0;
+    std::vector<Ptr<IOBufferData>> data;
+  };
+
+  void _release(uint32_t lo, uint32_t hi, bool copied);
+
+  enum class State { UNKNOWN, ON, OFF };
+
+  std::deque<Send> _sends;
+  uint32_t         _next_seq = 0;
+  State            _state    = State::UNKNOWN;
+};
@@ -105,3 +105,10 @@ QUICMultiCertConfigLoader::_debug_tag() const
 {
   return "quic";
 }
+
+bool
+QUICMultiCertConfigLoader::_lazy_load() const
+{
+  // The QUIC handshake does not wait for a context.
+  return false;
+}
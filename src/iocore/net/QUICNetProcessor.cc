@@ -123,7 +123,8 @@ QUICNetProcessor::createNetAccept(const NetProcessor::AcceptOptions &opt)
 {
   if (this->_ctable == nullptr) {
     QUICConfig::scoped_config params;
-    this->_ctable = new QUICConnectionTable(params->connection_table_size());
+    // A shard for each UDP listener.
+    this->_ctable = new QUICConnectionTable(params->connection_table_size(), eventProcessor.thread_group[ET_UDP]._count);
   }
   return new QUICPacketHandlerIn(opt, *this->_ctable, *this->_quiche_config);
 }
@@ -29,6 +29,7 @@
 #include "P_UnixNet.h"
 #include "P_UnixUDPConnection.h"
 #include "iocore/net/quic/QUICConnectionTable.h"
+#include "iocore/net/quic/QUICStats.h"
 #include "iocore/net/QUICMultiCertConfigLoader.h"
 #include "tscore/Layout.h"
 #include "tscore/ink_atomic.h"
@@ -36,6 +37,10 @@
 #include "swoc/BufferWriter.h"
 #include <quiche.h>
 
+#ifdef SO_ATTACH_REUSEPORT_CBPF
+#include <linux/filter.h>
+#endif
+
 namespace
 {
 constexpr char debug_tag[]   = "quic_sec";
@@ -45,6 +50,41 @@ DbgCtl dbg_ctl{debug_tag};
 DbgCtl dbg_ctl_v{v_debug_tag};
 DbgCtl dbg_ctl_quic_sec{"quic_sec"};
 
+/** Steer the short header packets of a reuseport group to the listener that owns their connection, the one in the first
+ * byte of their destination connection ID.
+ *
+ * The long header packets, whose destination connection ID may be chosen by the client, and the ones of a connection ID
+ * out of the @a nshards first listeners are spread by the kernel by the hash of their addresses.
+ */
+void
+attach_cid_steering(int fd, int nshards)
+{
+#ifdef SO_ATTACH_REUSEPORT_CBPF
+  // The program runs on the UDP payload, an index out of the group has the kernel fall back to the hash.
+  sock_filter prog[] = {
+    BPF_STMT(BPF_LD | BPF_B | BPF_ABS, 0),
+    BPF_JUMP(BPF_JMP | BPF_JSET | BPF_K, 0x80, 3, 0),
+    BPF_STMT(BPF_LD | BPF_B | BPF_ABS, 1),
+    BPF_JUMP(BPF_JMP | BPF_JGE | BPF_K, static_cast<uint32_t>(nshards), 1, 0),
+    BPF_STMT(BPF_RET | BPF_A, 0),
+    BPF_STMT(BPF_RET | BPF_K, static_cast<uint32_t>(nshards)),
+  };
+  sock_fprog fprog;
+
+  fprog.len    = sizeof(prog) / sizeof(prog[0]);
+  fprog.filter = prog;
+  if (safe_setsockopt(fd, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, reinterpret_cast<char *>(&fprog), sizeof(fprog)) < 0) {
+    Warning("unable to steer the QUIC packets by connection ID, they are spread over the UDP threads: %s", strerror(errno));
+    return;
+  }
+  Dbg(dbg_ctl, "steering the QUIC packets of fd=%d over %d listeners", fd, nshards);
+#else
+  (void)fd;
+  (void)nshards;
+  Dbg(dbg_ctl, "steering the QUIC packets by connection ID is not supported on this platform");
+#endif
+}
+
 } // end anonymous namespace
 
 #define QUICDebug(fmt, ...)               Dbg(dbg_ctl, fmt, ##__VA_ARGS__)
@@ -145,7 +185,12 @@ QUICPacketHandlerIn::acceptEvent(int event, void *data)
   ink_release_assert((event == NET_EVENT_DATAGRAM_READ_READY) ? (data != nullptr) : (1));
 
   if (event == NET_EVENT_DATAGRAM_OPEN) {
-    // Nothing to do.
+    // The next listener joins the reuseport group after this one, the last one steers the group.
+    if (this->_next) {
+      eventProcessor.thread_group[ET_UDP]._thread[this->_next->_index]->schedule_imm(this->_next);
+    } else {
+      attach_cid_steering(static_cast<UDPConnection *>(data)->getFd(), this->_ctable.shards());
+    }
     return EVENT_CONT;
   } else if (event == NET_EVENT_DATAGRAM_READ_READY) {
     if (this->_collector_event == nullptr) {
@@ -181,12 +226,26 @@ QUICPacketHandlerIn::init_accept(EThread * /* t  ATS_UNUSED */ = nullptr)
 
   SET_HANDLER(&QUICPacketHandlerIn::acceptEvent);
 
+  // The listeners bind one after the other in the order of the threads, the place of a listener in its reuseport group is
+  // then the shard of the connections it creates, where the steering program finds it.
+  QUICPacketHandlerIn *first = nullptr;
+  QUICPacketHandlerIn *prev  = nullptr;
+
   n = eventProcessor.thread_group[ET_UDP]._count;
   for (i = 0; i < n; i++) {
-    NetAccept *a = (i < n - 1) ? clone() : this;
-    EThread   *t = eventProcessor.thread_group[ET_UDP]._thread[i];
-    a->mutex     = get_NetHandler(t)->mutex;
-    t->schedule_imm(a);
+    QUICPacketHandlerIn *a = (i < n - 1) ? static_cast<QUICPacketHandlerIn *>(clone()) : this;
+    EThread             *t = eventProcessor.thread_group[ET_UDP]._thread[i];
+    a->mutex               = get_NetHandler(t)->mutex;
+    a->_index              = i;
+    if (prev != nullptr) {
+      prev->_next = a;
+    } else {
+      first = a;
+    }
+    prev = a;
+  }
+  if (first != nullptr) {
+    eventProcessor.thread_group[ET_UDP]._thread[0]->schedule_imm(first);
   }
 }
 
@@ -196,6 +255,12 @@ QUICPacketHandlerIn::_get_continuation()
   return this;
 }
 
+int
+QUICPacketHandlerIn::_shard() const
+{
+  return this->_index % this->_ctable.shards();
+}
+
 void
 QUICPacketHandlerIn::_recv_packet(int /* event ATS_UNUSED */, UDPPacket *udp_packet)
 {
@@ -229,6 +294,10 @@ QUICPacketHandlerIn::_recv_packet(int /* event ATS_UNUSED */, UDPPacket *udp_pac
   QUICConnection     *qc = this->_ctable.lookup({dcid, static_cast<uint8_t>(dcid_len)});
   QUICNetVConnection *vc = static_cast<QUICNetVConnection *>(qc);
 
+  if (vc != nullptr && !QUICInvariants::is_long_header(buf) && dcid_len > 0 && dcid[0] != this->_shard()) {
+    Metrics::Counter::increment(quic_rsb.packets_cross_listener);
+  }
+
   EThread *eth = nullptr;
   if (vc == nullptr) {
     if (!quiche_version_is_supported(version)) {
@@ -283,7 +352,9 @@ QUICPacketHandlerIn::_recv_packet(int /* event ATS_UNUSED */, UDPPacket *udp_pac
       return;
     }
 
+    // The connection belongs to this listener, its packets are steered here.
     QUICConnectionId new_cid;
+    new_cid.randomize(this->_shard());
 
     QUICCertConfig::scoped_config server_cert;
     SSL                          *ssl = SSL_new(server_cert->defaultContext());
@@ -50,13 +50,9 @@ ReadWriteEventIO::start(EventLoop l, int afd, NetEvent *ne, NetHandler *nh, int
 void
 ReadWriteEventIO::process_event(int flags)
 {
-  // Remove triggered NetEvent from cop_list because it won't be timeout before
-  // next InactivityCop runs.
-  if (_nh->cop_list.in(_ne)) {
-    _nh->cop_list.remove(_ne);
-  }
   if (flags & (EVENTIO_ERROR)) {
     _ne->set_error_from_socket();
+    _ne->process_error_queue();
   }
   if (flags & (EVENTIO_READ)) {
     _ne->read.triggered = 1;
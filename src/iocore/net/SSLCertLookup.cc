@@ -32,6 +32,7 @@
 #include "tsutil/Convert.h"
 
 #include "P_SSLUtils.h"
+#include "SSLLazyContext.h"
 
 #include <unordered_map>
 #include <utility>
@@ -237,6 +238,7 @@ SSLCertContext::SSLCertContext(SSLCertContext const &other)
   userconfig = other.userconfig;
   keyblock   = other.keyblock;
   ctx_type   = other.ctx_type;
+  lazy       = other.lazy;
   std::lock_guard<std::mutex> lock(other.ctx_mutex);
   ctx = other.ctx;
 }
@@ -249,6 +251,7 @@ SSLCertContext::operator=(SSLCertContext const &other)
     this->userconfig = other.userconfig;
     this->keyblock   = other.keyblock;
     this->ctx_type   = other.ctx_type;
+    this->lazy       = other.lazy;
     std::lock_guard<std::mutex> lock(other.ctx_mutex);
     this->ctx = other.ctx;
   }
@@ -258,6 +261,9 @@ SSLCertContext::operator=(SSLCertContext const &other)
 shared_SSL_CTX
 SSLCertContext::getCtx()
 {
+  if (lazy) {
+    return lazy->get(ctx_type);
+  }
   std::lock_guard<std::mutex> lock(ctx_mutex);
   return ctx;
 }
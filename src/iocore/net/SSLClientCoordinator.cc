@@ -60,6 +60,9 @@ SSLClientCoordinator::startup()
   sslClientUpdate->attach("proxy.config.ssl.servername.filename");
   SNIConfig::startup();
   sslClientUpdate->attach("proxy.config.ssl.server.multicert.filename");
+  sslClientUpdate->attach("proxy.config.ssl.server.multicert.lazy_load");
+  sslClientUpdate->attach("proxy.config.ssl.server.multicert.lazy_load_max_resident");
+  sslClientUpdate->attach("proxy.config.ssl.server.multicert.load_threads");
   sslClientUpdate->attach("proxy.config.ssl.server.cert.path");
   sslClientUpdate->attach("proxy.config.ssl.server.private_key.path");
   sslClientUpdate->attach("proxy.config.ssl.server.cert_chain.filename");
@@ -34,7 +34,9 @@
 #include "P_SSLConfig.h"
 #include "P_SSLUtils.h"
 #include "P_TLSKeyLogger.h"
+#include "SSLLazyContext.h"
 #include "SSLSessionCache.h"
+#include "SSLStats.h"
 #include "iocore/net/SSLMultiCertConfigLoader.h"
 #include "iocore/net/SSLDiags.h"
 #include "iocore/net/TLSEarlyDataSupport.h"
@@ -132,6 +134,8 @@ SSLConfigParams::reset()
   ssl_session_cache_timeout            = 0;
   ssl_session_cache_auto_clear         = 1;
   configExitOnLoadError                = 1;
+  configLazyLoad                       = 0;
+  configLoadThreads                    = 0;
   clientCertExitOnLoadError            = 0;
 }
 
@@ -431,6 +435,9 @@ SSLConfigParams::initialize()
 
   configFilePath = ats_stringdup(RecConfigReadConfigPath("proxy.config.ssl.server.multicert.filename"));
   REC_ReadConfigInteger(configExitOnLoadError, "proxy.config.ssl.server.multicert.exit_on_load_fail");
+  REC_ReadConfigInteger(configLazyLoad, "proxy.config.ssl.server.multicert.lazy_load");
+  REC_ReadConfigInteger(SSLLazyContext::max_resident, "proxy.config.ssl.server.multicert.lazy_load_max_resident");
+  REC_ReadConfigInteger(configLoadThreads, "proxy.config.ssl.server.multicert.load_threads");
 
   REC_ReadConfigStringAlloc(ssl_server_private_key_path, "proxy.config.ssl.server.private_key.path");
   set_paths_helper(ssl_server_private_key_path, nullptr, &serverKeyPathOnly, nullptr);
@@ -650,9 +657,10 @@ SSLCertificateConfig::startup()
 bool
 SSLCertificateConfig::reconfigure()
 {
-  bool                     retStatus = true;
-  SSLConfig::scoped_config params;
-  SSLCertLookup           *lookup = new SSLCertLookup();
+  bool                                retStatus = true;
+  SSLConfig::scoped_config            params;
+  SSLCertificateConfig::scoped_config previous;
+  SSLCertLookup                      *lookup = new SSLCertLookup();
 
   // Test SSL certificate loading startup. With large numbers of certificates, reloading can take time, so delay
   // twice the healthcheck period to simulate a loading a large certificate set.
@@ -662,7 +670,12 @@ SSLCertificateConfig::reconfigure()
     ink_hrtime_sleep(HRTIME_SECONDS(secs));
   }
 
-  auto errata = SSLMultiCertConfigLoader(params).load(lookup);
+  ink_hrtime start  = ink_get_hrtime();
+  auto       errata = SSLMultiCertConfigLoader(params).load(lookup, previous);
+  // On the "first run" the metrics have not been initialized, so this has to check it.
+  if (ssl_rsb.multicert_last_load_time) {
+    Metrics::Gauge::store(ssl_rsb.multicert_last_load_time, ink_hrtime_to_msec(ink_get_hrtime() - start));
+  }
   if (!lookup->is_valid || (errata.has_severity() && errata.severity() >= ERRATA_ERROR)) {
     retStatus = false;
   }
@@ -0,0 +1,225 @@
+/** @file
+
+  SSL_CTX of ssl_multicert.config built on the first handshake that needs them
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "SSLLazyContext.h"
+#include "P_SSLCertLookup.h"
+#include "P_SSLConfig.h"
+#include "P_SSLUtils.h"
+#include "SSLStats.h"
+
+#include <algorithm>
+
+namespace
+{
+DbgCtl dbg_ctl_ssl_load{"ssl_load"};
+
+} // end anonymous namespace
+
+int                          SSLLazyContext::max_resident = 0;
+std::mutex                   SSLLazyContext::_resident_mutex;
+SSLLazyContext::ResidentList SSLLazyContext::_resident_list;
+int                          SSLLazyContext::_resident_count = 0;
+
+/// Builds the contexts on a task thread.
+class SSLLazyContext::Loader : public Continuation
+{
+public:
+  explicit Loader(std::shared_ptr<SSLLazyContext> lazy) : Continuation(nullptr), _lazy(std::move(lazy))
+  {
+    SET_HANDLER(&Loader::event_handler);
+  }
+
+  int
+  event_handler(int /* event ATS_UNUSED */, void * /* edata ATS_UNUSED */)
+  {
+    _lazy->_load();
+    delete this;
+    return EVENT_DONE;
+  }
+
+private:
+  std::shared_ptr<SSLLazyContext> _lazy;
+};
+
+SSLLazyContext::SSLLazyContext(SSLMultiCertConfigLoader::CertLoadData data, shared_SSLMultiCertConfigParams userconfig)
+  : _data(std::move(data)), _userconfig(std::move(userconfig))
+{
+}
+
+SSLLazyContext::~SSLLazyContext()
+{
+  std::lock_guard<std::mutex> lock(_resident_mutex);
+  if (_resident) {
+    _resident_list.remove(this);
+    --_resident_count;
+    Metrics::Gauge::decrement(ssl_rsb.lazy_ctx_resident);
+  }
+}
+
+shared_SSL_CTX
+SSLLazyContext::get(SSLCertContextType ctx_type)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  if (_state != State::LOADED || _contexts.empty()) {
+    return nullptr;
+  }
+  _referenced.store(true, std::memory_order_relaxed);
+  for (auto const &resident : _contexts) {
+    if (resident.ctx_type == ctx_type) {
+      return resident.ctx;
+    }
+  }
+  return _contexts.front().ctx;
+}
+
+bool
+SSLLazyContext::wait(Continuation *c, EThread *t)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  switch (_state) {
+  case State::FAILED:
+    return false;
+  case State::LOADED:
+    // Built since the caller looked.
+    t->schedule_imm(c);
+    return true;
+  case State::UNLOADED:
+    _state = State::LOADING;
+    eventProcessor.schedule_imm(new Loader(shared_from_this()), ET_TASK);
+    [[fallthrough]];
+  case State::LOADING:
+    _waiters.push_back({c, t});
+    Metrics::Counter::increment(ssl_rsb.lazy_ctx_waits);
+    return true;
+  }
+  return false;
+}
+
+bool
+SSLLazyContext::cancel(Continuation *c)
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  auto spot = std::find_if(_waiters.begin(), _waiters.end(), [c](Waiter const &w) { return w.c == c; });
+  if (spot == _waiters.end()) {
+    return false;
+  }
+  _waiters.erase(spot);
+  return true;
+}
+
+void
+SSLLazyContext::unload()
+{
+  {
+    std::lock_guard<std::mutex> lock(_resident_mutex);
+    if (_resident) {
+      _resident_list.remove(this);
+      _resident = false;
+      --_resident_count;
+      Metrics::Gauge::decrement(ssl_rsb.lazy_ctx_resident);
+    }
+  }
+  this->_evict();
+}
+
+void
+SSLLazyContext::_load()
+{
+  SSLConfig::scoped_config params;
+  std::vector<Resident>    contexts;
+  ink_hrtime               start = ink_get_hrtime();
+
+  for (auto const &loadingctx : SSLMultiCertConfigLoader(params).init_lazy_ssl_ctx(_data, _userconfig.get())) {
+    contexts.push_back({shared_SSL_CTX{loadingctx.ctx, SSL_CTX_free}, loadingctx.ctx_type});
+  }
+  Metrics::Counter::increment(ssl_rsb.lazy_ctx_load_time, ink_hrtime_to_usec(ink_get_hrtime() - start));
+  Dbg(dbg_ctl_ssl_load, "built %zu contexts for %s in %" PRId64 " us", contexts.size(), _userconfig->cert.get(),
+      ink_hrtime_to_usec(ink_get_hrtime() - start));
+
+  this->_loaded(std::move(contexts));
+}
+
+void
+SSLLazyContext::_loaded(std::vector<Resident> &&contexts)
+{
+  std::vector<Waiter> waiters;
+  bool const          ok = !contexts.empty();
+
+  {
+    std::lock_guard<std::mutex> lock(_mutex);
+    _contexts = std::move(contexts);
+    _state    = ok ? State::LOADED : State::FAILED;
+    waiters.swap(_waiters);
+  }
+  // The handshakes look again, and find the contexts or go on without them.
+  for (auto const &w : waiters) {
+    w.t->schedule_imm(w.c);
+  }
+
+  if (!ok) {
+    Metrics::Counter::increment(ssl_rsb.lazy_ctx_load_failed);
+    Error("(ssl_load) failed to build the SSL_CTX for %s, its names use the default certificate until the next reload",
+          _userconfig->cert.get());
+    return;
+  }
+  Metrics::Counter::increment(ssl_rsb.lazy_ctx_loaded);
+
+  std::lock_guard<std::mutex> lock(_resident_mutex);
+  if (!_resident) {
+    _referenced.store(true, std::memory_order_relaxed);
+    _resident_list.enqueue(this);
+    _resident = true;
+    ++_resident_count;
+    Metrics::Gauge::increment(ssl_rsb.lazy_ctx_resident);
+  }
+  // Second chance, a context used since the last pass goes to the back of the list. This one is kept, its waiters are
+  // about to use it.
+  while (max_resident > 0 && _resident_count > max_resident) {
+    SSLLazyContext *victim = _resident_list.dequeue();
+    if (victim == this || victim->_referenced.exchange(false, std::memory_order_relaxed)) {
+      _resident_list.enqueue(victim);
+      continue;
+    }
+    victim->_resident = false;
+    --_resident_count;
+    Metrics::Gauge::decrement(ssl_rsb.lazy_ctx_resident);
+    Metrics::Counter::increment(ssl_rsb.lazy_ctx_evicted);
+    victim->_evict();
+  }
+}
+
+void
+SSLLazyContext::_evict()
+{
+  std::lock_guard<std::mutex> lock(_mutex);
+
+  // The handshakes that use the contexts hold references, they are freed when the last one is done.
+  if (_state == State::LOADED) {
+    Dbg(dbg_ctl_ssl_load, "dropping the contexts for %s", _userconfig->cert.get());
+    _contexts.clear();
+    _state = State::UNLOADED;
+  }
+}
@@ -0,0 +1,121 @@
+/** @file
+
+  SSL_CTX of ssl_multicert.config built on the first handshake that needs them
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#pragma once
+
+#include "iocore/eventsystem/EventSystem.h"
+#include "iocore/net/SSLMultiCertConfigLoader.h"
+#include "iocore/net/SSLTypes.h"
+#include "tscore/List.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/** The SSL_CTX of a line of ssl_multicert.config, built when a handshake first asks for one of its names.
+
+    With proxy.config.ssl.server.multicert.lazy_load the certificates are read at load time for their names only, and
+    the SSLCertContext of those names share one of these instead of a SSL_CTX. The SSL_CTX are built on a task thread,
+    the handshakes that want them wait in the certificate callback meanwhile.
+
+    The number of resident SSL_CTX is bounded by proxy.config.ssl.server.multicert.lazy_load_max_resident, the ones not
+    used for the longest time are dropped, with the second chance approximation of LRU so that a handshake only sets a
+    flag. A dropped SSL_CTX is built again on the next handshake that needs it.
+ */
+class SSLLazyContext : public std::enable_shared_from_this<SSLLazyContext>
+{
+public:
+  /// The maximum number of resident contexts, 0 for no limit.
+  static int max_resident;
+
+  SSLLazyContext(SSLMultiCertConfigLoader::CertLoadData data, shared_SSLMultiCertConfigParams userconfig);
+  ~SSLLazyContext();
+
+  SSLLazyContext(const SSLLazyContext &)            = delete;
+  SSLLazyContext &operator=(const SSLLazyContext &) = delete;
+
+  /** The context for @a ctx_type.
+      @return @c nullptr if it is not resident.
+   */
+  shared_SSL_CTX get(SSLCertContextType ctx_type);
+
+  /** Wait for the contexts, starting to build them if that is not under way.
+      @a c is scheduled on @a t once the build is done, or right away if the contexts are resident already.
+      @return @c false if the contexts failed to build, there is nothing to wait for.
+   */
+  bool wait(Continuation *c, EThread *t);
+
+  /** Stop waiting.
+      @return @c false if @a c was scheduled already.
+   */
+  bool cancel(Continuation *c);
+
+  /// Drop the contexts, they are built again when needed. For a change of the certificate files.
+  void unload();
+
+private:
+  friend struct SSLLazyContextTest;
+
+  enum class State {
+    UNLOADED, ///< Not built, or dropped.
+    LOADING,  ///< Being built on a task thread.
+    LOADED,   ///< Resident.
+    FAILED,   ///< Failed to build, it is not tried again until the configuration is reloaded.
+  };
+
+  struct Resident {
+    shared_SSL_CTX     ctx;
+    SSLCertContextType ctx_type;
+  };
+
+  struct Waiter {
+    Continuation *c;
+    EThread      *t;
+  };
+
+  class Loader;
+
+  void _load();
+  void _loaded(std::vector<Resident> &&contexts);
+  void _evict();
+
+  SSLMultiCertConfigLoader::CertLoadData _data;
+  shared_SSLMultiCertConfigParams        _userconfig;
+
+  std::mutex            _mutex; ///< For everything below, but the links and the reference flag.
+  State                 _state = State::UNLOADED;
+  std::vector<Resident> _contexts;
+  std::vector<Waiter>   _waiters;
+
+  std::atomic<bool> _referenced{false}; ///< Used since the eviction scan last passed it.
+  bool              _resident = false;  ///< In the resident list, guarded by its lock.
+  LINK(SSLLazyContext, _link);
+
+  using ResidentList = Que(SSLLazyContext, _link);
+
+  /// The resident contexts, the next one to look at for eviction at the head.
+  static std::mutex   _resident_mutex;
+  static ResidentList _resident_list;
+  static int          _resident_count;
+};
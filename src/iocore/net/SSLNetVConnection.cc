@@ -31,6 +31,7 @@
 #include "P_SSLClientUtils.h"
 #include "P_SSLNetVConnection.h"
 #include "P_UnixNetProcessor.h"
+#include "SSLLazyContext.h"
 #include "iocore/net/NetHandler.h"
 #include "iocore/net/NetVConnection.h"
 #include "iocore/net/ProxyProtocol.h"
@@ -882,6 +883,38 @@ SSLNetVConnection::do_io_close(int lerrno)
   super::do_io_close(lerrno);
 }
 
+/// Goes on with the handshake once the context it waits for is built.
+class SSLNetVConnection::LazyContextWait : public Continuation
+{
+public:
+  explicit LazyContextWait(SSLNetVConnection *vc) : Continuation(vc->nh->mutex), _vc(vc)
+  {
+    SET_HANDLER(&LazyContextWait::event_handler);
+  }
+
+  /// The connection is closed, there is nothing to go on with.
+  void
+  detach()
+  {
+    _vc = nullptr;
+  }
+
+  int
+  event_handler(int /* event ATS_UNUSED */, void * /* edata ATS_UNUSED */)
+  {
+    if (_vc) {
+      _vc->_lazy_ctx.reset();
+      _vc->_lazy_ctx_wait = nullptr;
+      _vc->readReschedule(_vc->nh);
+    }
+    delete this;
+    return EVENT_DONE;
+  }
+
+private:
+  SSLNetVConnection *_vc;
+};
+
 void
 SSLNetVConnection::clear()
 {
@@ -899,6 +932,16 @@ SSLNetVConnection::clear()
   // resetting here will decrement the ref-counter.
   client_sess.reset();
 
+  if (_lazy_ctx_wait != nullptr) {
+    if (_lazy_ctx->cancel(_lazy_ctx_wait)) {
+      delete _lazy_ctx_wait;
+    } else {
+      _lazy_ctx_wait->detach();
+    }
+    _lazy_ctx_wait = nullptr;
+  }
+  _lazy_ctx.reset();
+
   if (ssl != nullptr) {
     SSL_free(ssl);
     ssl = nullptr;
@@ -1796,6 +1839,16 @@ SSLNetVConnection::_lookupContextByName(const std::string &servername, SSLCertCo
 
   if (cc) {
     ctx = cc->getCtx();
+    if (ctx == nullptr && cc->lazy && _lazy_ctx_wait == nullptr) {
+      _lazy_ctx_wait = new LazyContextWait(this);
+      if (cc->lazy->wait(_lazy_ctx_wait, this->thread)) {
+        _lazy_ctx = cc->lazy;
+      } else {
+        // It failed to build, the handshake goes on without it.
+        delete _lazy_ctx_wait;
+        _lazy_ctx_wait = nullptr;
+      }
+    }
   }
 
   if (cc && ctx && SSLCertContextOption::OPT_TUNNEL == cc->opt && this->get_is_transparent()) {
@@ -1807,6 +1860,12 @@ SSLNetVConnection::_lookupContextByName(const std::string &servername, SSLCertCo
   }
 }
 
+bool
+SSLNetVConnection::_isWaitingForContext() const
+{
+  return _lazy_ctx_wait != nullptr;
+}
+
 shared_SSL_CTX
 SSLNetVConnection::_lookupContextByIP()
 {
@@ -164,6 +164,15 @@ SSLInitializeStatistics()
   ssl_rsb.error_async                        = Metrics::Counter::createPtr("proxy.process.ssl.ssl_error_async");
   ssl_rsb.error_ssl                          = Metrics::Counter::createPtr("proxy.process.ssl.ssl_error_ssl");
   ssl_rsb.error_syscall                      = Metrics::Counter::createPtr("proxy.process.ssl.ssl_error_syscall");
+  ssl_rsb.lazy_ctx_evicted                   = Metrics::Counter::createPtr("proxy.process.ssl.lazy_ctx_evicted");
+  ssl_rsb.lazy_ctx_load_failed               = Metrics::Counter::createPtr("proxy.process.ssl.lazy_ctx_load_failed");
+  ssl_rsb.lazy_ctx_load_time                 = Metrics::Counter::createPtr("proxy.process.ssl.lazy_ctx_load_time");
+  ssl_rsb.lazy_ctx_loaded                    = Metrics::Counter::createPtr("proxy.process.ssl.lazy_ctx_loaded");
+  ssl_rsb.lazy_ctx_resident                  = Metrics::Gauge::createPtr("proxy.process.ssl.lazy_ctx_resident");
+  ssl_rsb.lazy_ctx_waits                     = Metrics::Counter::createPtr("proxy.process.ssl.lazy_ctx_waits");
+  ssl_rsb.multicert_ctx_built                = Metrics::Counter::createPtr("proxy.process.ssl.multicert_ctx_built");
+  ssl_rsb.multicert_ctx_reused               = Metrics::Counter::createPtr("proxy.process.ssl.multicert_ctx_reused");
+  ssl_rsb.multicert_last_load_time           = Metrics::Gauge::createPtr("proxy.process.ssl.multicert_last_load_time");
   ssl_rsb.ocsp_refresh_cert_failure          = Metrics::Counter::createPtr("proxy.process.ssl.ssl_ocsp_refresh_cert_failure");
   ssl_rsb.ocsp_refreshed_cert                = Metrics::Counter::createPtr("proxy.process.ssl.ssl_ocsp_refreshed_cert");
   ssl_rsb.ocsp_revoked_cert                  = Metrics::Counter::createPtr("proxy.process.ssl.ssl_ocsp_revoked_cert");
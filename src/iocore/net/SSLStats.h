@@ -40,6 +40,15 @@ struct SSLStatsBlock {
   Metrics::Counter::AtomicType *error_async                                    = nullptr;
   Metrics::Counter::AtomicType *error_ssl                                      = nullptr;
   Metrics::Counter::AtomicType *error_syscall                                  = nullptr;
+  Metrics::Counter::AtomicType *lazy_ctx_evicted                               = nullptr;
+  Metrics::Counter::AtomicType *lazy_ctx_load_failed                           = nullptr;
+  Metrics::Counter::AtomicType *lazy_ctx_load_time                             = nullptr;
+  Metrics::Counter::AtomicType *lazy_ctx_loaded                                = nullptr;
+  Metrics::Gauge::AtomicType   *lazy_ctx_resident                              = nullptr;
+  Metrics::Counter::AtomicType *lazy_ctx_waits                                 = nullptr;
+  Metrics::Counter::AtomicType *multicert_ctx_built                            = nullptr;
+  Metrics::Counter::AtomicType *multicert_ctx_reused                           = nullptr;
+  Metrics::Gauge::AtomicType   *multicert_last_load_time                       = nullptr;
   Metrics::Counter::AtomicType *ocsp_refresh_cert_failure                      = nullptr;
   Metrics::Counter::AtomicType *ocsp_refreshed_cert                            = nullptr;
   Metrics::Counter::AtomicType *ocsp_revoked_cert                              = nullptr;
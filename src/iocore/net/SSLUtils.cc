@@ -26,10 +26,12 @@
 #include "P_SSLConfig.h"
 #include "P_SSLNetVConnection.h"
 #include "P_TLSKeyLogger.h"
+#include "SSLLazyContext.h"
 #include "SSLStats.h"
 #include "SSLSessionCache.h"
 #include "SSLSessionTicket.h"
 #include "SSLDynlock.h" // IWYU pragma: keep - for ssl_dyn_*
+#include "../../records/P_RecDefs.h"
 
 #include "iocore/net/SSLMultiCertConfigLoader.h"
 #include "iocore/net/SSLAPIHooks.h"
@@ -66,7 +68,12 @@
 #endif
 
 #include <utility>
+#include <algorithm>
+#include <atomic>
+#include <mutex>
 #include <string>
+#include <sys/stat.h>
+#include <thread>
 #include <unistd.h>
 #include <termios.h>
 #include <vector>
@@ -586,6 +593,26 @@ ssl_context_enable_dhe(const char *dhparams_file, SSL_CTX *ctx)
   return ctx;
 }
 
+#if TS_HAS_TLS_SESSION_TICKET
+static bool
+ssl_context_set_ticket_callback(SSL_CTX *ctx)
+{
+// Setting the callback can only fail if OpenSSL does not recognize the
+// SSL_CTRL_SET_TLSEXT_TICKET_KEY_CB constant.
+#ifdef HAVE_SSL_CTX_SET_TLSEXT_TICKET_KEY_EVP_CB
+  if (SSL_CTX_set_tlsext_ticket_key_evp_cb(ctx, ssl_callback_session_ticket) == 0) {
+#else
+  if (SSL_CTX_set_tlsext_ticket_key_cb(ctx, ssl_callback_session_ticket) == 0) {
+#endif
+    Error("failed to set session ticket callback");
+    return false;
+  }
+
+  SSL_CTX_clear_options(ctx, SSL_OP_NO_TICKET);
+  return true;
+}
+#endif /* TS_HAS_TLS_SESSION_TICKET */
+
 static ssl_ticket_key_block *
 ssl_context_enable_tickets(SSL_CTX *ctx, const char *ticket_key_path)
 {
@@ -599,20 +626,12 @@ ssl_context_enable_tickets(SSL_CTX *ctx, const char *ticket_key_path)
     Metrics::Counter::increment(ssl_rsb.total_ticket_keys_renewed);
   }
 
-// Setting the callback can only fail if OpenSSL does not recognize the
-// SSL_CTRL_SET_TLSEXT_TICKET_KEY_CB constant. we set the callback first
-// so that we don't leave a ticket_key pointer attached if it fails.
-#ifdef HAVE_SSL_CTX_SET_TLSEXT_TICKET_KEY_EVP_CB
-  if (SSL_CTX_set_tlsext_ticket_key_evp_cb(ctx, ssl_callback_session_ticket) == 0) {
-#else
-  if (SSL_CTX_set_tlsext_ticket_key_cb(ctx, ssl_callback_session_ticket) == 0) {
-#endif
-    Error("failed to set session ticket callback");
+  // The callback is set first so that we don't leave a ticket_key pointer attached if it fails.
+  if (!ssl_context_set_ticket_callback(ctx)) {
     ticket_block_free(keyblock);
     return nullptr;
   }
 
-  SSL_CTX_clear_options(ctx, SSL_OP_NO_TICKET);
   return keyblock;
 
 #else  /* !TS_HAS_TLS_SESSION_TICKET */
@@ -1193,6 +1212,20 @@ setClientCertCACerts(SSL *ssl, const char *file, const char *dir)
   }
 }
 
+/**
+   Pass a server context to the plugin callback, one at a time as the contexts are built on several threads.
+ */
+static void
+ssl_init_ctx_cb(SSL_CTX *ctx)
+{
+  static std::mutex mutex;
+
+  if (SSLConfigParams::init_ssl_ctx_cb) {
+    std::lock_guard<std::mutex> lock(mutex);
+    SSLConfigParams::init_ssl_ctx_cb(ctx, true);
+  }
+}
+
 /**
    Initialize SSL_CTX for server
    This is public function because of used by SSLCreateServerContext.
@@ -1350,9 +1383,7 @@ SSLMultiCertConfigLoader::init_server_ssl_ctx(CertLoadData const &data, const SS
     }
 #endif
 
-    if (SSLConfigParams::init_ssl_ctx_cb) {
-      SSLConfigParams::init_ssl_ctx_cb(ctx, true);
-    }
+    ssl_init_ctx_cb(ctx);
 
     ret.emplace_back(SSLLoadingContext(ctx, ctx_type));
     i++;
@@ -1671,69 +1702,377 @@ SSLMultiCertConfigLoader::_prep_ssl_ctx(const shared_SSLMultiCertConfigParams  &
 }
 
 /**
-   Insert SSLCertContext (SSL_CTX and options) into SSLCertLookup with key.
-   Do NOT call SSL_CTX_set_* functions from here. SSL_CTX should be set up by SSLMultiCertConfigLoader::init_server_ssl_ctx().
+   The types of the contexts that init_server_ssl_ctx() builds for @a data.
  */
+static std::vector<SSLCertContextType>
+ssl_ctx_types(SSLMultiCertConfigLoader::CertLoadData const &data)
+{
+  std::vector<SSLCertContextType> types;
+
+#ifndef HAVE_NATIVE_DUAL_CERT_SUPPORT
+  for (unsigned int i = 0; i < data.cert_names_list.size(); ++i) {
+    types.push_back(i < data.cert_type_list.size() ? data.cert_type_list[i] : SSLCertContextType::GENERIC);
+  }
+#else
+  if (!data.cert_names_list.empty()) {
+    types.push_back(data.cert_type_list.empty() ? SSLCertContextType::GENERIC : data.cert_type_list[0]);
+  }
+#endif
+  return types;
+}
+
 bool
-SSLMultiCertConfigLoader::_store_ssl_ctx(SSLCertLookup *lookup, const shared_SSLMultiCertConfigParams &sslMultCertSettings)
+SSLMultiCertConfigLoader::_lazy_load() const
 {
-  bool                                           retval = true;
+  return this->_params->configLazyLoad != 0;
+}
+
+/**
+   Build the contexts of a SSLLazyContext, on a task thread.
+   Nothing is kept if any of them fails, the names then fall back to the default context.
+ */
+std::vector<SSLLoadingContext>
+SSLMultiCertConfigLoader::init_lazy_ssl_ctx(CertLoadData const &data, const SSLMultiCertConfigParams *sslMultCertSettings)
+{
+  uint32_t elevate_setting = 0;
+  REC_ReadConfigInteger(elevate_setting, "proxy.config.ssl.cert.load_elevated");
+  ElevateAccess elevate_access(elevate_setting ? ElevateAccess::FILE_PRIVILEGE : 0);
+
+  std::vector<SSLLoadingContext> ctxs = this->init_server_ssl_ctx(data, sslMultCertSettings);
+
+  bool good = ctxs.size() == ssl_ctx_types(data).size();
+  for (auto const &loadingctx : ctxs) {
+    if (loadingctx.ctx == nullptr) {
+      good = false;
+    }
+  }
+  if (!good) {
+    for (auto const &loadingctx : ctxs) {
+      SSL_CTX_free(loadingctx.ctx);
+    }
+    return {};
+  }
+
+  for (auto const &loadingctx : ctxs) {
+#if TS_HAS_TLS_SESSION_TICKET
+    // The ticket keys are looked up by the local address, a line without one uses the default keys.
+    if (sslMultCertSettings->session_ticket_enabled != 0) {
+      ssl_context_set_ticket_callback(loadingctx.ctx);
+    }
+#endif
+  }
+  return ctxs;
+}
+
+namespace
+{
+/**
+   The SHA-256 of what the contexts of a certificate are built from.
+ */
+class SSLFingerprint
+{
+public:
+  SSLFingerprint() : _ctx(EVP_MD_CTX_new()) { EVP_DigestInit_ex(_ctx, EVP_sha256(), nullptr); }
+  ~SSLFingerprint() { EVP_MD_CTX_free(_ctx); }
+
+  SSLFingerprint(const SSLFingerprint &)            = delete;
+  SSLFingerprint &operator=(const SSLFingerprint &) = delete;
+
+  void
+  add(int64_t value)
+  {
+    EVP_DigestUpdate(_ctx, &value, sizeof(value));
+  }
+
+  void
+  add(std::string_view value)
+  {
+    this->add(static_cast<int64_t>(value.size()));
+    EVP_DigestUpdate(_ctx, value.data(), value.size());
+  }
+
+  void
+  add(const char *value)
+  {
+    this->add(std::string_view{value ? value : ""});
+  }
+
+  /// A file read by its path rather than through the secrets, it is known by its identity and modification time.
+  void
+  add_file(std::string const &path)
+  {
+    struct stat st;
+
+    this->add(path);
+    if (stat(path.c_str(), &st) == 0) {
+      this->add(static_cast<int64_t>(st.st_ino));
+      this->add(static_cast<int64_t>(st.st_size));
+      this->add(static_cast<int64_t>(st.st_mtime));
+    } else {
+      this->add(static_cast<int64_t>(-1));
+    }
+  }
+
+  std::string
+  digest()
+  {
+    unsigned char md[EVP_MAX_MD_SIZE];
+    unsigned int  len = 0;
+
+    EVP_DigestFinal_ex(_ctx, md, &len);
+    return {reinterpret_cast<char *>(md), len};
+  }
+
+private:
+  EVP_MD_CTX *_ctx;
+};
+} // end anonymous namespace
+
+/**
+   The fingerprint of the SSL records and of the files they name, all the server contexts are built from them.
+ */
+static std::string
+ssl_params_fingerprint(const SSLConfigParams *params)
+{
+  SSLFingerprint fp;
+
+  RecLookupMatchingRecords(
+    RECT_CONFIG, "^proxy\\.config\\.ssl\\.",
+    [](const RecRecord *r, void *data) {
+      auto *fp = static_cast<SSLFingerprint *>(data);
+
+      fp->add(r->name);
+      switch (r->data_type) {
+      case RECD_INT:
+        fp->add(static_cast<int64_t>(r->data.rec_int));
+        break;
+      case RECD_FLOAT:
+        fp->add(std::to_string(r->data.rec_float));
+        break;
+      case RECD_STRING:
+        fp->add(r->data.rec_string);
+        break;
+      default:
+        break;
+      }
+    },
+    &fp);
+
+  if (params->serverCertChainFilename) {
+    fp.add_file(Layout::relative_to(params->serverCertPathOnly, params->serverCertChainFilename));
+  }
+  if (params->serverCACertFilename) {
+    fp.add_file(params->serverCACertFilename);
+  }
+  if (params->dhparamsFile) {
+    fp.add_file(params->dhparamsFile);
+  }
+  return fp.digest();
+}
+
+/**
+   A line of ssl_multicert.config, built on a loading thread and then inserted in the order of the lines.
+ */
+struct SSLMultiCertConfigLoader::LoadedCert {
+  /// The contexts for a set of names, of all the certificates of the line for the common names, or of one for its own.
+  struct Group {
+    CertLoadData          data;
+    std::set<std::string> names;
+    std::string           fingerprint;
+    SSLCertContexts       contexts;
+    bool                  reused = false; ///< The contexts are those of the previous configuration.
+  };
+
+  unsigned                                       line_num = 0;
+  shared_SSLMultiCertConfigParams                settings;
+  bool                                           valid = false;
+  bool                                           lazy  = false;
+  CertLoadData                                   data;
   std::set<std::string>                          common_names;
   std::unordered_map<int, std::set<std::string>> unique_names;
-  SSLMultiCertConfigLoader::CertLoadData         data;
+  std::vector<Group>                             groups; ///< The common names first.
+};
 
-  if (!this->_prep_ssl_ctx(sslMultCertSettings, data, common_names, unique_names)) {
-    lookup->is_valid = false;
-    return false;
+/**
+   Read the certificates of a line and build its contexts, or take them from @a previous if they did not change.
+   This runs on several threads at once, it does not touch the lookup.
+ */
+void
+SSLMultiCertConfigLoader::_build_cert(LoadedCert &cert, const SSLCertLookup *previous)
+{
+  auto const &settings = cert.settings;
+
+  cert.valid = this->_prep_ssl_ctx(settings, cert.data, cert.common_names, cert.unique_names);
+  if (!cert.valid) {
+    return;
   }
 
-  std::vector<SSLLoadingContext> ctxs = this->init_server_ssl_ctx(data, sslMultCertSettings.get());
-  for (const auto &loadingctx : ctxs) {
-    if (!sslMultCertSettings ||
-        !this->_store_single_ssl_ctx(lookup, sslMultCertSettings, shared_SSL_CTX{loadingctx.ctx, SSL_CTX_free}, loadingctx.ctx_type,
-                                     common_names)) {
-      if (!common_names.empty()) {
-        std::string names;
-        for (auto const &name : data.cert_names_list) {
-          names.append(name);
-          names.append(" ");
-        }
-        Warning("(%s) Failed to insert SSL_CTX for certificate %s entries for names already made", this->_debug_tag(),
-                names.c_str());
-      } else {
-        Warning("(%s) Failed to insert SSL_CTX", this->_debug_tag());
+  // Only the lines matched by name can wait, the default context and the lines bound to an address are needed before the
+  // server name is known.
+  cert.lazy =
+    this->_lazy_load() && settings && !settings->addr && settings->opt == SSLCertContextOption::OPT_NONE && settings->cert;
+
+  auto &common = cert.groups.emplace_back();
+  common.data   = cert.data;
+  common.names  = cert.common_names;
+  for (auto const &[i, names] : cert.unique_names) {
+    CertLoadData single_data;
+    single_data.cert_names_list.push_back(cert.data.cert_names_list[i]);
+    if (static_cast<size_t>(i) < cert.data.key_list.size()) {
+      single_data.key_list.push_back(cert.data.key_list[i]);
+    }
+    single_data.ca_list.push_back(static_cast<size_t>(i) < cert.data.ca_list.size() ? cert.data.ca_list[i] : "");
+    single_data.ocsp_list.push_back(static_cast<size_t>(i) < cert.data.ocsp_list.size() ? cert.data.ocsp_list[i] : "");
+    auto &group = cert.groups.emplace_back();
+    group.data  = std::move(single_data);
+    group.names = names;
+  }
+
+  for (auto &group : cert.groups) {
+    if (cert.lazy && group.names.empty()) {
+      continue;
+    }
+
+    SSLFingerprint fp;
+    fp.add(this->_params_fingerprint);
+    fp.add(this->_debug_tag());
+    for (const char *value : {settings->addr.get(), settings->cert.get(), settings->ca.get(), settings->key.get(),
+                              settings->ocsp_response.get(), settings->dialog.get(), settings->servername.get()}) {
+      fp.add(value);
+    }
+    fp.add(static_cast<int64_t>(settings->opt));
+    fp.add(static_cast<int64_t>(settings->session_ticket_enabled));
+    fp.add(static_cast<int64_t>(settings->session_ticket_number));
+    for (size_t i = 0; i < group.data.cert_names_list.size(); ++i) {
+      std::string key_name = i < group.data.key_list.size() ? group.data.key_list[i] : "";
+      std::string cert_data;
+      std::string key_data;
+
+      this->_params->secrets.getOrLoadSecret(group.data.cert_names_list[i], key_name, cert_data, key_data);
+      fp.add(group.data.cert_names_list[i]);
+      fp.add(key_name);
+      fp.add(cert_data);
+      fp.add(key_data);
+    }
+    for (auto const &ca : group.data.ca_list) {
+      if (!ca.empty()) {
+        fp.add_file(Layout::relative_to(this->_params->serverCertPathOnly, ca));
       }
-    } else {
-      if (!common_names.empty()) {
-        lookup->register_cert_secrets(data.cert_names_list, common_names);
+    }
+    for (auto const &ocsp : group.data.ocsp_list) {
+      if (!ocsp.empty()) {
+        fp.add_file(Layout::relative_to(this->_params->ssl_ocsp_response_path_only, ocsp));
+      }
+    }
+    for (auto ctx_type : group.data.cert_type_list) {
+      fp.add(static_cast<int64_t>(ctx_type));
+    }
+    group.fingerprint = fp.digest();
+
+    if (previous) {
+      if (auto spot = previous->built.find(group.fingerprint); spot != previous->built.end()) {
+        group.contexts = spot->second;
+        group.reused   = true;
+        continue;
       }
     }
+    if (cert.lazy) {
+      group.contexts.lazy = std::make_shared<SSLLazyContext>(group.data, settings);
+      continue;
+    }
+    for (auto const &loadingctx : this->init_server_ssl_ctx(group.data, settings.get())) {
+      group.contexts.ctxs.emplace_back(shared_SSL_CTX{loadingctx.ctx, SSL_CTX_free}, loadingctx.ctx_type);
+    }
+  }
+  if (cert.lazy) {
+    Dbg(dbg_ctl_ssl_load, "%s is built on demand", settings->cert.get());
   }
+}
 
-  for (auto iter = unique_names.begin(); retval && iter != unique_names.end(); ++iter) {
-    size_t i = iter->first;
+/**
+   Insert the contexts of a line built by _build_cert(), the lines are inserted in their order.
+   Do NOT call SSL_CTX_set_* functions from here. SSL_CTX should be set up by SSLMultiCertConfigLoader::init_server_ssl_ctx().
+ */
+bool
+SSLMultiCertConfigLoader::_insert_cert(SSLCertLookup *lookup, LoadedCert &cert)
+{
+  auto const &settings = cert.settings;
+  bool        retval   = true;
 
-    SSLMultiCertConfigLoader::CertLoadData single_data;
-    single_data.cert_names_list.push_back(data.cert_names_list[i]);
-    if (i < data.key_list.size()) {
-      single_data.key_list.push_back(data.key_list[i]);
+  if (!cert.valid) {
+    lookup->is_valid = false;
+    return false;
+  }
+
+  for (auto group = cert.groups.begin(); retval && group != cert.groups.end(); ++group) {
+    bool const common   = group == cert.groups.begin();
+    bool       complete = true;
+
+    if (cert.lazy) {
+      if (group->names.empty()) {
+        continue;
+      }
+      for (auto ctx_type : ssl_ctx_types(group->data)) {
+        for (auto const &name : group->names) {
+          if (lookup->insert(name.c_str(), SSLCertContext(group->contexts.lazy, ctx_type, settings)) < 0) {
+            retval   = false;
+            complete = false;
+          }
+        }
+      }
+      lookup->register_cert_secrets(cert.data.cert_names_list, group->names);
+    } else {
+      // A line without certificates has the one default context.
+      size_t const expected = group->data.cert_names_list.empty() ? 1 : ssl_ctx_types(group->data).size();
+
+      complete = group->contexts.ctxs.size() == expected;
+      for (auto const &[ctx, ctx_type] : group->contexts.ctxs) {
+        if (!this->_store_single_ssl_ctx(lookup, settings, ctx, ctx_type, group->names, group->reused)) {
+          complete = false;
+          if (!common) {
+            retval = false;
+          } else if (!group->names.empty()) {
+            std::string names;
+            for (auto const &name : cert.data.cert_names_list) {
+              names.append(name);
+              names.append(" ");
+            }
+            Warning("(%s) Failed to insert SSL_CTX for certificate %s entries for names already made", this->_debug_tag(),
+                    names.c_str());
+          } else {
+            Warning("(%s) Failed to insert SSL_CTX", this->_debug_tag());
+          }
+        } else if (!group->names.empty()) {
+          lookup->register_cert_secrets(cert.data.cert_names_list, group->names);
+        }
+      }
     }
-    single_data.ca_list.push_back(i < data.ca_list.size() ? data.ca_list[i] : "");
-    single_data.ocsp_list.push_back(i < data.ocsp_list.size() ? data.ocsp_list[i] : "");
 
-    std::vector<SSLLoadingContext> ctxs = this->init_server_ssl_ctx(single_data, sslMultCertSettings.get());
-    for (const auto &loadingctx : ctxs) {
-      if (!this->_store_single_ssl_ctx(lookup, sslMultCertSettings, shared_SSL_CTX{loadingctx.ctx, SSL_CTX_free},
-                                       loadingctx.ctx_type, iter->second)) {
-        retval = false;
-      } else {
-        lookup->register_cert_secrets(data.cert_names_list, iter->second);
+    // Only the contexts that are all in use are kept for the next reload, a failed one is tried again.
+    if (complete) {
+      lookup->built[group->fingerprint] = group->contexts;
+      // On the "first run" the metrics have not been initialized, so this has to check it.
+      if (ssl_rsb.multicert_ctx_built) {
+        Metrics::Counter::increment(group->reused ? ssl_rsb.multicert_ctx_reused : ssl_rsb.multicert_ctx_built);
       }
     }
   }
   return retval;
 }
 
+/**
+   Insert SSLCertContext (SSL_CTX and options) into SSLCertLookup with key.
+ */
+bool
+SSLMultiCertConfigLoader::_store_ssl_ctx(SSLCertLookup *lookup, const shared_SSLMultiCertConfigParams &sslMultCertSettings)
+{
+  LoadedCert cert;
+
+  cert.settings = sslMultCertSettings;
+  this->_build_cert(cert, nullptr);
+  return this->_insert_cert(lookup, cert);
+}
+
 /**
  * Much like _store_ssl_ctx, but this updates the existing lookup entries rather than creating them
  * If it fails to create the new SSL_CTX, don't invalidate the lookup structure, just keep working with the
@@ -1764,6 +2103,30 @@ SSLMultiCertConfigLoader::update_ssl_ctx(const std::string &secret_name)
       break;
     }
 
+    // The contexts built on demand are dropped, the next handshake builds them from the new files.
+    bool lazy = false;
+    for (auto const &name : common_names) {
+      for (auto ctx_type : ssl_ctx_types(data)) {
+        SSLCertContext *cc = lookup->find(name, ctx_type);
+        if (cc && cc->userconfig.get() == policy_iter->get() && cc->lazy) {
+          cc->lazy->unload();
+          lazy = true;
+        }
+      }
+    }
+    for (auto const &[i, names] : unique_names) {
+      for (auto const &name : names) {
+        SSLCertContext *cc = lookup->find(name, SSLCertContextType::GENERIC);
+        if (cc && cc->userconfig.get() == policy_iter->get() && cc->lazy) {
+          cc->lazy->unload();
+          lazy = true;
+        }
+      }
+    }
+    if (lazy) {
+      continue;
+    }
+
     std::vector<SSLLoadingContext> ctxs = this->init_server_ssl_ctx(data, policy_iter->get());
     for (const auto &loadingctx : ctxs) {
       shared_SSL_CTX ctx(loadingctx.ctx, SSL_CTX_free);
@@ -1811,13 +2174,16 @@ SSLMultiCertConfigLoader::update_ssl_ctx(const std::string &secret_name)
 
 bool
 SSLMultiCertConfigLoader::_store_single_ssl_ctx(SSLCertLookup *lookup, const shared_SSLMultiCertConfigParams &sslMultCertSettings,
-                                                shared_SSL_CTX ctx, SSLCertContextType ctx_type, std::set<std::string> &names)
+                                                shared_SSL_CTX ctx, SSLCertContextType ctx_type, std::set<std::string> &names,
+                                                bool reused)
 {
   bool                        inserted = false;
   shared_ssl_ticket_key_block keyblock = nullptr;
-  // Load the session ticket key if session tickets are not disabled
+  // Load the session ticket key if session tickets are not disabled. A reused context has the callback already, and it may
+  // be in use by handshakes.
   if (sslMultCertSettings->session_ticket_enabled != 0) {
-    keyblock = shared_ssl_ticket_key_block(ssl_context_enable_tickets(ctx.get(), nullptr), ticket_block_free);
+    ssl_ticket_key_block *block = reused ? ssl_create_ticket_keyblock(nullptr) : ssl_context_enable_tickets(ctx.get(), nullptr);
+    keyblock                    = shared_ssl_ticket_key_block(block, ticket_block_free);
   }
 
   // Index this certificate by the specified IP(v6) address. If the address is "*", make it the default context.
@@ -1827,7 +2193,9 @@ SSLMultiCertConfigLoader::_store_single_ssl_ctx(SSLCertLookup *lookup, const sha
       if (lookup->insert(sslMultCertSettings->addr, SSLCertContext(ctx, ctx_type, sslMultCertSettings, keyblock)) >= 0) {
         inserted            = true;
         lookup->ssl_default = ctx;
-        this->_set_handshake_callbacks(ctx.get());
+        if (!reused) {
+          this->_set_handshake_callbacks(ctx.get());
+        }
       }
     } else {
       IpEndpoint ep;
@@ -1852,10 +2220,8 @@ SSLMultiCertConfigLoader::_store_single_ssl_ctx(SSLCertLookup *lookup, const sha
     }
   }
 
-  if (inserted) {
-    if (SSLConfigParams::init_ssl_ctx_cb) {
-      SSLConfigParams::init_ssl_ctx_cb(ctx.get(), true);
-    }
+  if (inserted && !reused) {
+    ssl_init_ctx_cb(ctx.get());
   }
 
   if (!inserted) {
@@ -1938,7 +2304,7 @@ ssl_extract_certificate(const matcher_line *line_info, SSLMultiCertConfigParams
 }
 
 swoc::Errata
-SSLMultiCertConfigLoader::load(SSLCertLookup *lookup)
+SSLMultiCertConfigLoader::load(SSLCertLookup *lookup, const SSLCertLookup *previous)
 {
   const SSLConfigParams *params = this->_params;
 
@@ -1970,6 +2336,9 @@ SSLMultiCertConfigLoader::load(SSLCertLookup *lookup)
   REC_ReadConfigInteger(elevate_setting, "proxy.config.ssl.cert.load_elevated");
   ElevateAccess elevate_access(elevate_setting ? ElevateAccess::FILE_PRIVILEGE : 0);
 
+  this->_params_fingerprint = ssl_params_fingerprint(params);
+
+  std::vector<LoadedCert> certs;
   line = tokLine(content.data(), &tok_state);
   swoc::Errata errata(ERRATA_NOTE);
   while (line != nullptr) {
@@ -1992,9 +2361,9 @@ SSLMultiCertConfigLoader::load(SSLCertLookup *lookup)
         if (ssl_extract_certificate(&line_info, sslMultiCertSettings.get())) {
           // There must be a certificate specified unless the tunnel action is set
           if (sslMultiCertSettings->cert || sslMultiCertSettings->opt != SSLCertContextOption::OPT_TUNNEL) {
-            if (!this->_store_ssl_ctx(lookup, sslMultiCertSettings)) {
-              errata.note(ERRATA_ERROR, "Failed to load certificate on line {}", line_num);
-            }
+            LoadedCert &cert = certs.emplace_back();
+            cert.line_num    = line_num;
+            cert.settings    = std::move(sslMultiCertSettings);
           } else {
             errata.note(ERRATA_WARN, "No ssl_cert_name specified and no tunnel action set on line {}", line_num);
           }
@@ -2005,6 +2374,49 @@ SSLMultiCertConfigLoader::load(SSLCertLookup *lookup)
     line = tokLine(nullptr, &tok_state);
   }
 
+  // The certificates are read and their contexts built on threads of their own rather than task threads, as a reload runs
+  // on a task thread, and the certificate secret hooks need an EThread. A pass phrase dialog may prompt on the terminal,
+  // those lines are built one at a time on this thread.
+  size_t nthreads = params->configLoadThreads > 0 ? params->configLoadThreads : std::thread::hardware_concurrency();
+  nthreads        = std::min(nthreads, certs.size());
+  if (nthreads > 1) {
+    std::atomic<size_t>    next{0};
+    std::vector<EThread *> threads;
+
+    for (size_t n = 0; n < nthreads; ++n) {
+      char name[MAX_THREAD_NAME_LENGTH];
+      snprintf(name, sizeof(name), "[SSL_LOAD %zu]", n);
+
+      EThread *t = new EThread();
+      t->start(name, nullptr, 0, [&]() {
+        // A change of user id is for the whole process and this thread has it already, capabilities are per thread.
+        ElevateAccess elevate_access(TS_USE_POSIX_CAP && elevate_setting ? ElevateAccess::FILE_PRIVILEGE : 0);
+
+        for (size_t i = next++; i < certs.size(); i = next++) {
+          if (!certs[i].settings->dialog) {
+            this->_build_cert(certs[i], previous);
+          }
+        }
+      });
+      threads.push_back(t);
+    }
+    for (auto *t : threads) {
+      ink_thread_join(t->tid);
+      delete t;
+    }
+  }
+  for (auto &cert : certs) {
+    if (nthreads <= 1 || cert.settings->dialog) {
+      this->_build_cert(cert, previous);
+    }
+  }
+
+  for (auto &cert : certs) {
+    if (!this->_insert_cert(lookup, cert)) {
+      errata.note(ERRATA_ERROR, "Failed to load certificate on line {}", cert.line_num);
+    }
+  }
+
   // We *must* have a default context even if it can't possibly work. The default context is used to
   // bootstrap the SSL handshake so that we can subsequently do the SNI lookup to switch to the real
   // context.
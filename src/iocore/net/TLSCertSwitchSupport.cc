@@ -85,6 +85,14 @@ TLSCertSwitchSupport::selectCertificate(SSL *ssl, SSLCertContextType ctxType)
   // already made a best effort to find the best match.
   if (likely(servername)) {
     ctx = this->_lookupContextByName(servername, ctxType);
+    if (ctx == nullptr && this->_isWaitingForContext()) {
+      Dbg(dbg_ctl_ssl_load, "set_context_cert waiting for the SSL context for '%s'", servername);
+#ifdef OPENSSL_IS_BORINGSSL
+      return -2; // Retry
+#else
+      return -1; // Pause
+#endif
+    }
   }
 
   // If there's no match on the server name, try to match on the peer address.
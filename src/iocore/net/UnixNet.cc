@@ -24,6 +24,7 @@
 #include "P_UnixNetProcessor.h"
 #include "P_Net.h"
 #include "P_UnixNet.h"
+#include "P_ZeroCopyWrites.h"
 #include "iocore/net/AsyncSignalEventIO.h"
 #include "tscore/ink_hrtime.h"
 
@@ -72,7 +73,7 @@ get_PollDescriptor(EThread *t)
 
 // INKqa10496
 // One Inactivity cop runs on each thread once every second and
-// loops through the list of NetEvents and calls the timeouts
+// calls the timeouts of the NetEvents that are due in the timeout wheel
 class InactivityCop : public Continuation
 {
 public:
@@ -81,17 +82,22 @@ public:
   check_inactivity(int event, Event *e)
   {
     (void)event;
-    ink_hrtime  now = ink_get_hrtime();
-    NetHandler &nh  = *get_NetHandler(this_ethread());
+    ink_hrtime  now     = ink_get_hrtime();
+    NetHandler &nh      = *get_NetHandler(this_ethread());
+    int64_t     checked = 0;
 
     Dbg(dbg_ctl_inactivity_cop_check, "Checking inactivity on Thread-ID #%d", this_ethread()->id);
-    // The rest NetEvents in cop_list which are not triggered between InactivityCop runs.
-    // Use pop() to catch any closes caused by callbacks.
-    while (NetEvent *ne = nh.cop_list.pop()) {
+    nh.process_timeout_updates();
+    nh.timeout_wheel.advance(now);
+    // The NetEvents whose timeouts may have expired, the others are not looked at.
+    // Use pop_due() to catch any closes caused by callbacks.
+    while (NetEvent *ne = nh.timeout_wheel.pop_due()) {
+      ++checked;
       // If we cannot get the lock don't stop just keep cleaning
       MUTEX_TRY_LOCK(lock, ne->get_mutex(), this_ethread());
       if (!lock.is_locked()) {
         Metrics::Counter::increment(net_rsb.inactivity_cop_lock_acquire_failure);
+        nh.timeout_wheel.schedule(ne, now);
         continue;
       }
 
@@ -135,30 +141,30 @@ public:
         }
         Dbg(dbg_ctl_inactivity_cop_verbose, "ne: %p now: %" PRId64 " timeout at: %" PRId64 " timeout in: %" PRId64, ne,
             ink_hrtime_to_sec(now), ne->next_inactivity_timeout_at, ne->inactivity_timeout_in);
+        // Checked again by the next run, unless the callback resets the timeout or closes the NetEvent.
+        nh.timeout_wheel.schedule(ne, now);
         ne->callback(VC_EVENT_INACTIVITY_TIMEOUT, e);
       } else if (ne->next_activity_timeout_at && ne->next_activity_timeout_at < now) {
         Dbg(dbg_ctl_inactivity_cop_verbose, "active ne: %p now: %" PRId64 " timeout at: %" PRId64 " timeout in: %" PRId64, ne,
             ink_hrtime_to_sec(now), ne->next_activity_timeout_at, ne->active_timeout_in);
+        nh.timeout_wheel.schedule(ne, now);
         ne->callback(VC_EVENT_ACTIVE_TIMEOUT, e);
+      } else {
+        // Not expired, I/O pushed the timeout back. Check it again when it is due.
+        nh.schedule_timeout(ne, now);
       }
     }
-    // The cop_list is empty now.
-    // Let's reload the cop_list from open_list again.
-    forl_LL(NetEvent, ne, nh.open_list)
-    {
-      if (ne->get_thread() == this_ethread()) {
-        nh.cop_list.push(ne);
-      }
-    }
-    // NetHandler will remove NetEvent from cop_list if it is triggered.
-    // As the NetHandler runs, the number of NetEvents in the cop_list is decreasing.
-    // NetHandler runs 100 times maximum between InactivityCop runs.
-    // Therefore we don't have to check all the NetEvents as much as open_list.
 
-    // Cleanup the active and keep-alive queues periodically
-    nh.manage_active_queue(nullptr, true); // close any connections over the active timeout
+    // Cleanup the keep-alive queue. The active queue needs no sweep, its timeouts are in the wheel.
     nh.manage_keep_alive_queue();
 
+    // Close the sockets that were waiting for their zero copy writes
+    ZeroCopyWrites::reap(now);
+
+    Metrics::Counter::increment(net_rsb.inactivity_cop_runs);
+    Metrics::Counter::increment(net_rsb.inactivity_cop_checked, checked);
+    Metrics::Counter::increment(net_rsb.inactivity_cop_sweep_time, ink_hrtime_to_usec(ink_get_hrtime() - now));
+
     return 0;
   }
 };
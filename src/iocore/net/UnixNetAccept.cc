@@ -21,6 +21,7 @@
   limitations under the License.
  */
 
+#include "P_IOUringNet.h"
 #include "P_NetAccept.h"
 #include "P_Net.h"
 #include "P_UnixNet.h"
@@ -31,6 +32,17 @@
 #include "tscore/ink_inet.h"
 #include "tscore/ink_defs.h"
 
+#if TS_USE_HWLOC
+#include <hwloc.h>
+#endif
+
+#ifdef SO_ATTACH_REUSEPORT_CBPF
+#include <linux/filter.h>
+#endif
+
+#include <map>
+#include <vector>
+
 using NetAcceptHandler = int (NetAccept::*)(int, void *);
 
 namespace
@@ -70,6 +82,101 @@ handle_max_client_connections(IpEndpoint const &addr, std::shared_ptr<Connection
   return true;
 }
 
+/// Whether the threads are bound to CPUs, so that the CPU that received a connection tells the threads that run on it.
+bool
+threads_bound_to_cpus()
+{
+#if TS_USE_HWLOC
+  int affinity = 1;
+  REC_ReadConfigInteger(affinity, "proxy.config.exec_thread.affinity");
+
+  // 0 and the other values put every thread on the machine as a whole.
+  return affinity >= 1 && affinity <= 4;
+#else
+  return false;
+#endif
+}
+
+#if TS_USE_HWLOC
+/// Whether @a t runs on @a cpu, by its affinity.
+bool
+runs_on_cpu(EThread *t, int cpu)
+{
+  return t->hwloc_obj != nullptr && hwloc_bitmap_isset(t->hwloc_obj->cpuset, cpu);
+}
+#endif
+
+/** Steer the connections of a reuseport group to the listener of a net thread that runs on the CPU that received them.
+ *
+ * The first @a n threads have a listener in the group, in their order.
+ */
+void
+attach_cpu_steering(int fd, int n)
+{
+#if defined(SO_ATTACH_REUSEPORT_CBPF) && TS_USE_HWLOC
+  // The threads that run on each CPU.
+  std::map<int, std::vector<uint32_t>> cpu_threads;
+  for (int i = 0; i < n; ++i) {
+    EThread *t = eventProcessor.thread_group[ET_NET]._thread[i];
+    if (t->hwloc_obj == nullptr) {
+      continue;
+    }
+    int cpu;
+    hwloc_bitmap_foreach_begin(cpu, t->hwloc_obj->cpuset)
+    {
+      cpu_threads[cpu].push_back(i);
+    }
+    hwloc_bitmap_foreach_end();
+  }
+
+  // The CPUs shared by several threads, as with the threads bound to NUMA nodes, go to each of them in turn.
+  std::map<std::vector<uint32_t>, size_t> turn;
+  std::vector<sock_filter>                prog;
+
+  prog.push_back(BPF_STMT(BPF_LD | BPF_W | BPF_ABS, static_cast<uint32_t>(SKF_AD_OFF + SKF_AD_CPU)));
+  for (auto const &[cpu, threads] : cpu_threads) {
+    prog.push_back(BPF_JUMP(BPF_JMP | BPF_JEQ | BPF_K, static_cast<uint32_t>(cpu), 0, 1));
+    prog.push_back(BPF_STMT(BPF_RET | BPF_K, threads[turn[threads]++ % threads.size()]));
+  }
+  // Out of the group, the kernel picks a listener by the hash of the connection.
+  prog.push_back(BPF_STMT(BPF_RET | BPF_K, static_cast<uint32_t>(n)));
+
+  if (prog.size() > BPF_MAXINSNS) {
+    Warning("too many CPUs to steer the connections by CPU, they are spread over the net threads");
+    return;
+  }
+
+  sock_fprog fprog;
+  fprog.len    = prog.size();
+  fprog.filter = prog.data();
+  if (safe_setsockopt(fd, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, reinterpret_cast<char *>(&fprog), sizeof(fprog)) < 0) {
+    Warning("unable to steer the connections by CPU, they are spread over the net threads: %s", strerror(errno));
+    return;
+  }
+  Dbg(dbg_ctl_iocore_net_accept_start, "steering the connections of %d listeners over %zu CPUs, fd=%d", n, cpu_threads.size(),
+      fd);
+#else
+  (void)fd;
+  (void)n;
+  Warning("steering the connections by CPU is not supported on this platform, they are spread over the net threads");
+#endif
+}
+
+#if defined(SO_INCOMING_CPU) && TS_USE_HWLOC
+/// Count whether a connection was received on a CPU of the thread that accepted it.
+void
+count_incoming_cpu(int fd, EThread *t)
+{
+  int cpu = -1;
+  int len = sizeof(cpu);
+
+  if (safe_getsockopt(fd, SOL_SOCKET, SO_INCOMING_CPU, reinterpret_cast<char *>(&cpu), &len) < 0 || cpu < 0) {
+    return;
+  }
+  Metrics::Counter::increment(runs_on_cpu(t, cpu) ? net_rsb.accepts_same_cpu : net_rsb.accepts_cross_cpu);
+}
+#endif
+
 } // end anonymous namespace
 
 static void
@@ -260,7 +367,7 @@ NetAccept::accept_per_thread(int /* event ATS_UNUSED */, void * /* ep ATS_UNUSED
   int listen_per_thread = 0;
   REC_ReadConfigInteger(listen_per_thread, "proxy.config.exec_thread.listen");
 
-  if (listen_per_thread == 1) {
+  if (listen_per_thread > 0) {
     if (ats_is_unix(server.accept_addr)) {
       auto id = this_ethread()->id;
       ats_unix_append_id(&server.accept_addr.sun, id);
@@ -270,6 +377,13 @@ NetAccept::accept_per_thread(int /* event ATS_UNUSED */, void * /* ep ATS_UNUSED
       Fatal("[NetAccept::accept_per_thread]:error listenting on ports");
       return -1;
     }
+
+    // The next listener joins the reuseport group after this one, the last one steers the group.
+    if (steer_next) {
+      eventProcessor.thread_group[ET_NET]._thread[steer_next->steer_index]->schedule_imm(steer_next);
+    } else if (steer_index >= 0) {
+      attach_cpu_steering(server.sock.get_fd(), steer_index + 1);
+    }
   }
 
   if (accept_fn == net_accept) {
@@ -277,6 +391,17 @@ NetAccept::accept_per_thread(int /* event ATS_UNUSED */, void * /* ep ATS_UNUSED
   } else {
     SET_HANDLER(&NetAccept::acceptEvent);
   }
+#if TS_USE_LINUX_IO_URING
+  // The completions of a multishot accept come to the ring of this thread, so the listener must be its own.
+  if (listen_per_thread > 0 && accept_fn == net_accept) {
+    uring_accept = new IOUringNetAccept(this);
+    if (uring_accept->start()) {
+      return 0;
+    }
+    delete uring_accept;
+    uring_accept = nullptr;
+  }
+#endif
   PollDescriptor *pd = get_PollDescriptor(this_ethread());
   if (this->ep.start(pd, this, EVENTIO_READ) < 0) {
     Fatal("[NetAccept::accept_per_thread]:error starting EventIO");
@@ -303,11 +428,32 @@ NetAccept::init_accept_per_thread()
   SET_HANDLER(&NetAccept::accept_per_thread);
   n = eventProcessor.thread_group[ET_NET]._count;
 
+  // To be steered by CPU, the listeners join their reuseport group one after the other in the order of the threads, the
+  // steering program picks a listener by its place in the group.
+  bool steer = listen_per_thread == 2 && !ats_is_unix(server.accept_addr);
+
+  if (steer && !threads_bound_to_cpus()) {
+    Warning("proxy.config.exec_thread.listen is 2 but the threads are not bound to CPUs with proxy.config.exec_thread.affinity, "
+            "the connections are spread over the net threads");
+    steer = false;
+  }
+  NetAccept *first = nullptr;
+  NetAccept *prev  = nullptr;
+
   for (i = 0; i < n; i++) {
     NetAccept *a = (i < n - 1) ? clone() : this;
     EThread   *t = eventProcessor.thread_group[ET_NET]._thread[i];
     a->mutex     = get_NetHandler(t)->mutex;
-    t->schedule_imm(a);
+    if (steer) {
+      a->steer_index = i;
+      (prev ? prev->steer_next : first) = a;
+      prev                              = a;
+    } else {
+      t->schedule_imm(a);
+    }
+  }
+  if (steer) {
+    eventProcessor.thread_group[ET_NET]._thread[0]->schedule_imm(first);
   }
 }
 
@@ -515,11 +661,32 @@ NetAccept::acceptFastEvent(int event, void *ep)
   NetHandler         *h                  = get_NetHandler(t);
   int                 additional_accepts = NetHandler::get_additional_accepts();
 
+#if TS_USE_LINUX_IO_URING
+  // The multishot accept keeps the listener open in the kernel after it is closed here.
+  if (uring_accept && !server.sock.is_ok()) {
+    uring_accept->stop();
+    uring_accept = nullptr;
+    return EVENT_CONT;
+  }
+#endif
+
   do {
     socklen_t  sz = sizeof(con.addr);
     UnixSocket sock{-1};
-    if (int res{server.sock.accept4(&con.addr.sa, &sz, SOCK_NONBLOCK | SOCK_CLOEXEC)}; res >= 0) {
-      sock = UnixSocket{res};
+    int        fd;
+#if TS_USE_LINUX_IO_URING
+    if (uring_accept) {
+      if ((fd = uring_accept->next(&con.addr.sa, &sz)) < 0) {
+        errno = -fd;
+      }
+    } else {
+      fd = server.sock.accept4(&con.addr.sa, &sz, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    }
+#else
+    fd = server.sock.accept4(&con.addr.sa, &sz, SOCK_NONBLOCK | SOCK_CLOEXEC);
+#endif
+    if (fd >= 0) {
+      sock = UnixSocket{fd};
     }
     con.sock = sock;
     std::shared_ptr<ConnectionTracker::Group> conn_track_group;
@@ -538,6 +705,11 @@ NetAccept::acceptFastEvent(int event, void *ep)
       }
       Dbg(dbg_ctl_iocore_net, "accepted a new socket: %d", sock.get_fd());
       Metrics::Counter::increment(net_rsb.tcp_accept);
+#if defined(SO_INCOMING_CPU) && TS_USE_HWLOC
+      if (steer_index >= 0) {
+        count_incoming_cpu(sock.get_fd(), t);
+      }
+#endif
       if (opt.send_bufsize > 0) {
         if (unlikely(sock.set_sndbuf_size(opt.send_bufsize))) {
           bufsz = ROUNDUP(opt.send_bufsize, 1024);
@@ -634,6 +806,12 @@ Ldone:
   return EVENT_CONT;
 
 Lerror:
+#if TS_USE_LINUX_IO_URING
+  if (uring_accept) {
+    uring_accept->stop();
+    uring_accept = nullptr;
+  }
+#endif
   server.close();
   e->cancel();
   Metrics::Gauge::decrement(net_rsb.accepts_currently_open);
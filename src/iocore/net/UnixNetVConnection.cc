@@ -21,10 +21,12 @@
     limitations under the License.
 */
 
+#include "P_IOUringNet.h"
 #include "P_Net.h"
 #include "P_NetAccept.h"
 #include "P_UnixNet.h"
 #include "P_UnixNetVConnection.h"
+#include "P_ZeroCopyWrites.h"
 #include "iocore/net/ConnectionTracker.h"
 #include "iocore/net/NetHandler.h"
 #include "iocore/eventsystem/UnixSocket.h"
@@ -303,6 +305,9 @@ UnixNetVConnection::do_io_close(int alerrno /* = -1 */)
     } else {
       this->free_thread(t);
     }
+  } else if (nh) {
+    // The InactivityCop frees it, if the NetHandler does not first.
+    nh->update_timeout(this);
   }
 }
 
@@ -467,6 +472,9 @@ UnixNetVConnection::set_enabled(VIO *vio)
   if (!next_inactivity_timeout_at && inactivity_timeout_in) {
     next_inactivity_timeout_at = ink_get_hrtime() + inactivity_timeout_in;
   }
+  if (nh) {
+    nh->update_timeout(this);
+  }
 }
 
 // Read the data for a UnixNetVConnection.
@@ -517,50 +525,60 @@ UnixNetVConnection::net_read_io(NetHandler *nh)
   unsigned niov = 0;
   IOVec    tiovec[NET_MAX_IOV];
   if (toread) {
-    IOBufferBlock *b = buf.writer()->first_write_block();
-    do {
-      niov       = 0;
-      rattempted = 0;
-      while (b && niov < NET_MAX_IOV) {
-        int64_t a = b->write_avail();
-        if (a > 0) {
-          tiovec[niov].iov_base = b->_end;
-          int64_t togo          = toread - total_read - rattempted;
-          if (a > togo) {
-            a = togo;
-          }
-          tiovec[niov].iov_len  = a;
-          rattempted           += a;
-          niov++;
-          if (a >= togo) {
-            break;
+#if TS_USE_LINUX_IO_URING
+    IOUringNetIO *uring = this->_io_uring();
+    if (uring) {
+      // The received blocks are appended to the buffer, there is nothing to fill.
+      r = uring->read(buf.writer(), toread);
+      Metrics::Counter::increment(net_rsb.calls_to_read);
+    } else
+#endif
+    {
+      IOBufferBlock *b = buf.writer()->first_write_block();
+      do {
+        niov       = 0;
+        rattempted = 0;
+        while (b && niov < NET_MAX_IOV) {
+          int64_t a = b->write_avail();
+          if (a > 0) {
+            tiovec[niov].iov_base = b->_end;
+            int64_t togo          = toread - total_read - rattempted;
+            if (a > togo) {
+              a = togo;
+            }
+            tiovec[niov].iov_len  = a;
+            rattempted           += a;
+            niov++;
+            if (a >= togo) {
+              break;
+            }
           }
+          b = b->next.get();
         }
-        b = b->next.get();
-      }
 
-      ink_assert(niov > 0);
-      ink_assert(niov <= countof(tiovec));
-      struct msghdr msg;
+        ink_assert(niov > 0);
+        ink_assert(niov <= countof(tiovec));
+        struct msghdr msg;
 
-      ink_zero(msg);
-      msg.msg_name    = const_cast<sockaddr *>(this->get_remote_addr());
-      msg.msg_namelen = ats_ip_size(this->get_remote_addr());
-      msg.msg_iov     = &tiovec[0];
-      msg.msg_iovlen  = niov;
-      r               = this->con.sock.recvmsg(&msg, 0);
+        ink_zero(msg);
+        msg.msg_name    = const_cast<sockaddr *>(this->get_remote_addr());
+        msg.msg_namelen = ats_ip_size(this->get_remote_addr());
+        msg.msg_iov     = &tiovec[0];
+        msg.msg_iovlen  = niov;
+        r               = this->con.sock.recvmsg(&msg, 0);
 
-      Metrics::Counter::increment(net_rsb.calls_to_read);
+        Metrics::Counter::increment(net_rsb.calls_to_read);
 
-      total_read += rattempted;
-    } while (rattempted && r == rattempted && total_read < toread);
+        total_read += rattempted;
+      } while (rattempted && r == rattempted && total_read < toread);
 
-    // if we have already moved some bytes successfully, summarize in r
-    if (total_read != rattempted) {
-      if (r <= 0) {
-        r = total_read - rattempted;
-      } else {
-        r = total_read - rattempted + r;
+      // if we have already moved some bytes successfully, summarize in r
+      if (total_read != rattempted) {
+        if (r <= 0) {
+          r = total_read - rattempted;
+        } else {
+          r = total_read - rattempted + r;
+        }
       }
     }
     // check for errors
@@ -586,7 +604,13 @@ UnixNetVConnection::net_read_io(NetHandler *nh)
     Metrics::Counter::increment(net_rsb.read_bytes_count);
 
     // Add data to buffer and signal continuation.
+#if TS_USE_LINUX_IO_URING
+    if (_uring == nullptr) {
+      buf.writer()->fill(r);
+    }
+#else
     buf.writer()->fill(r);
+#endif
 #ifdef DEBUG
     if (buf.writer()->write_avail() <= 0) {
       Dbg(dbg_ctl_iocore_net, "read_from_net, read buffer full");
@@ -851,13 +875,22 @@ UnixNetVConnection::net_write_io(NetHandler *nh)
 int64_t
 UnixNetVConnection::load_buffer_and_write(int64_t towrite, MIOBufferAccessor &buf, int64_t &total_written, int &needs)
 {
+#if TS_USE_LINUX_IO_URING
+  if (IOUringNetIO *uring = this->_io_uring(); uring) {
+    Metrics::Counter::increment(net_rsb.calls_to_write);
+    needs |= EVENTIO_WRITE;
+    return uring->write(towrite, buf, total_written);
+  }
+#endif
+
   int64_t         r            = 0;
   int64_t         try_to_write = 0;
   IOBufferReader *tmp_reader   = buf.reader()->clone();
 
   do {
-    IOVec    tiovec[NET_MAX_IOV];
-    unsigned niov = 0;
+    IOVec          tiovec[NET_MAX_IOV];
+    IOBufferBlock *tblocks[NET_MAX_IOV];
+    unsigned       niov = 0;
     try_to_write  = 0;
 
     while (niov < NET_MAX_IOV) {
@@ -881,6 +914,7 @@ UnixNetVConnection::load_buffer_and_write(int64_t towrite, MIOBufferAccessor &bu
       // build an iov entry
       tiovec[niov].iov_len  = len;
       tiovec[niov].iov_base = tmp_reader->start();
+      tblocks[niov]         = tmp_reader->block.get();
       niov++;
 
       try_to_write += len;
@@ -908,7 +942,28 @@ UnixNetVConnection::load_buffer_and_write(int64_t towrite, MIOBufferAccessor &bu
       Metrics::Counter::increment(net_rsb.fastopen_attempts);
       flags = MSG_FASTOPEN;
     }
+#ifdef MSG_ZEROCOPY
+    if (flags == 0 && net_zerocopy_threshold > 0 && try_to_write >= net_zerocopy_threshold) {
+      if (_zerocopy == nullptr) {
+        _zerocopy = new ZeroCopyWrites();
+      }
+      if (_zerocopy->use(con.sock.get_fd(), try_to_write)) {
+        flags = MSG_ZEROCOPY;
+      }
+    }
+#endif
     r = con.sock.sendmsg(&msg, flags);
+#ifdef MSG_ZEROCOPY
+    if (flags == MSG_ZEROCOPY) {
+      if (r == -ENOBUFS) {
+        // Over the locked memory limit, this one is copied.
+        flags = 0;
+        r     = con.sock.sendmsg(&msg, flags);
+      } else if (r >= 0) {
+        _zerocopy->sent(r, tblocks, niov);
+      }
+    }
+#endif
     if (!this->con.is_connected && this->options.f_tcp_fastopen) {
       if (r < 0) {
         if (r == -EINPROGRESS || r == -EWOULDBLOCK) {
@@ -935,6 +990,27 @@ UnixNetVConnection::load_buffer_and_write(int64_t towrite, MIOBufferAccessor &bu
   return r;
 }
 
+void
+UnixNetVConnection::process_error_queue()
+{
+  if (_zerocopy) {
+    _zerocopy->complete(con.sock.get_fd());
+  }
+}
+
+#if TS_USE_LINUX_IO_URING
+IOUringNetIO *
+UnixNetVConnection::_io_uring()
+{
+  // TLS does its own I/O, and TCP Fast Open sends the first data with the connect.
+  if (_uring == nullptr && con.sock_type == SOCK_STREAM && get_service<TLSBasicSupport>() == nullptr &&
+      (con.is_connected || !options.f_tcp_fastopen) && IOUringNetIO::enabled()) {
+    _uring = new IOUringNetIO(this);
+  }
+  return _uring;
+}
+#endif
+
 void
 UnixNetVConnection::readDisable(NetHandler *nh)
 {
@@ -1288,6 +1364,23 @@ UnixNetVConnection::free_thread(EThread *t)
     release_inbound_connection_tracking();
     Metrics::Gauge::decrement(net_rsb.connections_currently_open);
   }
+#if TS_USE_LINUX_IO_URING
+  // cancel the operations in flight before the socket is closed
+  if (_uring) {
+    _uring->detach();
+    _uring = nullptr;
+  }
+#endif
+  if (_zerocopy) {
+    // The kernel may still be sending from the data of the writes, the socket is closed once they complete.
+    if (_zerocopy->pending() && con.sock.is_ok()) {
+      ZeroCopyWrites::linger(con.sock.get_fd(), _zerocopy);
+      con.sock = UnixSocket{NO_FD};
+    } else {
+      delete _zerocopy;
+    }
+    _zerocopy = nullptr;
+  }
   con.close();
 
   if (is_tunnel_endpoint()) {
@@ -1329,6 +1422,20 @@ UnixNetVConnection::set_inactivity_timeout(ink_hrtime timeout_in)
   Dbg(dbg_ctl_socket, "Set inactive timeout=%" PRId64 ", for NetVC=%p", timeout_in, this);
   inactivity_timeout_in      = timeout_in;
   next_inactivity_timeout_at = (timeout_in > 0) ? ink_get_hrtime() + inactivity_timeout_in : 0;
+  if (nh) {
+    nh->update_timeout(this);
+  }
+}
+
+void
+UnixNetVConnection::set_active_timeout(ink_hrtime timeout_in)
+{
+  Dbg(dbg_ctl_socket, "Set active timeout=%" PRId64 ", NetVC=%p", timeout_in, this);
+  active_timeout_in        = timeout_in;
+  next_activity_timeout_at = (active_timeout_in > 0) ? ink_get_hrtime() + timeout_in : 0;
+  if (nh) {
+    nh->update_timeout(this);
+  }
 }
 
 TS_INLINE void
@@ -1336,6 +1443,9 @@ UnixNetVConnection::set_default_inactivity_timeout(ink_hrtime timeout_in)
 {
   Dbg(dbg_ctl_socket, "Set default inactive timeout=%" PRId64 ", for NetVC=%p", timeout_in, this);
   default_inactivity_timeout_in = timeout_in;
+  if (nh) {
+    nh->update_timeout(this);
+  }
 }
 
 TS_INLINE bool
@@ -1357,6 +1467,10 @@ UnixNetVConnection::migrateToCurrentThread(Continuation *cont, EThread *t)
     // We're already there!
     return this;
   }
+  // The data received with io_uring, and the operations in flight, belong to the ring of this thread.
+  if (!can_migrate()) {
+    return nullptr;
+  }
 
   Connection hold_con;
   hold_con.move(this->con);
@@ -1379,6 +1493,9 @@ UnixNetVConnection::migrateToCurrentThread(Continuation *cont, EThread *t)
   if (newvc) {
     newvc->set_context(get_context());
     newvc->options = this->options;
+    // The writes in flight are on the socket, which goes with the new VC.
+    newvc->_zerocopy = this->_zerocopy;
+    this->_zerocopy  = nullptr;
   }
 
   // Do not mark this closed until the end so it does not get freed by the other thread too soon
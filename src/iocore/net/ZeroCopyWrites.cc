@@ -0,0 +1,205 @@
+/** @file
+
+  Socket writes with MSG_ZEROCOPY
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "P_ZeroCopyWrites.h"
+#include "P_Net.h"
+#include "tscore/Diags.h"
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+#include <linux/errqueue.h>
+#endif
+
+#if defined(SO_ZEROCOPY) && defined(MSG_ZEROCOPY) && defined(SO_EE_ORIGIN_ZEROCOPY)
+#define HAVE_ZEROCOPY_WRITES 1
+#else
+#define HAVE_ZEROCOPY_WRITES 0
+#endif
+
+namespace
+{
+DbgCtl dbg_ctl_zerocopy{"net_zerocopy"};
+
+// How long a closed socket waits for its zero copy writes to complete. A peer that did not acknowledge the data in
+// that time is not going to, and the data is released.
+constexpr ink_hrtime LINGER_TIMEOUT = HRTIME_SECONDS(30);
+
+struct Lingering {
+  int             fd;
+  ZeroCopyWrites *zc;
+  ink_hrtime      deadline;
+};
+
+thread_local std::vector<Lingering> lingering;
+
+} // end anonymous namespace
+
+ZeroCopyWrites::~ZeroCopyWrites()
+{
+  int64_t held = 0;
+
+  for (auto const &send : _sends) {
+    held += send.held;
+  }
+  Metrics::Gauge::decrement(net_rsb.zerocopy_deferred_bytes, held);
+}
+
+bool
+ZeroCopyWrites::use(int fd, int64_t len)
+{
+#if HAVE_ZEROCOPY_WRITES
+  if (_state == State::OFF || net_zerocopy_threshold <= 0 || len < net_zerocopy_threshold) {
+    return false;
+  }
+  if (_state == State::UNKNOWN) {
+    int on = 1;
+
+    if (setsockopt(fd, SOL_SOCKET, SO_ZEROCOPY, &on, sizeof(on)) < 0) {
+      Dbg(dbg_ctl_zerocopy, "SO_ZEROCOPY failed on fd %d: %s", fd, strerror(errno));
+      _state = State::OFF;
+      return false;
+    }
+    _state = State::ON;
+  }
+  return true;
+#else
+  (void)fd;
+  (void)len;
+  return false;
+#endif
+}
+
+void
+ZeroCopyWrites::sent(int64_t bytes, IOBufferBlock *const *blocks, unsigned int nblocks)
+{
+  Send &send = _sends.emplace_back();
+
+  // The kernel numbers the zero copy writes of a socket, the failed ones excepted.
+  send.seq   = _next_seq++;
+  send.bytes = bytes;
+  send.data.reserve(nblocks);
+  for (unsigned int i = 0; i < nblocks; ++i) {
+    if (send.data.empty() || send.data.back().get() != blocks[i]->data.get()) {
+      send.data.push_back(blocks[i]->data);
+      send.held += blocks[i]->data->block_size();
+    }
+  }
+
+  Metrics::Counter::increment(net_rsb.zerocopy_writes);
+  Metrics::Counter::increment(net_rsb.zerocopy_bytes, bytes);
+  Metrics::Gauge::increment(net_rsb.zerocopy_deferred_bytes, send.held);
+}
+
+void
+ZeroCopyWrites::complete(int fd)
+{
+#if HAVE_ZEROCOPY_WRITES
+  while (!_sends.empty()) {
+    char   control[CMSG_SPACE(sizeof(sock_extended_err) + sizeof(sockaddr_in6))];
+    msghdr msg = {};
+
+    msg.msg_control    = control;
+    msg.msg_controllen = sizeof(control);
+    if (recvmsg(fd, &msg, MSG_ERRQUEUE) < 0) {
+      return;
+    }
+
+    for (cmsghdr *cmsg = CMSG_FIRSTHDR(&msg); cmsg != nullptr; cmsg = CMSG_NXTHDR(&msg, cmsg)) {
+      if (!(cmsg->cmsg_level == SOL_IP && cmsg->cmsg_type == IP_RECVERR) &&
+          !(cmsg->cmsg_level == SOL_IPV6 && cmsg->cmsg_type == IPV6_RECVERR)) {
+        continue;
+      }
+
+      auto *ee = reinterpret_cast<sock_extended_err *>(CMSG_DATA(cmsg));
+
+      if (ee->ee_errno == 0 && ee->ee_origin == SO_EE_ORIGIN_ZEROCOPY) {
+        _release(ee->ee_info, ee->ee_data, ee->ee_code & SO_EE_CODE_ZEROCOPY_COPIED);
+      }
+    }
+  }
+#else
+  (void)fd;
+#endif
+}
+
+void
+ZeroCopyWrites::_release(uint32_t lo, uint32_t hi, bool copied)
+{
+  int64_t held = 0;
+
+  // A completion is for the range of writes [lo, hi], the numbers wrap around.
+  for (auto it = _sends.begin(); it != _sends.end();) {
+    if (it->seq - lo <= hi - lo) {
+      held += it->held;
+      if (copied) {
+        Metrics::Counter::increment(net_rsb.zerocopy_copied_bytes, it->bytes);
+      }
+      it = _sends.erase(it);
+    } else {
+      ++it;
+    }
+  }
+  Metrics::Gauge::decrement(net_rsb.zerocopy_deferred_bytes, held);
+
+  // The data was copied, by a device without scatter-gather or checksum offload for example. There is nothing to gain
+  // for this socket, only the cost of the completions.
+  if (copied && _state == State::ON) {
+    Dbg(dbg_ctl_zerocopy, "writes %u to %u were copied, zero copy is off", lo, hi);
+    Metrics::Counter::increment(net_rsb.zerocopy_fallbacks);
+    _state = State::OFF;
+  }
+}
+
+void
+ZeroCopyWrites::linger(int fd, ZeroCopyWrites *zc)
+{
+  // The peer gets the end of the stream now, the completions come as it acknowledges the data.
+  shutdown(fd, SHUT_WR);
+  lingering.push_back({fd, zc, ink_get_hrtime() + LINGER_TIMEOUT});
+}
+
+void
+ZeroCopyWrites::reap(ink_hrtime now)
+{
+  for (auto it = lingering.begin(); it != lingering.end();) {
+    it->zc->complete(it->fd);
+    if (it->zc->pending() && it->deadline > now) {
+      ++it;
+      continue;
+    }
+    if (it->zc->pending()) {
+      // The kernel would still send, or retransmit, from the pages of the pending writes once their data is released and
+      // reused. Reset the connection so that it drops them on close.
+      struct linger reset = {1, 0};
+
+      Dbg(dbg_ctl_zerocopy, "fd %d reset with zero copy writes pending", it->fd);
+      setsockopt(it->fd, SOL_SOCKET, SO_LINGER, &reset, sizeof(reset));
+    }
+    ::close(it->fd);
+    delete it->zc;
+    it = lingering.erase(it);
+  }
+}
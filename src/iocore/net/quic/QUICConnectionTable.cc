@@ -23,6 +23,16 @@
 
 #include "iocore/net/quic/QUICConnectionTable.h"
 
+#include <algorithm>
+
+QUICConnectionTable::QUICConnectionTable(int hash_table_size, int nshards)
+{
+  nshards = std::clamp(nshards, 1, 256);
+  for (int i = 0; i < nshards; ++i) {
+    _shards.push_back(std::make_unique<Table>(std::max(hash_table_size / nshards, 1)));
+  }
+}
+
 QUICConnectionTable::~QUICConnectionTable()
 {
   // TODO: clear all values.
@@ -31,19 +41,21 @@ QUICConnectionTable::~QUICConnectionTable()
 QUICConnection *
 QUICConnectionTable::insert(QUICConnectionId cid, QUICConnection *connection)
 {
-  Ptr<ProxyMutex> m = _connections.lock_for_key(cid);
+  Table          &table = _table(cid);
+  Ptr<ProxyMutex> m     = table.lock_for_key(cid);
   SCOPED_MUTEX_LOCK(lock, m, this_ethread());
   // To check whether the return value is nullptr by caller in case memory leak.
   // The return value isn't nullptr, the new value will take up the slot and return old value.
-  return _connections.insert_entry(cid, connection);
+  return table.insert_entry(cid, connection);
 }
 
 void
 QUICConnectionTable::erase(QUICConnectionId cid, QUICConnection *connection)
 {
-  Ptr<ProxyMutex> m = _connections.lock_for_key(cid);
+  Table          &table = _table(cid);
+  Ptr<ProxyMutex> m     = table.lock_for_key(cid);
   SCOPED_MUTEX_LOCK(lock, m, this_ethread());
-  QUICConnection *ret_connection = _connections.remove_entry(cid);
+  QUICConnection *ret_connection = table.remove_entry(cid);
   if (ret_connection) {
     ink_assert(ret_connection == connection);
   }
@@ -52,15 +64,29 @@ QUICConnectionTable::erase(QUICConnectionId cid, QUICConnection *connection)
 QUICConnection *
 QUICConnectionTable::erase(QUICConnectionId cid)
 {
-  Ptr<ProxyMutex> m = _connections.lock_for_key(cid);
+  Table          &table = _table(cid);
+  Ptr<ProxyMutex> m     = table.lock_for_key(cid);
   SCOPED_MUTEX_LOCK(lock, m, this_ethread());
-  return _connections.remove_entry(cid);
+  return table.remove_entry(cid);
 }
 
 QUICConnection *
 QUICConnectionTable::lookup(QUICConnectionId cid)
 {
-  Ptr<ProxyMutex> m = _connections.lock_for_key(cid);
+  Table          &table = _table(cid);
+  Ptr<ProxyMutex> m     = table.lock_for_key(cid);
   SCOPED_MUTEX_LOCK(lock, m, this_ethread());
-  return _connections.lookup_entry(cid);
+  return table.lookup_entry(cid);
+}
+
+int
+QUICConnectionTable::shards() const
+{
+  return static_cast<int>(_shards.size());
+}
+
+QUICConnectionTable::Table &
+QUICConnectionTable::_table(QUICConnectionId const &cid)
+{
+  return *_shards[cid.shard() % _shards.size()];
 }
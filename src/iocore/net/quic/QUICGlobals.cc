@@ -77,6 +77,9 @@ QUIC::_register_stats()
   // Transferred packet counts
   quic_rsb.total_packets_sent = Metrics::Counter::createPtr("proxy.process.quic.total_packets_sent");
 
+  // Short header packets received by another UDP listener than the one that owns their connection
+  quic_rsb.packets_cross_listener = Metrics::Counter::createPtr("proxy.process.quic.packets_cross_listener");
+
   // quic_rsb.total_packets_retransmitted = Metrics::Counter::createPtr("proxy.process.quic.total_packets_retransmitted");
   // quic_rsb.total_packets_received      = Metrics::Counter::createPtr("proxy.process.quic.total_packets_received");
 }
@@ -671,6 +671,21 @@ QUICConnectionId::randomize()
   this->_len = QUICConnectionId::SCID_LEN;
 }
 
+void
+QUICConnectionId::randomize(uint8_t shard)
+{
+  this->randomize();
+  if (this->_len > 0) {
+    this->_id[0] = shard;
+  }
+}
+
+uint8_t
+QUICConnectionId::shard() const
+{
+  return this->_len > 0 ? this->_id[0] : 0;
+}
+
 uint64_t
 QUICConnectionId::_hashcode() const
 {
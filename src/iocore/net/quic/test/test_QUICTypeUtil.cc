@@ -175,3 +175,17 @@ TEST_CASE("Variable Length - decoding 5", "[quic]")
   CHECK(dst == 37);
   CHECK(len == 2);
 }
+
+TEST_CASE("Connection ID - shard", "[quic]")
+{
+  QUICConnectionId cid;
+
+  cid.randomize(7);
+  CHECK(cid.length() == QUICConnectionId::SCID_LEN);
+  CHECK(cid.shard() == 7);
+
+  uint8_t          buf[] = {0x2a, 0x01, 0x02, 0x03};
+  QUICConnectionId peer(buf, sizeof(buf));
+  CHECK(peer.shard() == 0x2a);
+  CHECK(QUICConnectionId::ZERO().shard() == 0);
+}
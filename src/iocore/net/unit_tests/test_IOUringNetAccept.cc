@@ -0,0 +1,140 @@
+/** @file
+
+  Catch based unit tests for the io_uring multishot accept
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "catch.hpp"
+
+#include "../P_IOUringNet.h"
+#include "../P_NetAccept.h"
+
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace
+{
+// A completion of the multishot accept, or of the delay before arming it again.
+io_uring_cqe
+completion(int res, unsigned flags = 0)
+{
+  io_uring_cqe cqe{};
+
+  cqe.res   = res;
+  cqe.flags = flags;
+  return cqe;
+}
+} // namespace
+
+TEST_CASE("IOUringNetAccept arms the accept again after it ends", "[net][io_uring]")
+{
+  IOUringConfig config = IOUringContext::get_config();
+
+  config.net_data_path = 1;
+  IOUringContext::set_config(config);
+  if (!IOUringNetIO::enabled()) {
+    WARN("io_uring networking is not supported here");
+    return;
+  }
+
+  // The completions are handed to the accept directly, nothing is submitted to the ring of this thread. The NetAccept is
+  // not freed, the accept schedules it when a socket or an error is ready.
+  NetProcessor::AcceptOptions opt;
+  NetAccept                  *na = new NetAccept(opt);
+  sockaddr_in                 addr{};
+  int                         fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+
+  addr.sin_family      = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  REQUIRE(fd >= 0);
+  REQUIRE(bind(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == 0);
+  REQUIRE(listen(fd, 16) == 0);
+  na->server.sock = UnixSocket{fd};
+
+  IOUringNetAccept *accept = new IOUringNetAccept(na);
+  sockaddr_storage  peer;
+  socklen_t         len = sizeof(peer);
+  io_uring_cqe      cqe;
+
+  REQUIRE(accept->start());
+  CHECK(accept->armed());
+
+  SECTION("out of file descriptors, armed after a delay")
+  {
+    cqe = completion(-EMFILE);
+    accept->handle_complete(&cqe);
+    CHECK_FALSE(accept->armed());
+    CHECK(accept->delayed());
+
+    // The error is reported once, the accept is not armed by the NetAccept while waiting.
+    CHECK(accept->next(reinterpret_cast<sockaddr *>(&peer), &len) == -EMFILE);
+    CHECK(accept->next(reinterpret_cast<sockaddr *>(&peer), &len) == -EAGAIN);
+    CHECK_FALSE(accept->armed());
+
+    cqe = completion(-ETIME);
+    accept->handle_complete(&cqe);
+    CHECK(accept->armed());
+    CHECK_FALSE(accept->delayed());
+  }
+
+  SECTION("a transient error, armed at once")
+  {
+    cqe = completion(-ECONNABORTED);
+    accept->handle_complete(&cqe);
+    CHECK(accept->armed());
+    CHECK_FALSE(accept->delayed());
+    CHECK(accept->next(reinterpret_cast<sockaddr *>(&peer), &len) == -ECONNABORTED);
+  }
+
+  SECTION("ended by the kernel after an accepted socket, armed at once")
+  {
+    cqe = completion(socket(AF_INET, SOCK_STREAM, 0));
+    accept->handle_complete(&cqe);
+    CHECK(accept->armed());
+    CHECK_FALSE(accept->delayed());
+  }
+
+  SECTION("a more accepts flag keeps it armed")
+  {
+    cqe = completion(socket(AF_INET, SOCK_STREAM, 0), IORING_CQE_F_MORE);
+    accept->handle_complete(&cqe);
+    CHECK(accept->armed());
+  }
+
+  SECTION("a fatal error is left to the NetAccept")
+  {
+    cqe = completion(-EBADF);
+    accept->handle_complete(&cqe);
+    CHECK_FALSE(accept->armed());
+    CHECK_FALSE(accept->delayed());
+    CHECK(accept->next(reinterpret_cast<sockaddr *>(&peer), &len) == -EBADF);
+  }
+
+  // The accept, or the delay, in flight is cancelled and its last completion deletes it.
+  bool in_flight = accept->armed() || accept->delayed();
+
+  accept->stop();
+  if (in_flight) {
+    cqe = completion(-ECANCELED);
+    accept->handle_complete(&cqe);
+  }
+  na->server.close();
+}
@@ -0,0 +1,149 @@
+/** @file
+
+  Catch based unit tests for the eviction of the lazily built SSL_CTX
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "catch.hpp"
+
+#include "../P_SSLCertLookup.h"
+#include "../SSLLazyContext.h"
+#include "../SSLStats.h"
+
+struct SSLLazyContextTest {
+  // The contexts are built, as _load would, without reading any certificate.
+  static void
+  load(SSLLazyContext &lazy)
+  {
+    std::vector<SSLLazyContext::Resident> contexts;
+
+    contexts.push_back({shared_SSL_CTX{SSL_CTX_new(TLS_server_method()), SSL_CTX_free}, SSLCertContextType::GENERIC});
+    lazy._loaded(std::move(contexts));
+  }
+
+  static void
+  forget(SSLLazyContext &lazy)
+  {
+    lazy._referenced = false;
+  }
+
+  static int
+  resident_count()
+  {
+    std::lock_guard<std::mutex> lock(SSLLazyContext::_resident_mutex);
+    return SSLLazyContext::_resident_count;
+  }
+};
+
+namespace
+{
+void
+init_stats()
+{
+  if (ssl_rsb.lazy_ctx_resident == nullptr) {
+    ssl_rsb.lazy_ctx_evicted  = Metrics::Counter::createPtr("proxy.process.ssl.lazy_ctx_evicted");
+    ssl_rsb.lazy_ctx_loaded   = Metrics::Counter::createPtr("proxy.process.ssl.lazy_ctx_loaded");
+    ssl_rsb.lazy_ctx_resident = Metrics::Gauge::createPtr("proxy.process.ssl.lazy_ctx_resident");
+  }
+}
+
+std::vector<std::shared_ptr<SSLLazyContext>>
+make_contexts(int n)
+{
+  std::vector<std::shared_ptr<SSLLazyContext>> contexts;
+
+  for (int i = 0; i < n; ++i) {
+    contexts.push_back(
+      std::make_shared<SSLLazyContext>(SSLMultiCertConfigLoader::CertLoadData{}, std::make_shared<SSLMultiCertConfigParams>()));
+  }
+  return contexts;
+}
+
+bool
+resident(SSLLazyContext &lazy)
+{
+  return lazy.get(SSLCertContextType::GENERIC) != nullptr;
+}
+} // namespace
+
+TEST_CASE("SSLLazyContext second chance eviction", "[ssl][lazy_load]")
+{
+  init_stats();
+
+  SECTION("the resident contexts stay within the bound")
+  {
+    auto contexts                = make_contexts(10);
+    SSLLazyContext::max_resident = 3;
+
+    for (auto &lazy : contexts) {
+      SSLLazyContextTest::load(*lazy);
+      CHECK(SSLLazyContextTest::resident_count() <= 3);
+    }
+    CHECK(std::count_if(contexts.begin(), contexts.end(), [](auto &lazy) { return resident(*lazy); }) == 3);
+    // The last one built is always resident, its handshakes are waiting for it.
+    CHECK(resident(*contexts.back()));
+  }
+
+  SECTION("no bound")
+  {
+    auto contexts                = make_contexts(10);
+    SSLLazyContext::max_resident = 0;
+
+    for (auto &lazy : contexts) {
+      SSLLazyContextTest::load(*lazy);
+    }
+    CHECK(SSLLazyContextTest::resident_count() == 10);
+  }
+
+  SECTION("a context used since the last pass is kept")
+  {
+    auto contexts                = make_contexts(3);
+    SSLLazyContext::max_resident = 2;
+
+    SSLLazyContextTest::load(*contexts[0]);
+    SSLLazyContextTest::load(*contexts[1]);
+    SSLLazyContextTest::forget(*contexts[0]);
+    SSLLazyContextTest::forget(*contexts[1]);
+
+    // The oldest one is used, the newer one that is not goes instead.
+    CHECK(resident(*contexts[0]));
+    SSLLazyContextTest::load(*contexts[2]);
+    CHECK(resident(*contexts[0]));
+    CHECK_FALSE(resident(*contexts[1]));
+    CHECK(resident(*contexts[2]));
+    CHECK(SSLLazyContextTest::resident_count() == 2);
+  }
+
+  SECTION("the context being built is not evicted")
+  {
+    auto contexts                = make_contexts(2);
+    SSLLazyContext::max_resident = 1;
+
+    // Both are referenced, the scan passes over the new one until the old one runs out of chances.
+    SSLLazyContextTest::load(*contexts[0]);
+    SSLLazyContextTest::load(*contexts[1]);
+    CHECK_FALSE(resident(*contexts[0]));
+    CHECK(resident(*contexts[1]));
+    CHECK(SSLLazyContextTest::resident_count() == 1);
+  }
+
+  SSLLazyContext::max_resident = 0;
+  CHECK(SSLLazyContextTest::resident_count() == 0);
+}
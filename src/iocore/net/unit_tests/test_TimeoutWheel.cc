@@ -0,0 +1,135 @@
+/** @file
+
+  Catch based unit tests for TimeoutWheel
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "catch.hpp"
+
+#include "iocore/net/TimeoutWheel.h"
+
+#include <set>
+#include <vector>
+
+namespace
+{
+struct Entry {
+  int        id               = 0;
+  int        timeout_slot     = -1;
+  ink_hrtime timeout_check_at = 0;
+  LINK(Entry, link);
+};
+
+using Wheel = TimeoutWheel<Entry>;
+
+constexpr ink_hrtime START = HRTIME_SECONDS(1000);
+
+std::set<int>
+due(Wheel &wheel)
+{
+  std::set<int> ids;
+
+  while (Entry *e = wheel.pop_due()) {
+    ids.insert(e->id);
+  }
+  return ids;
+}
+} // namespace
+
+TEST_CASE("TimeoutWheel", "[net][TimeoutWheel]")
+{
+  Wheel              wheel(START);
+  std::vector<Entry> entries(8);
+
+  for (int i = 0; i < static_cast<int>(entries.size()); ++i) {
+    entries[i].id = i;
+  }
+
+  SECTION("due at the tick of the check time")
+  {
+    wheel.schedule(&entries[0], START + HRTIME_SECONDS(1));
+    wheel.schedule(&entries[1], START + HRTIME_SECONDS(2) + HRTIME_MSECONDS(500));
+    wheel.schedule(&entries[2], START + HRTIME_SECONDS(5));
+    REQUIRE(wheel.size() == 3);
+
+    REQUIRE(wheel.advance(START + HRTIME_MSECONDS(900)) == 0);
+    REQUIRE(wheel.advance(START + HRTIME_SECONDS(1)) == 1);
+    REQUIRE(due(wheel) == std::set<int>{0});
+    REQUIRE(wheel.advance(START + HRTIME_SECONDS(2)) == 1);
+    REQUIRE(due(wheel) == std::set<int>{1});
+    REQUIRE(wheel.advance(START + HRTIME_SECONDS(10)) == 1);
+    REQUIRE(due(wheel) == std::set<int>{2});
+    REQUIRE(wheel.size() == 0);
+    REQUIRE_FALSE(wheel.in(&entries[2]));
+  }
+
+  SECTION("a check time that has passed is the next tick")
+  {
+    wheel.schedule(&entries[0], 0);
+    wheel.schedule(&entries[1], START);
+    REQUIRE(entries[0].timeout_check_at == START + Wheel::TICK);
+    REQUIRE(wheel.advance(START + Wheel::TICK) == 2);
+    REQUIRE(due(wheel) == std::set<int>{0, 1});
+  }
+
+  SECTION("schedule moves, remove takes out")
+  {
+    wheel.schedule(&entries[0], START + HRTIME_SECONDS(30));
+    wheel.schedule(&entries[1], START + HRTIME_SECONDS(30));
+    wheel.schedule(&entries[0], START + HRTIME_SECONDS(3));
+    wheel.remove(&entries[1]);
+    REQUIRE(wheel.size() == 1);
+
+    REQUIRE(wheel.advance(START + HRTIME_SECONDS(3)) == 1);
+    REQUIRE(due(wheel) == std::set<int>{0});
+    REQUIRE(wheel.advance(START + HRTIME_SECONDS(60)) == 0);
+  }
+
+  SECTION("a due entry can be removed before it is popped")
+  {
+    wheel.schedule(&entries[0], START + HRTIME_SECONDS(1));
+    wheel.schedule(&entries[1], START + HRTIME_SECONDS(1));
+    REQUIRE(wheel.advance(START + HRTIME_SECONDS(1)) == 2);
+    wheel.remove(&entries[1]);
+    REQUIRE(due(wheel) == std::set<int>{0});
+    REQUIRE(wheel.size() == 0);
+  }
+
+  SECTION("beyond the last slot")
+  {
+    ink_hrtime far = START + (Wheel::SLOTS + 10) * Wheel::TICK;
+
+    wheel.schedule(&entries[0], far);
+    // The slot comes around once before the check time, the entry stays in it.
+    REQUIRE(wheel.advance(START + 10 * Wheel::TICK) == 0);
+    REQUIRE(wheel.advance(far - Wheel::TICK) == 0);
+    REQUIRE(wheel.advance(far) == 1);
+    REQUIRE(due(wheel) == std::set<int>{0});
+  }
+
+  SECTION("a long pause")
+  {
+    wheel.schedule(&entries[0], START + HRTIME_SECONDS(2));
+    wheel.schedule(&entries[1], START + HRTIME_SECONDS(100));
+    wheel.schedule(&entries[2], START + 2 * Wheel::SLOTS * Wheel::TICK);
+    REQUIRE(wheel.advance(START + 3 * Wheel::SLOTS * Wheel::TICK) == 3);
+    REQUIRE(due(wheel) == std::set<int>{0, 1, 2});
+  }
+}
@@ -0,0 +1,265 @@
+/** @file
+
+  Catch based unit tests for the zero copy writes of a socket
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "catch.hpp"
+
+#include "../P_Net.h"
+#include "../P_ZeroCopyWrites.h"
+
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+struct ZeroCopyWritesTest {
+  static void
+  start_at(ZeroCopyWrites &zc, uint32_t seq)
+  {
+    zc._next_seq = seq;
+  }
+
+  static void
+  release(ZeroCopyWrites &zc, uint32_t lo, uint32_t hi, bool copied = false)
+  {
+    zc._release(lo, hi, copied);
+  }
+
+  static std::vector<uint32_t>
+  pending(ZeroCopyWrites const &zc)
+  {
+    std::vector<uint32_t> seqs;
+
+    for (auto const &send : zc._sends) {
+      seqs.push_back(send.seq);
+    }
+    return seqs;
+  }
+
+  static void
+  turn_on(ZeroCopyWrites &zc)
+  {
+    zc._state = ZeroCopyWrites::State::ON;
+  }
+
+  static bool
+  off(ZeroCopyWrites const &zc)
+  {
+    return zc._state == ZeroCopyWrites::State::OFF;
+  }
+};
+
+namespace
+{
+void
+init_stats()
+{
+  if (net_rsb.zerocopy_writes == nullptr) {
+    net_rsb.zerocopy_writes         = Metrics::Counter::createPtr("proxy.process.net.zerocopy.writes");
+    net_rsb.zerocopy_bytes          = Metrics::Counter::createPtr("proxy.process.net.zerocopy.bytes");
+    net_rsb.zerocopy_copied_bytes   = Metrics::Counter::createPtr("proxy.process.net.zerocopy.copied_bytes");
+    net_rsb.zerocopy_fallbacks      = Metrics::Counter::createPtr("proxy.process.net.zerocopy.fallbacks");
+    net_rsb.zerocopy_deferred_bytes = Metrics::Gauge::createPtr("proxy.process.net.zerocopy.deferred_bytes");
+  }
+}
+
+Ptr<IOBufferBlock>
+make_block()
+{
+  Ptr<IOBufferBlock> block = make_ptr(new_IOBufferBlock());
+
+  block->alloc(BUFFER_SIZE_INDEX_4K);
+  memset(block->end(), 'x', block->write_avail());
+  block->fill(block->write_avail());
+  return block;
+}
+
+// A connected pair of loopback TCP sockets.
+void
+connect_pair(int &client, int &server)
+{
+  sockaddr_in addr{};
+  socklen_t   len      = sizeof(addr);
+  int         listener = socket(AF_INET, SOCK_STREAM, 0);
+
+  addr.sin_family      = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  REQUIRE(listener >= 0);
+  REQUIRE(bind(listener, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == 0);
+  REQUIRE(listen(listener, 1) == 0);
+  REQUIRE(getsockname(listener, reinterpret_cast<sockaddr *>(&addr), &len) == 0);
+
+  client = socket(AF_INET, SOCK_STREAM, 0);
+  REQUIRE(client >= 0);
+  REQUIRE(connect(client, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) == 0);
+  server = accept(listener, nullptr, nullptr);
+  REQUIRE(server >= 0);
+  close(listener);
+}
+
+bool
+is_open(int fd)
+{
+  return fcntl(fd, F_GETFD) != -1;
+}
+} // namespace
+
+TEST_CASE("ZeroCopyWrites completion ranges", "[net][zerocopy]")
+{
+  init_stats();
+
+  ZeroCopyWrites     zc;
+  Ptr<IOBufferBlock> block     = make_block();
+  IOBufferBlock     *blocks[2] = {block.get(), block.get()};
+
+  SECTION("the data of a write is held once until it completes")
+  {
+    int refs = block->data->refcount();
+
+    zc.sent(100, blocks, 2);
+    CHECK(block->data->refcount() == refs + 1);
+    ZeroCopyWritesTest::release(zc, 0, 0);
+    CHECK(block->data->refcount() == refs);
+    CHECK_FALSE(zc.pending());
+  }
+
+  SECTION("a range releases the writes in it only")
+  {
+    for (int i = 0; i < 5; ++i) {
+      zc.sent(100, blocks, 1);
+    }
+    ZeroCopyWritesTest::release(zc, 1, 3);
+    CHECK(ZeroCopyWritesTest::pending(zc) == std::vector<uint32_t>{0, 4});
+    ZeroCopyWritesTest::release(zc, 4, 4);
+    CHECK(ZeroCopyWritesTest::pending(zc) == std::vector<uint32_t>{0});
+  }
+
+  SECTION("a range across the wrap around of the write numbers")
+  {
+    ZeroCopyWritesTest::start_at(zc, UINT32_MAX - 2);
+    for (int i = 0; i < 5; ++i) {
+      zc.sent(100, blocks, 1);
+    }
+    ZeroCopyWritesTest::release(zc, UINT32_MAX - 1, 0);
+    CHECK(ZeroCopyWritesTest::pending(zc) == std::vector<uint32_t>{UINT32_MAX - 2, 1});
+  }
+
+  SECTION("copied writes turn zero copy off")
+  {
+    ZeroCopyWritesTest::turn_on(zc);
+    zc.sent(100, blocks, 1);
+    CHECK_FALSE(ZeroCopyWritesTest::off(zc));
+    ZeroCopyWritesTest::release(zc, 0, 0, true);
+    CHECK(ZeroCopyWritesTest::off(zc));
+    CHECK_FALSE(zc.use(0, INT64_MAX));
+  }
+}
+
+TEST_CASE("ZeroCopyWrites completion from the error queue", "[net][zerocopy]")
+{
+  init_stats();
+
+  Ptr<IOBufferBlock> block     = make_block();
+  IOBufferBlock     *blocks[1] = {block.get()};
+  ZeroCopyWrites     zc;
+  int                client, server;
+  int                threshold = net_zerocopy_threshold;
+
+  connect_pair(client, server);
+  net_zerocopy_threshold = 1;
+  if (!zc.use(client, block->read_avail())) {
+    WARN("MSG_ZEROCOPY is not supported here");
+  } else {
+#ifdef MSG_ZEROCOPY
+    ssize_t r = send(client, block->start(), block->read_avail(), MSG_ZEROCOPY);
+
+    REQUIRE(r > 0);
+    zc.sent(r, blocks, 1);
+
+    // The completion of a loopback write comes right away, the data is copied to the peer.
+    pollfd pfd = {client, 0, 0};
+
+    for (int i = 0; i < 100 && zc.pending(); ++i) {
+      poll(&pfd, 1, 10);
+      zc.complete(client);
+    }
+    CHECK_FALSE(zc.pending());
+#endif
+  }
+  net_zerocopy_threshold = threshold;
+  close(client);
+  close(server);
+}
+
+TEST_CASE("ZeroCopyWrites reap of lingering sockets", "[net][zerocopy]")
+{
+  init_stats();
+
+  Ptr<IOBufferBlock> block     = make_block();
+  IOBufferBlock     *blocks[1] = {block.get()};
+  int                refs      = block->data->refcount();
+  auto              *zc        = new ZeroCopyWrites();
+  int                client, server;
+  char               c;
+
+  connect_pair(client, server);
+
+  SECTION("closed once the writes complete")
+  {
+    zc->sent(100, blocks, 1);
+    ZeroCopyWrites::linger(client, zc);
+    ZeroCopyWrites::reap(ink_get_hrtime());
+    CHECK(is_open(client));
+    CHECK(block->data->refcount() == refs + 1);
+
+    // The end of the stream was sent already.
+    CHECK(recv(server, &c, 1, 0) == 0);
+
+    ZeroCopyWritesTest::release(*zc, 0, 0);
+    ZeroCopyWrites::reap(ink_get_hrtime());
+    CHECK_FALSE(is_open(client));
+    CHECK(block->data->refcount() == refs);
+
+    pollfd pfd = {server, POLLIN, 0};
+
+    CHECK(poll(&pfd, 1, 0) == 1);
+    CHECK_FALSE(pfd.revents & POLLERR);
+  }
+
+  SECTION("reset with writes pending after the timeout")
+  {
+    zc->sent(100, blocks, 1);
+    ZeroCopyWrites::linger(client, zc);
+    ZeroCopyWrites::reap(ink_get_hrtime() + HRTIME_HOURS(1));
+    CHECK_FALSE(is_open(client));
+    CHECK(block->data->refcount() == refs);
+
+    // The peer got a reset rather than just the end of the stream.
+    pollfd pfd = {server, POLLIN, 0};
+
+    CHECK(poll(&pfd, 1, 1000) == 1);
+    CHECK(pfd.revents & POLLERR);
+  }
+
+  close(server);
+}
@@ -28,6 +28,7 @@
 #include "records/RecCore.h"
 #include "tscore/Layout.h"
 #include "proxy/Plugin.h"
+#include "api/PluginStats.h"
 #include "tscore/ink_cap.h"
 #include "tscore/Filenames.h"
 
@@ -72,6 +73,7 @@ void
 parsePluginConfig()
 {
   parsePluginDynamicReloadConfig();
+  PluginStats::init();
 }
 
 static const char *plugin_dir = ".";
@@ -191,6 +193,9 @@ single_plugin_init(int argc, char *argv[], bool validateOnly)
 #endif
     opterr = 0;
     optarg = nullptr;
+
+    // Continuations created by the plugin while it initializes belong to it.
+    PluginStats::Scope scope(PluginStats::get(path));
     init(argc, argv);
   } // done elevating access
 
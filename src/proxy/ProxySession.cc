@@ -94,6 +94,10 @@ ProxySession::state_api_callout(int event, void *data)
     schedule_event = nullptr;
   }
 
+  if (event == TS_EVENT_HTTP_CONTINUE || event == TS_EVENT_HTTP_ERROR) {
+    this->record_hook_time();
+  }
+
   switch (event) {
   case EVENT_NONE:
   case EVENT_INTERVAL:
@@ -102,7 +106,8 @@ ProxySession::state_api_callout(int event, void *data)
       /// Get the next hook to invoke from HttpHookState
       cur_hook = hook_state.getNext();
     }
-    if (nullptr != cur_hook) {
+    // Synchronous hooks resume the session with their return value, see TSContSyncHookSet().
+    while (nullptr != cur_hook) {
       APIHook const *hook = cur_hook;
 
       WEAK_MUTEX_TRY_LOCK(lock, hook->m_cont->mutex, mutex->thread_holding);
@@ -116,10 +121,22 @@ ProxySession::state_api_callout(int event, void *data)
         return -1;
       }
 
-      cur_hook = nullptr; // mark current callback at dispatched.
-      hook->invoke(eventmap[hook_state.id()], this);
+      cur_hook   = nullptr; // mark current callback at dispatched.
+      hook_timer = ink_get_hrtime();
+
+      // The session may be gone once an asynchronous hook returns.
+      if (!hook->m_cont->m_sync_hook) {
+        hook->invoke(eventmap[hook_state.id()], this);
+        return 0;
+      }
 
-      return 0;
+      int ret = hook->invoke(eventmap[hook_state.id()], this);
+      this->record_hook_time();
+      if (ret == TS_EVENT_HTTP_ERROR) {
+        this->handle_api_return(TS_EVENT_HTTP_ERROR);
+        return 0;
+      }
+      cur_hook = hook_state.getNext();
     }
 
     handle_api_return(event);
@@ -153,6 +170,16 @@ ProxySession::do_api_callout(TSHttpHookID id)
   return 0;
 }
 
+void
+ProxySession::record_hook_time()
+{
+  if (hook_timer) {
+    Metrics::Counter::increment(http_rsb.hook_count[hook_state.id()]);
+    Metrics::Counter::increment(http_rsb.hook_time[hook_state.id()], ink_get_hrtime() - hook_timer);
+    hook_timer = 0;
+  }
+}
+
 void
 ProxySession::handle_api_return(int event)
 {
@@ -376,9 +376,14 @@ http_hdr_clone(HTTPHdrImpl *s_hh, HdrHeap *s_heap, HdrHeap *d_heap)
 {
   HTTPHdrImpl *d_hh;
 
-  // FIX: A future optimization is to copy contiguous objects with
-  //      one single memcpy.  For this first optimization, we just
-  //      copy each object separately.
+  // A header unmarshalled from the cache is copied with one single
+  //   memcpy of its objects, this is the common case on a cache hit.
+  //   Otherwise we just copy each object separately.
+  if (s_heap != d_heap) {
+    if (HdrHeapObjImpl *obj = d_heap->clone_objects(s_heap, s_hh); obj != nullptr) {
+      return static_cast<HTTPHdrImpl *>(obj);
+    }
+  }
 
   d_hh = http_hdr_create(d_heap, s_hh->m_polarity, s_hh->m_version);
   http_hdr_copy_onto(s_hh, s_heap, d_hh, d_heap, ((s_heap != d_heap) ? true : false));
@@ -1957,6 +1962,15 @@ HTTPHdrImpl::unmarshal(intptr_t offset)
   HDR_UNMARSHAL_PTR(m_fields_impl, MIMEHdrImpl, offset);
 }
 
+void
+HTTPHdrImpl::relocate(intptr_t offset)
+{
+  if (m_polarity == HTTP_TYPE_REQUEST) {
+    HDR_UNMARSHAL_PTR(u.req.m_url_impl, URLImpl, offset);
+  }
+  HDR_UNMARSHAL_PTR(m_fields_impl, MIMEHdrImpl, offset);
+}
+
 void
 HTTPHdrImpl::move_strings(HdrStrHeap *new_heap)
 {
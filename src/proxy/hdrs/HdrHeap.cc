@@ -1107,6 +1107,75 @@ HdrHeap::inherit_string_heaps(const HdrHeap *inherit_from)
   return;
 }
 
+// HdrHeapObjImpl* HdrHeap::clone_objects(const HdrHeap *s_heap, const HdrHeapObjImpl *obj)
+//
+//   An unmarshalled heap is a single chunk whose objects only point
+//     at each other, so the whole object area can be copied at once and
+//     then fixed up by the distance it moved.  Strings are not copied,
+//     we reference the string heaps of s_heap like inherit_string_heaps
+//     does for the object by object copy.
+//
+HdrHeapObjImpl *
+HdrHeap::clone_objects(const HdrHeap *s_heap, const HdrHeapObjImpl *obj)
+{
+  ink_assert(m_writeable);
+
+  if (s_heap == this || s_heap->m_writeable || s_heap->m_next != nullptr) {
+    return nullptr;
+  }
+
+  const char *s_start = s_heap->m_data_start;
+  uint32_t    nbytes  = static_cast<uint32_t>(s_heap->m_free_start - s_start);
+
+  ink_assert(reinterpret_cast<const char *>(obj) >= s_start && reinterpret_cast<const char *>(obj) < s_heap->m_free_start);
+
+  HdrHeap *h = this;
+  while (h != nullptr && h->m_free_size < nbytes) {
+    h = h->m_next;
+  }
+  if (h == nullptr) {
+    return nullptr;
+  }
+
+  char *d_start = h->m_free_start;
+  memcpy(d_start, s_start, nbytes);
+  h->m_free_start += nbytes;
+  h->m_free_size  -= nbytes;
+
+  intptr_t offset   = d_start - s_start;
+  char    *obj_data = d_start;
+
+  while (obj_data < h->m_free_start) {
+    HdrHeapObjImpl *d_obj = reinterpret_cast<HdrHeapObjImpl *>(obj_data);
+    ink_assert(obj_is_aligned(d_obj));
+    ink_release_assert(0 != d_obj->m_length);
+
+    switch (d_obj->m_type) {
+    case HDR_HEAP_OBJ_HTTP_HEADER:
+      ((HTTPHdrImpl *)d_obj)->relocate(offset);
+      break;
+    case HDR_HEAP_OBJ_FIELD_BLOCK:
+      ((MIMEFieldBlockImpl *)d_obj)->relocate(offset);
+      break;
+    case HDR_HEAP_OBJ_MIME_HEADER:
+      ((MIMEHdrImpl *)d_obj)->relocate(offset);
+      break;
+    case HDR_HEAP_OBJ_URL:
+    case HDR_HEAP_OBJ_EMPTY:
+      // No pointers to other objects
+      break;
+    default:
+      ink_release_assert(!"clone_objects: unknown object type");
+    }
+
+    obj_data = obj_data + d_obj->m_length;
+  }
+
+  inherit_string_heaps(s_heap);
+
+  return reinterpret_cast<HdrHeapObjImpl *>(const_cast<char *>(reinterpret_cast<const char *>(obj)) + offset);
+}
+
 // void HdrHeap::dump_heap(int len)
 //
 //   Debugging function to dump the heap in hex
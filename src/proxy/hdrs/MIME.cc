@@ -3743,6 +3743,20 @@ MIMEFieldBlockImpl::unmarshal(intptr_t offset)
   }
 }
 
+void
+MIMEFieldBlockImpl::relocate(intptr_t offset)
+{
+  HDR_UNMARSHAL_PTR(m_next, MIMEFieldBlockImpl, offset);
+
+  for (uint32_t index = 0; index < m_freetop; index++) {
+    MIMEField *field = &(m_field_slots[index]);
+
+    if (field->is_live() && field->m_next_dup) {
+      HDR_UNMARSHAL_PTR(field->m_next_dup, MIMEField, offset);
+    }
+  }
+}
+
 void
 MIMEFieldBlockImpl::move_strings(HdrStrHeap *new_heap)
 {
@@ -3813,6 +3827,13 @@ MIMEHdrImpl::unmarshal(intptr_t offset)
   m_first_fblock.unmarshal(offset);
 }
 
+void
+MIMEHdrImpl::relocate(intptr_t offset)
+{
+  HDR_UNMARSHAL_PTR(m_fblock_list_tail, MIMEFieldBlockImpl, offset);
+  m_first_fblock.relocate(offset);
+}
+
 void
 MIMEHdrImpl::move_strings(HdrStrHeap *new_heap)
 {
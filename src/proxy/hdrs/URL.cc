@@ -93,6 +93,8 @@ int URL_LEN_MMS;
 int URL_LEN_MMSU;
 int URL_LEN_MMST;
 
+CryptoContext::HashType URLHashContext::Setting = CryptoContext::UNSPECIFIED;
+
 namespace
 {
 // Whether we should implement url_CryptoHash_get() using url_CryptoHash_get_fast(). Note that
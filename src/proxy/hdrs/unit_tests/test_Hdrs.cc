@@ -2103,3 +2103,82 @@ TEST_CASE("HdrTest", "[proxy][hdrtest]")
     }
   }
 }
+
+namespace
+{
+std::string
+print_hdr(HTTPHdr const &hdr)
+{
+  char buf[4096];
+  int  bufindex = 0, dumpoffset = 0;
+
+  REQUIRE(hdr.print(buf, sizeof(buf), &bufindex, &dumpoffset) == 1);
+  return {buf, static_cast<size_t>(bufindex)};
+}
+} // namespace
+
+TEST_CASE("HdrCloneUnmarshaled", "[proxy][hdrtest]")
+{
+  // More than one field block, and duplicate fields in both of them.
+  std::string response = "HTTP/1.1 200 OK\r\nSet-Cookie: a=1\r\nCache-Control: max-age=60\r\n";
+  for (int i = 0; i < 20; ++i) {
+    response += "X-Field-" + std::to_string(i) + ": value-" + std::to_string(i) + "\r\n";
+  }
+  response += "Set-Cookie: b=2\r\nContent-Length: 10\r\n\r\n";
+
+  HTTPHdr     hdr;
+  HTTPParser  parser;
+  const char *start = response.data();
+
+  hdr.create(HTTP_TYPE_RESPONSE);
+  http_parser_init(&parser);
+  REQUIRE(hdr.parse_resp(&parser, &start, response.data() + response.size(), true) == PARSE_RESULT_DONE);
+  http_parser_clear(&parser);
+
+  // What the cache does, marshal and unmarshal the header in place.
+  TestRefCountObj         ref;
+  std::unique_ptr<char[]> marshal_buf(new char[4096]);
+  HTTPHdr                 cached;
+
+  ref.refcount_inc();
+  int marshal_len = hdr.m_heap->marshal(marshal_buf.get(), 4096);
+  REQUIRE(marshal_len > 0);
+  REQUIRE(cached.unmarshal(marshal_buf.get(), marshal_len, &ref) > 0);
+  std::string expected = print_hdr(cached);
+  REQUIRE(expected == print_hdr(hdr));
+
+  // A copy into an empty header takes the objects of the cached header in one block.
+  HTTPHdr copy;
+  copy.copy(&cached);
+  REQUIRE(copy.m_heap->m_next == nullptr);
+  char const *heap_start = reinterpret_cast<char const *>(copy.m_heap);
+  char const *heap_end   = heap_start + copy.m_heap->m_size;
+  CHECK(reinterpret_cast<char const *>(copy.m_http) > heap_start);
+  CHECK(reinterpret_cast<char const *>(copy.m_http) < heap_end);
+  CHECK(reinterpret_cast<char const *>(copy.m_mime) > heap_start);
+  CHECK(reinterpret_cast<char const *>(copy.m_mime) < heap_end);
+  CHECK(print_hdr(copy) == expected);
+
+  // The duplicate chain points into the copy.
+  MIMEField *cookie = copy.field_find(MIME_FIELD_SET_COOKIE, MIME_LEN_SET_COOKIE);
+  REQUIRE(cookie != nullptr);
+  REQUIRE(cookie->m_next_dup != nullptr);
+  CHECK(reinterpret_cast<char const *>(cookie->m_next_dup) > heap_start);
+  CHECK(reinterpret_cast<char const *>(cookie->m_next_dup) < heap_end);
+  CHECK(cookie->m_next_dup->value_get() == "b=2");
+
+  // Modifying the copy leaves the cached header alone.
+  copy.field_delete(MIME_FIELD_SET_COOKIE, MIME_LEN_SET_COOKIE);
+  copy.value_set(MIME_FIELD_CACHE_CONTROL, MIME_LEN_CACHE_CONTROL, "no-cache", 8);
+  copy.value_set("X-Field-19", 10, "changed", 7);
+  copy.set_age(5);
+
+  CHECK(copy.field_find(MIME_FIELD_SET_COOKIE, MIME_LEN_SET_COOKIE) == nullptr);
+  CHECK(copy.value_get(std::string_view{MIME_FIELD_CACHE_CONTROL}) == "no-cache");
+  CHECK(copy.value_get(std::string_view{"X-Field-19"}) == "changed");
+  CHECK(copy.value_get(std::string_view{"X-Field-0"}) == "value-0");
+  CHECK(print_hdr(cached) == expected);
+
+  copy.destroy();
+  hdr.destroy();
+}
@@ -22,6 +22,7 @@
   limitations under the License.
  */
 
+#include <algorithm>
 #include <deque>
 
 #include "tscore/ink_config.h"
@@ -37,6 +38,7 @@
 #include "../../records/P_RecUtils.h"
 #include "records/RecHttp.h"
 #include "proxy/http/HttpSessionManager.h"
+#include "proxy/http/HttpDebugNames.h"
 
 #define HttpEstablishStaticConfigStringAlloc(_ix, _n) \
   REC_EstablishStaticConfigStringAlloc(_ix, _n);      \
@@ -175,6 +177,7 @@ static const ConfigEnumPair<TSServerSessionSharingPoolType> SessionSharingPoolSt
   {TS_SERVER_SESSION_SHARING_POOL_THREAD,        "thread"       },
   {TS_SERVER_SESSION_SHARING_POOL_HYBRID,        "hybrid"       },
   {TS_SERVER_SESSION_SHARING_POOL_GLOBAL_LOCKED, "global_locked"},
+  {TS_SERVER_SESSION_SHARING_POOL_STEAL,         "steal"        },
 };
 
 int              HttpConfig::m_id = 0;
@@ -390,6 +393,10 @@ register_stat_callbacks()
   http_rsb.parent_proxy_request_total_bytes  = Metrics::Counter::createPtr("proxy.process.http.parent_proxy_request_total_bytes");
   http_rsb.parent_proxy_response_total_bytes = Metrics::Counter::createPtr("proxy.process.http.parent_proxy_response_total_bytes");
   http_rsb.parent_proxy_transaction_time     = Metrics::Counter::createPtr("proxy.process.http.parent_proxy_transaction_time");
+  http_rsb.pool_steal_lock_contention        = Metrics::Counter::createPtr("proxy.process.http.pool_steal.lock_contention");
+  http_rsb.pool_steal_misses                 = Metrics::Counter::createPtr("proxy.process.http.pool_steal.misses");
+  http_rsb.pool_steal_origins_saved          = Metrics::Counter::createPtr("proxy.process.http.pool_steal.origins_saved");
+  http_rsb.pool_steals                       = Metrics::Counter::createPtr("proxy.process.http.pool_steal.steals");
   http_rsb.pooled_server_connections         = Metrics::Gauge::createPtr("proxy.process.http.pooled_server_connections");
   http_rsb.post_body_too_large               = Metrics::Counter::createPtr("proxy.process.http.post_body_too_large");
   http_rsb.post_requests                     = Metrics::Counter::createPtr("proxy.process.http.post_requests");
@@ -591,6 +598,21 @@ register_stat_callbacks()
   http_rsb.origin_server_speed_bytes_per_sec_1G =
     Metrics::Counter::createPtr("proxy.process.http.origin_server_speed_bytes_per_sec_1G");
 
+  // Plugin stats for each HTTP hook, e.g. proxy.process.http.hook.read_request_hdr.count for TS_HTTP_READ_REQUEST_HDR_HOOK.
+  static constexpr std::string_view HOOK_PREFIX{"TS_HTTP_"};
+  static constexpr std::string_view HOOK_SUFFIX{"_HOOK"};
+  for (int id = 0; id < TS_SSL_FIRST_HOOK; ++id) {
+    std::string_view name{HttpDebugNames::get_api_hook_name(static_cast<TSHttpHookID>(id))};
+    std::string      stem{"proxy.process.http.hook."};
+
+    ink_release_assert(name.starts_with(HOOK_PREFIX) && name.ends_with(HOOK_SUFFIX));
+    name.remove_prefix(HOOK_PREFIX.size());
+    name.remove_suffix(HOOK_SUFFIX.size());
+    std::transform(name.begin(), name.end(), std::back_inserter(stem), ::tolower);
+    http_rsb.hook_count[id] = Metrics::Counter::createPtr(stem + ".count");
+    http_rsb.hook_time[id]  = Metrics::Counter::createPtr(stem + ".time");
+  }
+
   Metrics::Derived::derive({
     // Total bytes of client request body + headers
     {"proxy.process.http.user_agent_total_request_bytes",
@@ -1303,6 +1303,7 @@ HttpSM::state_api_callback(int event, void *data)
   ink_assert(reentrancy_count >= 0);
   reentrancy_count++;
 
+  this->record_hook_time();
   this->milestone_update_api_time();
 
   STATE_ENTER(&HttpSM::state_api_callback, event);
@@ -1404,7 +1405,9 @@ plugins required to work with sni_routing.
     if (nullptr == cur_hook) {
       cur_hook = hook_state.getNext();
     }
-    if (cur_hook) {
+    // Synchronous hooks resume the transaction with their return value, so a run of them is
+    // called from this loop instead of each one reentering through TSHttpTxnReenable().
+    while (cur_hook) {
       if (callout_state == HTTP_API_NO_CALLOUT) {
         callout_state = HTTP_API_IN_CALLOUT;
       }
@@ -1427,11 +1430,25 @@ plugins required to work with sni_routing.
       // callback manipulation. cur_hook isn't needed to track state (in hook_state).
       cur_hook = nullptr;
 
+      hook_timer    = ink_get_hrtime();
+      hook_timer_id = cur_hook_id;
       if (!api_timer) {
-        api_timer = ink_get_hrtime();
+        api_timer = hook_timer;
+      }
+
+      bool sync = hook->m_cont->m_sync_hook;
+      int  ret  = hook->invoke(TS_EVENT_HTTP_READ_REQUEST_HDR + static_cast<int>(cur_hook_id), this);
+
+      if (sync) {
+        this->record_hook_time();
+        this->milestone_update_api_time();
+        if (ret == TS_EVENT_HTTP_ERROR) {
+          return state_api_callout(HTTP_API_ERROR, nullptr);
+        }
+        cur_hook = hook_state.getNext();
+        continue;
       }
 
-      hook->invoke(TS_EVENT_HTTP_READ_REQUEST_HDR + static_cast<int>(cur_hook_id), this);
       if (api_timer > 0) { // true if the hook did not call TxnReenable()
         this->milestone_update_api_time();
         api_timer = -ink_get_hrtime(); // set in order to track non-active callout duration
@@ -8795,6 +8812,18 @@ HttpSM::get_server_version(HTTPHdr &hdr) const
   return this->server_txn->get_proxy_ssn()->get_version(hdr);
 }
 
+void
+HttpSM::record_hook_time()
+{
+  if (hook_timer) {
+    if (hook_timer_id < TS_SSL_FIRST_HOOK) {
+      Metrics::Counter::increment(http_rsb.hook_count[hook_timer_id]);
+      Metrics::Counter::increment(http_rsb.hook_time[hook_timer_id], ink_get_hrtime() - hook_timer);
+    }
+    hook_timer = 0;
+  }
+}
+
 /// Update the milestone state given the milestones and timer.
 void
 HttpSM::milestone_update_api_time()
@@ -68,6 +68,7 @@ ServerSessionPool::purge()
   m_ip_pool.apply([](PoolableSession *ssn) -> void { ssn->do_io_close(); });
   m_ip_pool.clear();
   m_fqdn_pool.clear();
+  m_idle = 0;
 }
 
 bool
@@ -158,11 +159,15 @@ ServerSessionPool::validate_cert(HttpSM *sm, NetVConnection *netvc)
 
 HSMresult_t
 ServerSessionPool::acquireSession(sockaddr const *addr, CryptoHash const &hostname_hash,
-                                  TSServerSessionSharingMatchMask match_style, HttpSM *sm, PoolableSession *&to_return)
+                                  TSServerSessionSharingMatchMask match_style, HttpSM *sm, PoolableSession *&to_return,
+                                  bool migrate)
 {
   HSMresult_t zret = HSM_NOT_FOUND;
   to_return        = nullptr;
 
+  // A session for another thread must be able to move there.
+  auto movable = [migrate](PoolableSession const &ssn) -> bool { return !migrate || ssn.can_migrate(); };
+
   if ((TS_SERVER_SESSION_SHARING_MATCH_MASK_HOSTONLY & match_style) && !(TS_SERVER_SESSION_SHARING_MATCH_MASK_IP & match_style)) {
     Dbg(dbg_ctl_http_ss, "Search for host name only not IP.  Pool size %zu", m_fqdn_pool.count());
     // This is broken out because only in this case do we check the host hash first. The range must be checked
@@ -173,7 +178,7 @@ ServerSessionPool::acquireSession(sockaddr const *addr, CryptoHash const &hostna
     auto const end   = std::make_reverse_iterator(range.begin());
     while (iter != end) {
       Dbg(dbg_ctl_http_ss, "Compare port 0x%x against 0x%x", port, ats_ip_port_cast(iter->get_remote_addr()));
-      if (port == ats_ip_port_cast(iter->get_remote_addr()) &&
+      if (port == ats_ip_port_cast(iter->get_remote_addr()) && movable(*iter) &&
           (!(match_style & TS_SERVER_SESSION_SHARING_MATCH_MASK_SNI) || validate_sni(sm, iter->get_netvc())) &&
           (!(match_style & TS_SERVER_SESSION_SHARING_MATCH_MASK_HOSTSNISYNC) || validate_host_sni(sm, iter->get_netvc())) &&
           (!(match_style & TS_SERVER_SESSION_SHARING_MATCH_MASK_CERT) || validate_cert(sm, iter->get_netvc()))) {
@@ -201,6 +206,7 @@ ServerSessionPool::acquireSession(sockaddr const *addr, CryptoHash const &hostna
     if (match_style & (~TS_SERVER_SESSION_SHARING_MATCH_MASK_IP)) {
       while (iter != end) {
         if ((!(match_style & TS_SERVER_SESSION_SHARING_MATCH_MASK_HOSTONLY) || iter->hostname_hash == hostname_hash) &&
+            movable(*iter) &&
             (!(match_style & TS_SERVER_SESSION_SHARING_MATCH_MASK_SNI) || validate_sni(sm, iter->get_netvc())) &&
             (!(match_style & TS_SERVER_SESSION_SHARING_MATCH_MASK_HOSTSNISYNC) || validate_host_sni(sm, iter->get_netvc())) &&
             (!(match_style & TS_SERVER_SESSION_SHARING_MATCH_MASK_CERT) || validate_cert(sm, iter->get_netvc()))) {
@@ -209,8 +215,13 @@ ServerSessionPool::acquireSession(sockaddr const *addr, CryptoHash const &hostna
         }
         ++iter;
       }
-    } else if (iter != end) {
-      zret = HSM_DONE;
+    } else {
+      while (iter != end && !movable(*iter)) {
+        ++iter;
+      }
+      if (iter != end) {
+        zret = HSM_DONE;
+      }
     }
     if (zret == HSM_DONE) {
       to_return = &*iter;
@@ -395,10 +406,16 @@ HttpSessionManager::acquire_session(HttpSM *sm, sockaddr const *ip, const char *
 
   // Otherwise, check the thread pool first
   if (this->get_pool_type() == TS_SERVER_SESSION_SHARING_POOL_THREAD ||
-      this->get_pool_type() == TS_SERVER_SESSION_SHARING_POOL_HYBRID) {
+      this->get_pool_type() == TS_SERVER_SESSION_SHARING_POOL_HYBRID ||
+      this->get_pool_type() == TS_SERVER_SESSION_SHARING_POOL_STEAL) {
     retval = _acquire_session(ip, hostname_hash, sm, match_style, TS_SERVER_SESSION_SHARING_POOL_THREAD);
   }
 
+  // Then the pools of the other threads.
+  if (retval == HSM_NOT_FOUND && TS_SERVER_SESSION_SHARING_POOL_STEAL == this->get_pool_type()) {
+    retval = _steal_session(ip, hostname_hash, sm, match_style);
+  }
+
   //  If you didn't get a match, and the global pool is an option go there.
   if (retval != HSM_DONE) {
     if (TS_SERVER_SESSION_SHARING_POOL_GLOBAL == this->get_pool_type() ||
@@ -467,33 +484,9 @@ HttpSessionManager::_acquire_session(sockaddr const *ip, CryptoHash const &hostn
         Dbg(dbg_ctl_http_ss, "[acquire session] global pool search %s", to_return ? "successful" : "failed");
         // At this point to_return has been removed from the pool. Do we need to move it
         // to the same thread?
-        if (to_return) {
-          UnixNetVConnection *server_vc = dynamic_cast<UnixNetVConnection *>(to_return->get_netvc());
-          if (server_vc) {
-            // Disable i/o on this vc now, but, hold onto the g_pool cont
-            // and the mutex to stop any stray events from getting in
-            server_vc->do_io_read(m_g_pool, 0, nullptr);
-            server_vc->do_io_write(m_g_pool, 0, nullptr);
-            UnixNetVConnection *new_vc = server_vc->migrateToCurrentThread(sm, ethread);
-            // The VC moved, free up the original one
-            if (new_vc != server_vc) {
-              ink_assert(new_vc == nullptr || new_vc->nh != nullptr);
-              if (!new_vc) {
-                // Close out to_return, we were't able to get a connection
-                Metrics::Counter::increment(http_rsb.origin_shutdown_migration_failure);
-                to_return->do_io_close();
-                to_return = nullptr;
-                retval    = HSM_NOT_FOUND;
-              } else {
-                // Keep things from timing out on us
-                new_vc->set_inactivity_timeout(new_vc->get_inactivity_timeout());
-                to_return->set_netvc(new_vc);
-              }
-            } else {
-              // Keep things from timing out on us
-              server_vc->set_inactivity_timeout(server_vc->get_inactivity_timeout());
-            }
-          }
+        if (to_return && !_migrate_session(to_return, m_g_pool, sm, ethread)) {
+          to_return = nullptr;
+          retval    = HSM_NOT_FOUND;
         }
       }
     } else { // Didn't get the lock.  to_return is still NULL
@@ -524,13 +517,101 @@ HttpSessionManager::_acquire_session(sockaddr const *ip, CryptoHash const &hostn
   return retval;
 }
 
+bool
+HttpSessionManager::_migrate_session(PoolableSession *ssn, ServerSessionPool *pool, HttpSM *sm, EThread *ethread)
+{
+  UnixNetVConnection *server_vc = dynamic_cast<UnixNetVConnection *>(ssn->get_netvc());
+  if (server_vc) {
+    // Disable i/o on this vc now, but, hold onto the pool cont
+    // and the mutex to stop any stray events from getting in
+    server_vc->do_io_read(pool, 0, nullptr);
+    server_vc->do_io_write(pool, 0, nullptr);
+    UnixNetVConnection *new_vc = server_vc->migrateToCurrentThread(sm, ethread);
+    // The VC moved, free up the original one
+    if (new_vc != server_vc) {
+      ink_assert(new_vc == nullptr || new_vc->nh != nullptr);
+      if (!new_vc) {
+        // Close out ssn, we were't able to get a connection
+        Metrics::Counter::increment(http_rsb.origin_shutdown_migration_failure);
+        ssn->do_io_close();
+        return false;
+      }
+      // Keep things from timing out on us
+      new_vc->set_inactivity_timeout(new_vc->get_inactivity_timeout());
+      ssn->set_netvc(new_vc);
+    } else {
+      // Keep things from timing out on us
+      server_vc->set_inactivity_timeout(server_vc->get_inactivity_timeout());
+    }
+  }
+  return true;
+}
+
+// Look for a session in the pools of the other net threads. The pools are try locked so that a busy thread is passed
+// over rather than waited for, and the stolen session is moved to this thread the way a session from the global pool is.
+HSMresult_t
+HttpSessionManager::_steal_session(sockaddr const *ip, CryptoHash const &hostname_hash, HttpSM *sm,
+                                   TSServerSessionSharingMatchMask match_style)
+{
+  // Where the next search starts, so that the threads do not all go to the same sibling first.
+  static thread_local unsigned int next_victim = 0;
+
+  EThread    *ethread = this_ethread();
+  auto const &group   = eventProcessor.thread_group[ET_NET];
+  unsigned    start   = next_victim++;
+
+  for (int i = 0; i < group._count; ++i) {
+    EThread           *victim = group._thread[(start + i) % group._count];
+    ServerSessionPool *pool   = victim->server_session_pool;
+
+    if (victim == ethread || pool == nullptr || pool->idle() == 0) {
+      continue;
+    }
+
+    // Hold the lock until the session is attached to the SM, as in _acquire_session.
+    MUTEX_TRY_LOCK(lock, pool->mutex, ethread);
+    if (!lock.is_locked()) {
+      Metrics::Counter::increment(http_rsb.pool_steal_lock_contention);
+      continue;
+    }
+
+    PoolableSession *to_return = nullptr;
+    // The sessions that cannot move here, multiplexed ones included, are passed over and stay in their pool.
+    if (pool->acquireSession(ip, hostname_hash, match_style, sm, to_return, true) != HSM_DONE) {
+      continue;
+    }
+    Metrics::Gauge::decrement(http_rsb.pooled_server_connections);
+    if (!_migrate_session(to_return, pool, sm, ethread)) {
+      continue;
+    }
+    Metrics::Counter::increment(http_rsb.pool_steals);
+    Dbg(dbg_ctl_http_ss, "[%" PRId64 "] [acquire session] stole session from thread %p", to_return->connection_id(), victim);
+
+    if (sm->create_server_txn(to_return)) {
+      to_return->state = PoolableSession::SSN_IN_USE;
+      Metrics::Counter::increment(http_rsb.pool_steal_origins_saved);
+      return HSM_DONE;
+    }
+    Dbg(dbg_ctl_http_ss, "[%" PRId64 "] [acquire session] failed to get transaction on stolen session", to_return->connection_id());
+    to_return->do_io_close();
+    return HSM_RETRY;
+  }
+
+  Metrics::Counter::increment(http_rsb.pool_steal_misses);
+  return HSM_NOT_FOUND;
+}
+
 HSMresult_t
 HttpSessionManager::release_session(PoolableSession *to_release)
 {
-  EThread           *ethread = this_ethread();
-  ServerSessionPool *pool =
-    TS_SERVER_SESSION_SHARING_POOL_THREAD == to_release->sharing_pool ? ethread->server_session_pool : m_g_pool;
-  bool released_p = true;
+  EThread           *ethread    = this_ethread();
+  ServerSessionPool *pool       = m_g_pool;
+  bool               released_p = true;
+
+  if (TS_SERVER_SESSION_SHARING_POOL_THREAD == to_release->sharing_pool ||
+      TS_SERVER_SESSION_SHARING_POOL_STEAL == to_release->sharing_pool) {
+    pool = ethread->server_session_pool;
+  }
 
   // The per thread lock looks like it should not be needed but if it's not locked the close checking I/O op will crash.
 
@@ -572,6 +653,7 @@ ServerSessionPool::removeSession(PoolableSession *to_remove)
   }
   m_fqdn_pool.erase(to_remove);
   m_ip_pool.erase(to_remove);
+  m_idle.fetch_sub(1, std::memory_order_relaxed);
   if (dbg_ctl_http_ss.on()) {
     Dbg(dbg_ctl_http_ss, "After Remove session %p m_fqdn_pool size=%zu m_ip_pool_size=%zu", to_remove, m_fqdn_pool.count(),
         m_ip_pool.count());
@@ -586,6 +668,7 @@ ServerSessionPool::addSession(PoolableSession *ss)
   // put it in the pools.
   m_ip_pool.insert(ss);
   m_fqdn_pool.insert(ss);
+  m_idle.fetch_add(1, std::memory_order_relaxed);
 
   if (dbg_ctl_http_ss.on()) {
     char peer_ip[INET6_ADDRPORTSTRLEN];
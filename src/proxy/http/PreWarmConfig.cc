@@ -24,6 +24,8 @@
 #include "proxy/http/PreWarmConfig.h"
 #include "proxy/http/PreWarmManager.h"
 
+#include <algorithm>
+
 ////
 // PreWarmConfigParams
 //
@@ -35,6 +37,11 @@ PreWarmConfigParams::PreWarmConfigParams()
   // RECU_DYNAMIC
   REC_ReadConfigInteger(event_period, "proxy.config.tunnel.prewarm.event_period");
   REC_ReadConfigInteger(algorithm, "proxy.config.tunnel.prewarm.algorithm");
+  REC_ReadConfigInteger(max_connections, "proxy.config.tunnel.prewarm.max_connections");
+  REC_ReadConfigFloat(demand_alpha, "proxy.config.tunnel.prewarm.demand_alpha");
+  REC_ReadConfigInteger(discover_threshold, "proxy.config.tunnel.prewarm.discover_threshold");
+
+  demand_alpha = std::clamp(demand_alpha, 0.01f, 1.0f);
 }
 
 ////
@@ -48,6 +55,9 @@ PreWarmConfig::startup()
   // dynamic configs
   _config_update_handler->attach("proxy.config.tunnel.prewarm.event_period");
   _config_update_handler->attach("proxy.config.tunnel.prewarm.algorithm");
+  _config_update_handler->attach("proxy.config.tunnel.prewarm.max_connections");
+  _config_update_handler->attach("proxy.config.tunnel.prewarm.demand_alpha");
+  _config_update_handler->attach("proxy.config.tunnel.prewarm.discover_threshold");
 
   reconfigure();
 }
@@ -102,6 +102,8 @@ constexpr std::string_view COUNTER_STAT_ENTRIES[] = {
   "total_handshake_time"sv,
   "total_handshake_count"sv,
   "total_retry"sv,
+  "total_predicted"sv,
+  "total_handshake_time_saved"sv,
 };
 
 constexpr std::string_view GAUGE_STAT_ENTRIES[] = {
@@ -110,6 +112,24 @@ constexpr std::string_view GAUGE_STAT_ENTRIES[] = {
 };
 // clang-format on
 
+Metrics::Counter::AtomicType *discovered_pools_stat = nullptr;
+Metrics::Counter::AtomicType *budget_exhausted_stat = nullptr;
+
+// A candidate whose predicted demand falls below this is forgotten
+constexpr double CANDIDATE_FORGET_DEMAND = 0.05;
+// Bound of the candidates of a thread
+constexpr size_t MAX_CANDIDATES = 1024;
+
+/**
+   Whether the authority of a tunnel_route depends on the inbound connection, e.g. "$1.example.com:443" or
+   "example.com:{inbound_local_port}".
+ */
+bool
+is_dynamic_authority(std::string_view authority)
+{
+  return authority.find_first_of("${") != std::string_view::npos;
+}
+
 } // namespace
 
 ////
@@ -512,6 +532,12 @@ PreWarmSM::has_data_from_origin_server() const
   return _read_buf_reader->is_read_avail_more_than(0);
 }
 
+ink_hrtime
+PreWarmSM::handshake_time() const
+{
+  return _milestones.elapsed(Milestone::INIT, Milestone::ESTABLISHED);
+}
+
 bool
 PreWarmSM::is_active_timeout_expired(ink_hrtime now)
 {
@@ -661,13 +687,7 @@ PreWarmQueue::~PreWarmQueue()
   _tick_event = nullptr;
 
   for (auto &e : _map) {
-    Info info = e.second;
-
-    _make_queue_empty(info.init_list);
-    delete info.init_list;
-
-    _make_queue_empty(info.open_list);
-    delete info.open_list;
+    _delete_pool(e.second);
   }
 
   this->mutex = nullptr;
@@ -709,6 +729,14 @@ PreWarmQueue::state_running(int event, void * /* data ATS_UNUSED */)
       _delete_closed_sm(info.init_list);
       _delete_closed_sm(info.open_list);
 
+      auto &[counters, gauges] = *info.stats_ids;
+
+      // predict the demand of next period, the prediction for this period is recorded to compare with hit + miss
+      if (_algorithm == PreWarm::Algorithm::V3) {
+        ts::Metrics::Counter::increment(counters[static_cast<int>(PreWarm::CounterStat::PREDICTED)], std::lround(info.demand));
+        info.demand = PreWarm::predict_demand(info.demand, info.stat.hit + info.stat.miss, _demand_alpha);
+      }
+
       // pre-warm new connections
       _prewarm_on_event_interval(dst, info);
 
@@ -717,8 +745,6 @@ PreWarmQueue::state_running(int event, void * /* data ATS_UNUSED */)
           dst->host.data(), dst->port, (int)dst->type, dst->alpn_index, info.stat.miss, info.stat.hit, (int)info.init_list->size(),
           (int)info.open_list->size());
 
-      auto &[counters, gauges] = *info.stats_ids;
-
       ts::Metrics::Gauge::store(gauges[static_cast<int>(PreWarm::GaugeStat::INIT_LIST_SIZE)], info.init_list->size());
       ts::Metrics::Gauge::store(gauges[static_cast<int>(PreWarm::GaugeStat::OPEN_LIST_SIZE)], info.open_list->size());
       ts::Metrics::Counter::increment(counters[static_cast<int>(PreWarm::CounterStat::HIT)], info.stat.hit);
@@ -728,6 +754,11 @@ PreWarmQueue::state_running(int event, void * /* data ATS_UNUSED */)
       info.stat.miss = 0;
       info.stat.hit  = 0;
     }
+
+    if (_algorithm == PreWarm::Algorithm::V3) {
+      _drop_idle_discovered_pools();
+      _update_candidates();
+    }
     break;
   }
   case EVENT_IMMEDIATE: {
@@ -779,7 +810,8 @@ PreWarmQueue::dequeue(const PreWarm::SPtrConstDst &target)
 
   auto res = _map.find(target);
   if (res == _map.end()) {
-    // no such pool
+    // no such pool, it might be a destination of a dynamic route
+    _discover(target);
     return nullptr;
   }
 
@@ -793,6 +825,7 @@ PreWarmQueue::dequeue(const PreWarm::SPtrConstDst &target)
 
     if (sm->handler == &PreWarmSM::state_open) {
       _cop_list.remove(sm);
+      --_size;
       break;
     }
 
@@ -805,6 +838,9 @@ PreWarmQueue::dequeue(const PreWarm::SPtrConstDst &target)
     ++info.stat.miss;
   } else {
     ++info.stat.hit;
+
+    auto &[counters, _] = *info.stats_ids;
+    ts::Metrics::Counter::increment(counters[static_cast<int>(PreWarm::CounterStat::HANDSHAKE_TIME_SAVED)], sm->handshake_time());
   }
 
   _prewarm_on_dequeue(dst, info);
@@ -821,6 +857,7 @@ PreWarmQueue::_new_prewarm_sm(const PreWarm::SPtrConstDst &dst, const PreWarm::S
   PreWarmSM *sm = THREAD_ALLOC(preWarmSMAllocator, ethread);
   new (sm) PreWarmSM(dst, conf, stats_ids);
   _cop_list.push(sm);
+  ++_size;
 
   _map[dst].init_list->push_back(sm);
 
@@ -834,6 +871,7 @@ PreWarmQueue::_delete_prewarm_sm(PreWarmSM *sm)
   ink_release_assert(sm->handler == &PreWarmSM::state_closed);
 
   _cop_list.remove(sm);
+  --_size;
 
   sm->destroy();
   THREAD_FREE(sm, preWarmSMAllocator, this_ethread());
@@ -846,6 +884,9 @@ PreWarmQueue::_delete_prewarm_sm(PreWarmSM *sm)
 
    V1: Expand the pool size to requested size
    V2: Expand the pool size to current size + miss * rate
+   V3: Expand the pool size to predicted demand * rate
+
+   The connections of all the pools are bound by the budget.
  */
 void
 PreWarmQueue::_prewarm_on_event_interval(const PreWarm::SPtrConstDst &dst, const Info &info)
@@ -859,6 +900,10 @@ PreWarmQueue::_prewarm_on_event_interval(const PreWarm::SPtrConstDst &dst, const
                                                    info.conf->rate);
     break;
   }
+  case PreWarm::Algorithm::V3: {
+    n = PreWarm::prewarm_size_v3_on_event_interval(info.demand, current_size, info.conf->min, info.conf->max, info.conf->rate);
+    break;
+  }
   case PreWarm::Algorithm::V1:
     [[fallthrough]];
   default:
@@ -866,6 +911,11 @@ PreWarmQueue::_prewarm_on_event_interval(const PreWarm::SPtrConstDst &dst, const
     break;
   }
 
+  if (uint32_t allowed = PreWarm::prewarm_size_within_budget(n, _size, _budget); allowed < n) {
+    ts::Metrics::Counter::increment(budget_exhausted_stat, n - allowed);
+    n = allowed;
+  }
+
   Dbg(dbg_ctl_v_prewarm_q, "prewarm_size=%" PRId32, n);
 
   for (uint32_t i = 0; i < n; ++i) {
@@ -877,16 +927,22 @@ PreWarmQueue::_prewarm_on_event_interval(const PreWarm::SPtrConstDst &dst, const
    Event based pre-warming
 
    V1: Do nothing
-   V2: Start pre-warming a new netvc
+   V2, V3: Start pre-warming a new netvc
  */
 void
 PreWarmQueue::_prewarm_on_dequeue(const PreWarm::SPtrConstDst &dst, const Info &info)
 {
   switch (_algorithm) {
-  case PreWarm::Algorithm::V2: {
+  case PreWarm::Algorithm::V2:
+  case PreWarm::Algorithm::V3: {
     const int32_t current_size = info.init_list->size() + info.open_list->size();
-    if (current_size < info.conf->max) {
-      _new_prewarm_sm(dst, info.conf, info.stats_ids);
+    // v3 takes the max of -1 as unlimited here too
+    if (current_size < info.conf->max || (_algorithm == PreWarm::Algorithm::V3 && info.conf->max < 0)) {
+      if (PreWarm::prewarm_size_within_budget(1, _size, _budget) == 0) {
+        ts::Metrics::Counter::increment(budget_exhausted_stat);
+      } else {
+        _new_prewarm_sm(dst, info.conf, info.stats_ids);
+      }
     }
     break;
   }
@@ -907,8 +963,16 @@ PreWarmQueue::_reconfigure()
   {
     PreWarmConfig::scoped_config prewarm_conf;
 
-    _event_period = HRTIME_MSECONDS(prewarm_conf->event_period);
-    _algorithm    = PreWarm::algorithm_version(prewarm_conf->algorithm);
+    _event_period       = HRTIME_MSECONDS(prewarm_conf->event_period);
+    _algorithm          = PreWarm::algorithm_version(prewarm_conf->algorithm);
+    _demand_alpha       = prewarm_conf->demand_alpha;
+    _discover_threshold = std::max<int64_t>(prewarm_conf->discover_threshold, 0);
+
+    // the budget is shared by the threads evenly
+    _budget = 0;
+    if (prewarm_conf->max_connections > 0) {
+      _budget = std::max<int64_t>(prewarm_conf->max_connections / eventProcessor.thread_group[ET_NET]._count, 1);
+    }
   }
 
   // build new map based on new SNIConfig
@@ -941,26 +1005,131 @@ PreWarmQueue::_reconfigure()
     }
   }
 
+  // keep the discovered pools while discovery is on, the dynamic route of each is assumed to be still there
+  _dynamic_routes = prewarmManager.get_dynamic_routes();
+  if (_algorithm == PreWarm::Algorithm::V3 && _discover_threshold > 0 && !_dynamic_routes.empty()) {
+    for (auto &[dst, info] : _map) {
+      if (info.discovered && new_map.find(dst) == new_map.end()) {
+        new_map[dst] = info;
+      }
+    }
+  } else {
+    _candidates.clear();
+  }
+
   // free unexisting entries
   for (auto &[dst, info] : _map) {
-    if (auto entry = new_conf_list.find(dst); entry == new_conf_list.end()) {
-      auto &[_, gauges] = *info.stats_ids;
+    if (auto entry = new_map.find(dst); entry == new_map.end()) {
+      _delete_pool(info);
+    }
+  }
+
+  std::swap(_map, new_map);
+}
+
+/**
+   Delete the queues of a pool that is gone
+ */
+void
+PreWarmQueue::_delete_pool(Info &info)
+{
+  auto &[_, gauges] = *info.stats_ids;
+
+  ts::Metrics::Gauge::store(gauges[static_cast<int>(PreWarm::GaugeStat::INIT_LIST_SIZE)], 0);
+  ts::Metrics::Gauge::store(gauges[static_cast<int>(PreWarm::GaugeStat::OPEN_LIST_SIZE)], 0);
+
+  _make_queue_empty(info.init_list);
+  delete info.init_list;
+
+  _make_queue_empty(info.open_list);
+  delete info.open_list;
+
+  info.conf.reset();
+  info.stats_ids.reset();
+}
+
+/**
+   Count a request to a destination without a pool, if it is one of a dynamic route
+ */
+void
+PreWarmQueue::_discover(const PreWarm::SPtrConstDst &dst)
+{
+  if (_algorithm != PreWarm::Algorithm::V3 || _discover_threshold == 0) {
+    return;
+  }
 
-      ts::Metrics::Gauge::store(gauges[static_cast<int>(PreWarm::GaugeStat::INIT_LIST_SIZE)], 0);
-      ts::Metrics::Gauge::store(gauges[static_cast<int>(PreWarm::GaugeStat::OPEN_LIST_SIZE)], 0);
+  if (auto res = _candidates.find(dst); res != _candidates.end()) {
+    ++res->second.requests;
+    return;
+  }
 
-      _make_queue_empty(info.init_list);
-      delete info.init_list;
+  if (_candidates.size() >= MAX_CANDIDATES) {
+    return;
+  }
 
-      _make_queue_empty(info.open_list);
-      delete info.open_list;
+  for (const auto &route : _dynamic_routes) {
+    if (route.match(dst)) {
+      _candidates[dst] = Candidate{route.conf, 1, 0};
+      return;
+    }
+  }
+}
 
-      info.conf.reset();
-      info.stats_ids.reset();
+/**
+   Predict the demand of the candidates, and make a pool for the ones whose demand reached the threshold
+ */
+void
+PreWarmQueue::_update_candidates()
+{
+  for (auto it = _candidates.begin(); it != _candidates.end();) {
+    const PreWarm::SPtrConstDst &dst       = it->first;
+    Candidate                   &candidate = it->second;
+
+    candidate.demand   = PreWarm::predict_demand(candidate.demand, candidate.requests, _demand_alpha);
+    candidate.requests = 0;
+
+    if (candidate.demand >= _discover_threshold) {
+      // the pool connects with the name of the destination, the SNI of the inbound connection is not known
+      auto conf = std::make_shared<PreWarm::Conf>(*candidate.conf);
+      conf->sni = dst->host;
+
+      Info info{new Queue(), new Queue(), conf, prewarmManager.make_stats_ids(dst), {}};
+      info.demand     = candidate.demand;
+      info.discovered = true;
+      _map[dst]       = info;
+
+      ts::Metrics::Counter::increment(discovered_pools_stat);
+      Dbg(dbg_ctl_prewarm, "discovered dst=%.*s:%d type=%d alpn=%d demand=%.2f", (int)dst->host.size(), dst->host.data(), dst->port,
+          (int)dst->type, dst->alpn_index, candidate.demand);
+
+      it = _candidates.erase(it);
+    } else if (candidate.demand < CANDIDATE_FORGET_DEMAND) {
+      it = _candidates.erase(it);
+    } else {
+      ++it;
     }
   }
+}
 
-  std::swap(_map, new_map);
+/**
+   Delete the discovered pools whose predicted demand fell to half of the threshold, they are discovered again if the
+   demand comes back
+ */
+void
+PreWarmQueue::_drop_idle_discovered_pools()
+{
+  for (auto it = _map.begin(); it != _map.end();) {
+    Info &info = it->second;
+
+    if (info.discovered && info.demand * 2 < _discover_threshold) {
+      Dbg(dbg_ctl_prewarm, "drop discovered dst=%.*s:%d demand=%.2f", (int)it->first->host.size(), it->first->host.data(),
+          it->first->port, info.demand);
+      _delete_pool(info);
+      it = _map.erase(it);
+    } else {
+      ++it;
+    }
+  }
 }
 
 /**
@@ -1020,6 +1189,9 @@ PreWarmManager::start()
 
   _mutex = new_ProxyMutex();
 
+  discovered_pools_stat = Metrics::Counter::createPtr("proxy.process.tunnel.prewarm.discovered_pools");
+  budget_exhausted_stat = Metrics::Counter::createPtr("proxy.process.tunnel.prewarm.budget_exhausted");
+
   this->reconfigure();
 }
 
@@ -1046,7 +1218,8 @@ PreWarmManager::reconfigure()
 
   if (is_prewarm_enabled) {
     _parsed_conf.clear();
-    _parse_sni_conf(_parsed_conf, sni_conf);
+    _dynamic_routes.clear();
+    _parse_sni_conf(_parsed_conf, _dynamic_routes, sni_conf);
     _register_stats(_parsed_conf);
 
     reconfigure_prewarming_on_threads();
@@ -1074,11 +1247,18 @@ PreWarmManager::get_stats_id_map() const
   return _stats_id_map;
 }
 
+const PreWarm::DynamicRoutes &
+PreWarmManager::get_dynamic_routes() const
+{
+  return _dynamic_routes;
+}
+
 /**
    Convert SNIConfigParams to PreWarm::ParsedSNIConf
  */
 void
-PreWarmManager::_parse_sni_conf(PreWarm::ParsedSNIConf &parsed_conf, const SNIConfigParams *sni_conf) const
+PreWarmManager::_parse_sni_conf(PreWarm::ParsedSNIConf &parsed_conf, PreWarm::DynamicRoutes &dynamic_routes,
+                                const SNIConfigParams *sni_conf) const
 {
   PreWarmConfig::scoped_config prewarm_conf;
 
@@ -1104,6 +1284,33 @@ PreWarmManager::_parse_sni_conf(PreWarm::ParsedSNIConf &parsed_conf, const SNICo
           item.tunnel_destination.c_str(), (int)item.tunnel_type, id, (int)item.tunnel_prewarm_min, (int)item.tunnel_prewarm_max,
           (int)item.tunnel_prewarm_connect_timeout, (int)item.tunnel_prewarm_inactive_timeout, item.tunnel_prewarm_srv);
 
+      // The destination is known from traffic only, keep the conf for the pools made on the fly.
+      if (is_dynamic_authority(item.tunnel_destination)) {
+        std::string_view authority = item.tunnel_destination;
+        int32_t          port      = item.tunnel_type == SNIRoutingType::PARTIAL_BLIND ? 443 : 80;
+
+        if (auto pos = authority.rfind(':'); pos != std::string_view::npos) {
+          port = is_dynamic_authority(authority.substr(pos + 1)) ? -1 : std::stoi(std::string(authority.substr(pos + 1)));
+        }
+
+        // clang-format off
+        PreWarm::SPtrConstConf conf = std::make_shared<const PreWarm::Conf>(
+          item.tunnel_prewarm_min,
+          item.tunnel_prewarm_max,
+          item.tunnel_prewarm_rate,
+          HRTIME_SECONDS(item.tunnel_prewarm_connect_timeout),
+          HRTIME_SECONDS(item.tunnel_prewarm_inactive_timeout),
+          item.tunnel_prewarm_srv,
+          item.verify_server_policy,
+          item.verify_server_properties,
+          ""
+        );
+        // clang-format on
+
+        dynamic_routes.push_back(PreWarm::DynamicRoute{port, item.tunnel_type, id, std::move(conf)});
+        continue;
+      }
+
       std::string dst_fqdn;
       int32_t     port;
       parse_authority(dst_fqdn, port, item.tunnel_destination);
@@ -1164,45 +1371,60 @@ PreWarmManager::_register_stats(const PreWarm::ParsedSNIConf &parsed_conf)
 
   for (auto &entry : parsed_conf) {
     const PreWarm::SPtrConstDst &dst = entry.first;
-    PreWarm::StatsIds            ids;
-    auto &[counters, gauges] = ids;
 
-    // First the Counters
-    for (int j = 0; j < static_cast<int>(PreWarm::CounterStat::LAST_ENTRY); ++j) {
-      char name[STAT_NAME_BUF_LEN];
+    _stats_id_map[dst] = _make_stats_ids(dst, stats_counter);
+  }
 
-      _makeName(dst, COUNTER_STAT_ENTRIES[j], name, sizeof(name));
+  Note("%d dynamic stats are registered for pre-warming tunnel", stats_counter);
+}
 
-      auto metric = Metrics::Counter::createPtr(name); // This will do a lookup if it already exists
+PreWarm::SPtrConstStatsIds
+PreWarmManager::make_stats_ids(const PreWarm::SPtrConstDst &dst) const
+{
+  int stats_counter = 0;
 
-      if (metric == nullptr) {
-        Error("couldn't register counter stat name=%s", name);
-      } else {
-        ++stats_counter;
-        counters[j] = metric;
-        Dbg(dbg_ctl_v_prewarm_init, "conter stat id=%d name=%s", Metrics::Counter::lookup(name), name);
-      }
-    }
+  return _make_stats_ids(dst, stats_counter);
+}
 
-    // Gauges next
-    for (int j = 0; j < static_cast<int>(PreWarm::GaugeStat::LAST_ENTRY); ++j) {
-      char name[STAT_NAME_BUF_LEN];
+PreWarm::SPtrConstStatsIds
+PreWarmManager::_make_stats_ids(const PreWarm::SPtrConstDst &dst, int &stats_counter) const
+{
+  PreWarm::StatsIds ids;
+  auto &[counters, gauges] = ids;
 
-      _makeName(dst, GAUGE_STAT_ENTRIES[j], name, sizeof(name));
+  // First the Counters
+  for (int j = 0; j < static_cast<int>(PreWarm::CounterStat::LAST_ENTRY); ++j) {
+    char name[STAT_NAME_BUF_LEN];
 
-      auto metric = Metrics::Gauge::createPtr(name); // This will do a lookup if it already exists
+    _makeName(dst, COUNTER_STAT_ENTRIES[j], name, sizeof(name));
 
-      if (metric == nullptr) {
-        Error("couldn't register gauge stat name=%s", name);
-      } else {
-        ++stats_counter;
-        gauges[j] = metric;
-        Dbg(dbg_ctl_v_prewarm_init, "gauge stat id=%d name=%s", Metrics::Gauge::lookup(name), name);
-      }
+    auto metric = Metrics::Counter::createPtr(name); // This will do a lookup if it already exists
+
+    if (metric == nullptr) {
+      Error("couldn't register counter stat name=%s", name);
+    } else {
+      ++stats_counter;
+      counters[j] = metric;
+      Dbg(dbg_ctl_v_prewarm_init, "conter stat id=%d name=%s", Metrics::Counter::lookup(name), name);
     }
+  }
+
+  // Gauges next
+  for (int j = 0; j < static_cast<int>(PreWarm::GaugeStat::LAST_ENTRY); ++j) {
+    char name[STAT_NAME_BUF_LEN];
+
+    _makeName(dst, GAUGE_STAT_ENTRIES[j], name, sizeof(name));
+
+    auto metric = Metrics::Gauge::createPtr(name); // This will do a lookup if it already exists
 
-    _stats_id_map[dst] = std::make_shared<const PreWarm::StatsIds>(ids);
+    if (metric == nullptr) {
+      Error("couldn't register gauge stat name=%s", name);
+    } else {
+      ++stats_counter;
+      gauges[j] = metric;
+      Dbg(dbg_ctl_v_prewarm_init, "gauge stat id=%d name=%s", Metrics::Gauge::lookup(name), name);
+    }
   }
 
-  Note("%d dynamic stats are registered for pre-warming tunnel", stats_counter);
+  return std::make_shared<const PreWarm::StatsIds>(ids);
 }
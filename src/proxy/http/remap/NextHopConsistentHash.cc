@@ -63,8 +63,12 @@ NextHopConsistentHash::chashLookup(const std::shared_ptr<ATSConsistentHash> &rin
   ATSConsistentHashIter *iter     = &result.chashIter[cur_ring];
 
   if (result.chash_init[cur_ring] == false) {
-    hash_key                    = getHashKey(sm_id, request_info, &hash);
-    host_rec                    = static_cast<HostRecord *>(ring->lookup_by_hashval(hash_key, iter, wrapped));
+    hash_key = getHashKey(sm_id, request_info, &hash);
+    if (load_factor > 0) {
+      host_rec = static_cast<HostRecord *>(ring->lookup_bounded(hash_key, load_factor, iter, wrapped));
+    } else {
+      host_rec = static_cast<HostRecord *>(ring->lookup_by_hashval(hash_key, iter, wrapped));
+    }
     result.chash_init[cur_ring] = true;
   } else {
     host_rec = static_cast<HostRecord *>(ring->lookup(nullptr, iter, wrapped, &hash));
@@ -83,6 +87,13 @@ NextHopConsistentHash::chashLookup(const std::shared_ptr<ATSConsistentHash> &rin
   }
 }
 
+std::shared_ptr<HostRecord>
+NextHopConsistentHash::hostLookup(uint32_t cur_ring, ParentResult &result, HttpRequestData &request_info, bool *wrapped,
+                                  uint64_t sm_id)
+{
+  return chashLookup(rings[cur_ring], cur_ring, result, request_info, wrapped, sm_id);
+}
+
 NextHopConsistentHash::~NextHopConsistentHash()
 {
   NH_Dbg(NH_DBG_CTL, "destructor called for strategy named: %s", strategy_name.c_str());
@@ -140,18 +151,40 @@ NextHopConsistentHash::NextHopConsistentHash(const std::string_view name, const
                                 "', this strategy will be ignored.");
   }
 
+  try {
+    if (n["load_factor"]) {
+      load_factor = n["load_factor"].as<float>();
+      if (load_factor != 0 && load_factor < 1) {
+        throw std::invalid_argument("load_factor must be 0 (disabled) or at least 1");
+      }
+    }
+  } catch (std::exception &ex) {
+    throw std::invalid_argument("Error parsing the strategy named '" + strategy_name + "' due to '" + ex.what() +
+                                "', this strategy will be ignored.");
+  }
+
+  // need to copy the 'hash_string' or 'hostname' cstring to 'name' for insertion into ATSConsistentHash.
+  for (auto &group : host_groups) {
+    for (auto &host : group) {
+      if (!host->hash_string.empty()) {
+        host->name = const_cast<char *>(host->hash_string.c_str());
+      } else {
+        host->name = const_cast<char *>(host->hostname.c_str());
+      }
+    }
+  }
+
+  // the other hash policies build their own lookup structures.
+  if (policy_type != NH_CONSISTENT_HASH) {
+    return;
+  }
+
   // load up the hash rings.
   for (uint32_t i = 0; i < groups; i++) {
     std::shared_ptr<ATSConsistentHash> hash_ring = std::make_shared<ATSConsistentHash>();
     for (uint32_t j = 0; j < host_groups[i].size(); j++) {
       // ATSConsistentHash needs the raw pointer.
-      HostRecord *p = host_groups[i][j].get();
-      // need to copy the 'hash_string' or 'hostname' cstring to 'name' for insertion into ATSConsistentHash.
-      if (!p->hash_string.empty()) {
-        p->name = const_cast<char *>(p->hash_string.c_str());
-      } else {
-        p->name = const_cast<char *>(p->hostname.c_str());
-      }
+      HostRecord *p  = host_groups[i][j].get();
       p->group_index = host_groups[i][j]->group_index;
       p->host_index  = host_groups[i][j]->host_index;
       hash_ring->insert(p, p->weight, &hash);
@@ -356,10 +389,9 @@ NextHopConsistentHash::findNextHop(TSHttpTxn txnp, void * /* ih ATS_UNUSED */, t
       }
 
       // search for available parent
-      std::shared_ptr<ATSConsistentHash> r = rings[cur_ring];
-      pRec                                 = chashLookup(r, cur_ring, result, request_info, &wrapped, sm_id);
-      hst                                  = (pRec) ? pStatus.getHostStatus(pRec->hostname.c_str()) : nullptr;
-      wrap_around[cur_ring]                = wrapped;
+      pRec                  = hostLookup(cur_ring, result, request_info, &wrapped, sm_id);
+      hst                   = (pRec) ? pStatus.getHostStatus(pRec->hostname.c_str()) : nullptr;
+      wrap_around[cur_ring] = wrapped;
       lookups++;
 
       // found a parent
@@ -453,7 +485,15 @@ NextHopConsistentHash::findNextHop(TSHttpTxn txnp, void * /* ih ATS_UNUSED */, t
   // Validate and return the final result.
   // ----------------------------------------------------------------------------------------------------
 
+  // Any previously selected parent is no longer in use by this transaction.
+  result.release_load();
+
   if (pRec && host_stat == TS_HOST_STATUS_UP && (pRec->available.load() || result.retry)) {
+    if (load_factor > 0) {
+      result.load_ring = rings[pRec->group_index].get();
+      result.load_node = pRec.get();
+      result.load_ring->acquire(result.load_node);
+    }
     result.result      = PARENT_SPECIFIED;
     result.hostname    = pRec->hostname.c_str();
     result.last_parent = pRec->host_index;
@@ -40,8 +40,8 @@ constexpr std::string_view peering_rings   = "peering_ring";
 constexpr std::string_view active_health_check  = "active";
 constexpr std::string_view passive_health_check = "passive";
 
-constexpr const char *policy_strings[] = {"NH_UNDEFINED", "NH_FIRST_LIVE", "NH_RR_STRICT",
-                                          "NH_RR_IP",     "NH_RR_LATCHED", "NH_CONSISTENT_HASH"};
+constexpr const char *policy_strings[] = {"NH_UNDEFINED",       "NH_FIRST_LIVE",  "NH_RR_STRICT", "NH_RR_IP", "NH_RR_LATCHED",
+                                          "NH_CONSISTENT_HASH", "NH_MAGLEV_HASH", "NH_JUMP_HASH"};
 
 NextHopSelectionStrategy::NextHopSelectionStrategy(const std::string_view &name, const NHPolicyType &policy, ts::Yaml::Map &n)
   : strategy_name(name), policy_type(policy)
@@ -251,9 +251,9 @@ NextHopSelectionStrategy::NextHopSelectionStrategy(const std::string_view &name,
         "ring mode '" + std::string(peering_rings) +
         "' requires two host groups (peering group and an upstream group), or a single peering group with go_direct");
     }
-    if (policy_type != NH_CONSISTENT_HASH) {
+    if (policy_type != NH_CONSISTENT_HASH && policy_type != NH_MAGLEV_HASH && policy_type != NH_JUMP_HASH) {
       throw std::invalid_argument("ring mode '" + std::string(peering_rings) +
-                                  "' is only implemented for a 'consistent_hash' policy");
+                                  "' is only implemented for the 'consistent_hash', 'maglev_hash' and 'jump_hash' policies");
     }
   }
 }
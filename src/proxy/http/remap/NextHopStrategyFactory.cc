@@ -29,6 +29,7 @@
 #include "proxy/http/remap/NextHopStrategyFactory.h"
 #include "proxy/http/remap/NextHopConsistentHash.h"
 #include "proxy/http/remap/NextHopRoundRobin.h"
+#include "proxy/http/remap/NextHopTableHash.h"
 #include <tsutil/YamlCfg.h>
 
 NextHopStrategyFactory::NextHopStrategyFactory(const char *file) : fn(file)
@@ -40,6 +41,8 @@ NextHopStrategyFactory::NextHopStrategyFactory(const char *file) : fn(file)
 
   // strategy policies.
   constexpr std::string_view consistent_hash = "consistent_hash";
+  constexpr std::string_view maglev_hash     = "maglev_hash";
+  constexpr std::string_view jump_hash       = "jump_hash";
   constexpr std::string_view first_live      = "first_live";
   constexpr std::string_view rr_strict       = "rr_strict";
   constexpr std::string_view rr_ip           = "rr_ip";
@@ -89,6 +92,10 @@ NextHopStrategyFactory::NextHopStrategyFactory(const char *file) : fn(file)
 
       if (policy_value == consistent_hash) {
         policy_type = NH_CONSISTENT_HASH;
+      } else if (policy_value == maglev_hash) {
+        policy_type = NH_MAGLEV_HASH;
+      } else if (policy_value == jump_hash) {
+        policy_type = NH_JUMP_HASH;
       } else if (policy_value == first_live) {
         policy_type = NH_FIRST_LIVE;
       } else if (policy_value == rr_strict) {
@@ -132,6 +139,7 @@ NextHopStrategyFactory::createStrategy(const std::string &name, const NHPolicyTy
   std::shared_ptr<NextHopSelectionStrategy> strat;
   std::shared_ptr<NextHopRoundRobin>        strat_rr;
   std::shared_ptr<NextHopConsistentHash>    strat_chash;
+  std::shared_ptr<NextHopTableHash>         strat_table;
 
   strat = strategyInstance(name.c_str());
   if (strat != nullptr) {
@@ -153,6 +161,11 @@ NextHopStrategyFactory::createStrategy(const std::string &name, const NHPolicyTy
       strat_chash = std::make_shared<NextHopConsistentHash>(name, policy_type, node);
       _strategies.emplace(std::make_pair(std::string(name), strat_chash));
       break;
+    case NH_MAGLEV_HASH:
+    case NH_JUMP_HASH:
+      strat_table = std::make_shared<NextHopTableHash>(name, policy_type, node);
+      _strategies.emplace(std::make_pair(std::string(name), strat_table));
+      break;
     default: // handles P_UNDEFINED, no strategy is added
       break;
     };
@@ -0,0 +1,104 @@
+/** @file
+
+  Implementation of the maglev and jump hash nexthop selection strategies.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include <yaml-cpp/yaml.h>
+
+#include "proxy/http/HttpSM.h"
+#include "tscore/HashSip.h"
+#include "tsutil/YamlCfg.h"
+#include "proxy/http/remap/NextHopTableHash.h"
+
+NextHopTableHash::NextHopTableHash(const std::string_view name, const NHPolicyType &policy, ts::Yaml::Map &n)
+  : NextHopConsistentHash(name, policy, n)
+{
+  ATSHash64Sip24 hash;
+
+  if (load_factor > 0) {
+    throw std::invalid_argument("Error parsing the strategy named '" + strategy_name +
+                                "' due to 'load_factor is only supported by the consistent_hash policy', this strategy will be "
+                                "ignored.");
+  }
+
+  try {
+    if (n["table_size"]) {
+      auto size = n["table_size"].as<uint32_t>();
+      if (size == 0) {
+        throw std::invalid_argument("table_size must be greater than 0");
+      }
+      table_size = ATSTableHash::next_prime(size);
+      if (table_size != size) {
+        NH_Note("'table_size' %u for the strategy named '%s' is not a prime, using %u.", size, strategy_name.c_str(), table_size);
+      }
+    }
+  } catch (std::exception &ex) {
+    throw std::invalid_argument("Error parsing the strategy named '" + strategy_name + "' due to '" + ex.what() +
+                                "', this strategy will be ignored.");
+  }
+
+  // load up the lookup tables, host names were set up by NextHopConsistentHash.
+  for (uint32_t i = 0; i < groups; i++) {
+    auto table = std::make_unique<ATSTableHash>(policy_type == NH_MAGLEV_HASH ? ATSTableHash::MAGLEV : ATSTableHash::JUMP,
+                                                table_size);
+    for (auto &host : host_groups[i]) {
+      table->insert(host.get(), host->weight, &hash);
+      NH_Dbg(NH_DBG_CTL, "Loading lookup tables - table: %d, host record: %d, name: %s, hostname: %s, strategy: %s", i,
+             host->host_index, host->name, host->hostname.c_str(), strategy_name.c_str());
+    }
+    table->build();
+    tables.push_back(std::move(table));
+  }
+}
+
+NextHopTableHash::~NextHopTableHash()
+{
+  NH_Dbg(NH_DBG_CTL, "destructor called for strategy named: %s", strategy_name.c_str());
+}
+
+// The first lookup in a group uses the hash of the request, retries step through the fallback
+// sequence of that hash. The position in the sequence is kept in the consistent hash iterator.
+std::shared_ptr<HostRecord>
+NextHopTableHash::hostLookup(uint32_t cur_ring, ParentResult &result, HttpRequestData &request_info, bool *wrapped,
+                             uint64_t sm_id)
+{
+  ATSHash64Sip24         hash;
+  ATSConsistentHashIter &attempt = result.chashIter[cur_ring];
+  ATSTableHash const    &table   = *tables[cur_ring];
+  uint64_t               hash_key;
+
+  if (result.chash_init[cur_ring] == false) {
+    attempt                     = 0;
+    result.chash_init[cur_ring] = true;
+  } else {
+    ++attempt;
+  }
+
+  hash_key       = getHashKey(sm_id, request_info, &hash);
+  auto *host_rec = static_cast<HostRecord *>(table.lookup_by_hashval(hash_key, attempt));
+  *wrapped       = attempt >= table.size();
+
+  if (host_rec == nullptr) {
+    *wrapped = true;
+    return nullptr;
+  }
+  return host_groups[host_rec->group_index][host_rec->host_index];
+}
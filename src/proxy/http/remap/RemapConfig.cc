@@ -36,6 +36,7 @@
 #include "tscore/Filenames.h"
 #include "proxy/IPAllow.h"
 #include "proxy/http/remap/PluginFactory.h"
+#include "api/PluginStats.h"
 
 #define modulePrefix "[ReverseProxy]"
 
@@ -940,10 +941,13 @@ remap_load_plugin(const char *const *argv, int argc, url_mapping *mp, char *errb
 
   RemapPluginInst *pi = nullptr;
   std::string      error;
+  // Continuations created by the plugin while it loads belong to it.
+  PluginStats *stats = PluginStats::get(c);
   {
     uint32_t elevate_access = 0;
     REC_ReadConfigInteger(elevate_access, "proxy.config.plugin.load_elevated");
-    ElevateAccess access(elevate_access ? ElevateAccess::FILE_PRIVILEGE : 0);
+    ElevateAccess      access(elevate_access ? ElevateAccess::FILE_PRIVILEGE : 0);
+    PluginStats::Scope scope(stats);
 
     pi = rewrite->pluginFactory.getRemapPlugin(swoc::file::path(const_cast<const char *>(c)), parc, pargv, error,
                                                isPluginDynamicReloadEnabled());
@@ -954,6 +958,7 @@ remap_load_plugin(const char *const *argv, int argc, url_mapping *mp, char *errb
     snprintf(errbuf, errbufsize, "%s", error.c_str());
     result = false;
   } else {
+    pi->_stats = stats;
     mp->add_plugin_instance(pi);
   }
 
@@ -23,6 +23,7 @@
  */
 
 #include "proxy/http/remap/RemapPlugins.h"
+#include "api/PluginStats.h"
 
 namespace
 {
@@ -60,7 +61,10 @@ RemapPlugins::run_plugin(RemapPluginInst *plugin)
   }
 
   HttpTransact::milestone_start_api_time(_s);
-  plugin_retcode = plugin->doRemap(reinterpret_cast<TSHttpTxn>(_s->state_machine), &rri);
+  {
+    PluginStats::Timer timer(plugin->_stats, PluginStats::REMAP_SLOT);
+    plugin_retcode = plugin->doRemap(reinterpret_cast<TSHttpTxn>(_s->state_machine), &rri);
+  }
   HttpTransact::milestone_update_api_time(_s);
 
   // TODO: Deal with negative return codes here
@@ -670,3 +670,69 @@ SCENARIO("Testing NextHopConsistentHash using a peering ring_mode.")
     }
   }
 }
+
+SCENARIO("Testing NextHopConsistentHash with bounded loads", "[NextHopConsistentHash]")
+{
+  // We need this to build a HdrHeap object in build_request();
+  // No thread setup, forbid use of thread local allocators.
+  cmd_disable_pfreelist = true;
+  // Get all of the HTTP WKS items populated.
+  http_init();
+
+  GIVEN("Loading the consistent-hash-tests.yaml config for 'consistent_hash' tests.")
+  {
+    std::shared_ptr<NextHopSelectionStrategy> strategy;
+    NextHopStrategyFactory                    nhf(TS_SRC_DIR "/consistent-hash-tests.yaml");
+    strategy = nhf.strategyInstance("bounded-load");
+
+    WHEN("the config is loaded.")
+    {
+      THEN("then testing consistent hash.")
+      {
+        REQUIRE(nhf.strategies_loaded == true);
+        REQUIRE(strategy != nullptr);
+        REQUIRE(strategy->groups == 1);
+        REQUIRE(static_cast<NextHopConsistentHash *>(strategy.get())->load_factor == 1.0);
+      }
+    }
+
+    WHEN("concurrent requests for the same path are received.")
+    {
+      THEN("a loaded host is passed over until its load is released.")
+      {
+        HttpSM        sm1, sm2, sm3;
+        ParentResult *result1 = &sm1.t_state.parent_result;
+        ParentResult *result2 = &sm2.t_state.parent_result;
+        ParentResult *result3 = &sm3.t_state.parent_result;
+
+        // With two hosts and a load factor of 1, the second concurrent request has to
+        // go to the other host.
+        build_request(30001, &sm1, nullptr, "rabbit.net", nullptr);
+        result1->reset();
+        strategy->findNextHop(reinterpret_cast<TSHttpTxn>(&sm1));
+        REQUIRE(result1->result == ParentResultType::PARENT_SPECIFIED);
+        std::string first = result1->hostname;
+
+        build_request(30002, &sm2, nullptr, "rabbit.net", nullptr);
+        result2->reset();
+        strategy->findNextHop(reinterpret_cast<TSHttpTxn>(&sm2));
+        REQUIRE(result2->result == ParentResultType::PARENT_SPECIFIED);
+        CHECK(first != result2->hostname);
+
+        // Once the first transaction is done, its host is the preferred choice again.
+        result1->reset();
+        build_request(30003, &sm3, nullptr, "rabbit.net", nullptr);
+        result3->reset();
+        strategy->findNextHop(reinterpret_cast<TSHttpTxn>(&sm3));
+        REQUIRE(result3->result == ParentResultType::PARENT_SPECIFIED);
+        CHECK(first == result3->hostname);
+
+        result2->reset();
+        result3->reset();
+        br_destroy(sm1);
+        br_destroy(sm2);
+        br_destroy(sm3);
+      }
+    }
+  }
+}
@@ -0,0 +1,183 @@
+/** @file
+
+  Unit tests for the NextHopTableHash.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+
+  @section details Details
+
+  Unit testing the NextHopTableHash class.
+
+ */
+
+#define CATCH_CONFIG_MAIN /* include main function */
+
+#include <catch.hpp> /* catch unit-test framework */
+#include <yaml-cpp/yaml.h>
+
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "proxy/http/HttpSM.h"
+#include "nexthop_test_stubs.h"
+#include "proxy/http/remap/NextHopSelectionStrategy.h"
+#include "proxy/http/remap/NextHopStrategyFactory.h"
+#include "proxy/http/remap/NextHopTableHash.h"
+
+#include "proxy/hdrs/HTTP.h"
+extern int cmd_disable_pfreelist;
+
+namespace
+{
+constexpr int PATHS = 2000;
+
+// first choice for each of PATHS request paths.
+std::vector<std::string>
+select_parents(NextHopSelectionStrategy &strategy, HttpSM &sm)
+{
+  ParentResult            *result = &sm.t_state.parent_result;
+  std::vector<std::string> chosen;
+  time_t                   now = time(nullptr) - 1; ///< make sure down hosts are not retryable
+
+  for (int i = 0; i < PATHS; ++i) {
+    std::string path = "asset/" + std::to_string(i);
+
+    build_request(40000 + i, &sm, nullptr, "rabbit.net", nullptr);
+    sm.t_state.request_data.hdr->url_get()->path_set(path.data(), path.size());
+    result->reset();
+    strategy.findNextHop(reinterpret_cast<TSHttpTxn>(&sm), nullptr, now);
+    REQUIRE(result->result == ParentResultType::PARENT_SPECIFIED);
+    chosen.emplace_back(result->hostname);
+  }
+  return chosen;
+}
+} // namespace
+
+SCENARIO("Testing NextHopTableHash class, using policies 'maglev_hash' and 'jump_hash'", "[NextHopTableHash]")
+{
+  // We need this to build a HdrHeap object in build_request();
+  // No thread setup, forbid use of thread local allocators.
+  cmd_disable_pfreelist = true;
+  // Get all of the HTTP WKS items populated.
+  http_init();
+
+  GIVEN("Loading the table-hash-tests.yaml config for 'maglev_hash' and 'jump_hash' tests.")
+  {
+    NextHopStrategyFactory nhf(TS_SRC_DIR "/table-hash-tests.yaml");
+
+    WHEN("the config is loaded.")
+    {
+      THEN("then the strategies are created.")
+      {
+        REQUIRE(nhf.strategies_loaded == true);
+
+        auto maglev = nhf.strategyInstance("maglev-hash-1");
+        REQUIRE(maglev != nullptr);
+        CHECK(maglev->policy_type == NH_MAGLEV_HASH);
+        CHECK(maglev->groups == 1);
+        // rounded up to a prime.
+        CHECK(static_cast<NextHopTableHash *>(maglev.get())->table_size == 1009);
+
+        auto jump = nhf.strategyInstance("jump-hash-1");
+        REQUIRE(jump != nullptr);
+        CHECK(jump->policy_type == NH_JUMP_HASH);
+        CHECK(jump->groups == 1);
+
+        // bounded loads are only supported by consistent_hash.
+        CHECK(nhf.strategyInstance("maglev-hash-bounded") == nullptr);
+      }
+    }
+
+    for (auto const *name : {"maglev-hash-1", "jump-hash-1"}) {
+      WHEN(std::string("requests for many paths are received by ") + name)
+      {
+        THEN("the requests are balanced, and a down host only moves its own requests.")
+        {
+          HttpSM sm;
+          auto   strategy = nhf.strategyInstance(name);
+          REQUIRE(strategy != nullptr);
+
+          auto                       before = select_parents(*strategy, sm);
+          std::map<std::string, int> counts;
+          for (auto const &host : before) {
+            counts[host]++;
+          }
+          REQUIRE(counts.size() == 4);
+          for (auto const &[host, count] : counts) {
+            CHECK(count > PATHS / 4 * 0.8);
+            CHECK(count < PATHS / 4 * 1.2);
+          }
+
+          // take the host with the most requests down.
+          auto        most = std::max_element(counts.begin(), counts.end(), [](auto &a, auto &b) { return a.second < b.second; });
+          std::string down = most->first;
+          strategy->markNextHop(reinterpret_cast<TSHttpTxn>(&sm), down.c_str(), 80, NH_MARK_DOWN);
+
+          auto                  after = select_parents(*strategy, sm);
+          std::set<std::string> moved_to;
+          for (int i = 0; i < PATHS; ++i) {
+            if (before[i] == down) {
+              CHECK(after[i] != down);
+              moved_to.insert(after[i]);
+            } else {
+              // requests for the hosts that are up do not move.
+              CHECK(after[i] == before[i]);
+            }
+          }
+          // the requests of the down host are spread over all the others.
+          CHECK(moved_to.size() == 3);
+
+          br_destroy(sm);
+        }
+      }
+
+      WHEN(std::string("a request is retried by ") + name)
+      {
+        THEN("every host is tried once before failing.")
+        {
+          HttpSM                sm;
+          ParentResult         *result = &sm.t_state.parent_result;
+          TSHttpTxn             txnp   = reinterpret_cast<TSHttpTxn>(&sm);
+          time_t                now    = time(nullptr) - 1; ///< make sure down hosts are not retryable
+          std::set<std::string> tried;
+          auto                  strategy = nhf.strategyInstance(name);
+          REQUIRE(strategy != nullptr);
+
+          build_request(50001, &sm, nullptr, "rabbit.net", nullptr);
+          result->reset();
+          for (int i = 0; i < 4; ++i) {
+            strategy->findNextHop(txnp, nullptr, now);
+            REQUIRE(result->result == ParentResultType::PARENT_SPECIFIED);
+            tried.insert(result->hostname);
+            strategy->markNextHop(txnp, result->hostname, result->port, NH_MARK_DOWN);
+          }
+          CHECK(tried.size() == 4);
+
+          strategy->findNextHop(txnp, nullptr, now);
+          CHECK(result->result == ParentResultType::PARENT_FAIL);
+          CHECK(result->hostname == nullptr);
+
+          br_destroy(sm);
+        }
+      }
+    }
+  }
+}
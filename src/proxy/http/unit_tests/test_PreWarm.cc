@@ -219,4 +219,54 @@ TEST_CASE("PreWarm Algorithm", "[prewarm]")
       }
     }
   }
+  SECTION("predict_demand")
+  {
+    CHECK(PreWarm::predict_demand(0, 10, 1.0) == Approx(10));
+    CHECK(PreWarm::predict_demand(10, 0, 1.0) == Approx(0));
+    CHECK(PreWarm::predict_demand(10, 20, 0.5) == Approx(15));
+    CHECK(PreWarm::predict_demand(10, 10, 0.3) == Approx(10));
+
+    // converges to a steady rate
+    double demand = 0;
+    for (int i = 0; i < 50; ++i) {
+      demand = PreWarm::predict_demand(demand, 8, 0.3);
+    }
+    CHECK(demand == Approx(8).epsilon(0.001));
+  }
+
+  SECTION("prewarm_size_v3_on_event_interval")
+  {
+    SECTION("{min, max} = {10, 100}")
+    {
+      const uint32_t min = 10;
+      const uint32_t max = 100;
+
+      CHECK(PreWarm::prewarm_size_v3_on_event_interval(0, 0, min, max, 1.0) == min);
+      CHECK(PreWarm::prewarm_size_v3_on_event_interval(20, 0, min, max, 1.0) == 20);
+      CHECK(PreWarm::prewarm_size_v3_on_event_interval(19.6, 5, min, max, 1.0) == 15);
+      CHECK(PreWarm::prewarm_size_v3_on_event_interval(20, 5, min, max, 1.5) == 25);
+      CHECK(PreWarm::prewarm_size_v3_on_event_interval(20, 30, min, max, 1.0) == 0);
+      CHECK(PreWarm::prewarm_size_v3_on_event_interval(500, 50, min, max, 1.0) == 50);
+    }
+
+    SECTION("{min, max} = {0, -1}")
+    {
+      const uint32_t min = 0;
+      const int32_t  max = -1;
+
+      CHECK(PreWarm::prewarm_size_v3_on_event_interval(0, 0, min, max, 1.0) == 0);
+      CHECK(PreWarm::prewarm_size_v3_on_event_interval(0.4, 0, min, max, 1.0) == 0);
+      CHECK(PreWarm::prewarm_size_v3_on_event_interval(0.6, 0, min, max, 1.0) == 1);
+      CHECK(PreWarm::prewarm_size_v3_on_event_interval(500, 50, min, max, 1.0) == 450);
+    }
+  }
+
+  SECTION("prewarm_size_within_budget")
+  {
+    CHECK(PreWarm::prewarm_size_within_budget(10, 1000, 0) == 10);
+    CHECK(PreWarm::prewarm_size_within_budget(10, 0, 100) == 10);
+    CHECK(PreWarm::prewarm_size_within_budget(10, 95, 100) == 5);
+    CHECK(PreWarm::prewarm_size_within_budget(10, 100, 100) == 0);
+    CHECK(PreWarm::prewarm_size_within_budget(10, 120, 100) == 0);
+  }
 }
@@ -0,0 +1,177 @@
+/** @file
+
+  Unit tests for the server session pool
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "proxy/http/HttpSessionManager.h"
+
+#include "catch.hpp"
+
+namespace
+{
+/// A session to an origin, without a connection, that can or cannot move to another thread.
+class TestSession : public PoolableSession
+{
+public:
+  TestSession(sockaddr const *addr, char const *host, bool migrates, bool multiplexing = false)
+    : _migrates(migrates), _multiplexing(multiplexing)
+  {
+    ats_ip_copy(&_addr.sa, addr);
+    attach_hostname(host);
+  }
+
+  void
+  new_connection(NetVConnection * /* new_vc ATS_UNUSED */, MIOBuffer * /* iobuf ATS_UNUSED */,
+                 IOBufferReader * /* reader ATS_UNUSED */) override
+  {
+  }
+  void
+  start() override
+  {
+  }
+  void
+  release(ProxyTransaction * /* trans ATS_UNUSED */) override
+  {
+  }
+  void
+  destroy() override
+  {
+  }
+  void
+  free() override
+  {
+  }
+  void
+  do_io_close(int /* lerrno ATS_UNUSED */) override
+  {
+  }
+  void
+  increment_current_active_connections_stat() override
+  {
+  }
+  void
+  decrement_current_active_connections_stat() override
+  {
+  }
+  int
+  get_transact_count() const override
+  {
+    return 0;
+  }
+  char const *
+  get_protocol_string() const override
+  {
+    return "test";
+  }
+  IOBufferReader *
+  get_remote_reader() override
+  {
+    return nullptr;
+  }
+  sockaddr const *
+  get_remote_addr() const override
+  {
+    return &_addr.sa;
+  }
+  bool
+  is_multiplexing() const override
+  {
+    return _multiplexing;
+  }
+  // As a connection on io_uring does.
+  bool
+  can_migrate() const override
+  {
+    return _migrates && PoolableSession::can_migrate();
+  }
+
+private:
+  IpEndpoint _addr;
+  bool       _migrates;
+  bool       _multiplexing;
+};
+
+CryptoHash
+host_hash(char const *host)
+{
+  CryptoHash hash;
+
+  CryptoContext().hash_immediate(hash, reinterpret_cast<unsigned char const *>(host), strlen(host));
+  return hash;
+}
+} // namespace
+
+TEST_CASE("ServerSessionPool acquire for another thread", "[http][session]")
+{
+  IpEndpoint addr;
+
+  ats_ip_pton("127.0.0.1:8080", &addr);
+
+  // The most recently added session is looked at first.
+  ServerSessionPool pool;
+  TestSession       migrates(&addr.sa, "origin.test", true);
+  TestSession       stays(&addr.sa, "origin.test", false);
+  TestSession       multiplexed(&addr.sa, "origin.test", true, true);
+  PoolableSession  *ssn = nullptr;
+
+  pool.addSession(&migrates);
+  pool.addSession(&stays);
+  pool.addSession(&multiplexed);
+
+  auto match_style = GENERATE(TS_SERVER_SESSION_SHARING_MATCH_MASK_IP, TS_SERVER_SESSION_SHARING_MATCH_MASK_HOSTONLY,
+                              TS_SERVER_SESSION_SHARING_MATCH_MASK_IP | TS_SERVER_SESSION_SHARING_MATCH_MASK_HOSTONLY);
+  CAPTURE(match_style);
+
+  SECTION("the thread of the pool takes any session")
+  {
+    CHECK(pool.acquireSession(&addr.sa, host_hash("origin.test"), match_style, nullptr, ssn) == HSM_DONE);
+    CHECK(ssn == &multiplexed);
+    // A multiplexed session stays in the pool.
+    CHECK(pool.idle() == 3);
+  }
+
+  SECTION("another thread passes over the sessions that cannot move")
+  {
+    CHECK(pool.acquireSession(&addr.sa, host_hash("origin.test"), match_style, nullptr, ssn, true) == HSM_DONE);
+    CHECK(ssn == &migrates);
+    CHECK(pool.idle() == 2);
+
+    // The others are left for the thread of the pool.
+    CHECK(pool.acquireSession(&addr.sa, host_hash("origin.test"), match_style, nullptr, ssn, true) == HSM_NOT_FOUND);
+    CHECK(ssn == nullptr);
+    CHECK(pool.idle() == 2);
+    CHECK(pool.acquireSession(&addr.sa, host_hash("origin.test"), match_style, nullptr, ssn) == HSM_DONE);
+    CHECK(ssn == &multiplexed);
+    pool.addSession(&migrates);
+  }
+
+  SECTION("nothing to move")
+  {
+    pool.removeSession(&migrates);
+    CHECK(pool.acquireSession(&addr.sa, host_hash("origin.test"), match_style, nullptr, ssn, true) == HSM_NOT_FOUND);
+    pool.addSession(&migrates);
+  }
+
+  pool.removeSession(&multiplexed);
+  pool.removeSession(&stays);
+  pool.removeSession(&migrates);
+  CHECK(pool.idle() == 0);
+}
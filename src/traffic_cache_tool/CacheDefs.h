@@ -160,7 +160,7 @@ public:
   uint32_t      write_serial;
   uint32_t      dirty;
   uint32_t      sector_size;
-  uint32_t      unused; // pad out to 8 byte boundary
+  uint32_t      key_hash; // cache key hash algorithm (proxy.config.cache.key_hash), pads to 8 bytes
   uint16_t      freelist[1];
 };
 
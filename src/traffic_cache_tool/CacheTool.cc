@@ -204,6 +204,8 @@ struct Cache {
   //  ts::CacheStripeBlocks calcTotalSpanPhysicalSize();
   ts::CacheStripeBlocks calcTotalSpanConfiguredSize();
 
+  CryptoContext::HashType keyHashType();
+
   std::list<Span *>                  _spans;
   std::map<int, Volume>              _volumes;
   std::vector<StripeSM *>            globalVec_stripe;
@@ -629,7 +631,8 @@ Cache::dumpSpans(SpanDumpDepth depth)
                             << "\n phase: " << stripe->_meta[i][j].phase << "\n cycle: " << stripe->_meta[i][j].cycle
                             << "\n sync_serial: " << stripe->_meta[i][j].sync_serial
                             << "\n write_serial: " << stripe->_meta[i][j].write_serial << "\n dirty: " << stripe->_meta[i][j].dirty
-                            << "\n sector_size: " << stripe->_meta[i][j].sector_size << std::endl;
+                            << "\n sector_size: " << stripe->_meta[i][j].sector_size
+                            << "\n key_hash: " << stripe->_meta[i][j].key_hash << std::endl;
                 }
               }
               if (!stripe->validate_sync_serial()) {
@@ -940,6 +943,19 @@ next_rand(unsigned int *p)
   return seed;
 }
 
+// The hash the cache keys URLs with, the same choice ink_cache_init makes for URLHashContext.
+// proxy.config.cache.key_hash is recorded in every stripe header, the first valid one is used.
+CryptoContext::HashType
+Cache::keyHashType()
+{
+  for (auto stripe : globalVec_stripe) {
+    if (stripe->loadMeta()) {
+      return stripe->_meta[0][0].key_hash == 1 ? CryptoContext::MURMUR3 : CryptoContext::UNSPECIFIED;
+    }
+  }
+  return CryptoContext::UNSPECIFIED;
+}
+
 void
 Cache::build_stripe_hash_table()
 {
@@ -1194,8 +1210,9 @@ Find_Stripe(swoc::file::path const &input_file_path)
   if ((err = cache.loadSpan(SpanFile))) {
     cache.dumpSpans(Cache::SpanDumpDepth::SPAN);
     cache.build_stripe_hash_table();
+    CryptoContext::HashType key_hash = cache.keyHashType();
     for (auto host : cache.URLset) {
-      CryptoContext               ctx;
+      CryptoContext               ctx(key_hash);
       CryptoHash                  hashT;
       swoc::LocalBufferWriter<33> w;
       ctx.update(host->url.data(), host->url.size());
@@ -1310,8 +1327,9 @@ Get_Response(swoc::file::path const &input_file_path)
   if ((err = cache.loadSpan(SpanFile))) {
     cache.dumpSpans(Cache::SpanDumpDepth::SPAN);
     cache.build_stripe_hash_table();
+    CryptoContext::HashType key_hash = cache.keyHashType();
     for (auto host : cache.URLset) {
-      CryptoContext               ctx;
+      CryptoContext               ctx(key_hash);
       CryptoHash                  hashT;
       swoc::LocalBufferWriter<33> w;
       ctx.update(host->url.data(), host->url.size());
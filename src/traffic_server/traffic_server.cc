@@ -1772,12 +1772,18 @@ configure_io_uring()
   RecInt aio_io_uring_attach_wq     = cfg.attach_wq;
   RecInt aio_io_uring_wq_bounded    = cfg.wq_bounded;
   RecInt aio_io_uring_wq_unbounded  = cfg.wq_unbounded;
+  RecInt net_data_path              = cfg.net_data_path;
+  RecInt net_recv_buffers           = cfg.net_recv_buffers;
+  RecInt net_recv_buffer_size       = cfg.net_recv_buffer_size;
 
   REC_ReadConfigInteger(aio_io_uring_queue_entries, "proxy.config.io_uring.entries");
   REC_ReadConfigInteger(aio_io_uring_sq_poll_ms, "proxy.config.io_uring.sq_poll_ms");
   REC_ReadConfigInteger(aio_io_uring_attach_wq, "proxy.config.io_uring.attach_wq");
   REC_ReadConfigInteger(aio_io_uring_wq_bounded, "proxy.config.io_uring.wq_workers_bounded");
   REC_ReadConfigInteger(aio_io_uring_wq_unbounded, "proxy.config.io_uring.wq_workers_unbounded");
+  REC_ReadConfigInteger(net_data_path, "proxy.config.io_uring.net.enabled");
+  REC_ReadConfigInteger(net_recv_buffers, "proxy.config.io_uring.net.recv_buffers");
+  REC_ReadConfigInteger(net_recv_buffer_size, "proxy.config.io_uring.net.recv_buffer_size");
 
   cfg.queue_entries = aio_io_uring_queue_entries;
   cfg.sq_poll_ms    = aio_io_uring_sq_poll_ms;
@@ -1785,6 +1791,10 @@ configure_io_uring()
   cfg.wq_bounded    = aio_io_uring_wq_bounded;
   cfg.wq_unbounded  = aio_io_uring_wq_unbounded;
 
+  cfg.net_data_path        = net_data_path;
+  cfg.net_recv_buffers     = net_recv_buffers;
+  cfg.net_recv_buffer_size = net_recv_buffer_size;
+
   IOUringContext::set_config(cfg);
 }
 #endif
@@ -20,6 +20,7 @@
  */
 
 #include "tscore/ConsistentHash.h"
+#include <algorithm>
 #include <cstring>
 #include <string>
 #include <sstream>
@@ -55,14 +56,60 @@ ATSConsistentHash::insert(ATSConsistentHashNode *node, float weight, ATSHash64 *
   string_stream << *node;
   std_string = string_stream.str();
 
+  std::vector<std::pair<uint64_t, ATSConsistentHashNode *>> points, ring;
   for (i = 0; i < static_cast<int>(roundf(replicas * weight)); i++) {
     snprintf(numstr, 256, "%d-", i);
     thash->update(numstr, strlen(numstr));
     thash->update(std_string.c_str(), strlen(std_string.c_str()));
     thash->final();
-    NodeMap.insert(std::pair<uint64_t, ATSConsistentHashNode *>(thash->get(), node));
+    points.emplace_back(thash->get(), node);
     thash->clear();
   }
+
+  // The first node inserted at a hash value owns it, drop any points already on the ring.
+  auto by_hash = [](auto const &a, auto const &b) { return a.first < b.first; };
+  std::stable_sort(points.begin(), points.end(), by_hash);
+  points.erase(std::unique(points.begin(), points.end(), [](auto const &a, auto const &b) { return a.first == b.first; }),
+               points.end());
+  points.erase(std::remove_if(points.begin(), points.end(),
+                              [this](auto const &p) { return std::binary_search(keys.begin(), keys.end(), p.first); }),
+               points.end());
+
+  // Merge the new points into the ring, keeping it sorted.
+  ring.reserve(keys.size() + points.size());
+  for (size_t j = 0; j < keys.size(); ++j) {
+    ring.emplace_back(keys[j], nodes[j]);
+  }
+  ring.insert(ring.end(), points.begin(), points.end());
+  std::inplace_merge(ring.begin(), ring.begin() + keys.size(), ring.end(), by_hash);
+
+  keys.resize(ring.size());
+  nodes.resize(ring.size());
+  for (size_t j = 0; j < ring.size(); ++j) {
+    keys[j]  = ring[j].first;
+    nodes[j] = ring[j].second;
+  }
+  ++members;
+}
+
+// Branchless binary search, the index of the first ring position >= hashval, or keys.size().
+size_t
+ATSConsistentHash::lower_bound(uint64_t hashval) const
+{
+  const uint64_t *base = keys.data();
+  size_t          n    = keys.size();
+
+  if (n == 0) {
+    return 0;
+  }
+
+  while (n > 1) {
+    size_t half  = n / 2;
+    base         = (base[half] < hashval) ? base + half : base;
+    n           -= half;
+  }
+
+  return (base - keys.data()) + (*base < hashval);
 }
 
 ATSConsistentHashNode *
@@ -99,33 +146,33 @@ ATSConsistentHash::lookup(const char *url, ATSConsistentHashIter *i, bool *w, AT
     url_hash = thash->get();
     thash->clear();
 
-    *iter = NodeMap.lower_bound(url_hash);
+    *iter = lower_bound(url_hash);
 
-    if (*iter == NodeMap.end()) {
+    if (*iter == keys.size()) {
       *wptr = true;
-      *iter = NodeMap.begin();
+      *iter = 0;
     }
   } else {
     (*iter)++;
   }
 
-  if (!(*wptr) && *iter == NodeMap.end()) {
+  if (!(*wptr) && *iter >= keys.size()) {
     *wptr = true;
-    *iter = NodeMap.begin();
+    *iter = 0;
   }
 
-  if (*wptr && *iter == NodeMap.end()) {
+  if (*wptr && *iter >= keys.size()) {
     return nullptr;
   }
 
-  return (*iter)->second;
+  return nodes[*iter];
 }
 
 ATSConsistentHashNode *
 ATSConsistentHash::lookup_available(const char *url, ATSConsistentHashIter *i, bool *w, ATSHash64 *h)
 {
   uint64_t              url_hash;
-  ATSConsistentHashIter NodeMapIterUp, *iter;
+  ATSConsistentHashIter NodeMapIterUp = 0, *iter;
   ATSHash64            *thash;
   bool                 *wptr, wrapped = false;
 
@@ -155,26 +202,29 @@ ATSConsistentHash::lookup_available(const char *url, ATSConsistentHashIter *i, b
     url_hash = thash->get();
     thash->clear();
 
-    *iter = NodeMap.lower_bound(url_hash);
+    *iter = lower_bound(url_hash);
   }
 
-  if (*iter == NodeMap.end()) {
+  if (*iter >= keys.size()) {
+    if (keys.empty()) {
+      return nullptr;
+    }
     *wptr = true;
-    *iter = NodeMap.begin();
+    *iter = 0;
   }
 
-  while (!(*iter)->second->available) {
+  while (!nodes[*iter]->available) {
     (*iter)++;
 
-    if (!(*wptr) && *iter == NodeMap.end()) {
+    if (!(*wptr) && *iter == keys.size()) {
       *wptr = true;
-      *iter = NodeMap.begin();
-    } else if (*wptr && *iter == NodeMap.end()) {
+      *iter = 0;
+    } else if (*wptr && *iter == keys.size()) {
       return nullptr;
     }
   }
 
-  return (*iter)->second;
+  return nodes[*iter];
 }
 
 ATSConsistentHashNode *
@@ -195,14 +245,63 @@ ATSConsistentHash::lookup_by_hashval(uint64_t hashval, ATSConsistentHashIter *i,
     iter = &NodeMapIterUp;
   }
 
-  *iter = NodeMap.lower_bound(hashval);
+  if (keys.empty()) {
+    return nullptr;
+  }
+
+  *iter = lower_bound(hashval);
 
-  if (*iter == NodeMap.end()) {
+  if (*iter == keys.size()) {
     *wptr = true;
-    *iter = NodeMap.begin();
+    *iter = 0;
+  }
+
+  return nodes[*iter];
+}
+
+ATSConsistentHashNode *
+ATSConsistentHash::lookup_bounded(uint64_t hashval, float factor, ATSConsistentHashIter *i, bool *w)
+{
+  ATSConsistentHashIter NodeMapIterUp, *iter;
+  bool                 *wptr, wrapped = false;
+
+  if (w) {
+    wptr = w;
+  } else {
+    wptr = &wrapped;
+  }
+
+  if (i) {
+    iter = i;
+  } else {
+    iter = &NodeMapIterUp;
+  }
+
+  ATSConsistentHashNode *first = lookup_by_hashval(hashval, iter, wptr);
+
+  if (first == nullptr || members == 0) {
+    return first;
+  }
+
+  // Each node may carry at most ceil(factor * average load), counting the request being placed.
+  int64_t capacity = static_cast<int64_t>(std::ceil(factor * (total_load.load(std::memory_order_relaxed) + 1) / members));
+  size_t  pos      = *iter;
+  bool    passed   = *wptr;
+
+  for (size_t n = 0; n < keys.size(); ++n) {
+    if (nodes[pos]->load.load(std::memory_order_relaxed) < capacity) {
+      *iter = pos;
+      *wptr = passed;
+      return nodes[pos];
+    }
+    if (++pos == keys.size()) {
+      pos    = 0;
+      passed = true;
+    }
   }
 
-  return (*iter)->second;
+  // Everything is at capacity, fall back to the plain consistent hash choice.
+  return first;
 }
 
 ATSConsistentHash::~ATSConsistentHash()
@@ -28,6 +28,7 @@
 #include "tscore/ink_platform.h"
 #include "tscore/CryptoHash.h"
 #include "tscore/SHA256.h"
+#include "tscore/MurmurHash3.h"
 
 #if TS_ENABLE_FIPS == 1
 CryptoContext::HashType CryptoContext::Setting = CryptoContext::SHA256;
@@ -37,9 +38,11 @@ CryptoContext::HashType CryptoContext::Setting = CryptoContext::SHA256;
 CryptoContext::HashType CryptoContext::Setting = CryptoContext::MD5;
 #endif
 
-CryptoContext::CryptoContext()
+CryptoContext::CryptoContext() : CryptoContext(Setting) {}
+
+CryptoContext::CryptoContext(HashType type)
 {
-  switch (Setting) {
+  switch (type) {
   case UNSPECIFIED:
 #if TS_ENABLE_FIPS == 0
   case MD5:
@@ -52,6 +55,10 @@ CryptoContext::CryptoContext()
     new (_base) SHA256Context;
     break;
 #endif
+  case MURMUR3:
+    static_assert(OBJ_SIZE >= sizeof(MurmurHash3Context));
+    new (_base) MurmurHash3Context;
+    break;
   default:
     ink_release_assert(!"Invalid global URL hash context");
   };
@@ -0,0 +1,159 @@
+/** @file
+
+  MurmurHash3 (x64, 128 bit) support class.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include <algorithm>
+#include <cstring>
+#include "tscore/MurmurHash3.h"
+
+namespace
+{
+constexpr uint64_t C1 = 0x87c37b91114253d5ULL;
+constexpr uint64_t C2 = 0x4cf5ad432745937fULL;
+
+inline uint64_t
+rotl64(uint64_t x, int r)
+{
+  return (x << r) | (x >> (64 - r));
+}
+
+inline uint64_t
+fmix64(uint64_t k)
+{
+  k ^= k >> 33;
+  k *= 0xff51afd7ed558ccdULL;
+  k ^= k >> 33;
+  k *= 0xc4ceb9fe1a85ec53ULL;
+  k ^= k >> 33;
+  return k;
+}
+
+inline uint64_t
+mix_k1(uint64_t k1)
+{
+  k1 *= C1;
+  k1  = rotl64(k1, 31);
+  k1 *= C2;
+  return k1;
+}
+
+inline uint64_t
+mix_k2(uint64_t k2)
+{
+  k2 *= C2;
+  k2  = rotl64(k2, 33);
+  k2 *= C1;
+  return k2;
+}
+} // namespace
+
+void
+MurmurHash3Context::block(uint8_t const *data)
+{
+  uint64_t k1, k2;
+
+  memcpy(&k1, data, sizeof(k1));
+  memcpy(&k2, data + sizeof(k1), sizeof(k2));
+
+  _h1 ^= mix_k1(k1);
+  _h1  = rotl64(_h1, 27);
+  _h1 += _h2;
+  _h1  = _h1 * 5 + 0x52dce729;
+
+  _h2 ^= mix_k2(k2);
+  _h2  = rotl64(_h2, 31);
+  _h2 += _h1;
+  _h2  = _h2 * 5 + 0x38495ab5;
+}
+
+bool
+MurmurHash3Context::update(void const *data, int length)
+{
+  uint8_t const *p = static_cast<uint8_t const *>(data);
+
+  _length += length;
+
+  // Complete a block left over from a previous update first.
+  if (_buffer_size > 0) {
+    int n = std::min(length, static_cast<int>(sizeof(_buffer)) - _buffer_size);
+
+    memcpy(_buffer + _buffer_size, p, n);
+    _buffer_size += n;
+    p            += n;
+    length       -= n;
+    if (_buffer_size < static_cast<int>(sizeof(_buffer))) {
+      return true;
+    }
+    block(_buffer);
+    _buffer_size = 0;
+  }
+
+  for (; length >= static_cast<int>(sizeof(_buffer)); p += sizeof(_buffer), length -= sizeof(_buffer)) {
+    block(p);
+  }
+
+  if (length > 0) {
+    memcpy(_buffer, p, length);
+    _buffer_size = length;
+  }
+
+  return true;
+}
+
+bool
+MurmurHash3Context::finalize(CryptoHash &hash)
+{
+  uint64_t k1 = 0;
+  uint64_t k2 = 0;
+
+  // The tail is read as little endian, exactly as the reference implementation does.
+  for (int i = _buffer_size - 1; i >= 8; --i) {
+    k2 = (k2 << 8) | _buffer[i];
+  }
+  for (int i = std::min(_buffer_size, 8) - 1; i >= 0; --i) {
+    k1 = (k1 << 8) | _buffer[i];
+  }
+  if (_buffer_size > 8) {
+    _h2 ^= mix_k2(k2);
+  }
+  if (_buffer_size > 0) {
+    _h1 ^= mix_k1(k1);
+  }
+
+  _h1 ^= _length;
+  _h2 ^= _length;
+
+  _h1 += _h2;
+  _h2 += _h1;
+
+  _h1 = fmix64(_h1);
+  _h2 = fmix64(_h2);
+
+  _h1 += _h2;
+  _h2 += _h1;
+
+  hash.clear();
+  hash.u64[0] = _h1;
+  hash.u64[1] = _h2;
+
+  return true;
+}
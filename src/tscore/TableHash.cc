@@ -0,0 +1,175 @@
+/** @file
+
+  Maglev and jump consistent hash node selection.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include "tscore/TableHash.h"
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <numeric>
+
+namespace
+{
+constexpr uint32_t EMPTY_SLOT = std::numeric_limits<uint32_t>::max();
+} // namespace
+
+ATSTableHash::ATSTableHash(Algorithm a, uint32_t table_size, ATSHash64 *h) : algorithm(a), slots(next_prime(table_size)), hash(h)
+{
+}
+
+void
+ATSTableHash::insert(ATSConsistentHashNode *node, float weight, ATSHash64 *h)
+{
+  ATSHash64 *thash = h ? h : hash;
+
+  if (thash == nullptr) {
+    return;
+  }
+
+  thash->update(node->name, strlen(node->name));
+  thash->final();
+  node_hashes.push_back(thash->get());
+  thash->clear();
+
+  nodes.push_back(node);
+  weights.push_back(weight);
+}
+
+void
+ATSTableHash::build()
+{
+  uint32_t const n = nodes.size();
+
+  // Fallbacks step through the other n - 1 nodes, any stride coprime to that visits each of
+  // them once before repeating.
+  uint32_t const others = std::max(n, 2U) - 1;
+  strides.clear();
+  for (uint32_t s = 1; s < std::max(others, 2U); ++s) {
+    if (std::gcd(s, others) == 1) {
+      strides.push_back(s);
+    }
+  }
+
+  table.clear();
+  if (algorithm != MAGLEV || n == 0) {
+    return;
+  }
+
+  // Each node walks its own permutation of the slots, taking the first free slot on each of its
+  // turns. A node gets a turn each round its accumulated weight reaches the largest weight, so
+  // the heaviest node takes a slot every round.
+  std::vector<uint64_t> offset(n), skip(n), next(n, 0);
+  std::vector<double>   credit(n, 0), share(n, 1);
+  float const           max_weight = *std::max_element(weights.begin(), weights.end());
+
+  for (uint32_t i = 0; i < n; ++i) {
+    offset[i] = node_hashes[i] % slots;
+    skip[i]   = (node_hashes[i] >> 32) % (slots - 1) + 1;
+    if (max_weight > 0) {
+      share[i] = std::max(weights[i], 0.0F) / max_weight;
+    }
+  }
+
+  table.assign(slots, EMPTY_SLOT);
+  for (uint32_t filled = 0; filled < slots;) {
+    for (uint32_t i = 0; i < n && filled < slots; ++i) {
+      credit[i] += share[i];
+      if (credit[i] < 1) {
+        continue;
+      }
+      credit[i] -= 1;
+
+      uint64_t c = (offset[i] + next[i] * skip[i]) % slots;
+      while (table[c] != EMPTY_SLOT) {
+        ++next[i];
+        c = (offset[i] + next[i] * skip[i]) % slots;
+      }
+      table[c] = i;
+      ++next[i];
+      ++filled;
+    }
+  }
+}
+
+ATSConsistentHashNode *
+ATSTableHash::lookup_by_hashval(uint64_t hashval, uint32_t attempt) const
+{
+  uint64_t const n = nodes.size();
+
+  if (n == 0 || strides.empty()) {
+    return nullptr;
+  }
+
+  uint64_t first = algorithm == MAGLEV ? table[hashval % table.size()] : jump(hashval, n);
+  uint64_t step  = attempt % n;
+  if (step == 0) {
+    return nodes[first];
+  }
+
+  // Mix the hash value again so the fallbacks are independent of the first choice. The first
+  // fallback is spread evenly over the other nodes.
+  uint64_t mix    = hashval * 0x9E3779B97F4A7C15ULL;
+  uint64_t start  = (mix >> 32) % (n - 1);
+  uint64_t stride = strides[(mix & 0xFFFFFFFF) % strides.size()];
+  return nodes[(first + 1 + (start + (step - 1) * stride) % (n - 1)) % n];
+}
+
+ATSTableHash::~ATSTableHash()
+{
+  if (hash) {
+    delete hash;
+  }
+}
+
+int32_t
+ATSTableHash::jump(uint64_t key, int32_t buckets)
+{
+  int64_t b = -1;
+  int64_t j = 0;
+
+  while (j < buckets) {
+    b   = j;
+    key = key * 2862933555777941757ULL + 1;
+    j   = static_cast<int64_t>((b + 1) * (static_cast<double>(1LL << 31) / static_cast<double>((key >> 33) + 1)));
+  }
+  return static_cast<int32_t>(b);
+}
+
+uint32_t
+ATSTableHash::next_prime(uint32_t n)
+{
+  if (n <= 2) {
+    return 2;
+  }
+  for (n |= 1;; n += 2) {
+    bool prime = true;
+    for (uint32_t d = 3; d <= n / d; d += 2) {
+      if (n % d == 0) {
+        prime = false;
+        break;
+      }
+    }
+    if (prime) {
+      return n;
+    }
+  }
+}
@@ -0,0 +1,150 @@
+/** @file
+
+  Unit tests for ATSConsistentHash
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <cstring>
+#include <map>
+#include <set>
+#include <string>
+
+#include "tscore/ConsistentHash.h"
+#include "tscore/HashSip.h"
+#include "tscore/Random.h"
+#include <catch.hpp>
+
+namespace
+{
+constexpr int REPLICAS = 64;
+
+// The ring as the std::map based implementation built it.
+void
+reference_insert(std::map<uint64_t, ATSConsistentHashNode *> &ref, ATSConsistentHashNode *node)
+{
+  ATSHash64Sip24 hash;
+
+  for (int i = 0; i < REPLICAS; i++) {
+    std::string key = std::to_string(i) + "-" + node->name;
+
+    hash.update(key.data(), key.size());
+    hash.final();
+    ref.emplace(hash.get(), node);
+    hash.clear();
+  }
+}
+} // namespace
+
+TEST_CASE("ConsistentHash", "[libts][ConsistentHash]")
+{
+  char                  names[3][8] = {"alpha", "beta", "gamma"};
+  ATSConsistentHashNode nodes[3];
+  ATSConsistentHash     ring(REPLICAS, new ATSHash64Sip24);
+
+  std::map<uint64_t, ATSConsistentHashNode *> ref;
+
+  for (int i = 0; i < 3; ++i) {
+    nodes[i].name = names[i];
+    ring.insert(&nodes[i]);
+    reference_insert(ref, &nodes[i]);
+  }
+
+  SECTION("Lookups match a sorted map")
+  {
+    for (int i = 0; i < 10000; ++i) {
+      uint64_t hashval = ts::Random::random();
+      bool     wrapped = false;
+      auto     it      = ref.lower_bound(hashval);
+
+      if (it == ref.end()) {
+        it = ref.begin();
+      }
+      REQUIRE(ring.lookup_by_hashval(hashval, nullptr, &wrapped) == it->second);
+      REQUIRE(wrapped == (ref.lower_bound(hashval) == ref.end()));
+    }
+
+    // The exact ring positions, and the ends of the ring.
+    for (auto const &[hashval, node] : ref) {
+      REQUIRE(ring.lookup_by_hashval(hashval) == node);
+    }
+    REQUIRE(ring.lookup_by_hashval(0) == ref.begin()->second);
+    REQUIRE(ring.lookup_by_hashval(UINT64_MAX) == ref.begin()->second);
+  }
+
+  SECTION("Iterating walks the whole ring once")
+  {
+    ATSConsistentHashIter iter    = 0;
+    bool                  wrapped = false;
+    auto                  it      = ref.lower_bound(ref.rbegin()->first);
+    int                   steps   = 0;
+
+    // Start at the last position, so the walk wraps right away.
+    REQUIRE(ring.lookup_by_hashval(it->first, &iter, &wrapped) == it->second);
+    REQUIRE(wrapped == false);
+    for (ATSConsistentHashNode *node; (node = ring.lookup(nullptr, &iter, &wrapped)) != nullptr; ++steps) {
+      if (++it == ref.end()) {
+        it = ref.begin();
+      }
+      REQUIRE(node == it->second);
+    }
+    REQUIRE(wrapped == true);
+    REQUIRE(steps == static_cast<int>(ref.size()));
+  }
+
+  SECTION("Unavailable nodes are skipped")
+  {
+    std::set<ATSConsistentHashNode *> seen;
+
+    nodes[0].available = false;
+    for (int i = 0; i < 1000; ++i) {
+      std::string url = "http://example.com/" + std::to_string(i);
+      seen.insert(ring.lookup_available(url.c_str()));
+    }
+    nodes[0].available = true;
+
+    REQUIRE(seen.count(&nodes[0]) == 0);
+    REQUIRE(seen.count(nullptr) == 0);
+  }
+
+  SECTION("Bounded loads")
+  {
+    uint64_t               hashval = ref.begin()->first;
+    ATSConsistentHashNode *first   = ring.lookup_by_hashval(hashval);
+
+    // No load, the usual node is chosen.
+    REQUIRE(ring.lookup_bounded(hashval, 1.0) == first);
+
+    // Three nodes and a factor of 1 allow one connection per node.
+    ring.acquire(first);
+    ATSConsistentHashNode *second = ring.lookup_bounded(hashval, 1.0);
+    REQUIRE(second != first);
+    ring.acquire(second);
+    ATSConsistentHashNode *third = ring.lookup_bounded(hashval, 1.0);
+    REQUIRE(third != first);
+    REQUIRE(third != second);
+
+    // A larger factor tolerates more load on the usual node.
+    REQUIRE(ring.lookup_bounded(hashval, 3.0) == first);
+
+    ring.release(first);
+    ring.release(second);
+    REQUIRE(ring.lookup_bounded(hashval, 1.0) == first);
+  }
+}
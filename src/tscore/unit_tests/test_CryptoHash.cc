@@ -55,3 +55,45 @@ TEST_CASE("CrypoHash", "[libts][CrypoHash]")
     REQUIRE(memcmp(md5.data(), buffer, md5.size()) == 0);
   }
 }
+
+TEST_CASE("CryptoHash MurmurHash3", "[libts][CrypoHash]")
+{
+  std::string_view test     = "The quick brown fox jumps over the lazy dog";
+  std::string_view expected = "6C1B07BC7BBC4BE347939AC4A93C437A";
+  CryptoHash       hash;
+  char             buffer[(CRYPTO_HASH_SIZE * 2) + 1];
+
+  SECTION("Reference value")
+  {
+    ts::CryptoContext ctx(CryptoContext::MURMUR3);
+
+    REQUIRE(ctx.hash_immediate(hash, test.data(), test.size()));
+    hash.toHexStr(buffer);
+    REQUIRE(std::string_view(buffer, expected.size()) == expected);
+  }
+
+  SECTION("Incremental updates match a single update")
+  {
+    // Split across every offset, so partial blocks are carried between updates.
+    ts::CryptoContext whole(CryptoContext::MURMUR3);
+    whole.hash_immediate(hash, test.data(), test.size());
+
+    for (size_t split = 0; split <= test.size(); ++split) {
+      ts::CryptoContext ctx(CryptoContext::MURMUR3);
+      CryptoHash        parts;
+
+      ctx.update(test.data(), split);
+      ctx.update(test.data() + split, test.size() - split);
+      ctx.finalize(parts);
+      REQUIRE(parts == hash);
+    }
+  }
+
+  SECTION("Empty input")
+  {
+    ts::CryptoContext ctx(CryptoContext::MURMUR3);
+
+    ctx.finalize(hash);
+    REQUIRE(hash.is_zero());
+  }
+}
@@ -0,0 +1,230 @@
+/** @file
+
+  Unit tests for ATSTableHash
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+*/
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "tscore/TableHash.h"
+#include "tscore/HashSip.h"
+#include "tscore/Random.h"
+#include <catch.hpp>
+
+namespace
+{
+constexpr int NODES = 10;
+constexpr int KEYS  = 100000;
+
+struct Nodes {
+  std::vector<std::string>           names;
+  std::vector<ATSConsistentHashNode> nodes;
+
+  explicit Nodes(int n) : names(n), nodes(n)
+  {
+    for (int i = 0; i < n; ++i) {
+      names[i]      = "parent" + std::to_string(i) + ".example.com";
+      nodes[i].name = names[i].data();
+    }
+  }
+};
+
+std::unique_ptr<ATSTableHash>
+make_table(ATSTableHash::Algorithm a, Nodes &n, int count, std::vector<float> const &weights = {})
+{
+  auto table = std::make_unique<ATSTableHash>(a, ATSTableHash::DEFAULT_TABLE_SIZE, new ATSHash64Sip24);
+
+  for (int i = 0; i < count; ++i) {
+    table->insert(&n.nodes[i], weights.empty() ? 1.0 : weights[i]);
+  }
+  table->build();
+  return table;
+}
+
+std::vector<uint64_t>
+make_keys()
+{
+  std::vector<uint64_t> keys(KEYS);
+
+  for (auto &k : keys) {
+    k = ts::Random::random();
+  }
+  return keys;
+}
+
+// Largest count over the mean count.
+double
+imbalance(std::map<ATSConsistentHashNode *, int> const &counts, int nodes)
+{
+  int most = 0;
+
+  for (auto const &[node, count] : counts) {
+    most = std::max(most, count);
+  }
+  return most / (static_cast<double>(KEYS) / nodes);
+}
+
+// Fraction of the keys that map to a different node in @a after than in @a before.
+double
+disruption(ATSTableHash const &before, ATSTableHash const &after, std::vector<uint64_t> const &keys)
+{
+  int moved = 0;
+
+  for (auto k : keys) {
+    moved += before.lookup_by_hashval(k) != after.lookup_by_hashval(k);
+  }
+  return static_cast<double>(moved) / keys.size();
+}
+} // namespace
+
+TEST_CASE("TableHash helpers", "[libts][TableHash]")
+{
+  REQUIRE(ATSTableHash::next_prime(0) == 2);
+  REQUIRE(ATSTableHash::next_prime(3) == 3);
+  REQUIRE(ATSTableHash::next_prime(4) == 5);
+  REQUIRE(ATSTableHash::next_prime(65536) == 65537);
+  REQUIRE(ATSTableHash::next_prime(65537) == 65537);
+
+  // Growing the number of buckets only ever moves a key to the new bucket.
+  for (int i = 0; i < 1000; ++i) {
+    uint64_t key = ts::Random::random();
+
+    for (int32_t n = 1; n < 64; ++n) {
+      int32_t b = ATSTableHash::jump(key, n);
+      REQUIRE(b >= 0);
+      REQUIRE(b < n);
+      int32_t next = ATSTableHash::jump(key, n + 1);
+      REQUIRE((next == b || next == n));
+    }
+  }
+}
+
+TEST_CASE("TableHash", "[libts][TableHash]")
+{
+  Nodes n(NODES);
+  auto  keys = make_keys();
+
+  for (auto algorithm : {ATSTableHash::MAGLEV, ATSTableHash::JUMP}) {
+    auto const *name = algorithm == ATSTableHash::MAGLEV ? "maglev" : "jump";
+    auto        t    = make_table(algorithm, n, NODES);
+
+    SECTION(std::string(name) + " lookups are balanced")
+    {
+      std::map<ATSConsistentHashNode *, int> counts;
+
+      for (auto k : keys) {
+        counts[t->lookup_by_hashval(k)]++;
+      }
+      REQUIRE(counts.size() == NODES);
+      CHECK(imbalance(counts, NODES) < 1.05);
+    }
+
+    SECTION(std::string(name) + " removing a node moves few keys")
+    {
+      // JUMP only handles removal from the end, remove the last node for both.
+      auto   smaller = make_table(algorithm, n, NODES - 1);
+      double moved   = disruption(*t, *smaller, keys);
+
+      // The keys of the removed node have to move, ideally nothing else does.
+      CHECK(moved >= 0.9 / NODES);
+      CHECK(moved < 1.5 / NODES);
+    }
+
+    SECTION(std::string(name) + " fallback spreads the keys of an unusable node")
+    {
+      ATSConsistentHashNode                 *down = &n.nodes[3];
+      std::map<ATSConsistentHashNode *, int> counts;
+      int                                    down_keys = 0;
+
+      for (auto k : keys) {
+        if (t->lookup_by_hashval(k) == down) {
+          ++down_keys;
+          ATSConsistentHashNode *next = t->lookup_by_hashval(k, 1);
+          REQUIRE(next != down);
+          counts[next]++;
+        }
+      }
+      REQUIRE(counts.size() == NODES - 1);
+      for (auto const &[node, count] : counts) {
+        CHECK(count < 2.5 * down_keys / (NODES - 1));
+      }
+    }
+
+    SECTION(std::string(name) + " fallback visits every node")
+    {
+      for (int i = 0; i < 1000; ++i) {
+        uint64_t                          k = keys[i];
+        std::set<ATSConsistentHashNode *> seen;
+
+        for (uint32_t attempt = 0; attempt < NODES; ++attempt) {
+          seen.insert(t->lookup_by_hashval(k, attempt));
+        }
+        REQUIRE(seen.size() == NODES);
+        REQUIRE(t->lookup_by_hashval(k, NODES) == t->lookup_by_hashval(k));
+      }
+    }
+  }
+}
+
+TEST_CASE("TableHash maglev table", "[libts][TableHash]")
+{
+  Nodes n(NODES);
+
+  SECTION("equal weights fill the table evenly")
+  {
+    auto                                   t = make_table(ATSTableHash::MAGLEV, n, NODES);
+    std::map<ATSConsistentHashNode *, int> slots;
+
+    REQUIRE(t->table_size() == ATSTableHash::DEFAULT_TABLE_SIZE);
+    for (uint32_t s = 0; s < t->table_size(); ++s) {
+      slots[t->lookup_by_hashval(s)]++;
+    }
+    auto [least, most] = std::minmax_element(slots.begin(), slots.end(), [](auto &a, auto &b) { return a.second < b.second; });
+    REQUIRE(most->second - least->second <= 1);
+  }
+
+  SECTION("weights set the share of the table")
+  {
+    std::vector<float>                     weights(NODES, 1.0);
+    std::map<ATSConsistentHashNode *, int> slots;
+
+    weights[0] = 2.0;
+    weights[1] = 0.5;
+    auto t     = make_table(ATSTableHash::MAGLEV, n, NODES, weights);
+    for (uint32_t s = 0; s < t->table_size(); ++s) {
+      slots[t->lookup_by_hashval(s)]++;
+    }
+    CHECK(slots[&n.nodes[0]] == Approx(2 * slots[&n.nodes[2]]).epsilon(0.01));
+    CHECK(slots[&n.nodes[1]] == Approx(0.5 * slots[&n.nodes[2]]).epsilon(0.01));
+  }
+
+  SECTION("empty")
+  {
+    ATSTableHash t(ATSTableHash::MAGLEV, 13, new ATSHash64Sip24);
+
+    t.build();
+    REQUIRE(t.lookup_by_hashval(42) == nullptr);
+  }
+}
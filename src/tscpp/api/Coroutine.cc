@@ -0,0 +1,214 @@
+/**
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+/**
+ * @file Coroutine.cc
+ */
+
+#include "tscpp/api/Coroutine.h"
+#include "logging_internal.h"
+
+namespace atscppapi
+{
+namespace
+{
+  // The events of FetchUrl.
+  constexpr int FETCH_SUCCESS = 10000;
+  constexpr int FETCH_FAILURE = 10001;
+  constexpr int FETCH_TIMEOUT = 10002;
+} // namespace
+
+Task::promise_type::~promise_type()
+{
+  reenable();
+  if (_cont) {
+    TSContDestroy(_cont);
+  }
+}
+
+void
+Task::promise_type::unhandled_exception() noexcept
+{
+  LOG_ERROR("Coroutine exited with an exception, transaction %p", _txn);
+  reenable(TS_EVENT_HTTP_ERROR);
+}
+
+TSCont
+Task::promise_type::cont()
+{
+  if (_cont == nullptr) {
+    _cont = TSContCreate(_handleEvent, TSMutexCreate());
+    TSContDataSet(_cont, this);
+
+    // Resume the coroutine on this thread.
+    if (TSEventThread thread = TSEventThreadSelf(); thread != nullptr) {
+      TSContThreadAffinitySet(_cont, thread);
+    }
+  }
+  return _cont;
+}
+
+void
+Task::promise_type::hold(TSHttpTxn txn)
+{
+  reenable();
+  _txn = txn;
+}
+
+void
+Task::promise_type::reenable(TSEvent event)
+{
+  if (_txn) {
+    TSHttpTxn txn = _txn;
+
+    _txn = nullptr;
+    TSHttpTxnReenable(txn, event);
+  }
+}
+
+int
+Task::promise_type::_handleEvent(TSCont cont, TSEvent event, void *edata)
+{
+  promise_type *promise = static_cast<promise_type *>(TSContDataGet(cont));
+  Awaiter      *awaiter = promise->_waiting;
+
+  LOG_DEBUG("Coroutine received event %d, edata = %p", event, edata);
+  if (awaiter == nullptr) {
+    if (promise->_pending_event != TS_EVENT_NONE) {
+      LOG_ERROR("Coroutine is not waiting, dropped event %d", promise->_pending_event);
+    }
+    promise->_pending_event = event;
+    promise->_pending_edata = edata;
+    return 0;
+  }
+
+  promise->_waiting = nullptr;
+  awaiter->_event   = event;
+  awaiter->_edata   = edata;
+  if (!promise->_starting) {
+    std::coroutine_handle<promise_type>::from_promise(*promise).resume();
+  }
+  return 0;
+}
+
+bool
+Awaiter::await_suspend(std::coroutine_handle<Task::promise_type> handle)
+{
+  Task::promise_type &promise = handle.promise();
+  TSMutex             mutex   = TSContMutexGet(promise.cont());
+
+  // An event sent from another thread waits until the operation is started.
+  TSMutexLock(mutex);
+  promise._waiting  = this;
+  promise._starting = true;
+  _start(promise);
+  promise._starting = false;
+
+  // The coroutine may be resumed by another thread as soon as the mutex is released.
+  bool suspend = promise._waiting == this;
+  TSMutexUnlock(mutex);
+  return suspend;
+}
+
+void
+Sleep::_start(Task::promise_type &promise)
+{
+  if (TSEventThread thread = TSEventThreadSelf(); thread != nullptr) {
+    TSContScheduleOnThread(promise.cont(), _timeout, thread);
+  } else {
+    TSContScheduleOnPool(promise.cont(), _timeout, TS_THREAD_POOL_NET);
+  }
+}
+
+void
+Hook::_start(Task::promise_type &promise)
+{
+  // The hook must be added before the held transaction is reenabled to reach it.
+  TSHttpTxnHookAdd(_txn, _id, promise.cont());
+  promise.hold(_txn);
+}
+
+void
+NetConnect::_start(Task::promise_type &promise)
+{
+  TSNetConnect(promise.cont(), _addr);
+}
+
+void
+CacheRead::_start(Task::promise_type &promise)
+{
+  TSCacheRead(promise.cont(), _key);
+}
+
+void
+CacheWrite::_start(Task::promise_type &promise)
+{
+  TSCacheWrite(promise.cont(), _key);
+}
+
+void
+VConnRead::_start(Task::promise_type &promise)
+{
+  TSVConnRead(_vc, promise.cont(), _buffer, _nbytes);
+}
+
+void
+VConnWrite::_start(Task::promise_type &promise)
+{
+  TSVConnWrite(_vc, promise.cont(), _reader, _nbytes);
+}
+
+bool
+NextEvent::await_suspend(std::coroutine_handle<Task::promise_type> handle)
+{
+  Task::promise_type &promise = handle.promise();
+
+  if (promise._pending_event != TS_EVENT_NONE) {
+    _event                 = promise._pending_event;
+    _edata                 = promise._pending_edata;
+    promise._pending_event = TS_EVENT_NONE;
+    promise._pending_edata = nullptr;
+    return false;
+  }
+  return Awaiter::await_suspend(handle);
+}
+
+void
+FetchUrl::_start(Task::promise_type &promise)
+{
+  TSFetchEvent events = {FETCH_SUCCESS, FETCH_FAILURE, FETCH_TIMEOUT};
+
+  TSFetchUrl(_request.data(), _request.size(), _addr, promise.cont(), AFTER_BODY, events);
+}
+
+std::string_view
+FetchUrl::await_resume() const noexcept
+{
+  int         length   = 0;
+  const char *response = nullptr;
+
+  // The response is freed when the fetch returns from the event, after the coroutine suspends.
+  if (_event == static_cast<TSEvent>(FETCH_SUCCESS)) {
+    response = TSFetchRespGet(static_cast<TSHttpTxn>(_edata), &length);
+  } else {
+    LOG_DEBUG("Fetch failed with event %d", _event);
+  }
+  return response ? std::string_view{response, static_cast<size_t>(length)} : std::string_view{};
+}
+
+} // end namespace atscppapi
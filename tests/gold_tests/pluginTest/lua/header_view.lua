@@ -0,0 +1,31 @@
+--  Licensed to the Apache Software Foundation (ASF) under one
+--  or more contributor license agreements.  See the NOTICE file
+--  distributed with this work for additional information
+--  regarding copyright ownership.  The ASF licenses this file
+--  to you under the Apache License, Version 2.0 (the
+--  "License"); you may not use this file except in compliance
+--  with the License.  You may obtain a copy of the License at
+--
+--  http://www.apache.org/licenses/LICENSE-2.0
+--
+--  Unless required by applicable law or agreed to in writing, software
+--  distributed under the License is distributed on an "AS IS" BASIS,
+--  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+--  See the License for the specific language governing permissions and
+--  limitations under the License.
+
+local test = ts.client_request.header_view('X-Test')
+local ua = ts.client_request.header_view('user-agent')
+
+function do_remap()
+    local h = 'exists=' .. tostring(test:exists())
+    h = h .. ' len=' .. tostring(test:len())
+    h = h .. ' equals=' .. tostring(test:equals('test1'))
+    h = h .. ' nocase=' .. tostring(test:equals_nocase('TEST1'))
+    h = h .. ' starts=' .. tostring(test:starts_with('tes'))
+    h = h .. ' find=' .. tostring(test:find('st1'))
+    h = h .. ' get=' .. tostring(test:get())
+    h = h .. ' ua=' .. tostring(ua:starts_with('curl/'))
+    ts.http.set_resp(200, h)
+    return 0
+end
@@ -0,0 +1,65 @@
+'''
+'''
+#  Licensed to the Apache Software Foundation (ASF) under one
+#  or more contributor license agreements.  See the NOTICE file
+#  distributed with this work for additional information
+#  regarding copyright ownership.  The ASF licenses this file
+#  to you under the Apache License, Version 2.0 (the
+#  "License"); you may not use this file except in compliance
+#  with the License.  You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+#  Unless required by applicable law or agreed to in writing, software
+#  distributed under the License is distributed on an "AS IS" BASIS,
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#  See the License for the specific language governing permissions and
+#  limitations under the License.
+
+Test.Summary = '''
+Test lua header view functionality
+'''
+
+Test.SkipUnless(Condition.PluginExists('tslua.so'),)
+
+Test.ContinueOnFail = True
+# Define default ATS
+ts = Test.MakeATSProcess("ts")
+
+ts.Disk.remap_config.AddLine(f"map / http://127.0.0.1 @plugin=tslua.so @pparam=--gc-step=16 @pparam=header_view.lua")
+# A global instance with gc steps, its hook adds no transaction hook.
+ts.Disk.plugin_config.AddLine(f"tslua.so --gc-step=16 {Test.RunDirectory}/global.lua")
+# Configure the tslua's configuration file.
+ts.Setup.Copy("header_view.lua", ts.Variables.CONFIGDIR)
+Test.Setup.Copy("global.lua")
+Test.Setup.Copy("gc_steps.sh")
+
+# Test - Check the header view of a request
+tr = Test.AddTestRun("Lua Header View")
+ps = tr.Processes.Default  # alias
+ps.StartBefore(Test.Processes.ts)
+ps.Command = f"curl -s -D /dev/stderr -H 'X-Test: test1' -H 'X-Test: test2' http://127.0.0.1:{ts.Variables.port}"
+ps.Env = ts.Env
+ps.ReturnCode = 0
+ps.Streams.stdout.Content = Testers.ContainsExpression(
+    "exists=true len=5 equals=true nocase=true starts=true find=3 get=test1,test2 ua=true", "expected header view results")
+tr.StillRunningAfter = ts
+
+# Test - Check the header view of a request without the header
+tr = Test.AddTestRun("Lua Header View Missing")
+ps = tr.Processes.Default  # alias
+ps.Command = f"curl -s -D /dev/stderr http://127.0.0.1:{ts.Variables.port}"
+ps.Env = ts.Env
+ps.ReturnCode = 0
+ps.Streams.stdout.Content = Testers.ContainsExpression(
+    "exists=false len=nil equals=false nocase=false starts=false find=nil get=nil ua=true", "expected header view results")
+tr.StillRunningAfter = ts
+
+# Test - Check that the global instance steps the gc after its hooks
+tr = Test.AddTestRun("Lua Global GC Steps")
+ps = tr.Processes.Default  # alias
+ps.Command = "bash -c ./gc_steps.sh"
+ps.Env = ts.Env
+ps.ReturnCode = 0
+ps.Streams.stdout.Content = Testers.ContainsExpression("gc_steps [1-9]", "expected gc steps of the global instance")
+tr.StillRunningAfter = ts
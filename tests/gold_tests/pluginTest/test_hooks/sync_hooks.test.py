@@ -0,0 +1,72 @@
+#  Licensed to the Apache Software Foundation (ASF) under one
+#  or more contributor license agreements.  See the NOTICE file
+#  distributed with this work for additional information
+#  regarding copyright ownership.  The ASF licenses this file
+#  to you under the Apache License, Version 2.0 (the
+#  "License"); you may not use this file except in compliance
+#  with the License.  You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+#  Unless required by applicable law or agreed to in writing, software
+#  distributed under the License is distributed on an "AS IS" BASIS,
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#  See the License for the specific language governing permissions and
+#  limitations under the License.
+
+import os
+import re
+
+Test.Summary = '''
+Test synchronous hooks, which resume the transaction with their return value.
+'''
+
+Test.ContinueOnFail = True
+
+server = Test.MakeOriginServer("server")
+
+request_header = {"headers": "GET /argh HTTP/1.1\r\nHost: doesnotmatter\r\n\r\n", "timestamp": "1469733493.993", "body": ""}
+response_header = {"headers": "HTTP/1.1 200 OK\r\nConnection: close\r\n\r\n", "timestamp": "1469733493.993", "body": ""}
+server.addResponse("sessionlog.json", request_header, response_header)
+
+ts = Test.MakeATSProcess("ts", enable_cache=False)
+
+ts.Disk.records_config.update(
+    {
+        'proxy.config.diags.debug.tags': 'sync_hooks',
+        'proxy.config.diags.debug.enabled': 1,
+        'proxy.config.url_remap.remap_required': 0,
+    })
+
+Test.PrepareTestPlugin(os.path.join(Test.Variables.AtsTestPluginsDir, 'sync_hooks.so'), ts)
+
+ts.Disk.remap_config.AddLine("map http://one http://127.0.0.1:{0}".format(server.Variables.Port))
+
+# The hooks run in the order they were added, whether synchronous or not.
+tr = Test.AddTestRun()
+tr.Processes.Default.StartBefore(server, ready=When.PortOpen(server.Variables.Port))
+tr.Processes.Default.StartBefore(Test.Processes.ts)
+tr.Processes.Default.Command = ('curl --verbose --ipv4 --header "Host: one" http://localhost:{0}/argh'.format(ts.Variables.port))
+tr.Processes.Default.ReturnCode = 0
+tr.Processes.Default.Streams.stderr = Testers.ContainsExpression(
+    "HTTP/1.1 200 OK", "The synchronous hooks continue the transaction")
+tr.Processes.Default.Streams.stderr += Testers.ContainsExpression(
+    "X-Sync-Hooks: first.*\n.*X-Sync-Hooks: async.*\n.*X-Sync-Hooks: second", "All the hooks are called in order",
+    reflags=re.MULTILINE)
+tr.StillRunningAfter = ts
+
+# A synchronous hook returning TS_EVENT_HTTP_ERROR fails the transaction.
+tr = Test.AddTestRun()
+tr.Processes.Default.Command = ('curl --verbose --ipv4 --header "Host: one" http://localhost:{0}/deny'.format(ts.Variables.port))
+tr.Processes.Default.ReturnCode = 0
+tr.Processes.Default.Streams.stderr = Testers.ContainsExpression("HTTP/1.1 500", "The synchronous hook fails the transaction")
+tr.StillRunningAfter = ts
+
+# Both transactions are counted by the per hook stats.
+tr = Test.AddTestRun()
+tr.Processes.Default.Command = "traffic_ctl metric get proxy.process.http.hook.read_request_hdr.count"
+tr.Processes.Default.Env = ts.Env
+tr.Processes.Default.ReturnCode = 0
+tr.Processes.Default.Streams.stdout = Testers.ContainsExpression(
+    "proxy.process.http.hook.read_request_hdr.count 2", "Both requests are counted")
+tr.StillRunningAfter = ts
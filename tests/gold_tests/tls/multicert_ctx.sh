@@ -0,0 +1,46 @@
+#  Licensed to the Apache Software Foundation (ASF) under one
+#  or more contributor license agreements.  See the NOTICE file
+#  distributed with this work for additional information
+#  regarding copyright ownership.  The ASF licenses this file
+#  to you under the Apache License, Version 2.0 (the
+#  "License"); you may not use this file except in compliance
+#  with the License.  You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+#  Unless required by applicable law or agreed to in writing, software
+#  distributed under the License is distributed on an "AS IS" BASIS,
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#  See the License for the specific language governing permissions and
+#  limitations under the License.
+
+# Save the ssl_multicert context counters with "save", then "check" that a reload since then built one context and
+# reused one.
+
+metric() {
+    traffic_ctl metric get "proxy.process.ssl.$1" | awk '{print $2}'
+}
+
+case "$1" in
+save)
+    echo "$(metric multicert_ctx_built) $(metric multicert_ctx_reused)" > multicert_ctx.before
+    ;;
+check)
+    read -r BUILT REUSED < multicert_ctx.before
+    N=60
+    while (( N > 0 ))
+    do
+        B=$(metric multicert_ctx_built)
+        R=$(metric multicert_ctx_reused)
+        if (( B == BUILT + 1 && R == REUSED + 1 ))
+        then
+            echo "built +1 reused +1"
+            exit 0
+        fi
+        sleep 1
+        let N=N-1
+    done
+    echo "built ${BUILT} -> ${B} reused ${REUSED} -> ${R}"
+    exit 1
+    ;;
+esac
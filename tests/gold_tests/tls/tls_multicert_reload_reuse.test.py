@@ -0,0 +1,119 @@
+'''
+'''
+#  Licensed to the Apache Software Foundation (ASF) under one
+#  or more contributor license agreements.  See the NOTICE file
+#  distributed with this work for additional information
+#  regarding copyright ownership.  The ASF licenses this file
+#  to you under the Apache License, Version 2.0 (the
+#  "License"); you may not use this file except in compliance
+#  with the License.  You may obtain a copy of the License at
+#
+#      http://www.apache.org/licenses/LICENSE-2.0
+#
+#  Unless required by applicable law or agreed to in writing, software
+#  distributed under the License is distributed on an "AS IS" BASIS,
+#  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#  See the License for the specific language governing permissions and
+#  limitations under the License.
+
+Test.Summary = '''
+Test that a reload of ssl_multicert.config rebuilds the changed certificate only
+'''
+
+ts = Test.MakeATSProcess("ts", enable_tls=True)
+server = Test.MakeOriginServer("server", ssl=True)
+
+request_header = {"headers": "GET / HTTP/1.1\r\n\r\n", "timestamp": "1469733493.993", "body": ""}
+response_header = {"headers": "HTTP/1.1 200 OK\r\nConnection: close\r\n\r\n", "timestamp": "1469733493.993", "body": ""}
+server.addResponse("sessionlog.json", request_header, response_header)
+
+ts.addSSLfile("ssl/signed-bar.pem")
+ts.addSSLfile("ssl/signed-bar.key")
+ts.addSSLfile("ssl/signed-foo.pem")
+ts.addSSLfile("ssl/signed-foo.key")
+
+ts.Disk.ssl_multicert_config.AddLines(
+    [
+        'ssl_cert_name=signed-bar.pem ssl_key_name=signed-bar.key',
+        'dest_ip=* ssl_cert_name=signed-foo.pem ssl_key_name=signed-foo.key',
+    ])
+
+# Build the contexts on more than one thread.
+ts.Disk.records_config.update(
+    {
+        'proxy.config.ssl.server.cert.path': '{0}'.format(ts.Variables.SSLDir),
+        'proxy.config.ssl.server.private_key.path': '{0}'.format(ts.Variables.SSLDir),
+        'proxy.config.ssl.server.multicert.load_threads': 2,
+        'proxy.config.diags.debug.tags': 'ssl_load',
+        'proxy.config.diags.debug.enabled': 1
+    })
+
+Test.Setup.Copy("multicert_ctx.sh")
+
+curl_bar = "curl -v --cacert ./{1} --resolve 'bar.com:{0}:127.0.0.1' https://bar.com:{0}/random"
+curl_foo = "curl -v --cacert ./signer.pem --resolve 'foo.com:{0}:127.0.0.1' https://foo.com:{0}/random".format(
+    ts.Variables.ssl_port)
+
+tr = Test.AddTestRun("bar.com cert signer1")
+tr.Setup.Copy("ssl/signer.pem")
+tr.Setup.Copy("ssl/signer2.pem")
+tr.Processes.Default.Command = curl_bar.format(ts.Variables.ssl_port, "signer.pem")
+tr.ReturnCode = 0
+tr.Processes.Default.StartBefore(server)
+tr.Processes.Default.StartBefore(Test.Processes.ts)
+tr.StillRunningAfter = server
+tr.StillRunningAfter = ts
+tr.Processes.Default.Streams.All = Testers.ContainsExpression("CN=bar.com", "Cert should contain bar.com")
+tr.Processes.Default.Streams.All += Testers.ContainsExpression("404", "Should make an exchange")
+
+tr = Test.AddTestRun("Save the context counters")
+tr.Processes.Default.Command = "bash -c './multicert_ctx.sh save'"
+tr.Processes.Default.Env = ts.Env
+tr.Processes.Default.ReturnCode = 0
+tr.StillRunningAfter = ts
+
+# Pause a little to ensure mtime will be different
+tr = Test.AddTestRun("Update the bar cert to the signed 2 version")
+tr.Setup.CopyAs("ssl/signed2-bar.pem", ".", "{0}/signed-bar.pem".format(ts.Variables.SSLDir))
+tr.Processes.Default.Command = 'sleep 2 && touch {0}/signed-bar.pem'.format(ts.Variables.SSLDir)
+tr.Processes.Default.Env = ts.Env
+tr.Processes.Default.ReturnCode = 0
+
+tr = Test.AddTestRun("Reload config")
+tr.Processes.Default.Command = 'traffic_ctl config reload'
+# Need to copy over the environment so traffic_ctl knows where to find the unix domain socket
+tr.Processes.Default.Env = ts.Env
+tr.Processes.Default.ReturnCode = 0
+tr.StillRunningAfter = ts
+
+# The foo.com context is reused, the bar.com one is built again.
+tr = Test.AddTestRun("Check the context counters")
+tr.Processes.Default.Command = "bash -c './multicert_ctx.sh check'"
+tr.Processes.Default.Env = ts.Env
+tr.Processes.Default.ReturnCode = 0
+tr.Processes.Default.Streams.stdout = Testers.ContainsExpression("built \\+1 reused \\+1", "one context built and one reused")
+tr.StillRunningAfter = ts
+
+tr = Test.AddTestRun("bar.com cert signer2")
+tr.Processes.Default.Command = curl_bar.format(ts.Variables.ssl_port, "signer2.pem")
+tr.ReturnCode = 0
+tr.StillRunningAfter = server
+tr.StillRunningAfter = ts
+tr.Processes.Default.Streams.All = Testers.ContainsExpression("CN=bar.com", "Cert should contain bar.com")
+tr.Processes.Default.Streams.All += Testers.ContainsExpression("404", "Should make an exchange")
+
+tr = Test.AddTestRun("bar.com cert signer1 is gone")
+tr.Processes.Default.Command = curl_bar.format(ts.Variables.ssl_port, "signer.pem")
+tr.ReturnCode = 60
+tr.StillRunningAfter = server
+tr.StillRunningAfter = ts
+tr.Processes.Default.Streams.All = Testers.ContainsExpression(
+    "unable to get local issuer certificate", "Server certificate not issued by expected signer")
+
+tr = Test.AddTestRun("foo.com cert is still served")
+tr.Processes.Default.Command = curl_foo
+tr.ReturnCode = 0
+tr.StillRunningAfter = server
+tr.StillRunningAfter = ts
+tr.Processes.Default.Streams.All = Testers.ContainsExpression("CN=foo.com", "Cert should contain foo.com")
+tr.Processes.Default.Streams.All += Testers.ContainsExpression("404", "Should make an exchange")
@@ -0,0 +1,128 @@
+/** @file
+
+  Test the coroutines of the C++ plugin API, see tscpp/api/Coroutine.h.
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include <ts/ts.h>
+#include <cinttypes>
+#include <cstring>
+#include <string>
+
+#include "tscpp/api/Coroutine.h"
+
+#define PLUGIN_TAG "cppapi_coroutine"
+
+namespace
+{
+DbgCtl dbg_ctl{PLUGIN_TAG};
+
+constexpr TSHRTime SLEEP_MS = 50;
+
+void
+add_header(TSMBuffer bufp, TSMLoc hdr_loc, std::string const &value)
+{
+  TSMLoc field_loc;
+
+  if (TSMimeHdrFieldCreateNamed(bufp, hdr_loc, "X-Coroutine", -1, &field_loc) == TS_SUCCESS) {
+    TSMimeHdrFieldValueStringSet(bufp, hdr_loc, field_loc, -1, value.data(), value.size());
+    TSMimeHdrFieldAppend(bufp, hdr_loc, field_loc);
+    TSHandleMLocRelease(bufp, hdr_loc, field_loc);
+  }
+}
+
+bool
+is_denied(TSHttpTxn txnp)
+{
+  TSMBuffer   bufp;
+  TSMLoc      hdr_loc;
+  TSMLoc      url_loc = TS_NULL_MLOC;
+  char const *path    = nullptr;
+  int         len     = 0;
+
+  if (TSHttpTxnClientReqGet(txnp, &bufp, &hdr_loc) != TS_SUCCESS) {
+    return false;
+  }
+  if (TSHttpHdrUrlGet(bufp, hdr_loc, &url_loc) == TS_SUCCESS) {
+    path = TSUrlPathGet(bufp, url_loc, &len);
+  }
+  bool denied = path != nullptr && len == 4 && memcmp(path, "deny", 4) == 0;
+  TSHandleMLocRelease(bufp, hdr_loc, url_loc);
+  TSHandleMLocRelease(bufp, TS_NULL_MLOC, hdr_loc);
+  return denied;
+}
+
+// Holds the transaction from the read request header hook.
+atscppapi::Task
+handle_txn(TSHttpTxn txnp)
+{
+  TSEventThread thread = TSEventThreadSelf();
+  TSHRTime      start  = TShrtime();
+
+  co_await atscppapi::Sleep(SLEEP_MS);
+
+  TSHRTime slept       = (TShrtime() - start) / TS_HRTIME_MSECOND;
+  bool     same_thread = TSEventThreadSelf() == thread;
+
+  Dbg(dbg_ctl, "slept %" PRId64 " ms", slept);
+  if (is_denied(txnp)) {
+    co_await atscppapi::Reenable(TS_EVENT_HTTP_ERROR);
+    co_return;
+  }
+
+  TSEvent event = co_await atscppapi::Hook(txnp, TS_HTTP_SEND_RESPONSE_HDR_HOOK);
+
+  TSMBuffer bufp;
+  TSMLoc    hdr_loc;
+
+  if (event == TS_EVENT_HTTP_SEND_RESPONSE_HDR && TSHttpTxnClientRespGet(txnp, &bufp, &hdr_loc) == TS_SUCCESS) {
+    add_header(bufp, hdr_loc,
+               std::string(slept >= SLEEP_MS ? "slept" : "awake") + (same_thread ? " same-thread" : " other-thread"));
+    TSHandleMLocRelease(bufp, TS_NULL_MLOC, hdr_loc);
+  }
+  // The transaction is reenabled when the coroutine returns.
+}
+
+int
+read_request_hdr(TSCont /* contp ATS_UNUSED */, TSEvent /* event ATS_UNUSED */, void *edata)
+{
+  // The coroutine reenables the transaction.
+  handle_txn(static_cast<TSHttpTxn>(edata));
+  return 0;
+}
+
+} // namespace
+
+void
+TSPluginInit(int argc, const char *argv[])
+{
+  TSPluginRegistrationInfo info;
+
+  info.plugin_name   = PLUGIN_TAG;
+  info.vendor_name   = "Apache Software Foundation";
+  info.support_email = "dev@trafficserver.apache.org";
+
+  if (TSPluginRegister(&info) != TS_SUCCESS) {
+    TSError("[%s] Plugin registration failed", PLUGIN_TAG);
+    return;
+  }
+
+  TSHttpHookAdd(TS_HTTP_READ_REQUEST_HDR_HOOK, TSContCreate(read_request_hdr, nullptr));
+}
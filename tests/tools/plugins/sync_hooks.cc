@@ -0,0 +1,134 @@
+/** @file
+
+  Test synchronous HTTP hooks, see TSContSyncHookSet().
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+
+      http://www.apache.org/licenses/LICENSE-2.0
+
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#include <ts/ts.h>
+#include <cstring>
+
+#define PLUGIN_TAG "sync_hooks"
+
+namespace
+{
+DbgCtl dbg_ctl{PLUGIN_TAG};
+
+void
+add_header(TSMBuffer bufp, TSMLoc hdr_loc, const char *value)
+{
+  TSMLoc field_loc;
+
+  if (TSMimeHdrFieldCreateNamed(bufp, hdr_loc, "X-Sync-Hooks", -1, &field_loc) == TS_SUCCESS) {
+    TSMimeHdrFieldValueStringSet(bufp, hdr_loc, field_loc, -1, value, -1);
+    TSMimeHdrFieldAppend(bufp, hdr_loc, field_loc);
+    TSHandleMLocRelease(bufp, hdr_loc, field_loc);
+  }
+}
+
+// Synchronous, returns the event to resume the transaction with.
+int
+sync_handler(TSCont contp, TSEvent event, void *edata)
+{
+  TSHttpTxn txnp = static_cast<TSHttpTxn>(edata);
+  TSMBuffer bufp;
+  TSMLoc    hdr_loc;
+  int       result = TS_EVENT_HTTP_CONTINUE;
+
+  switch (event) {
+  case TS_EVENT_HTTP_READ_REQUEST_HDR:
+    if (TSHttpTxnClientReqGet(txnp, &bufp, &hdr_loc) == TS_SUCCESS) {
+      int         len;
+      TSMLoc      url_loc = TS_NULL_MLOC;
+      char const *path    = nullptr;
+
+      if (TSHttpHdrUrlGet(bufp, hdr_loc, &url_loc) == TS_SUCCESS) {
+        path = TSUrlPathGet(bufp, url_loc, &len);
+      }
+      if (path != nullptr && len == 4 && memcmp(path, "deny", 4) == 0) {
+        Dbg(dbg_ctl, "denying the request");
+        result = TS_EVENT_HTTP_ERROR;
+      }
+      TSHandleMLocRelease(bufp, hdr_loc, url_loc);
+      TSHandleMLocRelease(bufp, TS_NULL_MLOC, hdr_loc);
+    }
+    break;
+  case TS_EVENT_HTTP_SEND_RESPONSE_HDR:
+    if (TSHttpTxnClientRespGet(txnp, &bufp, &hdr_loc) == TS_SUCCESS) {
+      add_header(bufp, hdr_loc, TSContDataGet(contp) ? "second" : "first");
+      TSHandleMLocRelease(bufp, TS_NULL_MLOC, hdr_loc);
+    }
+    break;
+  default:
+    break;
+  }
+
+  Dbg(dbg_ctl, "sync hook for event %d", event);
+  return result;
+}
+
+// Asynchronous, resumes the transaction with TSHttpTxnReenable().
+int
+async_handler(TSCont contp, TSEvent event, void *edata)
+{
+  TSHttpTxn txnp = static_cast<TSHttpTxn>(edata);
+  TSMBuffer bufp;
+  TSMLoc    hdr_loc;
+
+  if (event == TS_EVENT_HTTP_SEND_RESPONSE_HDR && TSHttpTxnClientRespGet(txnp, &bufp, &hdr_loc) == TS_SUCCESS) {
+    add_header(bufp, hdr_loc, "async");
+    TSHandleMLocRelease(bufp, TS_NULL_MLOC, hdr_loc);
+  }
+
+  Dbg(dbg_ctl, "async hook for event %d", event);
+  TSHttpTxnReenable(txnp, TS_EVENT_HTTP_CONTINUE);
+  return 0;
+}
+
+} // namespace
+
+void
+TSPluginInit(int argc, const char *argv[])
+{
+  TSPluginRegistrationInfo info;
+
+  info.plugin_name   = PLUGIN_TAG;
+  info.vendor_name   = "Apache Software Foundation";
+  info.support_email = "dev@trafficserver.apache.org";
+
+  if (TSPluginRegister(&info) != TS_SUCCESS) {
+    TSError("[%s] Plugin registration failed", PLUGIN_TAG);
+    return;
+  }
+
+  // Two synchronous hooks around an asynchronous one, to check the order is kept.
+  TSCont first  = TSContCreate(sync_handler, nullptr);
+  TSCont async  = TSContCreate(async_handler, nullptr);
+  TSCont second = TSContCreate(sync_handler, nullptr);
+
+  TSContSyncHookSet(first, true);
+  TSContSyncHookSet(second, true);
+  TSContDataSet(second, second);
+
+  TSHttpHookAdd(TS_HTTP_READ_REQUEST_HDR_HOOK, first);
+  TSHttpHookAdd(TS_HTTP_SEND_RESPONSE_HDR_HOOK, first);
+  TSHttpHookAdd(TS_HTTP_SEND_RESPONSE_HDR_HOOK, async);
+  TSHttpHookAdd(TS_HTTP_SEND_RESPONSE_HDR_HOOK, second);
+  TSHttpHookAdd(TS_HTTP_TXN_CLOSE_HOOK, second);
+}
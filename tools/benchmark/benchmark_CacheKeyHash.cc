@@ -0,0 +1,169 @@
+/** @file
+
+  Micro Benchmark tool for cache key hashing - requires Catch2 v2.9.0+
+
+  Compares the default cryptographic cache key hash with MurmurHash3, and reports collision
+  counts and bucket distribution for each over a set of synthetic URLs.
+
+  - e.g. hashing one million URLs
+  ```
+  $ ./benchmark_CacheKeyHash --ts-nkeys 1000000
+  ```
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+      http://www.apache.org/licenses/LICENSE-2.0
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+
+#include "catch.hpp"
+
+#include "tscore/CryptoHash.h"
+
+#include <iostream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace
+{
+// Args
+int nkeys    = 100000;
+int nbuckets = 16384;
+
+std::vector<std::string> urls;
+
+void
+make_urls()
+{
+  urls.clear();
+  urls.reserve(nkeys);
+  for (int i = 0; i < nkeys; ++i) {
+    urls.emplace_back("http://cdn" + std::to_string(i % 97) + ".example.com/assets/" + std::to_string(i / 97) + "/image-" +
+                      std::to_string(i) + ".jpg?v=" + std::to_string(i % 7));
+  }
+}
+
+uint64_t
+hash_all(CryptoContext::HashType type)
+{
+  uint64_t sum = 0;
+
+  for (auto const &url : urls) {
+    CryptoContext ctx(type);
+    CryptoHash    hash;
+
+    ctx.hash_immediate(hash, url.data(), url.size());
+    sum += hash.u64[0];
+  }
+
+  return sum;
+}
+
+// Counts full key collisions, collisions of the 32 bit value the cache uses to pick a stripe
+// and directory bucket, and the chi-squared statistic of the bucket distribution.
+void
+analyze(const char *name, CryptoContext::HashType type)
+{
+  std::unordered_set<std::string> full;
+  std::unordered_set<uint32_t>    folded;
+  std::vector<int64_t>            buckets(nbuckets, 0);
+  int64_t                         full_collisions = 0, folded_collisions = 0;
+
+  for (auto const &url : urls) {
+    CryptoContext ctx(type);
+    CryptoHash    hash;
+
+    ctx.hash_immediate(hash, url.data(), url.size());
+    if (!full.emplace(reinterpret_cast<const char *>(hash.u8), CRYPTO_HASH_SIZE).second) {
+      ++full_collisions;
+    }
+
+    uint32_t h32 = static_cast<uint32_t>(hash.fold() >> 32);
+    if (!folded.insert(h32).second) {
+      ++folded_collisions;
+    }
+    ++buckets[h32 % nbuckets];
+  }
+
+  double expected = static_cast<double>(nkeys) / nbuckets;
+  double chi2     = 0;
+
+  for (auto count : buckets) {
+    chi2 += (count - expected) * (count - expected) / expected;
+  }
+
+  // For an ideal hash, the chi-squared value is close to the number of buckets - 1, and the number of
+  // 32 bit collisions close to n^2 / 2^33.
+  std::cout << name << ": keys=" << nkeys << " full_collisions=" << full_collisions << " fold32_collisions=" << folded_collisions
+            << " (ideal ~" << static_cast<double>(nkeys) * nkeys / 8589934592.0 << ") chi2=" << chi2 << " (ideal ~"
+            << nbuckets - 1 << ")" << std::endl;
+
+  CHECK(full_collisions == 0);
+}
+
+} // namespace
+
+TEST_CASE("Micro benchmark of cache key hashing", "")
+{
+  make_urls();
+
+  SECTION("Collision analysis")
+  {
+    analyze("default", CryptoContext::UNSPECIFIED);
+    analyze("murmur3", CryptoContext::MURMUR3);
+  }
+
+  SECTION("default")
+  {
+    BENCHMARK("default")
+    {
+      return hash_all(CryptoContext::UNSPECIFIED);
+    };
+  }
+
+  SECTION("murmur3")
+  {
+    BENCHMARK("murmur3")
+    {
+      return hash_all(CryptoContext::MURMUR3);
+    };
+  }
+}
+
+int
+main(int argc, char *argv[])
+{
+  Catch::Session session;
+
+  using namespace Catch::clara;
+
+  // clang-format off
+  auto cli = session.cli() |
+    Opt(nkeys, "")["--ts-nkeys"]("number of URLs to hash (default: 100000)") |
+    Opt(nbuckets, "")["--ts-nbuckets"]("number of buckets for the distribution check (default: 16384)");
+  // clang-format on
+
+  session.cli(cli);
+
+  int returnCode = session.applyCommandLine(argc, argv);
+  if (returnCode != 0) {
+    return returnCode;
+  }
+
+  return session.run();
+}
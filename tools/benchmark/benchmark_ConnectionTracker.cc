@@ -0,0 +1,196 @@
+/** @file
+
+  Micro Benchmark tool for the ConnectionTracker group tables - requires Catch2 v2.9.0+
+
+  Each thread opens and closes outbound connections the way a transaction does, it looks up the group of the upstream,
+  reserves a connection and releases it when the connection closes. A thread keeps a number of connections open, so
+  that most of the groups stay in the table and the lookups find them.
+
+  - e.g. 64 threads, 1000 upstreams, 16 open connections per thread
+  ```
+  $ taskset -c 0-63 ./benchmark_ConnectionTracker --ts-nthreads 64 --ts-ngroups 1000 --ts-nopen 16
+  ```
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+      http://www.apache.org/licenses/LICENSE-2.0
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+
+#include "catch.hpp"
+
+#include "P_Net.h"
+#include "iocore/net/ConnectionTracker.h"
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+// The table size gauge of the groups, normally set up with the other net stats.
+NetStatsBlock net_rsb;
+
+namespace
+{
+// Args
+struct Conf {
+  int nloop    = 10000;
+  int nthreads = 1;
+  int ngroups  = 1000;
+  int nopen    = 16;
+};
+
+Conf conf;
+
+// The global configuration is set by the records callbacks, there are no records here.
+struct Tracker : public ConnectionTracker {
+  static void
+  init()
+  {
+    static GlobalConfig config;
+    _global_config = &config;
+  }
+};
+
+struct Upstream {
+  IpEndpoint  addr;
+  std::string fqdn;
+};
+
+std::vector<Upstream> upstreams;
+
+void
+make_upstreams()
+{
+  upstreams.resize(conf.ngroups);
+  for (int i = 0; i < conf.ngroups; ++i) {
+    upstreams[i].addr.setToLoopback(AF_INET);
+    upstreams[i].addr.sin.sin_addr.s_addr  = htonl((10u << 24) + i);
+    upstreams[i].addr.network_order_port() = htons(443);
+    upstreams[i].fqdn                      = "origin" + std::to_string(i) + ".example.com";
+  }
+}
+
+/// Open and close @c nloop connections in each thread, @c nopen kept open. @return the number of connections opened.
+uint64_t
+run(ConnectionTracker::TxnConfig const &txn_cnf)
+{
+  std::vector<std::thread> threads;
+  std::atomic<uint64_t>    opened{0};
+
+  for (int t = 0; t < conf.nthreads; ++t) {
+    threads.emplace_back([&, t]() {
+      std::mt19937                                           rng(t);
+      std::uniform_int_distribution<int>                     pick(0, conf.ngroups - 1);
+      std::vector<std::shared_ptr<ConnectionTracker::Group>> open(conf.nopen);
+
+      for (int i = 0; i < conf.nloop; ++i) {
+        auto &slot = open[i % conf.nopen];
+        // The oldest connection closes.
+        if (slot) {
+          slot->release();
+          slot.reset();
+        }
+
+        auto &up    = upstreams[pick(rng)];
+        auto  state = ConnectionTracker::obtain_outbound(txn_cnf, up.fqdn, up.addr);
+        state.reserve();
+        slot = state.drop();
+      }
+      for (auto &g : open) {
+        if (g) {
+          g->release();
+        }
+      }
+      opened += conf.nloop;
+    });
+  }
+  for (auto &thread : threads) {
+    thread.join();
+  }
+  return opened;
+}
+
+void
+report(const char *name, ConnectionTracker::TxnConfig const &txn_cnf)
+{
+  auto     start  = std::chrono::steady_clock::now();
+  uint64_t opened = run(txn_cnf);
+  auto     usecs  = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+  std::cout << name << ": " << conf.nthreads << " threads, " << opened * 1000000 / std::max<int64_t>(usecs, 1)
+            << " connections opened and closed per second" << std::endl;
+}
+
+} // namespace
+
+TEST_CASE("Micro benchmark of the ConnectionTracker group tables", "")
+{
+  ConnectionTracker::TxnConfig ip_cnf;
+  ConnectionTracker::TxnConfig host_cnf;
+
+  ip_cnf.server_match   = ConnectionTracker::MATCH_IP;
+  host_cnf.server_match = ConnectionTracker::MATCH_BOTH;
+
+  BENCHMARK("match by ip")
+  {
+    return run(ip_cnf);
+  };
+
+  BENCHMARK("match by host and ip")
+  {
+    return run(host_cnf);
+  };
+
+  std::cout << std::endl;
+  report("match by ip", ip_cnf);
+  report("match by host and ip", host_cnf);
+}
+
+int
+main(int argc, char *argv[])
+{
+  Catch::Session session;
+
+  using namespace Catch::clara;
+
+  // clang-format off
+  auto cli = session.cli() |
+    Opt(conf.nthreads, "")["--ts-nthreads"]("number of threads (default: 1)") |
+    Opt(conf.nloop, "")["--ts-nloop"]("number of connections opened by each thread (default: 10000)") |
+    Opt(conf.ngroups, "")["--ts-ngroups"]("number of upstreams (default: 1000)") |
+    Opt(conf.nopen, "")["--ts-nopen"]("number of connections each thread keeps open (default: 16)");
+  // clang-format on
+
+  session.cli(cli);
+
+  int returnCode = session.applyCommandLine(argc, argv);
+  if (returnCode != 0) {
+    return returnCode;
+  }
+
+  conf.ngroups = std::max(conf.ngroups, 1);
+  conf.nopen   = std::max(conf.nopen, 1);
+
+  Tracker::init();
+  net_rsb.connection_tracker_table_size = Metrics::Gauge::createPtr("proxy.process.net.connection_tracker_table_size");
+  make_upstreams();
+
+  return session.run();
+}
@@ -0,0 +1,209 @@
+/** @file
+
+  Micro Benchmark tool for ATSConsistentHash lookups - requires Catch2 v2.9.0+
+
+  Measures lookups against rings of increasing size, along with a std::map of the same
+  positions for comparison, and the ATSTableHash maglev and jump hash lookups.
+
+  - e.g. 100 parents
+  ```
+  $ ./benchmark_ConsistentHash --ts-nparents 100
+  ```
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+      http://www.apache.org/licenses/LICENSE-2.0
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+
+#include "catch.hpp"
+
+#include "tscore/ConsistentHash.h"
+#include "tscore/HashSip.h"
+#include "tscore/TableHash.h"
+
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Args
+int nparents = 10;
+int nlookups = 100000;
+
+struct Ring {
+  std::vector<std::unique_ptr<ATSConsistentHashNode>> nodes;
+  std::vector<std::string>                            names;
+  std::unique_ptr<ATSConsistentHash>                  ring;
+  std::map<uint64_t, ATSConsistentHashNode *>         map;
+};
+
+std::unique_ptr<Ring>
+make_ring(int replicas)
+{
+  auto           r = std::make_unique<Ring>();
+  ATSHash64Sip24 hash;
+
+  r->ring = std::make_unique<ATSConsistentHash>(replicas);
+  r->names.reserve(nparents);
+  for (int i = 0; i < nparents; ++i) {
+    r->names.push_back("parent" + std::to_string(i) + ".example.com");
+    r->nodes.push_back(std::make_unique<ATSConsistentHashNode>());
+    r->nodes.back()->name = r->names.back().data();
+    r->ring->insert(r->nodes.back().get(), 1.0, &hash);
+
+    for (int j = 0; j < replicas; ++j) {
+      std::string key = std::to_string(j) + "-" + r->names.back();
+
+      hash.update(key.data(), key.size());
+      hash.final();
+      r->map.emplace(hash.get(), r->nodes.back().get());
+      hash.clear();
+    }
+  }
+
+  return r;
+}
+
+std::vector<uint64_t>
+make_hashes()
+{
+  std::mt19937_64       engine(1);
+  std::vector<uint64_t> hashes(nlookups);
+
+  for (auto &h : hashes) {
+    h = engine();
+  }
+  return hashes;
+}
+
+} // namespace
+
+TEST_CASE("Micro benchmark of consistent hash lookups", "")
+{
+  auto hashes = make_hashes();
+
+  for (int replicas : {128, 1024, 8192}) {
+    auto        r    = make_ring(replicas);
+    std::string size = std::to_string(nparents * replicas);
+
+    BENCHMARK("flat ring, " + size + " positions")
+    {
+      uintptr_t sum = 0;
+      for (auto h : hashes) {
+        sum += reinterpret_cast<uintptr_t>(r->ring->lookup_by_hashval(h));
+      }
+      return sum;
+    };
+
+    BENCHMARK("bounded flat ring, " + size + " positions")
+    {
+      uintptr_t sum = 0;
+      for (auto h : hashes) {
+        sum += reinterpret_cast<uintptr_t>(r->ring->lookup_bounded(h, 1.25));
+      }
+      return sum;
+    };
+
+    BENCHMARK("std::map, " + size + " positions")
+    {
+      uintptr_t sum = 0;
+      for (auto h : hashes) {
+        auto it = r->map.lower_bound(h);
+        if (it == r->map.end()) {
+          it = r->map.begin();
+        }
+        sum += reinterpret_cast<uintptr_t>(it->second);
+      }
+      return sum;
+    };
+  }
+}
+
+TEST_CASE("Micro benchmark of table hash lookups", "")
+{
+  auto                                                hashes = make_hashes();
+  std::vector<std::unique_ptr<ATSConsistentHashNode>> nodes;
+  std::vector<std::string>                            names;
+
+  ATSTableHash maglev(ATSTableHash::MAGLEV, ATSTableHash::DEFAULT_TABLE_SIZE, new ATSHash64Sip24);
+  ATSTableHash jump(ATSTableHash::JUMP, 0, new ATSHash64Sip24);
+
+  names.reserve(nparents);
+  for (int i = 0; i < nparents; ++i) {
+    names.push_back("parent" + std::to_string(i) + ".example.com");
+    nodes.push_back(std::make_unique<ATSConsistentHashNode>());
+    nodes.back()->name = names.back().data();
+    maglev.insert(nodes.back().get());
+    jump.insert(nodes.back().get());
+  }
+  maglev.build();
+  jump.build();
+
+  BENCHMARK("maglev, " + std::to_string(maglev.table_size()) + " entries")
+  {
+    uintptr_t sum = 0;
+    for (auto h : hashes) {
+      sum += reinterpret_cast<uintptr_t>(maglev.lookup_by_hashval(h));
+    }
+    return sum;
+  };
+
+  BENCHMARK("maglev fallback")
+  {
+    uintptr_t sum = 0;
+    for (auto h : hashes) {
+      sum += reinterpret_cast<uintptr_t>(maglev.lookup_by_hashval(h, 1));
+    }
+    return sum;
+  };
+
+  BENCHMARK("jump hash")
+  {
+    uintptr_t sum = 0;
+    for (auto h : hashes) {
+      sum += reinterpret_cast<uintptr_t>(jump.lookup_by_hashval(h));
+    }
+    return sum;
+  };
+}
+
+int
+main(int argc, char *argv[])
+{
+  Catch::Session session;
+
+  using namespace Catch::clara;
+
+  // clang-format off
+  auto cli = session.cli() |
+    Opt(nparents, "")["--ts-nparents"]("number of parents on the ring (default: 10)") |
+    Opt(nlookups, "")["--ts-nlookups"]("number of lookups per benchmark run (default: 100000)");
+  // clang-format on
+
+  session.cli(cli);
+
+  int returnCode = session.applyCommandLine(argc, argv);
+  if (returnCode != 0) {
+    return returnCode;
+  }
+
+  return session.run();
+}
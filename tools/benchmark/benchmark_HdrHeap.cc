@@ -0,0 +1,177 @@
+/** @file
+
+  Micro Benchmark tool for the cache hit path of header heaps - requires Catch2 v2.9.0+
+
+  Measures marshalling a response header for the cache, unmarshalling it from a cache buffer, and
+  copying it into a writable header followed by the first modification, as done for every response
+  served from the cache.
+
+  - e.g. a response header with 40 fields
+  ```
+  $ ./benchmark_HdrHeap --ts-nfields 40
+  ```
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+      http://www.apache.org/licenses/LICENSE-2.0
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+
+#include "catch.hpp"
+
+#include "proxy/hdrs/HTTP.h"
+
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+
+extern int cmd_disable_pfreelist;
+
+namespace
+{
+// Args
+int nfields = 20;
+
+// The cache buffer pins the strings of an unmarshalled header.
+struct PinnedBlock : public RefCountObj {
+  void
+  free() override
+  {
+  }
+};
+
+void
+parse_response(HTTPHdr &hdr)
+{
+  std::string response = "HTTP/1.1 200 OK\r\nDate: Mon, 19 Oct 2026 00:00:00 GMT\r\nContent-Length: 1024\r\n";
+  for (int i = 0; i < nfields; ++i) {
+    response += "X-Field-" + std::to_string(i) + ": value-" + std::to_string(i) + "\r\n";
+  }
+  response += "\r\n";
+
+  HTTPParser  parser;
+  const char *start = response.data();
+
+  hdr.create(HTTP_TYPE_RESPONSE);
+  http_parser_init(&parser);
+  REQUIRE(hdr.parse_resp(&parser, &start, response.data() + response.size(), true) == PARSE_RESULT_DONE);
+  http_parser_clear(&parser);
+}
+
+// What HttpTransactHeaders::copy_header_fields does to a cached response.
+int
+copy_and_modify(HTTPHdr *src)
+{
+  HTTPHdr copy;
+
+  copy.copy(src);
+  copy.field_delete(MIME_FIELD_DATE, MIME_LEN_DATE);
+  copy.set_age(60);
+  int n = copy.fields_count();
+  copy.destroy();
+  return n;
+}
+
+} // namespace
+
+TEST_CASE("Micro benchmark of the header cache hit path", "")
+{
+  HTTPHdr     hdr;
+  PinnedBlock block;
+
+  parse_response(hdr);
+  block.refcount_inc();
+
+  int                     length = hdr.m_heap->marshal_length();
+  std::unique_ptr<char[]> marshalled(new char[length]);
+  std::unique_ptr<char[]> buf(new char[length]);
+  int                     marshal_len = hdr.m_heap->marshal(marshalled.get(), length);
+  REQUIRE(marshal_len > 0);
+
+  HTTPHdr cached;
+  memcpy(buf.get(), marshalled.get(), marshal_len);
+  REQUIRE(cached.unmarshal(buf.get(), marshal_len, &block) > 0);
+
+  std::cout << "fields=" << cached.fields_count() << " marshalled=" << marshal_len << " bytes" << std::endl;
+
+  SECTION("marshal")
+  {
+    std::unique_ptr<char[]> out(new char[length]);
+
+    BENCHMARK("marshal")
+    {
+      return hdr.m_heap->marshal(out.get(), length);
+    };
+  }
+
+  SECTION("unmarshal")
+  {
+    // The cache unmarshals in place, so each run needs a fresh copy of the marshalled buffer.
+    std::unique_ptr<char[]> in(new char[length]);
+
+    BENCHMARK("unmarshal")
+    {
+      HTTPHdr h;
+
+      memcpy(in.get(), marshalled.get(), marshal_len);
+      return h.unmarshal(in.get(), marshal_len, &block);
+    };
+  }
+
+  SECTION("copy and modify")
+  {
+    // A writable heap is cloned object by object, an unmarshalled one with a single copy.
+    BENCHMARK("writable header")
+    {
+      return copy_and_modify(&hdr);
+    };
+
+    BENCHMARK("unmarshalled header")
+    {
+      return copy_and_modify(&cached);
+    };
+  }
+
+  hdr.destroy();
+}
+
+int
+main(int argc, char *argv[])
+{
+  Catch::Session session;
+
+  using namespace Catch::clara;
+
+  // clang-format off
+  auto cli = session.cli() |
+    Opt(nfields, "")["--ts-nfields"]("number of fields in the response header (default: 20)");
+  // clang-format on
+
+  session.cli(cli);
+
+  int returnCode = session.applyCommandLine(argc, argv);
+  if (returnCode != 0) {
+    return returnCode;
+  }
+
+  // No thread setup, forbid use of thread local allocators.
+  cmd_disable_pfreelist = true;
+  http_init();
+
+  return session.run();
+}
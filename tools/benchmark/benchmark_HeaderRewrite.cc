@@ -0,0 +1,260 @@
+/** @file
+
+  Micro Benchmark tool for the evaluation of header_rewrite rules - requires Catch2 v2.9.0+
+
+  Evaluates the conditions of a large synthetic ruleset against one request, the way the plugin
+  did, with the recursive evaluation of each condition and its modifiers, and the way it does now,
+  with the conditions compiled to a BranchProgram, the result of identical conditions shared, and a
+  literal prefix check before each regex. The conditions look up request header fields in a small
+  vector, as a stand in for the MIME header of the transaction.
+
+  - e.g. 500 rules
+  ```
+  $ ./benchmark_HeaderRewrite --ts-nrules 500
+  ```
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+      http://www.apache.org/licenses/LICENSE-2.0
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+
+#include "catch.hpp"
+
+#include "program.h"
+#include "regex_helper.h"
+
+#include <bitset>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <strings.h>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace
+{
+// Args
+int nrules = 200;
+
+using Fields = std::vector<std::pair<std::string, std::string>>;
+
+const Fields REQUEST = {
+  {"Host", "www.example.com"},
+  {"User-Agent", "Mozilla/5.0 (X11; Linux x86_64) Gecko/20100101 Firefox/118.0"},
+  {"Accept", "text/html,application/xhtml+xml"},
+  {"Accept-Encoding", "gzip, deflate, br"},
+  {"Cookie", "session=0123456789abcdef; theme=dark"},
+  {"X-Tenant", "tenant-7"},
+  {"@Path", "/static/img/logo.png"},
+};
+
+const std::string &
+field_get(const Fields &fields, const std::string &name)
+{
+  static const std::string empty;
+
+  for (auto const &[key, value] : fields) {
+    if (key.size() == name.size() && strcasecmp(key.c_str(), name.c_str()) == 0) {
+      return value;
+    }
+  }
+  return empty;
+}
+
+// A condition on the value of a field, with either a string or a regex match.
+struct Cond {
+  std::string field;
+  std::string match;
+  bool        regex  = false;
+  bool        is_or  = false;
+  bool        negate = false;
+
+  // The baseline, as the plugin used pcre.
+  pcre       *re       = nullptr;
+  pcre_extra *re_extra = nullptr;
+
+  regexHelper helper;
+  int         cse_id = -1;
+
+  Cond *next = nullptr;
+
+  bool
+  eval_pcre(const Fields &fields) const
+  {
+    const std::string &value = field_get(fields, field);
+    int                ovector[OVECCOUNT];
+
+    if (regex) {
+      return pcre_exec(re, re_extra, value.c_str(), value.size(), 0, 0, ovector, OVECCOUNT) > 0;
+    }
+    return value == match;
+  }
+
+  bool
+  eval(const Fields &fields) const
+  {
+    const std::string &value = field_get(fields, field);
+    int                ovector[OVECCOUNT];
+
+    if (regex) {
+      return helper.regexMatch(value.c_str(), value.size(), ovector) > 0;
+    }
+    return value == match;
+  }
+
+  // Condition::do_eval()
+  bool
+  do_eval(const Fields &fields) const
+  {
+    bool rt = eval_pcre(fields) != negate;
+
+    if (next) {
+      return is_or ? rt || next->do_eval(fields) : rt && next->do_eval(fields);
+    }
+    return rt;
+  }
+};
+
+struct Rule {
+  std::vector<std::unique_ptr<Cond>> conds;
+  BranchProgram<Cond>                program;
+};
+
+std::vector<Rule> rules;
+
+// Rules in the shape of a large configuration, most of which do not match: a few tenants and
+// hosts repeated over many rules, and regexes on the path of the URL.
+void
+make_rules()
+{
+  std::unordered_map<std::string, int> cse_ids;
+  const char                          *error;
+  int                                  erroffset;
+
+  rules.resize(nrules);
+  for (int i = 0; i < nrules; ++i) {
+    Rule &rule = rules[i];
+    auto  add  = [&rule](std::string field, std::string match, bool regex, bool is_or = false, bool negate = false) {
+      auto cond = std::make_unique<Cond>();
+
+      cond->field  = std::move(field);
+      cond->match  = std::move(match);
+      cond->regex  = regex;
+      cond->is_or  = is_or;
+      cond->negate = negate;
+      if (!rule.conds.empty()) {
+        rule.conds.back()->next = cond.get();
+      }
+      rule.conds.push_back(std::move(cond));
+    };
+
+    add("X-Tenant", "tenant-" + std::to_string(i % 8), false, true);
+    add("X-Tenant", "tenant-" + std::to_string((i + 1) % 8), false);
+    add("Host", "www.example.com", false, false, i % 3 == 0);
+    add("@Path", "^/api/v" + std::to_string(i % 4) + "/svc" + std::to_string(i) + "/.*\\.json$", true);
+
+    std::vector<BranchProgram<Cond>::Node> nodes;
+
+    for (auto &cond : rule.conds) {
+      if (cond->regex) {
+        cond->re       = pcre_compile(cond->match.c_str(), 0, &error, &erroffset, nullptr);
+        cond->re_extra = pcre_study(cond->re, 0, &error);
+        cond->helper.setRegexMatch(cond->match);
+      }
+      cond->cse_id = cse_ids.try_emplace(cond->field + '\x1f' + cond->match, cse_ids.size()).first->second;
+      nodes.push_back({cond.get(), {}, cond->negate, cond->is_or});
+    }
+    rule.program.compile(nodes);
+  }
+}
+
+int
+eval_baseline(const Fields &fields)
+{
+  int matched = 0;
+
+  for (auto const &rule : rules) {
+    matched += rule.conds.front()->do_eval(fields);
+  }
+  return matched;
+}
+
+int
+eval_compiled(const Fields &fields)
+{
+  std::bitset<1024> known, value;
+  int               matched = 0;
+
+  for (auto const &rule : rules) {
+    matched += rule.program.run([&](Cond &cond) {
+      if (cond.cse_id < 1024 && known[cond.cse_id]) {
+        return static_cast<bool>(value[cond.cse_id]);
+      }
+
+      bool rt = cond.eval(fields);
+
+      if (cond.cse_id < 1024) {
+        known[cond.cse_id] = true;
+        value[cond.cse_id] = rt;
+      }
+      return rt;
+    });
+  }
+  return matched;
+}
+
+} // namespace
+
+TEST_CASE("Micro benchmark of the header_rewrite conditions", "")
+{
+  make_rules();
+  REQUIRE(eval_baseline(REQUEST) == eval_compiled(REQUEST));
+
+  BENCHMARK("recursive")
+  {
+    return eval_baseline(REQUEST);
+  };
+
+  BENCHMARK("compiled")
+  {
+    return eval_compiled(REQUEST);
+  };
+}
+
+int
+main(int argc, char *argv[])
+{
+  Catch::Session session;
+
+  using namespace Catch::clara;
+
+  // clang-format off
+  auto cli = session.cli() |
+    Opt(nrules, "")["--ts-nrules"]("number of rules (default: 200)");
+  // clang-format on
+
+  session.cli(cli);
+
+  int returnCode = session.applyCommandLine(argc, argv);
+  if (returnCode != 0) {
+    return returnCode;
+  }
+
+  return session.run();
+}
@@ -0,0 +1,347 @@
+/** @file
+
+  Micro Benchmark tool for the io_uring network data path - requires Catch2 v2.9.0+ and Linux 6.0+
+
+  Echoes one message on each of a set of connections, the way the NetHandler does with epoll,
+  a readiness wait followed by a read and a write for each ready connection, and the way it does
+  with the io_uring data path, a multishot recv on each connection into a provided buffer ring,
+  and the sends of one loop iteration submitted together. The connections are socket pairs, the
+  client side is written and read directly by the benchmark.
+
+  The system calls made by the server side for each message are printed after the benchmarks.
+
+  - e.g. 256 connections, 4KB messages
+  ```
+  $ ./benchmark_IOUringNet --ts-nconns 256 --ts-size 4096
+  ```
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+      http://www.apache.org/licenses/LICENSE-2.0
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+
+#include "catch.hpp"
+
+#include <liburing.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+// Args
+int nconns = 64;
+int size   = 4096;
+
+constexpr unsigned int BUFFERS     = 1024;
+constexpr int          BUFFER_SIZE = 16384;
+constexpr int          GROUP_ID    = 0;
+
+struct Conn {
+  int client = -1;
+  int server = -1;
+};
+
+std::vector<Conn> conns;
+std::vector<char> message;
+std::vector<char> echo;
+
+uint64_t epoll_syscalls    = 0;
+uint64_t epoll_messages    = 0;
+uint64_t io_uring_syscalls = 0;
+uint64_t io_uring_messages = 0;
+
+void
+make_conns()
+{
+  conns.resize(nconns);
+  for (auto &conn : conns) {
+    int sv[2];
+
+    if (socketpair(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK, 0, sv) < 0) {
+      perror("socketpair");
+      exit(1);
+    }
+    conn.client = sv[0];
+    conn.server = sv[1];
+  }
+  message.assign(size, 'x');
+  echo.resize(size);
+}
+
+void
+send_messages()
+{
+  for (auto &conn : conns) {
+    if (write(conn.client, message.data(), message.size()) != static_cast<ssize_t>(message.size())) {
+      perror("write");
+      exit(1);
+    }
+  }
+}
+
+// Read the echo of every connection, the server has sent it all when this is called.
+void
+receive_echoes()
+{
+  for (auto &conn : conns) {
+    ssize_t got = 0;
+
+    while (got < size) {
+      ssize_t r = read(conn.client, echo.data() + got, size - got);
+
+      if (r <= 0) {
+        perror("read");
+        exit(1);
+      }
+      got += r;
+    }
+  }
+}
+
+//
+// epoll
+//
+
+struct EpollServer {
+  int              epfd = epoll_create1(EPOLL_CLOEXEC);
+  std::vector<int> pending; // bytes each connection still has to echo
+
+  EpollServer()
+  {
+    pending.resize(nconns);
+    for (int i = 0; i < nconns; ++i) {
+      epoll_event ev{};
+
+      ev.events   = EPOLLIN | EPOLLET;
+      ev.data.u32 = i;
+      epoll_ctl(epfd, EPOLL_CTL_ADD, conns[i].server, &ev);
+    }
+  }
+
+  ~EpollServer() { close(epfd); }
+
+  void
+  round()
+  {
+    char        buf[BUFFER_SIZE];
+    epoll_event events[256];
+    int         remaining = nconns;
+
+    send_messages();
+    while (remaining > 0) {
+      int n = epoll_wait(epfd, events, 256, -1);
+
+      ++epoll_syscalls;
+      for (int e = 0; e < n; ++e) {
+        int fd = conns[events[e].data.u32].server;
+
+        // read until EAGAIN, as the edge triggered NetHandler does, and echo what was read
+        for (;;) {
+          ssize_t r = read(fd, buf, sizeof(buf));
+
+          ++epoll_syscalls;
+          if (r <= 0) {
+            break;
+          }
+          if (write(fd, buf, r) != r) {
+            perror("write");
+            exit(1);
+          }
+          ++epoll_syscalls;
+          if ((pending[events[e].data.u32] += r) >= size) {
+            pending[events[e].data.u32] -= size;
+            --remaining;
+          }
+        }
+      }
+    }
+    receive_echoes();
+    epoll_messages += nconns;
+  }
+};
+
+//
+// io_uring
+//
+
+enum class Op : uint64_t { RECV = 0, SEND = 1 };
+
+// The operation, the connection and, for a send, the buffer it sends.
+inline uint64_t
+user_data(Op op, int conn, unsigned int bid = 0)
+{
+  return (static_cast<uint64_t>(bid) << 32) | (static_cast<uint64_t>(conn) << 1) | static_cast<uint64_t>(op);
+}
+
+struct IOUringServer {
+  io_uring           ring;
+  io_uring_buf_ring *br = nullptr;
+  std::vector<char>  buffers;
+  std::vector<int>   pending;
+
+  IOUringServer()
+  {
+    io_uring_params p{};
+    int             ret;
+
+    if (io_uring_queue_init_params(4096, &ring, &p) < 0) {
+      std::cerr << "io_uring_queue_init_params failed" << std::endl;
+      exit(1);
+    }
+    br = io_uring_setup_buf_ring(&ring, BUFFERS, GROUP_ID, 0, &ret);
+    if (br == nullptr) {
+      std::cerr << "io_uring_setup_buf_ring failed: " << strerror(-ret) << std::endl;
+      exit(1);
+    }
+    buffers.resize(static_cast<size_t>(BUFFERS) * BUFFER_SIZE);
+    for (unsigned int bid = 0; bid < BUFFERS; ++bid) {
+      io_uring_buf_ring_add(br, buffers.data() + bid * BUFFER_SIZE, BUFFER_SIZE, bid, io_uring_buf_ring_mask(BUFFERS), bid);
+    }
+    io_uring_buf_ring_advance(br, BUFFERS);
+
+    pending.resize(nconns);
+    for (int i = 0; i < nconns; ++i) {
+      arm(i);
+    }
+  }
+
+  ~IOUringServer()
+  {
+    io_uring_free_buf_ring(&ring, br, BUFFERS, GROUP_ID);
+    io_uring_queue_exit(&ring);
+  }
+
+  void
+  arm(int conn)
+  {
+    io_uring_sqe *sqe = io_uring_get_sqe(&ring);
+
+    io_uring_prep_recv_multishot(sqe, conns[conn].server, nullptr, 0, 0);
+    sqe->flags     |= IOSQE_BUFFER_SELECT;
+    sqe->buf_group  = GROUP_ID;
+    io_uring_sqe_set_data64(sqe, user_data(Op::RECV, conn));
+  }
+
+  void
+  round()
+  {
+    int remaining = nconns;
+    int sends     = 0;
+
+    send_messages();
+    while (remaining > 0 || sends > 0) {
+      // one system call to submit the sends of the last iteration and wait for completions
+      io_uring_submit_and_wait(&ring, 1);
+      ++io_uring_syscalls;
+
+      io_uring_cqe *cqe;
+      unsigned      head;
+      unsigned      seen = 0;
+
+      io_uring_for_each_cqe(&ring, head, cqe)
+      {
+        uint64_t data = io_uring_cqe_get_data64(cqe);
+        int      conn = static_cast<uint32_t>(data) >> 1;
+
+        ++seen;
+        if (static_cast<Op>(data & 1) == Op::SEND) {
+          // The buffer goes back to the ring once it is sent.
+          unsigned int bid = data >> 32;
+
+          io_uring_buf_ring_add(br, buffers.data() + bid * BUFFER_SIZE, BUFFER_SIZE, bid, io_uring_buf_ring_mask(BUFFERS), 0);
+          io_uring_buf_ring_advance(br, 1);
+          --sends;
+          continue;
+        }
+        if (!(cqe->flags & IORING_CQE_F_MORE)) {
+          arm(conn);
+        }
+        if (cqe->res <= 0 || !(cqe->flags & IORING_CQE_F_BUFFER)) {
+          continue;
+        }
+
+        unsigned int  bid = cqe->flags >> IORING_CQE_BUFFER_SHIFT;
+        io_uring_sqe *sqe = io_uring_get_sqe(&ring);
+
+        io_uring_prep_send(sqe, conns[conn].server, buffers.data() + bid * BUFFER_SIZE, cqe->res, 0);
+        io_uring_sqe_set_data64(sqe, user_data(Op::SEND, conn, bid));
+        ++sends;
+        if ((pending[conn] += cqe->res) >= size) {
+          pending[conn] -= size;
+          --remaining;
+        }
+      }
+      io_uring_cq_advance(&ring, seen);
+    }
+    receive_echoes();
+    io_uring_messages += nconns;
+  }
+};
+
+} // namespace
+
+TEST_CASE("Micro benchmark of the io_uring network data path", "")
+{
+  make_conns();
+
+  EpollServer   epoll_server;
+  IOUringServer io_uring_server;
+
+  BENCHMARK("epoll, read and write")
+  {
+    epoll_server.round();
+  };
+
+  BENCHMARK("io_uring, multishot recv and batched send")
+  {
+    io_uring_server.round();
+  };
+
+  std::cout << "system calls per message, epoll: " << static_cast<double>(epoll_syscalls) / epoll_messages
+            << ", io_uring: " << static_cast<double>(io_uring_syscalls) / io_uring_messages << std::endl;
+}
+
+int
+main(int argc, char *argv[])
+{
+  Catch::Session session;
+
+  using namespace Catch::clara;
+
+  // clang-format off
+  auto cli = session.cli() |
+    Opt(nconns, "")["--ts-nconns"]("number of connections (default: 64)") |
+    Opt(size, "")["--ts-size"]("message size in bytes (default: 4096)");
+  // clang-format on
+
+  session.cli(cli);
+
+  int returnCode = session.applyCommandLine(argc, argv);
+  if (returnCode != 0) {
+    return returnCode;
+  }
+
+  return session.run();
+}
@@ -0,0 +1,447 @@
+/** @file
+
+  Micro Benchmark tool for the dispatch of QUIC packets to the thread of their connection - requires Catch2 v2.9.0+ and Linux
+
+  Sends QUIC short header packets over the loopback to a reuseport group of UDP sockets, one for each receiving thread,
+  the way the UDP threads listen for QUIC. The first byte of the connection ID of a connection is the thread that owns
+  it. Without steering, the kernel spreads the packets by the hash of their addresses, the thread that receives a packet
+  looks its connection up in a shared table and hands the packet over to the owner, as a packet is handed over to the
+  net thread of its connection. With the steering program of QUICPacketHandlerIn, each packet reaches its owner, which
+  looks the connection up in its own shard of the table.
+
+  The packets per second, and the latency from the send to the processing by the owner, are printed after the
+  benchmarks.
+
+  - e.g. 4 threads, 256 connections
+  ```
+  $ ./benchmark_QUICDispatch --ts-nthreads 4 --ts-nconns 256
+  ```
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+      http://www.apache.org/licenses/LICENSE-2.0
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+
+#include "catch.hpp"
+
+#include <arpa/inet.h>
+#include <linux/filter.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace
+{
+// Args
+int nthreads = 4;
+int nconns   = 256;
+int npackets = 100; // per connection, in a run
+int size     = 1200;
+int window   = 64; // packets in flight
+
+constexpr int CID_LEN    = 8;
+constexpr int PARTITIONS = 64;
+
+uint64_t
+now_ns()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// The connection IDs, the first byte is the owner.
+std::vector<uint64_t> cids;
+
+void
+make_cids()
+{
+  cids.resize(nconns);
+  for (int i = 0; i < nconns; ++i) {
+    cids[i] = (static_cast<uint64_t>(i % nthreads) << 56) | (static_cast<uint64_t>(rand()) << 24) | i;
+  }
+}
+
+/// A connection table with a lock for each partition, as the MTHashTable of QUICConnectionTable.
+struct Table {
+  std::mutex                        locks[PARTITIONS];
+  std::unordered_map<uint64_t, int> maps[PARTITIONS];
+
+  void
+  insert(uint64_t cid, int conn)
+  {
+    maps[cid % PARTITIONS][cid] = conn;
+  }
+
+  int
+  lookup(uint64_t cid)
+  {
+    std::lock_guard<std::mutex> lock(locks[cid % PARTITIONS]);
+    auto                        spot = maps[cid % PARTITIONS].find(cid);
+    return spot == maps[cid % PARTITIONS].end() ? -1 : spot->second;
+  }
+};
+
+struct Packet {
+  int      conn;
+  uint64_t sent_at;
+};
+
+struct Receiver {
+  int                   fd  = -1;
+  int                   efd = eventfd(0, EFD_NONBLOCK);
+  std::mutex            mutex;
+  std::vector<Packet>   handoff;
+  std::vector<uint64_t> latencies;
+  std::thread           thread;
+};
+
+struct Results {
+  uint64_t packets   = 0;
+  uint64_t handed    = 0;
+  uint64_t usecs     = 0;
+  uint64_t mean_ns   = 0;
+  uint64_t p99_ns    = 0;
+  uint64_t max_ns    = 0;
+  uint64_t lost_runs = 0;
+
+  void
+  print(const char *name) const
+  {
+    std::cout << name << ": " << packets * 1000000 / std::max<uint64_t>(usecs, 1) << " packets per second, "
+              << handed * 100 / std::max<uint64_t>(packets, 1) << "% handed over, latency mean " << mean_ns / 1000
+              << " us, p99 " << p99_ns / 1000 << " us, max " << max_ns / 1000 << " us";
+    if (lost_runs) {
+      std::cout << ", " << lost_runs << " runs with lost packets";
+    }
+    std::cout << std::endl;
+  }
+};
+
+class Dispatcher
+{
+public:
+  explicit Dispatcher(bool steer) : _steer(steer), _shards(steer ? nthreads : 1)
+  {
+    sockaddr_in addr{};
+
+    addr.sin_family      = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+
+    // The sockets bind in the order of the threads, the place of a socket in the group is its thread.
+    for (int i = 0; i < nthreads; ++i) {
+      auto r      = std::make_unique<Receiver>();
+      int  on     = 1;
+      int  rcvbuf = 4 * 1024 * 1024;
+
+      r->fd = socket(AF_INET, SOCK_DGRAM, 0);
+      setsockopt(r->fd, SOL_SOCKET, SO_REUSEPORT, &on, sizeof(on));
+      setsockopt(r->fd, SOL_SOCKET, SO_RCVBUF, &rcvbuf, sizeof(rcvbuf));
+      if (bind(r->fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0) {
+        perror("bind");
+        exit(1);
+      }
+      socklen_t len = sizeof(addr);
+      getsockname(r->fd, reinterpret_cast<sockaddr *>(&addr), &len);
+      _receivers.push_back(std::move(r));
+    }
+    if (steer) {
+      attach_steering(_receivers.back()->fd);
+    }
+
+    for (int i = 0; i < nconns; ++i) {
+      _shards[steer ? i % nthreads : 0].insert(cids[i], i);
+
+      int fd = socket(AF_INET, SOCK_DGRAM, 0);
+      if (connect(fd, reinterpret_cast<sockaddr *>(&addr), sizeof(addr)) < 0) {
+        perror("connect");
+        exit(1);
+      }
+      _clients.push_back(fd);
+    }
+
+    for (int i = 0; i < nthreads; ++i) {
+      _receivers[i]->thread = std::thread([this, i]() { this->receive(i); });
+    }
+  }
+
+  ~Dispatcher()
+  {
+    _stop = true;
+    for (auto &r : _receivers) {
+      r->thread.join();
+      close(r->fd);
+      close(r->efd);
+    }
+    for (int fd : _clients) {
+      close(fd);
+    }
+  }
+
+  /// Send @c npackets packets on each connection. @return @c false if packets were lost.
+  bool
+  run()
+  {
+    std::vector<char> buf(size, 0);
+    uint64_t          sent = _processed;
+
+    buf[0] = 0x40; // short header
+    for (int p = 0; p < npackets; ++p) {
+      for (int c = 0; c < nconns; ++c) {
+        if (!wait_for(sent - window)) {
+          return false;
+        }
+        uint64_t cid = cids[c];
+        uint64_t at  = now_ns();
+        for (int b = 0; b < CID_LEN; ++b) {
+          buf[1 + b] = static_cast<char>(cid >> (56 - 8 * b));
+        }
+        memcpy(buf.data() + 1 + CID_LEN, &at, sizeof(at));
+        if (send(_clients[c], buf.data(), buf.size(), 0) < 0) {
+          perror("send");
+          exit(1);
+        }
+        ++sent;
+      }
+    }
+    return wait_for(sent);
+  }
+
+  Results
+  report()
+  {
+    Results  results;
+    uint64_t handed = _handed;
+    uint64_t lost   = _lost_runs;
+
+    for (auto &r : _receivers) {
+      std::lock_guard<std::mutex> lock(r->mutex);
+      r->latencies.clear();
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    run();
+    results.usecs = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<uint64_t> latencies;
+    for (auto &r : _receivers) {
+      std::lock_guard<std::mutex> lock(r->mutex);
+      latencies.insert(latencies.end(), r->latencies.begin(), r->latencies.end());
+    }
+    std::sort(latencies.begin(), latencies.end());
+    results.packets = latencies.size();
+    results.handed  = _handed - handed;
+    if (!latencies.empty()) {
+      uint64_t total = 0;
+      for (auto l : latencies) {
+        total += l;
+      }
+      results.mean_ns = total / latencies.size();
+      results.p99_ns  = latencies[latencies.size() * 99 / 100];
+      results.max_ns  = latencies.back();
+    }
+    results.lost_runs = _lost_runs - lost;
+    return results;
+  }
+
+private:
+  /// The program of QUICPacketHandlerIn.
+  void
+  attach_steering(int fd)
+  {
+    sock_filter prog[] = {
+      BPF_STMT(BPF_LD | BPF_B | BPF_ABS, 0),
+      BPF_JUMP(BPF_JMP | BPF_JSET | BPF_K, 0x80, 3, 0),
+      BPF_STMT(BPF_LD | BPF_B | BPF_ABS, 1),
+      BPF_JUMP(BPF_JMP | BPF_JGE | BPF_K, static_cast<uint32_t>(nthreads), 1, 0),
+      BPF_STMT(BPF_RET | BPF_A, 0),
+      BPF_STMT(BPF_RET | BPF_K, static_cast<uint32_t>(nthreads)),
+    };
+    sock_fprog fprog;
+
+    fprog.len    = sizeof(prog) / sizeof(prog[0]);
+    fprog.filter = prog;
+    if (setsockopt(fd, SOL_SOCKET, SO_ATTACH_REUSEPORT_CBPF, &fprog, sizeof(fprog)) < 0) {
+      perror("SO_ATTACH_REUSEPORT_CBPF");
+      exit(1);
+    }
+  }
+
+  // Wait until no more than @a sent packets are unprocessed, a packet lost on the way ends the run.
+  bool
+  wait_for(uint64_t sent)
+  {
+    auto start = std::chrono::steady_clock::now();
+
+    while (static_cast<int64_t>(_processed.load() - sent) < 0) {
+      if (std::chrono::steady_clock::now() - start > std::chrono::seconds(1)) {
+        ++_lost_runs;
+        _processed = sent;
+        return false;
+      }
+      std::this_thread::yield();
+    }
+    return true;
+  }
+
+  void
+  process(Receiver &r, Packet const &packet)
+  {
+    uint64_t latency = now_ns() - packet.sent_at;
+    {
+      std::lock_guard<std::mutex> lock(r.mutex);
+      r.latencies.push_back(latency);
+    }
+    ++_processed;
+  }
+
+  void
+  receive(int self)
+  {
+    Receiver           &r = *_receivers[self];
+    pollfd              fds[2];
+    char                buf[65536];
+    std::vector<Packet> handoff;
+
+    fds[0] = {r.fd, POLLIN, 0};
+    fds[1] = {r.efd, POLLIN, 0};
+    while (!_stop) {
+      if (poll(fds, 2, 100) <= 0) {
+        continue;
+      }
+
+      ssize_t n;
+      while ((n = recv(r.fd, buf, sizeof(buf), MSG_DONTWAIT)) >= 1 + CID_LEN + 8) {
+        uint64_t cid = 0;
+        Packet   packet;
+
+        for (int b = 0; b < CID_LEN; ++b) {
+          cid = (cid << 8) | static_cast<uint8_t>(buf[1 + b]);
+        }
+        memcpy(&packet.sent_at, buf + 1 + CID_LEN, sizeof(packet.sent_at));
+
+        int owner   = static_cast<uint8_t>(buf[1]);
+        packet.conn = _shards[_steer ? owner : 0].lookup(cid);
+        if (owner == self) {
+          process(r, packet);
+        } else {
+          Receiver &o   = *_receivers[owner];
+          uint64_t  one = 1;
+          {
+            std::lock_guard<std::mutex> lock(o.mutex);
+            o.handoff.push_back(packet);
+          }
+          ++_handed;
+          if (write(o.efd, &one, sizeof(one)) < 0) {
+            perror("write");
+          }
+        }
+      }
+
+      uint64_t count;
+      if (read(r.efd, &count, sizeof(count)) > 0) {
+        {
+          std::lock_guard<std::mutex> lock(r.mutex);
+          handoff.swap(r.handoff);
+        }
+        for (auto const &packet : handoff) {
+          process(r, packet);
+        }
+        handoff.clear();
+      }
+    }
+  }
+
+  bool                                   _steer;
+  std::vector<Table>                     _shards;
+  std::vector<std::unique_ptr<Receiver>> _receivers;
+  std::vector<int>                       _clients;
+  std::atomic<uint64_t>                  _processed{0};
+  std::atomic<uint64_t>                  _handed{0};
+  uint64_t                               _lost_runs = 0;
+  std::atomic<bool>                      _stop{false};
+};
+
+} // namespace
+
+TEST_CASE("Micro benchmark of the dispatch of QUIC packets", "")
+{
+  make_cids();
+
+  Dispatcher handoff(false);
+  Dispatcher steered(true);
+
+  BENCHMARK("hash, shared table and hand over")
+  {
+    return handoff.run();
+  };
+
+  BENCHMARK("steered by connection ID, sharded table")
+  {
+    return steered.run();
+  };
+
+  std::cout << std::endl;
+  handoff.report().print("hand over");
+  steered.report().print("steered");
+}
+
+int
+main(int argc, char *argv[])
+{
+  Catch::Session session;
+
+  using namespace Catch::clara;
+
+  // clang-format off
+  auto cli = session.cli() |
+    Opt(nthreads, "")["--ts-nthreads"]("number of receiving threads (default: 4)") |
+    Opt(nconns, "")["--ts-nconns"]("number of connections (default: 256)") |
+    Opt(npackets, "")["--ts-npackets"]("number of packets on each connection in a run (default: 100)") |
+    Opt(size, "")["--ts-size"]("packet size in bytes (default: 1200)") |
+    Opt(window, "")["--ts-window"]("number of packets in flight (default: 64)");
+  // clang-format on
+
+  session.cli(cli);
+
+  int returnCode = session.applyCommandLine(argc, argv);
+  if (returnCode != 0) {
+    return returnCode;
+  }
+
+  nthreads = std::clamp(nthreads, 1, 256);
+  nconns   = std::max(nconns, 1);
+  size     = std::clamp(size, 1 + CID_LEN + 8, 65507);
+  window   = std::max(window, 1);
+
+  return session.run();
+}
@@ -0,0 +1,240 @@
+/** @file
+
+  Micro Benchmark tool for the timeout checks of idle connections - requires Catch2 v2.9.0+
+
+  Runs the once a second timeout check of a network thread over a set of mostly idle connections, the way the
+  InactivityCop did with a scan of all the connections, and the way it does with the timing wheel. Each run is a
+  second of simulated time, in which a share of the connections has I/O that pushes back its inactivity timeout, and
+  the connections that time out are replaced by new ones.
+
+  The longest and the mean run are printed after the benchmarks, this is how long a run holds up the event loop of
+  the thread.
+
+  - e.g. 500k connections, 1% of them active each second
+  ```
+  $ ./benchmark_TimeoutWheel --ts-nconns 500000 --ts-active 1
+  ```
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+      http://www.apache.org/licenses/LICENSE-2.0
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+
+#include "catch.hpp"
+
+#include "iocore/net/TimeoutWheel.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+namespace
+{
+// Args
+int nconns  = 500000;
+int active  = 1;  // percent of the connections with I/O each second
+int timeout = 30; // inactivity timeout in seconds
+
+// The fields a timeout check touches, in an object the size of a UnixNetVConnection.
+struct Conn {
+  ink_hrtime next_inactivity_timeout_at = 0;
+  int        timeout_slot               = -1;
+  ink_hrtime timeout_check_at           = 0;
+  LINK(Conn, open_link);
+  LINK(Conn, timeout_link);
+  char rest[1024];
+};
+
+struct RunTimes {
+  std::chrono::nanoseconds max{0};
+  std::chrono::nanoseconds total{0};
+  uint64_t                 runs    = 0;
+  uint64_t                 timeout = 0;
+
+  void
+  add(std::chrono::nanoseconds t)
+  {
+    max    = std::max(max, t);
+    total += t;
+    ++runs;
+  }
+
+  void
+  print(const char *name) const
+  {
+    using std::chrono::microseconds;
+
+    uint64_t n = std::max<uint64_t>(runs, 1);
+
+    std::cout << name << ": longest run " << std::chrono::duration_cast<microseconds>(max).count() << " us, mean run "
+              << std::chrono::duration_cast<microseconds>(total).count() / n << " us, " << timeout / n << " timeouts per run"
+              << std::endl;
+  }
+};
+
+/// The connections of one thread, and the simulated clock.
+struct Conns {
+  std::vector<Conn> conns;
+  ink_hrtime        now = HRTIME_SECONDS(1000000);
+  std::mt19937      rng{42};
+
+  Conns()
+  {
+    std::uniform_int_distribution<int> spread(0, timeout - 1);
+
+    conns.resize(nconns);
+    // The connections went idle over the last timeout period.
+    for (auto &c : conns) {
+      c.next_inactivity_timeout_at = now + HRTIME_SECONDS(spread(rng)) + 1;
+    }
+  }
+
+  // One second passes, with I/O on some connections.
+  void
+  tick()
+  {
+    std::uniform_int_distribution<int> pick(0, nconns - 1);
+
+    now += HRTIME_SECOND;
+    for (int i = 0, n = static_cast<int>(static_cast<int64_t>(nconns) * active / 100); i < n; ++i) {
+      conns[pick(rng)].next_inactivity_timeout_at = now + HRTIME_SECONDS(timeout);
+    }
+  }
+};
+
+/// The InactivityCop with a scan of all the open connections.
+struct ScanCop {
+  Conns &c;
+  Que(Conn, open_link) open_list;
+  RunTimes times;
+
+  explicit ScanCop(Conns &conns) : c(conns)
+  {
+    std::vector<Conn *> order;
+
+    // The connections are not in the list in the order of their addresses.
+    for (auto &conn : c.conns) {
+      order.push_back(&conn);
+    }
+    std::shuffle(order.begin(), order.end(), c.rng);
+    for (auto conn : order) {
+      open_list.enqueue(conn);
+    }
+  }
+
+  void
+  run()
+  {
+    c.tick();
+
+    auto start = std::chrono::steady_clock::now();
+
+    forl_LL(Conn, conn, open_list)
+    {
+      if (conn->next_inactivity_timeout_at && conn->next_inactivity_timeout_at < c.now) {
+        // closed, a new connection takes its place
+        conn->next_inactivity_timeout_at = c.now + HRTIME_SECONDS(timeout);
+        ++times.timeout;
+      }
+    }
+    times.add(std::chrono::steady_clock::now() - start);
+  }
+};
+
+/// The InactivityCop with the timing wheel.
+struct WheelCop {
+  Conns                                         &c;
+  TimeoutWheel<Conn, DList(Conn, timeout_link)> *wheel;
+  RunTimes                                       times;
+
+  explicit WheelCop(Conns &conns) : c(conns), wheel(new TimeoutWheel<Conn, DList(Conn, timeout_link)>(c.now))
+  {
+    for (auto &conn : c.conns) {
+      wheel->schedule(&conn, conn.next_inactivity_timeout_at);
+    }
+  }
+
+  ~WheelCop() { delete wheel; }
+
+  void
+  run()
+  {
+    c.tick();
+
+    auto start = std::chrono::steady_clock::now();
+
+    wheel->advance(c.now);
+    while (Conn *conn = wheel->pop_due()) {
+      if (conn->next_inactivity_timeout_at < c.now) {
+        conn->next_inactivity_timeout_at = c.now + HRTIME_SECONDS(timeout);
+        ++times.timeout;
+      }
+      wheel->schedule(conn, conn->next_inactivity_timeout_at);
+    }
+    times.add(std::chrono::steady_clock::now() - start);
+  }
+};
+
+} // namespace
+
+TEST_CASE("Micro benchmark of the timeout checks of idle connections", "")
+{
+  Conns    scan_conns;
+  Conns    wheel_conns;
+  ScanCop  scan_cop(scan_conns);
+  WheelCop wheel_cop(wheel_conns);
+
+  BENCHMARK("scan of all connections")
+  {
+    scan_cop.run();
+  };
+
+  BENCHMARK("timing wheel")
+  {
+    wheel_cop.run();
+  };
+
+  scan_cop.times.print("scan");
+  wheel_cop.times.print("wheel");
+}
+
+int
+main(int argc, char *argv[])
+{
+  Catch::Session session;
+
+  using namespace Catch::clara;
+
+  // clang-format off
+  auto cli = session.cli() |
+    Opt(nconns, "")["--ts-nconns"]("number of connections (default: 500000)") |
+    Opt(active, "")["--ts-active"]("percent of the connections with I/O each second (default: 1)") |
+    Opt(timeout, "")["--ts-timeout"]("inactivity timeout in seconds (default: 30)");
+  // clang-format on
+
+  session.cli(cli);
+
+  int returnCode = session.applyCommandLine(argc, argv);
+  if (returnCode != 0) {
+    return returnCode;
+  }
+
+  return session.run();
+}
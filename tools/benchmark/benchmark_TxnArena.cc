@@ -0,0 +1,179 @@
+/** @file
+
+  Micro Benchmark tool for the transaction arena of the plugin API - requires Catch2 v2.9.0+
+
+  Compares the strings a plugin allocates while processing a transaction, the URL string and a
+  few copies of header values, with ats_malloc / ats_free (TSUrlStringGet, TSstrdup and TSfree)
+  and with an arena that is reset when the transaction is destroyed (TSHttpTxnArenaUrlStringGet
+  and TSHttpTxnArenaStrdup). The number of malloc calls per transaction is reported as well.
+
+  - e.g. 10 strings of each transaction
+  ```
+  $ ./benchmark_TxnArena --ts-nstrings 10
+  ```
+
+  @section license License
+
+  Licensed to the Apache Software Foundation (ASF) under one
+  or more contributor license agreements.  See the NOTICE file
+  distributed with this work for additional information
+  regarding copyright ownership.  The ASF licenses this file
+  to you under the Apache License, Version 2.0 (the
+  "License"); you may not use this file except in compliance
+  with the License.  You may obtain a copy of the License at
+      http://www.apache.org/licenses/LICENSE-2.0
+  Unless required by applicable law or agreed to in writing, software
+  distributed under the License is distributed on an "AS IS" BASIS,
+  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+  See the License for the specific language governing permissions and
+  limitations under the License.
+ */
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#define CATCH_CONFIG_RUNNER
+
+#include "catch.hpp"
+
+#include "proxy/hdrs/HTTP.h"
+#include "tscore/Arena.h"
+#include "tscore/ink_memory.h"
+
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+extern int cmd_disable_pfreelist;
+
+namespace
+{
+// Args
+int nstrings = 5;
+
+int64_t malloc_calls = 0;
+
+const std::string_view URL_STRING{"http://www.example.com/path/to/an/asset.html?query=value&other=value"};
+
+std::vector<std::string> values;
+
+// The allocations of a plugin for one transaction, released with TSfree.
+size_t
+txn_malloc(URL &url)
+{
+  size_t total = 0;
+  int    length;
+  char  *str = url.string_get(nullptr, &length);
+
+  total += length;
+  ats_free(str);
+  for (auto const &value : values) {
+    char *copy = ats_strndup(value.data(), value.size());
+
+    total += strlen(copy);
+    ats_free(copy);
+  }
+  return total;
+}
+
+// The allocations of a plugin for one transaction, released when the transaction is destroyed.
+size_t
+txn_arena(URL &url)
+{
+  Arena  arena;
+  size_t total = 0;
+  int    length;
+
+  url.string_get(&arena, &length);
+  total += length;
+  for (auto const &value : values) {
+    char *copy = static_cast<char *>(arena.alloc(value.size() + 1, 1));
+
+    memcpy(copy, value.data(), value.size());
+    copy[value.size()]  = '\0';
+    total              += strlen(copy);
+  }
+  arena.reset();
+  return total;
+}
+
+template <typename F>
+double
+mallocs_per_txn(F &&f)
+{
+  constexpr int N      = 10000;
+  int64_t       before = malloc_calls;
+
+  for (int i = 0; i < N; ++i) {
+    f();
+  }
+  return static_cast<double>(malloc_calls - before) / N;
+}
+
+} // namespace
+
+#if defined(__GLIBC__) && !defined(__SANITIZE_ADDRESS__)
+// Count the calls to malloc, the memory is returned by the glibc allocator so free is unchanged.
+extern "C" void *__libc_malloc(size_t size);
+
+extern "C" void *
+malloc(size_t size)
+{
+  ++malloc_calls;
+  return __libc_malloc(size);
+}
+#endif
+
+TEST_CASE("Micro benchmark of the transaction arena", "")
+{
+  URL url;
+
+  url.create(nullptr);
+  REQUIRE(url.parse(URL_STRING) == PARSE_RESULT_DONE);
+  for (int i = 0; i < nstrings; ++i) {
+    values.emplace_back("value-of-a-header-field-" + std::to_string(i));
+  }
+
+  // Warm up the arena block free list, as it is on a running server.
+  txn_arena(url);
+
+  std::cout << "strings=" << nstrings + 1 << " mallocs per transaction: ats_malloc=" << mallocs_per_txn([&] { txn_malloc(url); })
+            << " arena=" << mallocs_per_txn([&] { txn_arena(url); }) << std::endl;
+
+  BENCHMARK("ats_malloc")
+  {
+    return txn_malloc(url);
+  };
+
+  BENCHMARK("arena")
+  {
+    return txn_arena(url);
+  };
+
+  url.destroy();
+}
+
+int
+main(int argc, char *argv[])
+{
+  Catch::Session session;
+
+  using namespace Catch::clara;
+
+  // clang-format off
+  auto cli = session.cli() |
+    Opt(nstrings, "")["--ts-nstrings"]("number of header values copied by each transaction (default: 5)");
+  // clang-format on
+
+  session.cli(cli);
+
+  int returnCode = session.applyCommandLine(argc, argv);
+  if (returnCode != 0) {
+    return returnCode;
+  }
+
+  // No thread setup, forbid use of thread local allocators.
+  cmd_disable_pfreelist = true;
+  url_init();
+
+  return session.run();
+}